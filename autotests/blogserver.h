@@ -0,0 +1,236 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_TEST_BLOGSERVER_H_
+#define KBLOG_TEST_BLOGSERVER_H_
+
+#include <QStringList>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QUrl>
+#include <QUrlQuery>
+
+// answers just enough of the Movable Type API and records the methods called;
+// as the proxy of a GData blog it serves its post feed
+class BlogServer : public QTcpServer
+{
+public:
+    QStringList mMethods;
+    // the query of every feed request
+    QStringList mFeeds;
+    // whether system.listMethods lists the WordPress API
+    bool mWordpress = false;
+    // the ids of the posts on the blog, the newest first
+    QStringList mPostIds;
+    // the posts sent without an id, so they cannot be read
+    QStringList mUnreadablePostIds;
+    // the most posts getRecentPosts returns, 0 for no limit
+    int mRecentPostsCap = 0;
+    // whether system.listMethods lists system.multicall
+    bool mMulticall = false;
+    // the methods answered with a fault, and its code
+    QStringList mFaults;
+    int mFaultCode = 4;
+    // the methods of every system.multicall, in the order they were called
+    QList<QStringList> mMulticalls;
+    // sent in front of the answer to system.multicall, e.g. a PHP warning
+    QByteArray mMulticallJunk;
+
+protected:
+    void incomingConnection(qintptr handle) override
+    {
+        QTcpSocket *socket = new QTcpSocket(this);
+        socket->setSocketDescriptor(handle);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            QByteArray request = socket->property("buffer").toByteArray() + socket->readAll();
+            int end;
+            while ((end = request.indexOf("\r\n\r\n")) >= 0) {
+                if (request.startsWith("GET ")) {
+                    const QByteArray target = request.left(request.indexOf("\r\n")).split(' ').value(1);
+                    request.remove(0, end + 4);
+                    const QByteArray answer = feed(QUrl(QString::fromLatin1(target)));
+                    socket->write("HTTP/1.1 200 OK\r\nContent-Type: application/atom+xml\r\nContent-Length: " +
+                                  QByteArray::number(answer.size()) + "\r\n\r\n" + answer);
+                    continue;
+                }
+                const QByteArray head = request.left(end).toLower();
+                const int start = head.indexOf("content-length:");
+                const int length = start < 0 ? 0 :
+                                   head.mid(start + 15, head.indexOf('\r', start) - start - 15).trimmed().toInt();
+                if (request.size() < end + 4 + length) {
+                    break;
+                }
+                const QByteArray body = request.mid(end + 4, length);
+                request.remove(0, end + 4 + length);
+                const int nameStart = body.indexOf("<methodName>") + 12;
+                const QString method = QString::fromLatin1(body.mid(nameStart, body.indexOf("</methodName>") - nameStart));
+                mMethods << method;
+                QByteArray answer = "<?xml version=\"1.0\"?><methodResponse>" +
+                                    respond(method, body) + "</methodResponse>";
+                if (method == QLatin1String("system.multicall")) {
+                    answer.prepend(mMulticallJunk);
+                }
+                socket->write("HTTP/1.1 200 OK\r\nContent-Type: text/xml\r\nContent-Length: " +
+                              QByteArray::number(answer.size()) + "\r\n\r\n" + answer);
+            }
+            socket->setProperty("buffer", request);
+        });
+    }
+
+private:
+    QByteArray fault() const
+    {
+        return "<value><struct>"
+               "<member><name>faultCode</name><value><int>" + QByteArray::number(mFaultCode) +
+               "</int></value></member>"
+               "<member><name>faultString</name><value><string>Not allowed</string></value></member>"
+               "</struct></value>";
+    }
+
+    QByteArray respond(const QString &method, const QByteArray &body)
+    {
+        if (mFaults.contains(method)) {
+            return "<fault>" + fault() + "</fault>";
+        }
+        if (method != QLatin1String("system.multicall")) {
+            return "<params><param><value>" + value(method, body) + "</value></param></params>";
+        }
+        // every call is a struct with the members methodName and params
+        QStringList methods;
+        QByteArray results = "<array><data>";
+        int pos = body.indexOf("<name>methodName</name>");
+        while (pos >= 0) {
+            const int next = body.indexOf("<name>methodName</name>", pos + 1);
+            const QByteArray call = body.mid(pos, next < 0 ? -1 : next - pos);
+            const int start = call.indexOf("<string>") + 8;
+            const QString name = QString::fromLatin1(call.mid(start, call.indexOf("</string>") - start));
+            methods << name;
+            if (mFaults.contains(name)) {
+                results += fault();
+            } else {
+                results += "<value><array><data><value>" + value(name, call) + "</value></data></array></value>";
+            }
+            pos = next;
+        }
+        mMulticalls << methods;
+        return "<params><param><value>" + results + "</data></array></value></param></params>";
+    }
+
+    // the last integer of the call, e.g. the number of posts asked for
+    static int lastInt(const QByteArray &body)
+    {
+        const int start = body.lastIndexOf("<int>") + 5;
+        return body.mid(start, body.indexOf("</int>", start) - start).toInt();
+    }
+
+    // the integer member @p name of a struct in the call
+    static int member(const QByteArray &body, const QByteArray &name)
+    {
+        const int start = body.indexOf("<int>", body.indexOf("<name>" + name + "</name>")) + 5;
+        return body.mid(start, body.indexOf("</int>", start) - start).toInt();
+    }
+
+    // an Atom feed of the posts the start-index and max-results of @p url ask for
+    QByteArray feed(const QUrl &url)
+    {
+        const QUrlQuery query(url);
+        mFeeds << url.query();
+        const int start = query.queryItemValue(QStringLiteral("start-index")).toInt() - 1;
+        const int count = query.queryItemValue(QStringLiteral("max-results")).toInt();
+        QByteArray entries;
+        for (int i = start; i >= 0 && i < qMin(start + count, mPostIds.count()); ++i) {
+            const QByteArray postId = mPostIds.at(i).toLatin1();
+            const QByteArray id = mUnreadablePostIds.contains(mPostIds.at(i)) ? "entry-" : "post-";
+            entries += "<entry><id>tag:blogger.com,1999:blog-1." + id + postId + "</id>"
+                       "<title>Post " + postId + "</title><content type=\"html\">content</content>"
+                       "<published>2026-03-01T10:00:00Z</published>"
+                       "<updated>2026-03-01T10:00:00Z</updated></entry>";
+        }
+        return "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+               "<feed xmlns=\"http://www.w3.org/2005/Atom\">"
+               "<id>tag:blogger.com,1999:blog-1</id><title>Blog</title>"
+               "<updated>2026-03-01T10:00:00Z</updated>" + entries + "</feed>";
+    }
+
+    static QByteArray post(const QString &postId)
+    {
+        return "<struct>"
+               "<member><name>postid</name><value><string>" + postId.toLatin1() + "</string></value></member>"
+               "<member><name>title</name><value><string>Post " + postId.toLatin1() + "</string></value></member>"
+               "<member><name>description</name><value><string>content</string></value></member>"
+               "<member><name>dateCreated</name><value><dateTime.iso8601>20260301T10:00:00</dateTime.iso8601></value></member>"
+               "</struct>";
+    }
+
+    QByteArray value(const QString &method, const QByteArray &body) const
+    {
+        if (method == QLatin1String("system.listMethods")) {
+            return "<array><data><value><string>metaWeblog.newPost</string></value>"
+                   "<value><string>mt.setPostCategories</string></value>" +
+                   QByteArray(mWordpress ? "<value><string>wp.getCategories</string></value>"
+                              "<value><string>wp.getPosts</string></value>" : "") +
+                   QByteArray(mMulticall ? "<value><string>system.multicall</string></value>" : "") +
+                   "</data></array>";
+        }
+        if (method == QLatin1String("metaWeblog.getCategories")) {
+            return "<array><data><value><struct>"
+                   "<member><name>categoryName</name><value><string>KDE</string></value></member>"
+                   "<member><name>categoryId</name><value><string>7</string></value></member>"
+                   "</struct></value></data></array>";
+        }
+        if (method == QLatin1String("metaWeblog.newPost")) {
+            return "<string>" + QByteArray::number(mMethods.count()) + "</string>";
+        }
+        if (method == QLatin1String("metaWeblog.getPost")) {
+            return "<struct>"
+                   "<member><name>postid</name><value><string>99</string></value></member>"
+                   "<member><name>title</name><value><string>Fetched</string></value></member>"
+                   "<member><name>description</name><value><string>content</string></value></member>"
+                   "<member><name>dateCreated</name><value><dateTime.iso8601>20260301T10:00:00</dateTime.iso8601></value></member>"
+                   "<member><name>categories</name><value><array><data>"
+                   "<value><string>KDE</string></value></data></array></value></member>"
+                   "</struct>";
+        }
+        if (method == QLatin1String("metaWeblog.getRecentPosts")) {
+            int count = qMin(lastInt(body), mPostIds.count());
+            if (mRecentPostsCap > 0) {
+                count = qMin(count, mRecentPostsCap);
+            }
+            QByteArray posts = "<array><data>";
+            for (int i = 0; i < count; ++i) {
+                posts += "<value>" + post(mPostIds.at(i)) + "</value>";
+            }
+            return posts + "</data></array>";
+        }
+        if (method == QLatin1String("wp.getPosts")) {
+            const int offset = member(body, "offset");
+            const int count = member(body, "number");
+            QByteArray posts = "<array><data>";
+            for (int i = offset; i < qMin(offset + count, mPostIds.count()); ++i) {
+                const QByteArray postId = mPostIds.at(i).toLatin1();
+                posts += "<value><struct>";
+                if (!mUnreadablePostIds.contains(mPostIds.at(i))) {
+                    posts += "<member><name>post_id</name><value><string>" + postId + "</string></value></member>";
+                }
+                posts += "<member><name>post_title</name><value><string>Post " + postId + "</string></value></member>"
+                         "<member><name>post_content</name><value><string>content</string></value></member>"
+                         "</struct></value>";
+            }
+            return posts + "</data></array>";
+        }
+        if (method == QLatin1String("mt.getPostCategories")) {
+            return "<array><data><value><struct>"
+                   "<member><name>categoryName</name><value><string>KDE</string></value></member>"
+                   "<member><name>categoryId</name><value><string>7</string></value></member>"
+                   "</struct></value></data></array>";
+        }
+        return "<boolean>1</boolean>";
+    }
+};
+
+#endif
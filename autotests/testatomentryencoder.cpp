@@ -0,0 +1,97 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QTest>
+#include <QXmlStreamReader>
+
+#include "atomentryencoder_p.h"
+#include "kblog/blogcomment.h"
+#include "kblog/blogpost.h"
+
+using namespace KBlog;
+
+class testAtomEntryEncoder: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testCreatePost();
+    void testModifyPost();
+    void testComment();
+};
+
+#include "testatomentryencoder.moc"
+
+void testAtomEntryEncoder::testCreatePost()
+{
+    BlogPost post;
+    post.setTitle(QStringLiteral("Fish & <Chips>"));
+    post.setContent(QString::fromUtf8("<p>caf\xc3\xa9 &amp; more<br></p>"));
+    post.setTags(QStringList() << QStringLiteral("it's") << QStringLiteral("\"quoted\""));
+    post.setPrivate(true);
+
+    const QByteArray data = AtomEntryEncoder::encodePost(post, QString(),
+                                                         QString(), QStringLiteral("me@example.com"));
+    QVERIFY(!data.contains("<id>"));
+    QVERIFY(data.contains("<app:draft>yes</app:draft>"));
+    QVERIFY(!data.contains("<name>"));
+
+    QXmlStreamReader reader(data);
+    QStringList terms;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (!reader.isStartElement()) {
+            continue;
+        }
+        if (reader.name() == QLatin1String("title")) {
+            QCOMPARE(reader.readElementText(), post.title());
+        } else if (reader.name() == QLatin1String("content")) {
+            QCOMPARE(reader.attributes().value(QLatin1String("type")).toString(), QStringLiteral("html"));
+            QCOMPARE(reader.readElementText(), post.content());
+        } else if (reader.name() == QLatin1String("category")) {
+            terms << reader.attributes().value(QLatin1String("term")).toString();
+        } else if (reader.name() == QLatin1String("email")) {
+            QCOMPARE(reader.readElementText(), QStringLiteral("me@example.com"));
+        }
+    }
+    QVERIFY2(!reader.hasError(), qPrintable(reader.errorString()));
+    QCOMPARE(terms, post.tags());
+}
+
+void testAtomEntryEncoder::testModifyPost()
+{
+    BlogPost post(QStringLiteral("42"));
+    post.setTitle(QStringLiteral("Title"));
+    post.setCreationDateTime(QDateTime(QDate(2026, 3, 1), QTime(10, 20, 30), Qt::UTC));
+    post.setModificationDateTime(QDateTime(QDate(2026, 3, 2), QTime(8, 0, 0), Qt::UTC));
+
+    const QByteArray data = AtomEntryEncoder::encodePost(post, QStringLiteral("7"),
+                                                         QStringLiteral("Me"), QStringLiteral("me@example.com"));
+    QVERIFY(data.contains("<id>tag:blogger.com,1999:blog-7.post-42</id>"));
+    QVERIFY(data.contains("<published>2026-03-01T10:20:30Z</published>"));
+    QVERIFY(data.contains("<updated>2026-03-02T08:00:00Z</updated>"));
+    QVERIFY(data.contains("<name>Me</name>"));
+    QVERIFY(!data.contains("app:draft"));
+}
+
+void testAtomEntryEncoder::testComment()
+{
+    BlogComment comment;
+    comment.setTitle(QStringLiteral("Re: <b>"));
+    comment.setContent(QStringLiteral("1 < 2"));
+    comment.setName(QString::fromUtf8("J\xc3\xbcrgen"));
+    comment.setEmail(QStringLiteral("j@example.com"));
+
+    const QByteArray data = AtomEntryEncoder::encodeComment(comment);
+    QCOMPARE(data, QByteArray("<entry xmlns='http://www.w3.org/2005/Atom'>"
+                              "<title type=\"text\">Re: &lt;b&gt;</title>"
+                              "<content type=\"html\">1 &lt; 2</content>"
+                              "<author><name>J\xc3\xbcrgen</name><email>j@example.com</email></author>"
+                              "</entry>"));
+}
+
+QTEST_GUILESS_MAIN(testAtomEntryEncoder)
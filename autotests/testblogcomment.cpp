@@ -24,6 +24,7 @@ class testBlogComment: public QObject
 private Q_SLOTS:
     void testValidity();
     void testValidity_data();
+    void testSharing();
 };
 
 #include "testblogcomment.moc"
@@ -93,4 +94,17 @@ void testBlogComment::testValidity()
 
 }
 
+void testBlogComment::testSharing()
+{
+    BlogComment original(QStringLiteral("1"));
+    original.setContent(QStringLiteral("Content"));
+    BlogComment copy(original);
+    copy.setContent(QStringLiteral("Changed"));
+    QCOMPARE(original.content(), QStringLiteral("Content"));
+
+    BlogComment moved(std::move(copy));
+    QCOMPARE(moved.content(), QStringLiteral("Changed"));
+    QCOMPARE(moved.status(), BlogComment::New);
+}
+
 QTEST_GUILESS_MAIN(testBlogComment)
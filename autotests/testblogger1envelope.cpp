@@ -0,0 +1,94 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include "blogger1envelope_p.h"
+
+using namespace KBlog;
+
+class testBlogger1Envelope: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testRoundTrip_data();
+    void testRoundTrip();
+    void testDecode_data();
+    void testDecode();
+};
+
+#include "testblogger1envelope.moc"
+
+void testBlogger1Envelope::testRoundTrip_data()
+{
+    QTest::addColumn<QString>("title");
+    QTest::addColumn<QStringList>("categories");
+    QTest::addColumn<QString>("content");
+
+    QTest::newRow("empty") << QString() << QStringList() << QString();
+    QTest::newRow("title") << QStringLiteral("Title") << QStringList() << QStringLiteral("<p>Content</p>");
+    QTest::newRow("categories") << QStringLiteral("Title")
+                                << (QStringList() << QStringLiteral("one") << QStringLiteral("two")
+                                    << QStringLiteral("three"))
+                                << QStringLiteral("Content");
+    QTest::newRow("tags in content") << QString::fromUtf8("T\xc3\xaftle")
+                                     << QStringList(QStringLiteral("kde"))
+                                     << QStringLiteral("<p><title>kept</title><category>kept</category></p>");
+}
+
+void testBlogger1Envelope::testRoundTrip()
+{
+    QFETCH(QString, title);
+    QFETCH(QStringList, categories);
+    QFETCH(QString, content);
+
+    const QString envelope = Blogger1Envelope::encode(title, categories, content);
+    QString decodedTitle = QStringLiteral("unset");
+    QStringList decodedCategories;
+    QCOMPARE(Blogger1Envelope::decode(envelope, &decodedTitle, &decodedCategories), content);
+    QCOMPARE(decodedTitle, title);
+    QCOMPARE(decodedCategories, categories);
+}
+
+void testBlogger1Envelope::testDecode_data()
+{
+    QTest::addColumn<QString>("envelope");
+    QTest::addColumn<QString>("title");
+    QTest::addColumn<QStringList>("categories");
+    QTest::addColumn<QString>("content");
+
+    QTest::newRow("plain") << QStringLiteral("  just content") << QStringLiteral("unset")
+                           << QStringList() << QStringLiteral("  just content");
+    QTest::newRow("whitespace") << QStringLiteral("<title>T</title>\n<category>a</category> \n<p>x</p>")
+                                << QStringLiteral("T") << QStringList(QStringLiteral("a"))
+                                << QStringLiteral(" \n<p>x</p>");
+    QTest::newRow("category first") << QStringLiteral("<category>a</category><title>T</title>x")
+                                    << QStringLiteral("T") << QStringList(QStringLiteral("a"))
+                                    << QStringLiteral("x");
+    QTest::newRow("unclosed") << QStringLiteral("<title>T</title><category>a<b>x")
+                              << QStringLiteral("T") << QStringList()
+                              << QStringLiteral("<category>a<b>x");
+    QTest::newRow("not at start") << QStringLiteral("x<title>T</title>") << QStringLiteral("unset")
+                                  << QStringList() << QStringLiteral("x<title>T</title>");
+}
+
+void testBlogger1Envelope::testDecode()
+{
+    QFETCH(QString, envelope);
+    QFETCH(QString, title);
+    QFETCH(QStringList, categories);
+    QFETCH(QString, content);
+
+    QString decodedTitle = QStringLiteral("unset");
+    QStringList decodedCategories;
+    QCOMPARE(Blogger1Envelope::decode(envelope, &decodedTitle, &decodedCategories), content);
+    QCOMPARE(decodedTitle, title);
+    QCOMPARE(decodedCategories, categories);
+}
+
+QTEST_GUILESS_MAIN(testBlogger1Envelope)
@@ -0,0 +1,66 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QRegExp>
+#include <QTest>
+
+#include "bloggerid_p.h"
+
+using namespace KBlog;
+
+class testBloggerId: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testIds_data();
+    void testIds();
+    void testReference();
+};
+
+#include "testbloggerid.moc"
+
+void testBloggerId::testIds_data()
+{
+    QTest::addColumn<QString>("id");
+    QTest::newRow("post") << QStringLiteral("tag:blogger.com,1999:blog-1234.post-5678");
+    QTest::newRow("blog") << QStringLiteral("tag:blogger.com,1999:user-1.blog-42");
+    QTest::newRow("comment") << QStringLiteral("tag:blogger.com,1999:blog-7.post-8.comment-9");
+    QTest::newRow("empty") << QString();
+    QTest::newRow("no digits") << QStringLiteral("tag:blogger.com,1999:blog-.post-");
+    QTest::newRow("later match") << QStringLiteral("blog-x post-y blog-3 post-4");
+    QTest::newRow("overlapping") << QStringLiteral("post-post-11");
+    QTest::newRow("at the end") << QStringLiteral("post-");
+    QTest::newRow("response") << QStringLiteral("<entry><id>tag:blogger.com,1999:blog-1.post-2</id>"
+                                                "<link href='http://x.blogspot.com/2026/01/post-3.html'/></entry>");
+}
+
+void testBloggerId::testIds()
+{
+    // the handlers used these expressions before
+    QFETCH(QString, id);
+    QRegExp blogRx(QStringLiteral("blog-(\\d+)"));
+    QRegExp postRx(QStringLiteral("post-(\\d+)"));
+    const QStringRef blogId = BloggerId::blogId(id);
+    const QStringRef postId = BloggerId::postId(id);
+
+    QCOMPARE(blogId.isNull(), blogRx.indexIn(id) == -1);
+    QCOMPARE(blogId.toString(), blogRx.cap(1));
+    QCOMPARE(postId.isNull(), postRx.indexIn(id) == -1);
+    QCOMPARE(postId.toString(), postRx.cap(1));
+}
+
+void testBloggerId::testReference()
+{
+    const QString id = QStringLiteral("tag:blogger.com,1999:blog-1234.post-5678");
+    const QStringRef postId = BloggerId::postId(id);
+    QCOMPARE(postId.string(), &id);
+    QCOMPARE(postId.position(), id.size() - 4);
+    QVERIFY(postId == QLatin1String("5678"));
+}
+
+QTEST_GUILESS_MAIN(testBloggerId)
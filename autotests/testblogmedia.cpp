@@ -23,6 +23,7 @@ class testBlogMedia: public QObject
 private Q_SLOTS:
     void testValidity();
     void testValidity_data();
+    void testSharing();
 };
 
 #include "testblogmedia.moc"
@@ -72,4 +73,17 @@ void testBlogMedia::testValidity()
 
 }
 
+void testBlogMedia::testSharing()
+{
+    BlogMedia original;
+    original.setName(QStringLiteral("image.png"));
+    BlogMedia copy(original);
+    copy.setName(QStringLiteral("other.png"));
+    QCOMPARE(original.name(), QStringLiteral("image.png"));
+
+    BlogMedia moved(std::move(copy));
+    QCOMPARE(moved.name(), QStringLiteral("other.png"));
+    QCOMPARE(moved.status(), BlogMedia::New);
+}
+
 QTEST_GUILESS_MAIN(testBlogMedia)
@@ -20,6 +20,9 @@ class testBlogPost: public QObject
 private Q_SLOTS:
     void testValidity();
     void testValidity_data();
+    void testSharing();
+    void testJournal_data();
+    void testJournal();
 };
 
 #include "testblogpost.moc"
@@ -131,4 +134,68 @@ void testBlogPost::testValidity()
     QCOMPARE(p.error(), error);
 }
 
+void testBlogPost::testSharing()
+{
+    BlogPost original(QStringLiteral("1"));
+    original.setTitle(QStringLiteral("Title"));
+    original.setLink(QUrl(QStringLiteral("http://my.link/")));
+
+    BlogPost copy(original);
+    copy.setTitle(QStringLiteral("Changed"));
+    QCOMPARE(original.title(), QStringLiteral("Title"));
+    QCOMPARE(copy.title(), QStringLiteral("Changed"));
+    QCOMPARE(copy.link(), original.link());
+
+    BlogPost assigned;
+    assigned = original;
+    original.setPostId(QStringLiteral("2"));
+    QCOMPARE(assigned.postId(), QStringLiteral("1"));
+
+    BlogPost moved(std::move(assigned));
+    QCOMPARE(moved.postId(), QStringLiteral("1"));
+    assigned = std::move(moved);
+    QCOMPARE(assigned.title(), QStringLiteral("Title"));
+    QCOMPARE(assigned.status(), BlogPost::New);
+}
+
+void testBlogPost::testJournal_data()
+{
+    QTest::addColumn<QString>("description");
+    QTest::addColumn<bool>("isRich");
+    QTest::addColumn<QString>("content");
+
+    QTest::newRow("plain") << QStringLiteral("  <p style=\"x\">text</p>") << false
+                           << QStringLiteral("  <p style=\"x\">text</p>");
+    QTest::newRow("no body") << QStringLiteral("<p style=\"margin:0\">text</p>") << true
+                             << QStringLiteral("<p>text</p>");
+    QTest::newRow("body") << QStringLiteral("<html><head><meta name=\"qrichtext\"/></head>"
+                                            "<body style=\"font-size:9pt;\">\n  <p style=\"margin:0\">"
+                                            "one</p><p>two</p><p style=\"\">three</p></body></html>") << true
+                          << QStringLiteral("<p>one</p><p>two</p><p>three</p>");
+    QTest::newRow("body at start") << QStringLiteral("<body> text </body>") << true
+                                   << QStringLiteral("text ");
+    QTest::newRow("nested body end") << QStringLiteral("<body>a</body>b</body>") << true
+                                     << QStringLiteral("a</body>b");
+    QTest::newRow("empty paragraph") << QStringLiteral("<html><body>\n<p style=\"margin:0\"></p></body></html>")
+                                     << true << QString();
+    QTest::newRow("unterminated style") << QStringLiteral("<p style=\"a\" class=\"b\">x</p><p style=\"")
+                                        << true << QStringLiteral("<p style=\"a\" class=\"b\">x</p><p style=\"");
+    QTest::newRow("style outside body") << QStringLiteral("<body>x</body><p style=\"a\">") << true
+                                        << QStringLiteral("x");
+}
+
+void testBlogPost::testJournal()
+{
+    QFETCH(QString, description);
+    QFETCH(bool, isRich);
+    QFETCH(QString, content);
+
+    KCalendarCore::Journal::Ptr journal(new KCalendarCore::Journal);
+    journal->setSummary(QStringLiteral("Title"));
+    journal->setDescription(description, isRich);
+    const BlogPost post(journal);
+    QCOMPARE(post.title(), QStringLiteral("Title"));
+    QCOMPARE(post.content(), content);
+}
+
 QTEST_GUILESS_MAIN(testBlogPost)
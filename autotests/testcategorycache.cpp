@@ -0,0 +1,128 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QDataStream>
+#include <QFile>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "categorycache_p.h"
+#include "kblog/blogpost.h"
+#include "kblog/movabletype.h"
+
+using namespace KBlog;
+
+class testCategoryCache: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void testStore();
+    void testLegacyFile();
+    void testRefresh();
+    void testShared();
+
+private:
+    QList<QMap<QString, QString> > mCategories;
+};
+
+#include "testcategorycache.moc"
+
+void testCategoryCache::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    const QStringList names = QStringList() << QStringLiteral("News") << QStringLiteral("KDE");
+    for (int i = 0; i < names.count(); ++i) {
+        QMap<QString, QString> category;
+        category[QStringLiteral("name")] = names.at(i);
+        category[QStringLiteral("categoryId")] = QString::number(i + 1);
+        mCategories << category;
+    }
+}
+
+void testCategoryCache::testStore()
+{
+    QTemporaryDir dir;
+    const QString key = CategoryCache::key(QStringLiteral("example.com"), QStringLiteral("1"),
+                                           QStringLiteral("user"));
+    {
+        CategoryCache cache(dir.path());
+        const CategoryCache::Entry entry = cache.store(key, mCategories);
+        QVERIFY(cache.isFresh(entry));
+        QCOMPARE(cache.entry(key).mCategories, mCategories);
+        QCOMPARE(cache.diskReads(), 0);
+    }
+
+    CategoryCache cache(dir.path());
+    const CategoryCache::Entry entry = cache.entry(key);
+    QCOMPARE(cache.entry(key).mCategories, mCategories);
+    QCOMPARE(cache.diskReads(), 1);
+    QVERIFY(cache.isFresh(entry));
+    QCOMPARE(entry.mCategoryIds.value(QStringLiteral("KDE")), QStringLiteral("2"));
+    QCOMPARE(entry.mCategoryNames.value(QStringLiteral("1")), QStringLiteral("News"));
+
+    cache.setMaxAge(0);
+    QVERIFY(!cache.isFresh(entry));
+
+    // a blog without a file is read only once as well
+    QVERIFY(cache.entry(QStringLiteral("missing")).mCategories.isEmpty());
+    QVERIFY(cache.entry(QStringLiteral("missing")).mCategories.isEmpty());
+    QCOMPARE(cache.diskReads(), 1);
+}
+
+void testCategoryCache::testLegacyFile()
+{
+    QTemporaryDir dir;
+    QFile file(dir.path() + QLatin1String("/example.com_1_user"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QDataStream stream(&file);
+    stream << mCategories;
+    file.close();
+
+    CategoryCache cache(dir.path());
+    const CategoryCache::Entry entry = cache.entry(QStringLiteral("example.com_1_user"));
+    QCOMPARE(entry.mCategories, mCategories);
+    QVERIFY(!entry.mListedAt.isValid());
+    QVERIFY(!cache.isFresh(entry));
+}
+
+void testCategoryCache::testRefresh()
+{
+    QTemporaryDir dir;
+    CategoryCache cache(dir.path());
+    const QString key = QStringLiteral("example.com_1_user");
+    QVERIFY(cache.startRefresh(key));
+    QVERIFY(!cache.startRefresh(key));
+    cache.cancelRefresh(key);
+    QVERIFY(cache.startRefresh(key));
+    cache.store(key, mCategories);
+    QVERIFY(cache.startRefresh(key));
+}
+
+void testCategoryCache::testShared()
+{
+    const QString key = CategoryCache::key(QStringLiteral("shared.example.com"), QStringLiteral("1"),
+                                           QStringLiteral("user"));
+    // written by another process
+    CategoryCache(CategoryCache::self()->directory()).store(key, mCategories);
+
+    const int diskReads = CategoryCache::self()->diskReads();
+    BlogPost post;
+    post.setCategories(QStringList(QStringLiteral("KDE")));
+    for (int i = 0; i < 20; ++i) {
+        MovableType blog(QUrl(QStringLiteral("http://shared.example.com/xmlrpc")));
+        blog.setBlogId(QStringLiteral("1"));
+        blog.setUsername(QStringLiteral("user"));
+        const QList<QStringList> categoryIds = blog.resolveCategories(QList<BlogPost *>() << &post);
+        QCOMPARE(categoryIds.first(), QStringList(QStringLiteral("2")));
+    }
+    QCOMPARE(CategoryCache::self()->diskReads(), diskReads + 1);
+}
+
+QTEST_GUILESS_MAIN(testCategoryCache)
@@ -0,0 +1,170 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTest>
+
+#include "kblog/blogpost.h"
+#include "kblog/movabletype.h"
+#include "kblog/transport.h"
+
+#include "blogserver.h"
+
+Q_DECLARE_METATYPE(KBlog::BlogPost *)
+
+using namespace KBlog;
+
+class testCategoryPrefetch: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void testBurst();
+    void testNewPostCategories();
+    void testSharedReads();
+
+private:
+    BlogServer mServer;
+};
+
+#include "testcategoryprefetch.moc"
+
+void testCategoryPrefetch::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    qRegisterMetaType<BlogPost *>();
+    QVERIFY(mServer.listen(QHostAddress::LocalHost));
+    // no categories or methods cached by an earlier run
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) +
+                              QLatin1String("/kblog/");
+    QFile::remove(directory + QLatin1String("127.0.0.1_burst_user"));
+    QFile::remove(directory + QLatin1String("127.0.0.1_direct_user"));
+    QFile::remove(directory + QLatin1String("127.0.0.1_shared_user"));
+    QDir(directory + QLatin1String("capabilities")).removeRecursively();
+}
+
+void testCategoryPrefetch::testBurst()
+{
+    QUrl url(QStringLiteral("http://127.0.0.1/burst"));
+    url.setPort(mServer.serverPort());
+    Transport transport;
+    // one request at a time, so the server sees them in the order they were made
+    transport.setMaxRequestsPerHost(1);
+    MovableType blog(url);
+    blog.setTransport(&transport);
+    blog.setBlogId(QStringLiteral("burst"));
+    blog.setUsername(QStringLiteral("user"));
+    QSignalSpy created(&blog, &MovableType::createdPost);
+    QSignalSpy fetched(&blog, &MovableType::fetchedPost);
+
+    const int count = 20;
+    QList<BlogPost *> posts;
+    for (int i = 0; i < count; ++i) {
+        BlogPost *post = new BlogPost;
+        post->setTitle(QStringLiteral("Post %1").arg(i));
+        post->setCategories(QStringList(QStringLiteral("KDE")));
+        post->setPrivate(true);
+        posts << post;
+        blog.createPost(post);
+    }
+    BlogPost fetch(QStringLiteral("99"));
+    fetch.setCategories(QStringList(QStringLiteral("KDE")));
+    blog.fetchPost(&fetch);
+
+    QTRY_COMPARE_WITH_TIMEOUT(created.count(), count, 10000);
+    QTRY_COMPARE_WITH_TIMEOUT(fetched.count(), 1, 10000);
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("system.listMethods")), 1);
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("metaWeblog.getCategories")), 1);
+    QCOMPARE(mServer.mMethods.at(0), QStringLiteral("system.listMethods"));
+    QCOMPARE(mServer.mMethods.at(1), QStringLiteral("metaWeblog.getCategories"));
+    // released together, in the order they were requested
+    for (int i = 2; i < count + 2; ++i) {
+        QCOMPARE(mServer.mMethods.at(i), QStringLiteral("metaWeblog.newPost"));
+    }
+    QCOMPARE(mServer.mMethods.at(count + 2), QStringLiteral("metaWeblog.getPost"));
+    // the legacy servers need the categories set afterwards
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("mt.setPostCategories")), count);
+    for (int i = 0; i < count; ++i) {
+        QCOMPARE(created.at(i).at(0).value<BlogPost *>(), posts.at(i));
+    }
+    qDeleteAll(posts);
+}
+
+void testCategoryPrefetch::testNewPostCategories()
+{
+    mServer.mMethods.clear();
+    mServer.mWordpress = true;
+    // another URL, whose methods are not cached yet
+    QUrl url(QStringLiteral("http://127.0.0.1/direct"));
+    url.setPort(mServer.serverPort());
+    Transport transport;
+    transport.setMaxRequestsPerHost(1);
+    MovableType blog(url);
+    blog.setTransport(&transport);
+    blog.setBlogId(QStringLiteral("direct"));
+    blog.setUsername(QStringLiteral("user"));
+    QSignalSpy created(&blog, &MovableType::createdPost);
+
+    BlogPost first;
+    first.setCategories(QStringList(QStringLiteral("KDE")));
+    blog.createPost(&first);
+    QTRY_COMPARE_WITH_TIMEOUT(created.count(), 1, 10000);
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("mt.setPostCategories")), 0);
+
+    // known from now on, one request per post
+    mServer.mMethods.clear();
+    BlogPost second;
+    second.setCategories(QStringList(QStringLiteral("KDE")));
+    blog.createPost(&second);
+    QTRY_COMPARE_WITH_TIMEOUT(created.count(), 2, 10000);
+    QCOMPARE(mServer.mMethods, QStringList(QStringLiteral("metaWeblog.newPost")));
+}
+
+void testCategoryPrefetch::testSharedReads()
+{
+    mServer.mMethods.clear();
+    QUrl url(QStringLiteral("http://127.0.0.1/shared"));
+    url.setPort(mServer.serverPort());
+    Transport transport;
+    transport.setMaxRequestsPerHost(1);
+    MovableType blog(url);
+    blog.setTransport(&transport);
+    blog.setBlogId(QStringLiteral("shared"));
+    blog.setUsername(QStringLiteral("user"));
+    QSignalSpy fetched(&blog, &MovableType::fetchedPost);
+    QSignalSpy listed(&blog, &MovableType::listedCategories);
+
+    // the same post in two objects, e.g. an editor and a sync
+    BlogPost first(QStringLiteral("99"));
+    BlogPost second(QStringLiteral("99"));
+    blog.fetchPost(&first);
+    blog.fetchPost(&second);
+    blog.listCategories();
+    blog.listCategories();
+
+    QTRY_COMPARE_WITH_TIMEOUT(fetched.count(), 2, 10000);
+    QTRY_COMPARE_WITH_TIMEOUT(listed.count(), 2, 10000);
+    QCOMPARE(fetched.at(0).at(0).value<BlogPost *>(), &first);
+    QCOMPARE(fetched.at(1).at(0).value<BlogPost *>(), &second);
+    QCOMPARE(first.title(), QStringLiteral("Fetched"));
+    QCOMPARE(second.title(), QStringLiteral("Fetched"));
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("metaWeblog.getPost")), 1);
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("metaWeblog.getCategories")), 1);
+    QCOMPARE(blog.sharedRequests(), quint64(2));
+
+    // answered requests are not shared
+    blog.fetchPost(&first);
+    QTRY_COMPARE_WITH_TIMEOUT(fetched.count(), 3, 10000);
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("metaWeblog.getPost")), 2);
+    QCOMPARE(blog.sharedRequests(), quint64(2));
+}
+
+QTEST_GUILESS_MAIN(testCategoryPrefetch)
@@ -0,0 +1,176 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QCryptographicHash>
+#include <QEventLoop>
+#include <QFile>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+#include <QTimer>
+
+#include "kblog/feedcache.h"
+#include "kblog/transport.h"
+#include "feedloader.h"
+#include "feedretriever.h"
+
+using namespace KBlog;
+
+// serves one Atom feed and answers "not modified" if its ETag is sent
+class FeedServer : public QTcpServer
+{
+public:
+    QByteArray mETag = "\"v1\"";
+    QByteArray mTitle = "Test feed";
+    // the If-None-Match header of every request, empty if there was none
+    QList<QByteArray> mConditions;
+
+protected:
+    void incomingConnection(qintptr handle) override
+    {
+        QTcpSocket *socket = new QTcpSocket(this);
+        socket->setSocketDescriptor(handle);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            QByteArray request = socket->property("buffer").toByteArray() + socket->readAll();
+            int end;
+            while ((end = request.indexOf("\r\n\r\n")) >= 0) {
+                QByteArray condition;
+                const QList<QByteArray> lines = request.left(end).split('\n');
+                for (const QByteArray &line : lines) {
+                    if (line.toLower().startsWith("if-none-match:")) {
+                        condition = line.mid(14).trimmed();
+                    }
+                }
+                request.remove(0, end + 4);
+                mConditions << condition;
+                if (!condition.isEmpty() && condition == mETag) {
+                    socket->write("HTTP/1.1 304 Not Modified\r\nETag: " + mETag + "\r\n\r\n");
+                    continue;
+                }
+                const QByteArray feed = "<?xml version=\"1.0\" encoding=\"utf-8\"?>"
+                                        "<feed xmlns=\"http://www.w3.org/2005/Atom\">"
+                                        "<id>urn:kblog:test</id><title>" + mTitle + "</title>"
+                                        "<updated>2026-03-01T10:00:00Z</updated>"
+                                        "<entry><id>urn:kblog:test:1</id><title>Post 1</title>"
+                                        "<updated>2026-03-01T10:00:00Z</updated></entry>"
+                                        "</feed>";
+                socket->write("HTTP/1.1 200 OK\r\nContent-Type: application/atom+xml\r\nETag: " +
+                              mETag + "\r\nContent-Length: " + QByteArray::number(feed.size()) +
+                              "\r\n\r\n" + feed);
+            }
+            socket->setProperty("buffer", request);
+        });
+    }
+};
+
+class testFeedCache: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void testNotModified();
+    void testUpdatedMinNotCached();
+
+private:
+    QUrl url(const QString &pathAndQuery) const;
+    Syndication::FeedPtr load(const QUrl &url);
+    FeedServer mServer;
+    Transport mTransport;
+};
+
+#include "testfeedcache.moc"
+
+void testFeedCache::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(mServer.listen(QHostAddress::LocalHost));
+}
+
+void testFeedCache::init()
+{
+    FeedCache::self()->clear();
+    FeedCache::self()->resetStatistics();
+    mServer.mConditions.clear();
+    mServer.mETag = "\"v1\"";
+    mServer.mTitle = "Test feed";
+}
+
+QUrl testFeedCache::url(const QString &pathAndQuery) const
+{
+    QUrl url(QStringLiteral("http://127.0.0.1") + pathAndQuery);
+    url.setPort(mServer.serverPort());
+    return url;
+}
+
+Syndication::FeedPtr testFeedCache::load(const QUrl &url)
+{
+    Syndication::FeedPtr result;
+    QEventLoop loop;
+    FeedLoader *loader = new FeedLoader;
+    connect(loader, &FeedLoader::loadingComplete, &loop,
+            [&](FeedLoader *, const Syndication::FeedPtr &feed, Syndication::ErrorCode) {
+        result = feed;
+        loop.quit();
+    });
+    QTimer::singleShot(10000, &loop, &QEventLoop::quit);
+    loader->loadFrom(url, new FeedRetriever(&mTransport));
+    loop.exec();
+    return result;
+}
+
+void testFeedCache::testNotModified()
+{
+    const QUrl feedUrl = url(QStringLiteral("/feeds/1/posts/default"));
+    Syndication::FeedPtr feed = load(feedUrl);
+    QVERIFY(feed);
+    QCOMPARE(feed->title(), QStringLiteral("Test feed"));
+    QCOMPARE(FeedCache::self()->count(), 1);
+    QCOMPARE(FeedCache::self()->misses(), quint64(1));
+
+    // the parsed feed is still in memory, so the copy on disk is not read
+    QVERIFY(QFile::remove(FeedCache::self()->directory() + QLatin1Char('/') +
+                          QString::fromLatin1(QCryptographicHash::hash(feedUrl.toEncoded(),
+                                                                       QCryptographicHash::Sha1).toHex())));
+
+    // the second request is conditional and the server has nothing new
+    mServer.mTitle = "Changed on the server";
+    feed = load(feedUrl);
+    QVERIFY(feed);
+    QCOMPARE(mServer.mConditions, QList<QByteArray>() << QByteArray() << "\"v1\"");
+    QCOMPARE(feed->title(), QStringLiteral("Test feed"));
+    QCOMPARE(feed->items().count(), 1);
+    QCOMPARE(FeedCache::self()->hits(), quint64(1));
+    QCOMPARE(FeedCache::self()->misses(), quint64(1));
+
+    // a new ETag means a new feed, which replaces the cached one
+    mServer.mETag = "\"v2\"";
+    feed = load(feedUrl);
+    QVERIFY(feed);
+    QCOMPARE(feed->title(), QStringLiteral("Changed on the server"));
+    QCOMPARE(FeedCache::self()->misses(), quint64(2));
+    QCOMPARE(FeedCache::self()->count(), 1);
+    feed = load(feedUrl);
+    QCOMPARE(mServer.mConditions.last(), QByteArray("\"v2\""));
+    QCOMPARE(FeedCache::self()->hits(), quint64(2));
+}
+
+void testFeedCache::testUpdatedMinNotCached()
+{
+    const QUrl syncUrl = url(QStringLiteral("/feeds/1/posts/default?orderby=updated"
+                                            "&updated-min=2026-03-01T10:00:00Z"));
+    QVERIFY(load(syncUrl));
+    QVERIFY(load(syncUrl));
+    // neither stored nor asked for conditionally
+    QCOMPARE(mServer.mConditions, QList<QByteArray>() << QByteArray() << QByteArray());
+    QCOMPARE(FeedCache::self()->count(), 0);
+    QCOMPARE(FeedCache::self()->size(), qint64(0));
+}
+
+QTEST_GUILESS_MAIN(testFeedCache)
@@ -0,0 +1,221 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QNetworkProxy>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+
+#include "kblog/blogpost.h"
+#include "kblog/gdata.h"
+#include "kblog/transport.h"
+
+using namespace KBlog;
+
+// acts as the HTTP proxy between GData and Blogger; it accepts one token and
+// refuses the tunnel to the login, so no login can succeed
+class BloggerProxy : public QTcpServer
+{
+public:
+    QByteArray mToken;
+    // the request lines, in the order they came in
+    QList<QByteArray> mRequests;
+    // the Authorization header of every post request
+    QList<QByteArray> mAuthorizations;
+
+protected:
+    void incomingConnection(qintptr handle) override
+    {
+        QTcpSocket *socket = new QTcpSocket(this);
+        socket->setSocketDescriptor(handle);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            QByteArray request = socket->property("buffer").toByteArray() + socket->readAll();
+            int end;
+            while ((end = request.indexOf("\r\n\r\n")) >= 0) {
+                const QList<QByteArray> lines = request.left(end).split('\n');
+                QByteArray authorization;
+                int length = 0;
+                for (const QByteArray &line : lines) {
+                    if (line.toLower().startsWith("authorization:")) {
+                        authorization = line.mid(14).trimmed();
+                    } else if (line.toLower().startsWith("content-length:")) {
+                        length = line.mid(15).trimmed().toInt();
+                    }
+                }
+                if (request.size() < end + 4 + length) {
+                    break;
+                }
+                request.remove(0, end + 4 + length);
+                const QByteArray requestLine = lines.first().trimmed();
+                mRequests << requestLine;
+
+                if (requestLine.startsWith("CONNECT")) {
+                    socket->write("HTTP/1.1 403 Forbidden\r\nContent-Length: 0\r\n\r\n");
+                    socket->disconnectFromHost();
+                    return;
+                }
+                mAuthorizations << authorization;
+                if (authorization != "GoogleLogin auth=" + mToken) {
+                    socket->write("HTTP/1.1 401 Unauthorized\r\nContent-Length: 0\r\n\r\n");
+                    continue;
+                }
+                const QByteArray entry = "<entry xmlns=\"http://www.w3.org/2005/Atom\">"
+                                         "<id>tag:blogger.com,1999:blog-42.post-7</id>"
+                                         "<published>2026-03-01T10:00:00Z</published>"
+                                         "<updated>2026-03-01T10:00:00Z</updated></entry>";
+                socket->write("HTTP/1.1 201 Created\r\nContent-Type: application/atom+xml\r\n"
+                              "Content-Length: " + QByteArray::number(entry.size()) +
+                              "\r\n\r\n" + entry);
+            }
+            socket->setProperty("buffer", request);
+        });
+    }
+};
+
+class testGDataToken: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void testStoredToken();
+    void testExpiredToken();
+    void testRejectedToken();
+
+private:
+    QString tokenFileName() const;
+    void storeToken(const QByteArray &token, const QDateTime &time);
+    void createPost(int *created, int *failed, Blog::ErrorType *errorType);
+    BloggerProxy mProxy;
+};
+
+#include "testgdatatoken.moc"
+
+static const char user[] = "user@example.com";
+
+void testGDataToken::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(mProxy.listen(QHostAddress::LocalHost));
+    QNetworkProxy::setApplicationProxy(QNetworkProxy(QNetworkProxy::HttpProxy,
+                                                     QStringLiteral("127.0.0.1"), mProxy.serverPort()));
+}
+
+void testGDataToken::cleanupTestCase()
+{
+    QNetworkProxy::setApplicationProxy(QNetworkProxy(QNetworkProxy::NoProxy));
+}
+
+void testGDataToken::init()
+{
+    mProxy.mRequests.clear();
+    mProxy.mAuthorizations.clear();
+    QFile::remove(tokenFileName());
+}
+
+QString testGDataToken::tokenFileName() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) +
+           QLatin1String("/kblog/gdata/") +
+           QString::fromLatin1(QCryptographicHash::hash(user, QCryptographicHash::Sha1).toHex());
+}
+
+// writes the token the way GData persists it
+void testGDataToken::storeToken(const QByteArray &token, const QDateTime &time)
+{
+    QVERIFY(QDir().mkpath(QFileInfo(tokenFileName()).absolutePath()));
+    QFile file(tokenFileName());
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << QString::fromLatin1(token) << time;
+}
+
+void testGDataToken::createPost(int *created, int *failed, Blog::ErrorType *errorType)
+{
+    Transport transport;
+    GData blog(QUrl(QStringLiteral("http://www.blogger.com")));
+    blog.setTransport(&transport);
+    blog.setBlogId(QStringLiteral("42"));
+    blog.setUsername(QString::fromLatin1(user));
+    blog.setPassword(QStringLiteral("secret"));
+    connect(&blog, &Blog::createdPost, this, [created](BlogPost *) {
+        ++*created;
+    });
+    connect(&blog, &Blog::errorPost, this,
+            [failed, errorType](Blog::ErrorType type, const QString &, BlogPost *) {
+        *errorType = type;
+        ++*failed;
+    });
+
+    BlogPost post;
+    post.setTitle(QStringLiteral("Title"));
+    post.setContent(QStringLiteral("Content"));
+    blog.createPost(&post);
+    QTRY_COMPARE_WITH_TIMEOUT(*created + *failed, 1, 10000);
+    // nothing else is retried
+    QTest::qWait(100);
+    QCOMPARE(*created + *failed, 1);
+}
+
+void testGDataToken::testStoredToken()
+{
+    // days old, but still within the lifetime of the token
+    mProxy.mToken = "stored";
+    storeToken(mProxy.mToken, QDateTime::currentDateTime().addDays(-3));
+
+    int created = 0, failed = 0;
+    Blog::ErrorType errorType = Blog::Other;
+    createPost(&created, &failed, &errorType);
+    QCOMPARE(created, 1);
+    QCOMPARE(mProxy.mRequests, QList<QByteArray>()
+             << "POST http://www.blogger.com/feeds/42/posts/default HTTP/1.1");
+    QCOMPARE(mProxy.mAuthorizations, QList<QByteArray>() << "GoogleLogin auth=stored");
+}
+
+void testGDataToken::testExpiredToken()
+{
+    mProxy.mToken = "stored";
+    storeToken(mProxy.mToken, QDateTime::currentDateTime().addDays(-15));
+
+    int created = 0, failed = 0;
+    Blog::ErrorType errorType = Blog::Other;
+    createPost(&created, &failed, &errorType);
+    // straight to the login, which fails
+    QCOMPARE(failed, 1);
+    QCOMPARE(errorType, Blog::AuthenticationError);
+    QCOMPARE(mProxy.mRequests.count(), 1);
+    QVERIFY(mProxy.mRequests.first().startsWith("CONNECT www.google.com:443"));
+}
+
+void testGDataToken::testRejectedToken()
+{
+    mProxy.mToken = "fresh";
+    storeToken("revoked", QDateTime::currentDateTime().addDays(-1));
+
+    int created = 0, failed = 0;
+    Blog::ErrorType errorType = Blog::Other;
+    createPost(&created, &failed, &errorType);
+    // the post is queued again behind a new login instead of failing
+    // with the answer to the rejected token
+    QCOMPARE(failed, 1);
+    QCOMPARE(errorType, Blog::AuthenticationError);
+    QCOMPARE(mProxy.mAuthorizations, QList<QByteArray>() << "GoogleLogin auth=revoked");
+    QCOMPARE(mProxy.mRequests.count(), 2);
+    QVERIFY(mProxy.mRequests.last().startsWith("CONNECT www.google.com:443"));
+    QVERIFY(!QFile::exists(tokenFileName()));
+}
+
+QTEST_GUILESS_MAIN(testGDataToken)
@@ -0,0 +1,120 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include <kcalendarcore/memorycalendar.h>
+
+#include "kblog/blogger1.h"
+#include "kblog/blogpost.h"
+#include "kblog/journalmirror.h"
+
+using namespace KBlog;
+
+class testJournalMirror: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void testUid();
+    void testExport();
+    void testImport();
+
+private:
+    BlogPost makePost(const QString &postId);
+    Blogger1 *mBlog;
+};
+
+#include "testjournalmirror.moc"
+
+void testJournalMirror::initTestCase()
+{
+    mBlog = new Blogger1(QUrl(QStringLiteral("http://example.com/xmlrpc")), this);
+    mBlog->setBlogId(QStringLiteral("1"));
+    mBlog->setUsername(QStringLiteral("user"));
+}
+
+BlogPost testJournalMirror::makePost(const QString &postId)
+{
+    BlogPost post(postId);
+    post.setTitle(QStringLiteral("Title ") + postId);
+    post.setContent(QStringLiteral("<p>Content of ") + postId + QStringLiteral("</p>"));
+    post.setCategories(QStringList() << QStringLiteral("a") << QStringLiteral("b"));
+    post.setCreationDateTime(QDateTime(QDate(2026, 1, 1), QTime(12, 0), Qt::UTC));
+    return post;
+}
+
+void testJournalMirror::testUid()
+{
+    const JournalMirror mirror(*mBlog);
+    const BlogPost post = makePost(QStringLiteral("42"));
+    QCOMPARE(mirror.journalUid(post.postId()), post.journal(*mBlog)->uid());
+}
+
+void testJournalMirror::testExport()
+{
+    JournalMirror mirror(*mBlog);
+    KCalendarCore::Calendar::Ptr calendar(new KCalendarCore::MemoryCalendar(QTimeZone::utc()));
+
+    QList<BlogPost> posts;
+    posts << makePost(QStringLiteral("1")) << makePost(QStringLiteral("2")) << BlogPost();
+    QCOMPARE(mirror.exportPosts(posts, calendar), 2);
+    QCOMPARE(calendar->journals().count(), 2);
+
+    const KCalendarCore::Journal::Ptr journal = calendar->journal(mirror.journalUid(QStringLiteral("1")));
+    QVERIFY(journal);
+    const KCalendarCore::Journal::Ptr expected = posts.first().journal(*mBlog);
+    QCOMPARE(journal->summary(), expected->summary());
+    QCOMPARE(journal->description(), expected->description());
+    QCOMPARE(journal->categories(), expected->categories());
+    QCOMPARE(journal->dtStart(), expected->dtStart());
+    QCOMPARE(journal->customProperty("KBLOG", "ID"), QStringLiteral("1"));
+
+    // the unchanged posts are skipped, the changed one is updated in place
+    QCOMPARE(mirror.exportPosts(posts, calendar), 0);
+    posts[1].setTitle(QStringLiteral("Changed"));
+    QCOMPARE(mirror.exportPosts(posts, calendar), 1);
+    QCOMPARE(calendar->journals().count(), 2);
+    QCOMPARE(calendar->journal(mirror.journalUid(QStringLiteral("2")))->summary(),
+             QStringLiteral("Changed"));
+}
+
+void testJournalMirror::testImport()
+{
+    JournalMirror mirror(*mBlog);
+    KCalendarCore::Calendar::Ptr calendar(new KCalendarCore::MemoryCalendar(QTimeZone::utc()));
+    mirror.exportPosts(QList<BlogPost>() << makePost(QStringLiteral("1"))
+                       << makePost(QStringLiteral("2")), calendar);
+    QVERIFY(mirror.importJournals(calendar->journals()).isEmpty());
+
+    // edited in the calendar
+    calendar->journal(mirror.journalUid(QStringLiteral("2")))->setSummary(QStringLiteral("Edited"));
+    // written in the calendar
+    KCalendarCore::Journal::Ptr created(new KCalendarCore::Journal);
+    created->setSummary(QStringLiteral("New"));
+    created->setDescription(QStringLiteral("<p>new</p>"), true);
+    calendar->addJournal(created);
+    // a journal of another blog
+    Blogger1 other(QUrl(QStringLiteral("http://example.org/xmlrpc")));
+    other.setBlogId(QStringLiteral("1"));
+    other.setUsername(QStringLiteral("user"));
+    calendar->addJournal(makePost(QStringLiteral("3")).journal(other));
+
+    QList<BlogPost> posts = mirror.importJournals(calendar->journals());
+    QCOMPARE(posts.count(), 2);
+    if (posts.first().postId().isEmpty()) {
+        posts.swapItemsAt(0, 1);
+    }
+    QCOMPARE(posts.at(0).postId(), QStringLiteral("2"));
+    QCOMPARE(posts.at(0).title(), QStringLiteral("Edited"));
+    QCOMPARE(posts.at(1).postId(), QString());
+    QCOMPARE(posts.at(1).title(), QStringLiteral("New"));
+    QCOMPARE(posts.at(1).content(), QStringLiteral("<p>new</p>"));
+}
+
+QTEST_GUILESS_MAIN(testJournalMirror)
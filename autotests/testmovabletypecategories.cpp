@@ -0,0 +1,89 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTest>
+
+#include "kblog/blogpost.h"
+#include "kblog/movabletype.h"
+
+Q_DECLARE_METATYPE(KBlog::BlogPost *)
+
+using namespace KBlog;
+
+class testMovableTypeCategories: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void testResolve();
+
+private:
+    static QMap<QString, QString> category(const QString &name, const QString &categoryId);
+};
+
+#include "testmovabletypecategories.moc"
+
+QMap<QString, QString> testMovableTypeCategories::category(const QString &name,
+        const QString &categoryId)
+{
+    QMap<QString, QString> category;
+    category[QStringLiteral("name")] = name;
+    category[QStringLiteral("categoryId")] = categoryId;
+    return category;
+}
+
+void testMovableTypeCategories::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    qRegisterMetaType<BlogPost *>();
+
+    // the categories cached by an earlier listCategories()
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) +
+                              QLatin1String("/kblog");
+    QVERIFY(QDir().mkpath(directory));
+    QFile file(directory + QLatin1String("/example.com_1_user"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QDataStream stream(&file);
+    stream << (QList<QMap<QString, QString> >()
+               << category(QStringLiteral("News"), QStringLiteral("3"))
+               << category(QStringLiteral("KDE"), QStringLiteral("7"))
+               << category(QStringLiteral("Misc"), QStringLiteral("12")));
+}
+
+void testMovableTypeCategories::testResolve()
+{
+    MovableType blog(QUrl(QStringLiteral("http://example.com/xmlrpc")));
+    blog.setBlogId(QStringLiteral("1"));
+    blog.setUsername(QStringLiteral("user"));
+    QSignalSpy spy(&blog, &MovableType::unresolvedCategories);
+
+    BlogPost known;
+    known.setCategories(QStringList() << QStringLiteral("KDE") << QStringLiteral("News"));
+    BlogPost mixed;
+    mixed.setCategories(QStringList() << QStringLiteral("Misc") << QStringLiteral("Unknown")
+                        << QStringLiteral("news"));
+    BlogPost none;
+
+    const QList<QStringList> categoryIds = blog.resolveCategories(QList<BlogPost *>() << &known << &mixed << &none);
+    QCOMPARE(categoryIds.count(), 3);
+    QCOMPARE(categoryIds.at(0), QStringList() << QStringLiteral("7") << QStringLiteral("3"));
+    QCOMPARE(categoryIds.at(1), QStringList(QStringLiteral("12")));
+    QCOMPARE(categoryIds.at(2), QStringList());
+
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).value<BlogPost *>(), &mixed);
+    QCOMPARE(spy.at(0).at(1).toStringList(), QStringList() << QStringLiteral("Unknown")
+             << QStringLiteral("news"));
+}
+
+QTEST_GUILESS_MAIN(testMovableTypeCategories)
@@ -0,0 +1,172 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QTest>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "kblog/blogger1.h"
+#include "kblog/blogpost.h"
+#include "kblog/poststore.h"
+
+using namespace KBlog;
+
+class testPostStore: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void testStore();
+    void testPersistence();
+    void testModifiedSince();
+    void testTornRecord();
+    void testShared();
+
+private:
+    BlogPost makePost(const QString &postId, const QDateTime &modified);
+    Blogger1 *mBlog;
+};
+
+#include "testpoststore.moc"
+
+void testPostStore::initTestCase()
+{
+    mBlog = new Blogger1(QUrl(QStringLiteral("http://example.com/xmlrpc")), this);
+    mBlog->setBlogId(QStringLiteral("1"));
+    mBlog->setUsername(QStringLiteral("user"));
+}
+
+BlogPost testPostStore::makePost(const QString &postId, const QDateTime &modified)
+{
+    BlogPost post(postId);
+    post.setTitle(QStringLiteral("Title ") + postId);
+    post.setContent(QStringLiteral("Content of ") + postId);
+    post.setCategories(QStringList() << QStringLiteral("a") << QStringLiteral("b"));
+    post.setModificationDateTime(modified);
+    post.setStatus(BlogPost::Fetched);
+    return post;
+}
+
+void testPostStore::testStore()
+{
+    QTemporaryDir dir;
+    PostStore store(dir.path());
+    const QDateTime modified(QDate(2020, 1, 1), QTime(12, 0), Qt::UTC);
+    store.store(*mBlog, makePost(QStringLiteral("1"), modified));
+    QVERIFY(store.contains(*mBlog, QStringLiteral("1")));
+    QVERIFY(!store.contains(*mBlog, QStringLiteral("2")));
+
+    QDateTime storedAt;
+    const BlogPost post = store.post(*mBlog, QStringLiteral("1"), &storedAt);
+    QCOMPARE(post.postId(), QStringLiteral("1"));
+    QCOMPARE(post.title(), QStringLiteral("Title 1"));
+    QCOMPARE(post.categories().count(), 2);
+    QCOMPARE(post.modificationDateTime(), modified);
+    QVERIFY(storedAt.isValid());
+
+    store.remove(*mBlog, QStringLiteral("1"));
+    QVERIFY(!store.contains(*mBlog, QStringLiteral("1")));
+    QVERIFY(store.post(*mBlog, QStringLiteral("1")).postId().isEmpty());
+}
+
+void testPostStore::testPersistence()
+{
+    QTemporaryDir dir;
+    const QDateTime modified(QDate(2020, 1, 1), QTime(12, 0), Qt::UTC);
+    {
+        PostStore store(dir.path());
+        store.store(*mBlog, makePost(QStringLiteral("1"), modified));
+        store.store(*mBlog, makePost(QStringLiteral("2"), modified));
+        BlogPost changed = makePost(QStringLiteral("1"), modified.addDays(1));
+        changed.setTitle(QStringLiteral("Changed"));
+        store.store(*mBlog, changed);
+        store.remove(*mBlog, QStringLiteral("2"));
+    }
+    PostStore store(dir.path());
+    QCOMPARE(store.count(), 1);
+    QCOMPARE(store.post(*mBlog, QStringLiteral("1")).title(), QStringLiteral("Changed"));
+    QVERIFY(!store.contains(*mBlog, QStringLiteral("2")));
+}
+
+void testPostStore::testModifiedSince()
+{
+    QTemporaryDir dir;
+    PostStore store(dir.path());
+    const QDateTime base(QDate(2020, 1, 1), QTime(12, 0), Qt::UTC);
+    store.store(*mBlog, makePost(QStringLiteral("old"), base));
+    store.store(*mBlog, makePost(QStringLiteral("new"), base.addDays(2)));
+    store.store(*mBlog, makePost(QStringLiteral("newer"), base.addDays(3)));
+
+    Blogger1 other(QUrl(QStringLiteral("http://example.org/xmlrpc")));
+    store.store(other, makePost(QStringLiteral("foreign"), base.addDays(5)));
+
+    QCOMPARE(store.modifiedSince(*mBlog, base.addDays(1)),
+             QList<QString>() << QStringLiteral("new") << QStringLiteral("newer"));
+    QCOMPARE(store.modifiedSince(*mBlog, QDateTime()).count(), 3);
+}
+
+void testPostStore::testTornRecord()
+{
+    QTemporaryDir dir;
+    const QDateTime modified(QDate(2020, 1, 1), QTime(12, 0), Qt::UTC);
+    {
+        PostStore store(dir.path());
+        store.store(*mBlog, makePost(QStringLiteral("1"), modified));
+        store.store(*mBlog, makePost(QStringLiteral("2"), modified));
+    }
+    // cut the last record in half, as a crash during the write would
+    QFile file(dir.path() + QLatin1String("/posts.log"));
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - 10));
+    file.close();
+
+    PostStore store(dir.path());
+    QCOMPARE(store.count(), 1);
+    QVERIFY(store.contains(*mBlog, QStringLiteral("1")));
+    store.store(*mBlog, makePost(QStringLiteral("3"), modified));
+    QCOMPARE(store.post(*mBlog, QStringLiteral("3")).postId(), QStringLiteral("3"));
+}
+
+void testPostStore::testShared()
+{
+    // two stores on the same log, as two processes would have
+    QTemporaryDir dir;
+    PostStore first(dir.path());
+    PostStore second(dir.path());
+    const QDateTime modified(QDate(2020, 1, 1), QTime(12, 0), Qt::UTC);
+    first.store(*mBlog, makePost(QStringLiteral("1"), modified));
+    QVERIFY(second.contains(*mBlog, QStringLiteral("1")));
+    second.store(*mBlog, makePost(QStringLiteral("2"), modified.addDays(1)));
+    second.remove(*mBlog, QStringLiteral("1"));
+    QVERIFY(!first.contains(*mBlog, QStringLiteral("1")));
+    QCOMPARE(first.modifiedSince(*mBlog, QDateTime()), QList<QString>() << QStringLiteral("2"));
+
+    // rewriting one post until the first store compacts the log
+    BlogPost large = makePost(QStringLiteral("3"), modified);
+    large.setContent(QString(64 * 1024, QLatin1Char('x')));
+    for (int i = 0; i < 20; ++i) {
+        first.store(*mBlog, large);
+    }
+    // the twenty copies of 128 KiB each would take 2.5 MiB
+    QVERIFY(QFileInfo(dir.path() + QLatin1String("/posts.log")).size() < 1024 * 1024);
+
+    // the second store reads the compacted log from the start
+    QCOMPARE(second.count(), 2);
+    QCOMPARE(second.post(*mBlog, QStringLiteral("2")).postId(), QStringLiteral("2"));
+    QCOMPARE(second.post(*mBlog, QStringLiteral("3")).content().size(), 64 * 1024);
+    second.store(*mBlog, makePost(QStringLiteral("4"), modified));
+    QCOMPARE(first.count(), 3);
+    QCOMPARE(first.post(*mBlog, QStringLiteral("4")).postId(), QStringLiteral("4"));
+
+    first.clear();
+    QCOMPARE(second.count(), 0);
+}
+
+QTEST_GUILESS_MAIN(testPostStore)
@@ -0,0 +1,216 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QDir>
+#include <QNetworkProxy>
+#include <QStandardPaths>
+#include <QTest>
+
+#include "kblog/blogpost.h"
+#include "kblog/gdata.h"
+#include "kblog/transport.h"
+#include "kblog/wordpressbuggy.h"
+
+#include "blogserver.h"
+
+using namespace KBlog;
+
+// collects the pages of a listing
+class PageReceiver : public QObject
+{
+    Q_OBJECT
+public:
+    explicit PageReceiver(Blog *blog)
+        : mBlog(blog)
+    {
+        connect(blog, SIGNAL(listedRecentPostsPage(QList<KBlog::BlogPost>,int,bool)),
+                this, SLOT(slotPage(QList<KBlog::BlogPost>,int,bool)));
+        connect(blog, SIGNAL(error(KBlog::Blog::ErrorType,QString)),
+                this, SLOT(slotError()));
+    }
+
+    Blog *mBlog;
+    // the offset and the post ids of every page
+    QList<QPair<int, QStringList> > mPages;
+    bool mLast = false;
+    int mErrors = 0;
+    // the number of pages after which the listing is stopped, 0 for never
+    int mStopAfter = 0;
+
+public Q_SLOTS:
+    void slotPage(const QList<KBlog::BlogPost> &posts, int offset, bool last)
+    {
+        QStringList ids;
+        for (const BlogPost &post : posts) {
+            ids << post.postId();
+        }
+        mPages << qMakePair(offset, ids);
+        mLast = last;
+        if (mPages.count() == mStopAfter) {
+            mBlog->stopListingRecentPosts();
+        }
+    }
+
+    void slotError()
+    {
+        ++mErrors;
+    }
+};
+
+class testRecentPostsPaged: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+    void testGDataPages();
+    void testWordpressPages();
+    void testWordpressFallback();
+    void testStop();
+
+private:
+    QUrl url(const QString &path) const;
+    BlogServer mServer;
+};
+
+#include "testrecentpostspaged.moc"
+
+typedef QPair<int, QStringList> Page;
+
+void testRecentPostsPaged::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(mServer.listen(QHostAddress::LocalHost));
+    // no methods cached by an earlier run
+    QDir(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) +
+         QLatin1String("/kblog/capabilities")).removeRecursively();
+    // the GData feeds go through the server as well
+    QNetworkProxy::setApplicationProxy(QNetworkProxy(QNetworkProxy::HttpProxy,
+                                                     QStringLiteral("127.0.0.1"), mServer.serverPort()));
+}
+
+void testRecentPostsPaged::cleanupTestCase()
+{
+    QNetworkProxy::setApplicationProxy(QNetworkProxy(QNetworkProxy::NoProxy));
+}
+
+void testRecentPostsPaged::init()
+{
+    mServer.mMethods.clear();
+    mServer.mFeeds.clear();
+    mServer.mFaults.clear();
+    mServer.mFaultCode = 4;
+    mServer.mWordpress = true;
+    // the newest post first
+    mServer.mPostIds = QStringList() << QStringLiteral("5") << QStringLiteral("4")
+                       << QStringLiteral("3") << QStringLiteral("2") << QStringLiteral("1");
+    mServer.mUnreadablePostIds = QStringList(QStringLiteral("4"));
+}
+
+QUrl testRecentPostsPaged::url(const QString &path) const
+{
+    QUrl url(QStringLiteral("http://127.0.0.1") + path);
+    url.setPort(mServer.serverPort());
+    return url;
+}
+
+void testRecentPostsPaged::testGDataPages()
+{
+    Transport transport;
+    GData blog(QUrl(QStringLiteral("http://www.blogger.com")));
+    blog.setTransport(&transport);
+    blog.setBlogId(QStringLiteral("1"));
+    PageReceiver receiver(&blog);
+
+    blog.listRecentPostsPaged(5, 2);
+    QTRY_VERIFY_WITH_TIMEOUT(receiver.mLast, 10000);
+
+    // the unreadable post is left out, but the next page starts after it
+    QCOMPARE(mServer.mFeeds, QStringList() << QStringLiteral("start-index=1&max-results=2")
+             << QStringLiteral("start-index=3&max-results=2")
+             << QStringLiteral("start-index=5&max-results=1"));
+    QCOMPARE(receiver.mPages, QList<Page>()
+             << Page(0, QStringList(QStringLiteral("5")))
+             << Page(2, QStringList() << QStringLiteral("3") << QStringLiteral("2"))
+             << Page(4, QStringList(QStringLiteral("1"))));
+    QCOMPARE(receiver.mErrors, 1);
+}
+
+void testRecentPostsPaged::testWordpressPages()
+{
+    Transport transport;
+    WordpressBuggy blog(url(QStringLiteral("/wordpress")));
+    blog.setTransport(&transport);
+    blog.setBlogId(QStringLiteral("1"));
+    blog.setUsername(QStringLiteral("user"));
+    PageReceiver receiver(&blog);
+
+    blog.listRecentPostsPaged(5, 2);
+    QTRY_VERIFY_WITH_TIMEOUT(receiver.mLast, 10000);
+
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("wp.getPosts")), 3);
+    QCOMPARE(receiver.mPages, QList<Page>()
+             << Page(0, QStringList(QStringLiteral("5")))
+             << Page(2, QStringList() << QStringLiteral("3") << QStringLiteral("2"))
+             << Page(4, QStringList(QStringLiteral("1"))));
+    QCOMPARE(receiver.mErrors, 1);
+}
+
+void testRecentPostsPaged::testWordpressFallback()
+{
+    // listed, but rejected as a method that does not exist
+    mServer.mFaults << QStringLiteral("wp.getPosts");
+    mServer.mFaultCode = -32601;
+    mServer.mUnreadablePostIds.clear();
+    Transport transport;
+    WordpressBuggy blog(url(QStringLiteral("/fallback")));
+    blog.setTransport(&transport);
+    blog.setBlogId(QStringLiteral("1"));
+    blog.setUsername(QStringLiteral("user"));
+    PageReceiver receiver(&blog);
+
+    blog.listRecentPostsPaged(3, 2);
+    QTRY_VERIFY_WITH_TIMEOUT(receiver.mLast, 10000);
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("wp.getPosts")), 1);
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("metaWeblog.getRecentPosts")), 1);
+    QCOMPARE(receiver.mPages, QList<Page>()
+             << Page(0, QStringList() << QStringLiteral("5") << QStringLiteral("4"))
+             << Page(2, QStringList(QStringLiteral("3"))));
+    QCOMPARE(receiver.mErrors, 0);
+
+    // wp.getPosts is not asked for again
+    receiver.mPages.clear();
+    receiver.mLast = false;
+    blog.listRecentPostsPaged(1, 1);
+    QTRY_VERIFY_WITH_TIMEOUT(receiver.mLast, 10000);
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("wp.getPosts")), 1);
+    QCOMPARE(receiver.mPages, QList<Page>() << Page(0, QStringList(QStringLiteral("5"))));
+}
+
+void testRecentPostsPaged::testStop()
+{
+    mServer.mUnreadablePostIds.clear();
+    Transport transport;
+    WordpressBuggy blog(url(QStringLiteral("/stop")));
+    blog.setTransport(&transport);
+    blog.setBlogId(QStringLiteral("1"));
+    blog.setUsername(QStringLiteral("user"));
+    PageReceiver receiver(&blog);
+    receiver.mStopAfter = 2;
+
+    blog.listRecentPostsPaged(5, 1);
+    QTRY_COMPARE_WITH_TIMEOUT(receiver.mPages.count(), 2, 10000);
+    // no further page is asked for or emitted
+    QTest::qWait(200);
+    QCOMPARE(receiver.mPages.count(), 2);
+    QVERIFY(!receiver.mLast);
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("wp.getPosts")), 2);
+}
+
+QTEST_GUILESS_MAIN(testRecentPostsPaged)
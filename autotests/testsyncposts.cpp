@@ -0,0 +1,154 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QStandardPaths>
+#include <QTest>
+
+#include "kblog/blogpost.h"
+#include "kblog/metaweblog.h"
+#include "kblog/transport.h"
+
+#include "blogserver.h"
+
+using namespace KBlog;
+
+class testSyncPosts: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void testCappedServer();
+    void testConcurrentSync();
+
+private:
+    BlogServer mServer;
+};
+
+#include "testsyncposts.moc"
+
+static QStringList sorted(QStringList ids)
+{
+    ids.sort();
+    return ids;
+}
+
+static QStringList postIds(const QList<BlogPost> &posts)
+{
+    QStringList ids;
+    for (const BlogPost &post : posts) {
+        ids << post.postId();
+    }
+    return sorted(ids);
+}
+
+// the ids from @p last down to @p first, the newest post first
+static QStringList range(int first, int last)
+{
+    QStringList ids;
+    for (int i = last; i >= first; --i) {
+        ids << QString::number(i);
+    }
+    return ids;
+}
+
+void testSyncPosts::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(mServer.listen(QHostAddress::LocalHost));
+}
+
+void testSyncPosts::testCappedServer()
+{
+    QUrl url(QStringLiteral("http://127.0.0.1/capped"));
+    url.setPort(mServer.serverPort());
+    Transport transport;
+    MetaWeblog blog(url);
+    blog.setTransport(&transport);
+    blog.setBlogId(QStringLiteral("capped"));
+    blog.setUsername(QStringLiteral("user"));
+    blog.resetSync();
+
+    int syncs = 0;
+    QStringList created, removed;
+    connect(&blog, &Blog::syncedPosts, this,
+            [&](const QList<BlogPost> &c, const QList<BlogPost> &u, const QList<BlogPost> &r) {
+        Q_UNUSED(u);
+        created = postIds(c);
+        removed = postIds(r);
+        ++syncs;
+    });
+
+    // 30 posts, of which the server returns the newest 20 only
+    mServer.mPostIds = range(1, 30);
+    mServer.mRecentPostsCap = 20;
+    blog.syncPosts();
+    QTRY_COMPARE_WITH_TIMEOUT(syncs, 1, 10000);
+    QCOMPARE(created, sorted(range(11, 30)));
+    QVERIFY(removed.isEmpty());
+
+    // a new post pushes the oldest known one out of the list
+    mServer.mPostIds.prepend(QStringLiteral("31"));
+    blog.syncPosts();
+    QTRY_COMPARE_WITH_TIMEOUT(syncs, 2, 10000);
+    QCOMPARE(created, QStringList(QStringLiteral("31")));
+    QVERIFY(removed.isEmpty());
+
+    // fewer posts than the server returned before, so this is all of them
+    mServer.mPostIds = range(1, 10);
+    blog.syncPosts();
+    QTRY_COMPARE_WITH_TIMEOUT(syncs, 3, 10000);
+    QVERIFY(created.isEmpty());
+    QCOMPARE(removed, sorted(range(11, 31)));
+}
+
+void testSyncPosts::testConcurrentSync()
+{
+    QUrl url(QStringLiteral("http://127.0.0.1/concurrent"));
+    url.setPort(mServer.serverPort());
+    Transport transport;
+    MetaWeblog blog(url);
+    blog.setTransport(&transport);
+    blog.setBlogId(QStringLiteral("concurrent"));
+    blog.setUsername(QStringLiteral("user"));
+    blog.resetSync();
+
+    int syncs = 0, errors = 0;
+    QStringList created;
+    connect(&blog, &Blog::syncedPosts, this,
+            [&](const QList<BlogPost> &c, const QList<BlogPost> &, const QList<BlogPost> &) {
+        created = postIds(c);
+        ++syncs;
+    });
+    connect(&blog, &Blog::error, this, [&errors]() {
+        ++errors;
+    });
+
+    mServer.mPostIds = range(1, 5);
+    mServer.mRecentPostsCap = 0;
+    mServer.mMethods.clear();
+    // the second call joins the first one
+    blog.syncPosts();
+    blog.syncPosts();
+    QTRY_COMPARE_WITH_TIMEOUT(syncs, 1, 10000);
+    QTest::qWait(100);
+    QCOMPARE(syncs, 1);
+    QCOMPARE(created, sorted(range(1, 5)));
+    QCOMPARE(mServer.mMethods.count(QStringLiteral("metaWeblog.getRecentPosts")), 1);
+
+    // a failed sync does not keep the next one from running
+    mServer.mFaults << QStringLiteral("metaWeblog.getRecentPosts");
+    blog.syncPosts();
+    QTRY_COMPARE_WITH_TIMEOUT(errors, 1, 10000);
+    mServer.mFaults.clear();
+    mServer.mPostIds.prepend(QStringLiteral("6"));
+    blog.syncPosts();
+    QTRY_COMPARE_WITH_TIMEOUT(syncs, 2, 10000);
+    QCOMPARE(created, QStringList(QStringLiteral("6")));
+}
+
+QTEST_GUILESS_MAIN(testSyncPosts)
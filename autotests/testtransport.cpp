@@ -0,0 +1,371 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QAuthenticator>
+#include <QNetworkProxy>
+#include <QTest>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "kblog/transport.h"
+#include "kblog/transportjob.h"
+
+using namespace KBlog;
+
+class TestServer : public QTcpServer
+{
+    Q_OBJECT
+public:
+    int mConnections = 0;
+    // the Authorization header of every request, empty if there was none
+    QList<QByteArray> mAuthorization;
+
+protected:
+    void incomingConnection(qintptr handle) override
+    {
+        ++mConnections;
+        QTcpSocket *socket = new QTcpSocket(this);
+        socket->setSocketDescriptor(handle);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            QByteArray request = socket->property("buffer").toByteArray() + socket->readAll();
+            int end;
+            while ((end = request.indexOf("\r\n\r\n")) >= 0) {
+                const QByteArray head = request.left(end);
+                request.remove(0, end + 4);
+                const QByteArray path = head.split(' ').value(1);
+                QByteArray authorization, proxyAuthorization;
+                const QList<QByteArray> lines = head.split('\n');
+                for (const QByteArray &line : lines) {
+                    if (line.toLower().startsWith("authorization:")) {
+                        authorization = line.mid(14).trimmed();
+                    } else if (line.toLower().startsWith("proxy-authorization:")) {
+                        proxyAuthorization = line.mid(20).trimmed();
+                    }
+                }
+                mAuthorization << authorization;
+                if (path == "/chunked") {
+                    socket->write("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+                                  "5\r\nHello\r\n7;ext=1\r\n, world\r\n0\r\n\r\n");
+                } else if (path == "/moved") {
+                    socket->write("HTTP/1.1 302 Found\r\nLocation: /plain\r\nContent-Length: 0\r\n\r\n");
+                } else if (path == "/movedbody") {
+                    socket->write("HTTP/1.1 302 Found\r\nLocation: /plain\r\nContent-Length: 5\r\n\r\nmoved");
+                } else if (path == "/elsewhere") {
+                    // the same server, but another origin
+                    socket->write("HTTP/1.1 302 Found\r\nLocation: http://localhost:" +
+                                  QByteArray::number(serverPort()) +
+                                  "/plain\r\nContent-Length: 0\r\n\r\n");
+                } else if (path == "http://blog.example/proxy") {
+                    // acting as the proxy
+                    if (proxyAuthorization == "Basic " + QByteArray("user:secret").toBase64()) {
+                        socket->write("HTTP/1.1 200 OK\r\nContent-Length: 7\r\n\r\nproxied");
+                    } else {
+                        socket->write("HTTP/1.1 407 Proxy Authentication Required\r\n"
+                                      "Proxy-Authenticate: Basic realm=\"test\"\r\n"
+                                      "Content-Length: 6\r\n\r\ndenied");
+                    }
+                } else if (path == "/slow") {
+                    socket->write("HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\nfirst");
+                    QTimer::singleShot(200, socket, [socket]() {
+                        socket->write("later");
+                    });
+                } else if (path == "/stall") {
+                    // accepts the request and never answers
+                } else if (path == "/stallbody") {
+                    socket->write("HTTP/1.1 200 OK\r\nContent-Length: 10\r\n\r\nhello");
+                } else if (path == "/missing") {
+                    socket->write("HTTP/1.1 404 Not Found\r\nContent-Length: 4\r\n\r\ngone");
+                } else {
+                    socket->write("HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nplain");
+                }
+            }
+            socket->setProperty("buffer", request);
+        });
+    }
+};
+
+class testTransport: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void testKeepAlive();
+    void testChunked();
+    void testDataReceived();
+    void testFinishEarly();
+    void testRedirect();
+    void testRedirectOrigin();
+    void testUnfollowedRedirect();
+    void testHttpError();
+    void testProxy();
+    void testReadTimeout();
+    void testPriorities();
+
+private:
+    QByteArray fetch(Transport *transport, const QString &path, int *error = nullptr);
+    QByteArray fetch(Transport *transport, const QUrl &url, int *error = nullptr);
+    TestServer mServer;
+};
+
+#include "testtransport.moc"
+
+void testTransport::initTestCase()
+{
+    QVERIFY(mServer.listen(QHostAddress::LocalHost));
+}
+
+QByteArray testTransport::fetch(Transport *transport, const QString &path, int *error)
+{
+    QUrl url(QStringLiteral("http://127.0.0.1") + path);
+    url.setPort(mServer.serverPort());
+    return fetch(transport, url, error);
+}
+
+QByteArray testTransport::fetch(Transport *transport, const QUrl &url, int *error)
+{
+    TransportJob *job = transport->get(url);
+    QSignalSpy spy(job, SIGNAL(result(KJob*)));
+    QByteArray data;
+    connect(job, &KJob::result, this, [&data, error](KJob *job) {
+        data = static_cast<TransportJob *>(job)->data();
+        if (error) {
+            *error = job->error();
+        }
+    });
+    job->start();
+    if (!spy.wait(5000)) {
+        return QByteArray("timeout");
+    }
+    return data;
+}
+
+void testTransport::testKeepAlive()
+{
+    Transport transport;
+    const int connections = mServer.mConnections;
+    QCOMPARE(fetch(&transport, QStringLiteral("/plain")), QByteArray("plain"));
+    QCOMPARE(fetch(&transport, QStringLiteral("/plain")), QByteArray("plain"));
+    QCOMPARE(fetch(&transport, QStringLiteral("/plain")), QByteArray("plain"));
+    QCOMPARE(transport.requestCount(), quint64(3));
+    QCOMPARE(transport.connectionsOpened(), quint64(1));
+    QCOMPARE(transport.connectionsReused(), quint64(2));
+    QCOMPARE(mServer.mConnections, connections + 1);
+}
+
+void testTransport::testChunked()
+{
+    Transport transport;
+    QCOMPARE(fetch(&transport, QStringLiteral("/chunked")), QByteArray("Hello, world"));
+    QCOMPARE(fetch(&transport, QStringLiteral("/plain")), QByteArray("plain"));
+    QCOMPARE(transport.connectionsOpened(), quint64(1));
+}
+
+void testTransport::testDataReceived()
+{
+    Transport transport;
+    QUrl url(QStringLiteral("http://127.0.0.1/moved"));
+    url.setPort(mServer.serverPort());
+    TransportJob *job = transport.get(url);
+    QSignalSpy spy(job, SIGNAL(result(KJob*)));
+    QByteArray received;
+    connect(job, &TransportJob::dataReceived, this, [&received](TransportJob *, const QByteArray &data) {
+        received += data;
+    });
+    job->start();
+    QVERIFY(spy.wait(5000));
+    // only the body after the redirect
+    QCOMPARE(received, QByteArray("plain"));
+
+    url.setPath(QStringLiteral("/chunked"));
+    job = transport.get(url);
+    QSignalSpy chunkedSpy(job, SIGNAL(result(KJob*)));
+    received.clear();
+    int parts = 0;
+    connect(job, &TransportJob::dataReceived, this, [&received, &parts](TransportJob *job, const QByteArray &data) {
+        received += data;
+        ++parts;
+        QCOMPARE(job->data(), received);
+    });
+    job->start();
+    QVERIFY(chunkedSpy.wait(5000));
+    QCOMPARE(received, QByteArray("Hello, world"));
+    // at least one part per chunk
+    QVERIFY(parts >= 2);
+}
+
+void testTransport::testFinishEarly()
+{
+    Transport transport;
+    transport.setMaxRequestsPerHost(1);
+    QUrl url(QStringLiteral("http://127.0.0.1/slow"));
+    url.setPort(mServer.serverPort());
+    TransportJob *job = transport.get(url);
+    job->setBufferData(false);
+    QByteArray received;
+    connect(job, &TransportJob::dataReceived, this, [&received](TransportJob *job, const QByteArray &data) {
+        received += data;
+        QVERIFY(job->data().isEmpty());
+        job->finishEarly();
+    });
+    int error = -1;
+    connect(job, &KJob::result, this, [&error](KJob *job) {
+        error = job->error();
+    });
+    QSignalSpy spy(job, SIGNAL(result(KJob*)));
+    job->start();
+    QVERIFY(spy.wait(5000));
+    // done before the rest of the body has arrived
+    QCOMPARE(received, QByteArray("first"));
+    QCOMPARE(error, 0);
+
+    // which is dropped, and the connection is used for the next request
+    QCOMPARE(fetch(&transport, QStringLiteral("/plain")), QByteArray("plain"));
+    QCOMPARE(transport.connectionsOpened(), quint64(1));
+    QCOMPARE(transport.connectionsReused(), quint64(1));
+}
+
+void testTransport::testRedirect()
+{
+    Transport transport;
+    QCOMPARE(fetch(&transport, QStringLiteral("/moved")), QByteArray("plain"));
+    QCOMPARE(transport.requestCount(), quint64(2));
+}
+
+void testTransport::testRedirectOrigin()
+{
+    Transport transport;
+    QUrl url(QStringLiteral("http://127.0.0.1/moved"));
+    url.setPort(mServer.serverPort());
+    const QList<QString> paths = QList<QString>() << QStringLiteral("/moved")
+                                 << QStringLiteral("/elsewhere");
+    for (const QString &path : paths) {
+        url.setPath(path);
+        TransportJob *job = transport.get(url);
+        job->setRequestHeader("Authorization", "GoogleLogin auth=secret");
+        QSignalSpy spy(job, SIGNAL(result(KJob*)));
+        mServer.mAuthorization.clear();
+        job->start();
+        QVERIFY(spy.wait(5000));
+        QCOMPARE(mServer.mAuthorization.count(), 2);
+        QCOMPARE(mServer.mAuthorization.first(), QByteArray("GoogleLogin auth=secret"));
+        // kept on the same origin only
+        QCOMPARE(mServer.mAuthorization.last(),
+                 path == QLatin1String("/moved") ? QByteArray("GoogleLogin auth=secret") : QByteArray());
+    }
+}
+
+void testTransport::testUnfollowedRedirect()
+{
+    Transport transport;
+    QUrl url(QStringLiteral("http://127.0.0.1/movedbody"));
+    url.setPort(mServer.serverPort());
+    // the server reads no request body, so none is sent
+    TransportJob *job = transport.post(url, QByteArray());
+    QSignalSpy spy(job, SIGNAL(result(KJob*)));
+    QByteArray received;
+    connect(job, &TransportJob::dataReceived, this, [&received](TransportJob *, const QByteArray &data) {
+        received += data;
+    });
+    job->start();
+    QVERIFY(spy.wait(5000));
+    // a POST is not redirected, so its answer is the body of the redirect
+    QCOMPARE(job->error(), int(TransportJob::HttpError));
+    QCOMPARE(received, QByteArray("moved"));
+    QCOMPARE(transport.requestCount(), quint64(1));
+
+    // while a GET is, and leaves that body out
+    QCOMPARE(fetch(&transport, QStringLiteral("/movedbody")), QByteArray("plain"));
+    QCOMPARE(transport.requestCount(), quint64(3));
+}
+
+void testTransport::testHttpError()
+{
+    Transport transport;
+    int error = 0;
+    QCOMPARE(fetch(&transport, QStringLiteral("/missing"), &error), QByteArray("gone"));
+    QCOMPARE(error, int(TransportJob::HttpError));
+}
+
+void testTransport::testProxy()
+{
+    QNetworkProxy::setApplicationProxy(QNetworkProxy(QNetworkProxy::HttpProxy,
+                                       QStringLiteral("127.0.0.1"), mServer.serverPort()));
+    Transport transport;
+    int asked = 0;
+    connect(&transport, &Transport::proxyAuthenticationRequired, this,
+            [&asked](const QNetworkProxy &, QAuthenticator *authenticator) {
+        ++asked;
+        authenticator->setUser(QStringLiteral("user"));
+        authenticator->setPassword(QStringLiteral("secret"));
+    });
+    const QUrl url(QStringLiteral("http://blog.example/proxy"));
+    int error = 0;
+    QCOMPARE(fetch(&transport, url, &error), QByteArray("proxied"));
+    QCOMPARE(error, 0);
+    QCOMPARE(asked, 1);
+    // the credentials are kept for later requests
+    QCOMPARE(fetch(&transport, url, &error), QByteArray("proxied"));
+    QCOMPARE(asked, 1);
+    QNetworkProxy::setApplicationProxy(QNetworkProxy(QNetworkProxy::NoProxy));
+}
+
+void testTransport::testReadTimeout()
+{
+    Transport transport;
+    transport.setReadTimeout(200);
+    int error = 0;
+    fetch(&transport, QStringLiteral("/stall"), &error);
+    QCOMPARE(error, int(TransportJob::TimeoutError));
+    // the timeout starts again with every piece of data
+    fetch(&transport, QStringLiteral("/stallbody"), &error);
+    QCOMPARE(error, int(TransportJob::TimeoutError));
+    QCOMPARE(fetch(&transport, QStringLiteral("/plain"), &error), QByteArray("plain"));
+    QCOMPARE(error, 0);
+}
+
+void testTransport::testPriorities()
+{
+    Transport transport;
+    transport.setMaxRequestsPerHost(1);
+    QUrl url(QStringLiteral("http://127.0.0.1/plain"));
+    url.setPort(mServer.serverPort());
+
+    QStringList order;
+    const QStringList names = QStringList() << QStringLiteral("first")
+                              << QStringLiteral("background") << QStringLiteral("interactive");
+    const Transport::Priority priorities[] = {
+        Transport::Background, Transport::Background, Transport::Interactive
+    };
+    TransportJob *last = nullptr;
+    for (int i = 0; i < names.count(); ++i) {
+        TransportJob *job = transport.get(url);
+        job->setPriority(priorities[i]);
+        const QString name = names.at(i);
+        connect(job, &KJob::result, this, [&order, name]() {
+            order << name;
+        });
+        job->start();
+        last = job;
+    }
+    QCOMPARE(transport.queueDepth(), 2);
+    QCOMPARE(transport.queueDepth(Transport::Interactive), 1);
+    QCOMPARE(transport.queueDepth(Transport::Background), 1);
+
+    QSignalSpy spy(last, SIGNAL(result(KJob*)));
+    QVERIFY(spy.wait(5000));
+    QTRY_COMPARE(order.count(), 3);
+    QCOMPARE(order, QStringList() << QStringLiteral("first")
+             << QStringLiteral("interactive") << QStringLiteral("background"));
+    QCOMPARE(transport.queueDepth(), 0);
+    QCOMPARE(transport.queuedRequests(), quint64(2));
+    QCOMPARE(transport.connectionsOpened(), quint64(1));
+}
+
+QTEST_GUILESS_MAIN(testTransport)
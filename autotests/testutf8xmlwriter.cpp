@@ -0,0 +1,101 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QTest>
+#include <QXmlStreamReader>
+
+#include "utf8xmlwriter_p.h"
+
+using namespace KBlog;
+
+class testUtf8XmlWriter: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testEncoding_data();
+    void testEncoding();
+    void testCData_data();
+    void testCData();
+    void testText();
+    void testGrowth();
+};
+
+#include "testutf8xmlwriter.moc"
+
+void testUtf8XmlWriter::testEncoding_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::newRow("empty") << QString();
+    QTest::newRow("ascii") << QStringLiteral("plain text");
+    QTest::newRow("latin1") << QString::fromUtf8("gr\xc3\xbc\xc3\x9f dich");
+    QTest::newRow("bmp") << QString::fromUtf8("\xe2\x82\xac \xe6\x97\xa5\xe6\x9c\xac");
+    QTest::newRow("surrogates") << QString::fromUtf8("emoji \xf0\x9f\x98\x80 end");
+    QTest::newRow("lone surrogate") << (QStringLiteral("a") + QChar(0xd800) + QStringLiteral("b"));
+}
+
+void testUtf8XmlWriter::testEncoding()
+{
+    QFETCH(QString, text);
+    Utf8XmlWriter writer;
+    writer.writeCData(text);
+    QCOMPARE(writer.takeData(), "<![CDATA[" + text.toUtf8() + "]]>");
+}
+
+void testUtf8XmlWriter::testCData_data()
+{
+    QTest::addColumn<QString>("text");
+    QTest::newRow("none") << QStringLiteral("<b>bold</b>");
+    QTest::newRow("one") << QStringLiteral("a]]>b");
+    QTest::newRow("start") << QStringLiteral("]]>b");
+    QTest::newRow("end") << QStringLiteral("a]]>");
+    QTest::newRow("repeated") << QStringLiteral("]]>]]>]]]>>");
+    QTest::newRow("brackets") << QStringLiteral("a]]]b]]");
+}
+
+void testUtf8XmlWriter::testCData()
+{
+    QFETCH(QString, text);
+    Utf8XmlWriter writer;
+    writer.writeMarkup("<value>");
+    writer.writeCData(text);
+    writer.writeMarkup("</value>");
+
+    QXmlStreamReader reader(writer.takeData());
+    QVERIFY(reader.readNextStartElement());
+    QCOMPARE(reader.readElementText(), text);
+    QVERIFY(!reader.hasError());
+}
+
+void testUtf8XmlWriter::testText()
+{
+    Utf8XmlWriter writer;
+    writer.writeMarkup("<name>");
+    writer.writeText(QString::fromUtf8("a < b && c > \xc3\xa4"));
+    writer.writeMarkup("</name><int>");
+    writer.writeNumber(-42);
+    writer.writeMarkup("</int><category term='");
+    writer.writeAttribute(QStringLiteral("it's \"<x>\""));
+    writer.writeMarkup("'/>");
+    QCOMPARE(writer.takeData(),
+             QByteArray("<name>a &lt; b &amp;&amp; c &gt; \xc3\xa4</name><int>-42</int>"
+                        "<category term='it&apos;s &quot;&lt;x&gt;&quot;'/>"));
+}
+
+void testUtf8XmlWriter::testGrowth()
+{
+    // the capacity is only a hint
+    const QString text = QString(5000, QChar(0x20ac)) + QString(5000, QLatin1Char('x'));
+    Utf8XmlWriter writer(16);
+    writer.writeCData(text);
+    writer.writeCData(text);
+    const QByteArray expected = "<![CDATA[" + text.toUtf8() + "]]>";
+    QCOMPARE(writer.takeData(), expected + expected);
+    QCOMPARE(writer.takeData(), QByteArray());
+}
+
+QTEST_GUILESS_MAIN(testUtf8XmlWriter)
@@ -0,0 +1,233 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QDir>
+#include <QStandardPaths>
+#include <QTest>
+
+#include "kblog/transport.h"
+#include "xmlrpcclient_p.h"
+
+#include "blogserver.h"
+
+using namespace KBlog;
+
+// collects the results of the calls by their id
+class Receiver : public QObject
+{
+    Q_OBJECT
+public:
+    QMap<int, QList<QVariant> > mMessages;
+    QMap<int, QPair<int, QString> > mFaults;
+
+public Q_SLOTS:
+    void slotMessage(const QList<QVariant> &result, const QVariant &id)
+    {
+        mMessages.insert(id.toInt(), result);
+    }
+
+    void slotFault(int number, const QString &errorString, const QVariant &id)
+    {
+        mFaults.insert(id.toInt(), qMakePair(number, errorString));
+    }
+};
+
+class testXmlRpcClient: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void testMulticall();
+    void testWithoutMulticall();
+    void testMulticallFault();
+    void testInvalidMulticall();
+    void testSetUrl();
+
+private:
+    QUrl url(const QString &path) const;
+    void call(XmlRpcClient *client, Receiver *receiver, const QString &method, int id,
+              bool shared = false);
+    BlogServer mServer;
+};
+
+#include "testxmlrpcclient.moc"
+
+void testXmlRpcClient::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(mServer.listen(QHostAddress::LocalHost));
+    // no methods cached by an earlier run
+    QDir(QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) +
+         QLatin1String("/kblog/capabilities")).removeRecursively();
+}
+
+void testXmlRpcClient::init()
+{
+    mServer.mMethods.clear();
+    mServer.mMulticalls.clear();
+    mServer.mFaults.clear();
+    mServer.mMulticall = false;
+    mServer.mMulticallJunk.clear();
+}
+
+QUrl testXmlRpcClient::url(const QString &path) const
+{
+    QUrl url(QStringLiteral("http://127.0.0.1") + path);
+    url.setPort(mServer.serverPort());
+    return url;
+}
+
+void testXmlRpcClient::call(XmlRpcClient *client, Receiver *receiver, const QString &method, int id,
+                            bool shared)
+{
+    client->call(method, QList<QVariant>() << QStringLiteral("1") << QStringLiteral("user"),
+                 receiver, SLOT(slotMessage(QList<QVariant>,QVariant)),
+                 receiver, SLOT(slotFault(int,QString,QVariant)), QVariant(id), shared);
+}
+
+void testXmlRpcClient::testMulticall()
+{
+    mServer.mMulticall = true;
+    mServer.mFaults << QStringLiteral("metaWeblog.deletePost");
+    Transport transport;
+    XmlRpcClient client(url(QStringLiteral("/multicall")));
+    client.setTransport(&transport);
+    client.setBatchingEnabled(true);
+    Receiver receiver;
+
+    call(&client, &receiver, QStringLiteral("metaWeblog.getCategories"), 0);
+    call(&client, &receiver, QStringLiteral("metaWeblog.deletePost"), 1);
+    call(&client, &receiver, QStringLiteral("metaWeblog.getPost"), 2);
+    QTRY_COMPARE_WITH_TIMEOUT(receiver.mMessages.count() + receiver.mFaults.count(), 3, 10000);
+
+    // one probe, then all calls in one request
+    QCOMPARE(mServer.mMethods, QStringList() << QStringLiteral("system.listMethods")
+             << QStringLiteral("system.multicall"));
+    QCOMPARE(mServer.mMulticalls.count(), 1);
+    QCOMPARE(mServer.mMulticalls.first(), QStringList() << QStringLiteral("metaWeblog.getCategories")
+             << QStringLiteral("metaWeblog.deletePost") << QStringLiteral("metaWeblog.getPost"));
+
+    // every result goes to its own call
+    const QList<QVariant> categories = receiver.mMessages.value(0);
+    QCOMPARE(categories.count(), 1);
+    QCOMPARE(categories.first().toList().first().toMap().value(QStringLiteral("categoryName")).toString(),
+             QStringLiteral("KDE"));
+    const QList<QVariant> post = receiver.mMessages.value(2);
+    QCOMPARE(post.count(), 1);
+    QCOMPARE(post.first().toMap().value(QStringLiteral("title")).toString(), QStringLiteral("Fetched"));
+
+    // and a fault only to the call that failed
+    QCOMPARE(receiver.mFaults.keys(), QList<int>() << 1);
+    QCOMPARE(receiver.mFaults.value(1).first, 4);
+    QCOMPARE(receiver.mFaults.value(1).second, QStringLiteral("Not allowed"));
+}
+
+void testXmlRpcClient::testWithoutMulticall()
+{
+    mServer.mFaults << QStringLiteral("metaWeblog.deletePost");
+    Transport transport;
+    transport.setMaxRequestsPerHost(1);
+    XmlRpcClient client(url(QStringLiteral("/single")));
+    client.setTransport(&transport);
+    client.setBatchingEnabled(true);
+    Receiver receiver;
+
+    call(&client, &receiver, QStringLiteral("metaWeblog.getCategories"), 0);
+    call(&client, &receiver, QStringLiteral("metaWeblog.deletePost"), 1);
+    QTRY_COMPARE_WITH_TIMEOUT(receiver.mMessages.count() + receiver.mFaults.count(), 2, 10000);
+
+    QCOMPARE(mServer.mMethods, QStringList() << QStringLiteral("system.listMethods")
+             << QStringLiteral("metaWeblog.getCategories") << QStringLiteral("metaWeblog.deletePost"));
+    QVERIFY(mServer.mMulticalls.isEmpty());
+    QCOMPARE(receiver.mMessages.keys(), QList<int>() << 0);
+    QCOMPARE(receiver.mFaults.value(1).first, 4);
+}
+
+void testXmlRpcClient::testMulticallFault()
+{
+    // listed, but rejected when called
+    mServer.mMulticall = true;
+    mServer.mFaults << QStringLiteral("system.multicall");
+    Transport transport;
+    transport.setMaxRequestsPerHost(1);
+    XmlRpcClient client(url(QStringLiteral("/multicallfault")));
+    client.setTransport(&transport);
+    client.setBatchingEnabled(true);
+    Receiver receiver;
+
+    call(&client, &receiver, QStringLiteral("metaWeblog.getCategories"), 0);
+    call(&client, &receiver, QStringLiteral("metaWeblog.getPost"), 1);
+    QTRY_COMPARE_WITH_TIMEOUT(receiver.mMessages.count() + receiver.mFaults.count(), 2, 10000);
+
+    // none of the calls has run, so they are sent singly
+    QCOMPARE(mServer.mMethods, QStringList() << QStringLiteral("system.listMethods")
+             << QStringLiteral("system.multicall") << QStringLiteral("metaWeblog.getCategories")
+             << QStringLiteral("metaWeblog.getPost"));
+    QCOMPARE(receiver.mMessages.keys(), QList<int>() << 0 << 1);
+}
+
+void testXmlRpcClient::testInvalidMulticall()
+{
+    mServer.mMulticall = true;
+    mServer.mMulticallJunk = "<b>Warning</b>: Cannot modify header information\n";
+    Transport transport;
+    XmlRpcClient client(url(QStringLiteral("/invalidmulticall")));
+    client.setTransport(&transport);
+    client.setBatchingEnabled(true);
+    Receiver receiver;
+
+    call(&client, &receiver, QStringLiteral("metaWeblog.newPost"), 0);
+    call(&client, &receiver, QStringLiteral("metaWeblog.newPost"), 1);
+    QTRY_COMPARE_WITH_TIMEOUT(receiver.mFaults.count(), 2, 10000);
+
+    // the server might have created the posts, they are not sent again
+    QTest::qWait(100);
+    QCOMPARE(mServer.mMethods, QStringList() << QStringLiteral("system.listMethods")
+             << QStringLiteral("system.multicall"));
+    QVERIFY(receiver.mMessages.isEmpty());
+}
+
+void testXmlRpcClient::testSetUrl()
+{
+    mServer.mMulticall = true;
+    Transport transport;
+    XmlRpcClient client(url(QStringLiteral("/old")));
+    client.setTransport(&transport);
+    client.setBatchingEnabled(true);
+    client.setBatchWindow(60000);
+    Receiver receiver;
+
+    call(&client, &receiver, QStringLiteral("metaWeblog.getCategories"), 0);
+    call(&client, &receiver, QStringLiteral("metaWeblog.getPost"), 1);
+    client.setUrl(url(QStringLiteral("/new")));
+    // the waiting calls fail right away instead of being stranded
+    QCOMPARE(receiver.mFaults.keys(), QList<int>() << 0 << 1);
+    QVERIFY(receiver.mMessages.isEmpty());
+
+    // and the new server gets the calls made afterwards
+    client.setBatchWindow(0);
+    call(&client, &receiver, QStringLiteral("metaWeblog.getPost"), 2);
+    QTRY_COMPARE_WITH_TIMEOUT(receiver.mMessages.count(), 1, 10000);
+    QVERIFY(receiver.mMessages.contains(2));
+    QCOMPARE(mServer.mMethods, QStringList(QStringLiteral("metaWeblog.getPost")));
+
+    // a read still in flight to the old server does not answer the same
+    // read to the new one
+    mServer.mMethods.clear();
+    client.setBatchingEnabled(false);
+    client.setUrl(url(QStringLiteral("/old")));
+    call(&client, &receiver, QStringLiteral("metaWeblog.getPost"), 3, true);
+    client.setUrl(url(QStringLiteral("/new")));
+    call(&client, &receiver, QStringLiteral("metaWeblog.getPost"), 4, true);
+    QTRY_COMPARE_WITH_TIMEOUT(receiver.mMessages.count(), 3, 10000);
+    QCOMPARE(mServer.mMethods, QStringList() << QStringLiteral("metaWeblog.getPost")
+             << QStringLiteral("metaWeblog.getPost"));
+}
+
+QTEST_GUILESS_MAIN(testXmlRpcClient)
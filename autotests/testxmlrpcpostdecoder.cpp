@@ -0,0 +1,150 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include "xmlrpcclient_p.h"
+#include "xmlrpcpostdecoder_p.h"
+
+using namespace KBlog;
+
+static const char postStruct[] =
+    "<struct>"
+    "<member><name>dateCreated</name><value><dateTime.iso8601>20260301T10:20:30</dateTime.iso8601></value></member>"
+    "<member><name>postid</name><value><string>42</string></value></member>"
+    "<member><name>postId</name><value><string>ignored</string></value></member>"
+    "<member><name>title</name><value><string>Title &amp; more</string></value></member>"
+    "<member><name>description</name><value>untyped description</value></member>"
+    "<member><name>content</name><value><base64>w6TDtsO8</base64></value></member>"
+    "<member><name>categories</name><value><array><data>"
+    "<value><string>one</string></value><value>two</value>"
+    "</data></array></value></member>"
+    "<member><name>mt_keywords</name><value><string>tag</string></value></member>"
+    "<member><name>mt_allow_comments</name><value><int>1</int></value></member>"
+    "<member><name>mt_allow_pings</name><value><boolean>0</boolean></value></member>"
+    "<member><name>custom_fields</name><value><array><data>"
+    "<value><struct><member><name>title</name><value>nested</value></member></struct></value>"
+    "</data></array></value></member>"
+    "<member><name>wp_slug</name>\n  <value>\n    <string>slug</string>\n  </value>\n</member>"
+    "<member><name>post_status</name><value><string>draft</string></value></member>"
+    "</struct>";
+
+static QByteArray response(const QByteArray &value)
+{
+    return "<?xml version=\"1.0\"?>\n<methodResponse><params><param><value>"
+           + value + "</value></param></params></methodResponse>";
+}
+
+class testXmlRpcPostDecoder: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testDecodePost();
+    void testDecodeList();
+    void testMatchesMaps();
+    void testFault();
+};
+
+#include "testxmlrpcpostdecoder.moc"
+
+void testXmlRpcPostDecoder::testDecodePost()
+{
+    QList<PostFields> posts;
+    bool isList = true;
+    int faultCode = 0;
+    QString faultString;
+    QVERIFY(XmlRpcPostDecoder::decode(response(postStruct), &posts, &isList,
+                                      &faultCode, &faultString));
+    QVERIFY(!isList);
+    QCOMPARE(posts.count(), 1);
+    const PostFields &post = posts.first();
+    QCOMPARE(post.mPostId, QStringLiteral("42"));
+    QCOMPARE(post.mTitle, QStringLiteral("Title & more"));
+    QCOMPARE(post.mDescription, QStringLiteral("untyped description"));
+    QCOMPARE(post.mContent, QString::fromUtf8("\xc3\xa4\xc3\xb6\xc3\xbc"));
+    QCOMPARE(post.mCategories, QStringList() << QStringLiteral("one") << QStringLiteral("two"));
+    QCOMPARE(post.mKeywords, QStringList() << QStringLiteral("tag"));
+    QCOMPARE(post.mSlug, QStringLiteral("slug"));
+    QCOMPARE(post.mPostStatus, QStringLiteral("draft"));
+    QVERIFY(post.mAllowComments);
+    QVERIFY(!post.mAllowPings);
+    QCOMPARE(post.mDateCreated, QDateTime(QDate(2026, 3, 1), QTime(10, 20, 30)));
+}
+
+void testXmlRpcPostDecoder::testDecodeList()
+{
+    QList<PostFields> posts;
+    bool isList = false;
+    int faultCode = 0;
+    QString faultString;
+    const QByteArray value = "<array><data><value>" + QByteArray(postStruct) + "</value>"
+                             "<value>" + QByteArray(postStruct) + "</value></data></array>";
+    QVERIFY(XmlRpcPostDecoder::decode(response(value), &posts, &isList,
+                                      &faultCode, &faultString));
+    QVERIFY(isList);
+    QCOMPARE(posts.count(), 2);
+    QCOMPARE(posts.at(1).mTitle, QStringLiteral("Title & more"));
+
+    posts.clear();
+    QVERIFY(XmlRpcPostDecoder::decode(response("<array><data></data></array>"), &posts, &isList,
+                                      &faultCode, &faultString));
+    QVERIFY(isList);
+    QVERIFY(posts.isEmpty());
+}
+
+void testXmlRpcPostDecoder::testMatchesMaps()
+{
+    const QByteArray data = response(postStruct);
+    QList<PostFields> posts;
+    bool isList;
+    int faultCode = 0;
+    QString faultString;
+    QVERIFY(XmlRpcPostDecoder::decode(data, &posts, &isList, &faultCode, &faultString));
+
+    QList<QVariant> result;
+    QVERIFY(XmlRpcClient::parseResponse(data, &result, &faultCode, &faultString));
+    bool ok;
+    const QList<PostFields> fromMaps = PostFields::fromResult(result.first(), &ok);
+    QVERIFY(ok);
+    QCOMPARE(fromMaps.count(), 1);
+
+    const PostFields &typed = posts.first();
+    const PostFields &mapped = fromMaps.first();
+    QCOMPARE(typed.mPostId, mapped.mPostId);
+    QCOMPARE(typed.mTitle, mapped.mTitle);
+    QCOMPARE(typed.mDescription, mapped.mDescription);
+    QCOMPARE(typed.mContent, mapped.mContent);
+    QCOMPARE(typed.mCategories, mapped.mCategories);
+    QCOMPARE(typed.mKeywords, mapped.mKeywords);
+    QCOMPARE(typed.mSlug, mapped.mSlug);
+    QCOMPARE(typed.mPostStatus, mapped.mPostStatus);
+    QCOMPARE(typed.mAllowComments, mapped.mAllowComments);
+    QCOMPARE(typed.mAllowPings, mapped.mAllowPings);
+    QCOMPARE(typed.mDateCreated, mapped.mDateCreated);
+}
+
+void testXmlRpcPostDecoder::testFault()
+{
+    const QByteArray data = "<?xml version=\"1.0\"?>\n<methodResponse><fault><value><struct>"
+                            "<member><name>faultCode</name><value><int>801</int></value></member>"
+                            "<member><name>faultString</name><value><string>denied</string></value></member>"
+                            "</struct></value></fault></methodResponse>";
+    QList<PostFields> posts;
+    bool isList;
+    int faultCode = 0;
+    QString faultString;
+    QVERIFY(!XmlRpcPostDecoder::decode(data, &posts, &isList, &faultCode, &faultString));
+    QCOMPARE(faultCode, 801);
+    QCOMPARE(faultString, QStringLiteral("denied"));
+
+    QVERIFY(!XmlRpcPostDecoder::decode("<methodResponse><params>", &posts, &isList,
+                                       &faultCode, &faultString));
+    QCOMPARE(faultCode, -1);
+}
+
+QTEST_GUILESS_MAIN(testXmlRpcPostDecoder)
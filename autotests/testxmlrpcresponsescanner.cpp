@@ -0,0 +1,128 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include "xmlrpcresponsescanner_p.h"
+
+using namespace KBlog;
+
+static const char valueResponse[] =
+    "<?xml version=\"1.0\"?>\n"
+    "<methodResponse>\n"
+    "  <params>\n"
+    "    <param>\n"
+    "      <value>\n"
+    "        <string>1234</string>\n"
+    "      </value>\n"
+    "    </param>\n"
+    "  </params>\n"
+    "</methodResponse>\n";
+
+static const char faultResponse[] =
+    "<?xml version=\"1.0\"?>\n"
+    "<methodResponse><fault><value><struct>"
+    "<member><name>faultCode</name><value><int> 403 </int></value></member>"
+    "<member><name>faultString</name><value><string>Incorrect username or password.</string></value></member>"
+    "</struct></value></fault></methodResponse>";
+
+class testXmlRpcResponseScanner: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testValue_data();
+    void testValue();
+    void testFault();
+    void testIncremental();
+    void testStopsEarly();
+    void testInvalid();
+};
+
+#include "testxmlrpcresponsescanner.moc"
+
+void testXmlRpcResponseScanner::testValue_data()
+{
+    QTest::addColumn<QByteArray>("value");
+    QTest::addColumn<QString>("expected");
+    QTest::newRow("string") << QByteArray("<string> 12 </string>") << QStringLiteral(" 12 ");
+    QTest::newRow("int") << QByteArray("<int> 12 </int>") << QStringLiteral("12");
+    QTest::newRow("boolean") << QByteArray("<boolean>1</boolean>") << QStringLiteral("1");
+    QTest::newRow("untyped") << QByteArray("abc") << QStringLiteral("abc");
+    QTest::newRow("cdata") << QByteArray("<string><![CDATA[a]]]]><![CDATA[>b]]></string>") << QStringLiteral("a]]>b");
+}
+
+void testXmlRpcResponseScanner::testValue()
+{
+    QFETCH(QByteArray, value);
+    QFETCH(QString, expected);
+    XmlRpcResponseScanner scanner;
+    scanner.addData("<?xml version=\"1.0\"?><methodResponse><params><param><value>" + value +
+                    "</value></param></params></methodResponse>");
+    QCOMPARE(scanner.finish(), XmlRpcResponseScanner::Value);
+    QCOMPARE(scanner.value(), expected);
+}
+
+void testXmlRpcResponseScanner::testFault()
+{
+    XmlRpcResponseScanner scanner;
+    QCOMPARE(scanner.addData(faultResponse), XmlRpcResponseScanner::Fault);
+    QCOMPARE(scanner.faultCode(), 403);
+    QCOMPARE(scanner.faultString(), QStringLiteral("Incorrect username or password."));
+}
+
+void testXmlRpcResponseScanner::testIncremental()
+{
+    const QByteArray data(valueResponse);
+    XmlRpcResponseScanner scanner;
+    for (int i = 0; i < data.size() - 1; ++i) {
+        scanner.addData(data.mid(i, 1));
+        if (scanner.state() != XmlRpcResponseScanner::NeedMoreData) {
+            break;
+        }
+    }
+    QCOMPARE(scanner.finish(), XmlRpcResponseScanner::Value);
+    QCOMPARE(scanner.value(), QStringLiteral("1234"));
+
+    const QByteArray fault(faultResponse);
+    XmlRpcResponseScanner faultScanner;
+    for (int i = 0; i < fault.size(); i += 7) {
+        faultScanner.addData(fault.mid(i, 7));
+    }
+    QCOMPARE(faultScanner.finish(), XmlRpcResponseScanner::Fault);
+    QCOMPARE(faultScanner.faultCode(), 403);
+}
+
+void testXmlRpcResponseScanner::testStopsEarly()
+{
+    const QByteArray data(valueResponse);
+    const int end = data.indexOf("</value>") + 8;
+    XmlRpcResponseScanner scanner;
+    QCOMPARE(scanner.addData(data.left(end)), XmlRpcResponseScanner::Value);
+    // the rest is not looked at, even if it is garbage
+    QCOMPARE(scanner.addData("</broken"), XmlRpcResponseScanner::Value);
+    QCOMPARE(scanner.bytesAdded(), qint64(end + 8));
+    QCOMPARE(scanner.value(), QStringLiteral("1234"));
+}
+
+void testXmlRpcResponseScanner::testInvalid()
+{
+    XmlRpcResponseScanner truncated;
+    truncated.addData(QByteArray(valueResponse).left(60));
+    QCOMPARE(truncated.state(), XmlRpcResponseScanner::NeedMoreData);
+    QCOMPARE(truncated.finish(), XmlRpcResponseScanner::Invalid);
+
+    XmlRpcResponseScanner html;
+    QCOMPARE(html.addData("<html><body>Error 500</body></html>"), XmlRpcResponseScanner::Invalid);
+    QVERIFY(!html.errorString().isEmpty());
+
+    XmlRpcResponseScanner empty;
+    QCOMPARE(empty.addData("<methodResponse><params></params></methodResponse>"),
+             XmlRpcResponseScanner::Invalid);
+}
+
+QTEST_GUILESS_MAIN(testXmlRpcResponseScanner)
@@ -0,0 +1,119 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QBuffer>
+#include <QTest>
+
+#include "xmlrpcclient_p.h"
+
+using namespace KBlog;
+
+static const char prefix[] = "<value><base64>";
+static const char suffix[] = "</base64></value>";
+
+// the size of the chunks the device encodes at a time
+static const int chunkSize = 3 * 16384;
+
+class testXmlRpcStreamDevice: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testRead_data();
+    void testRead();
+    void testReset();
+};
+
+#include "testxmlrpcstreamdevice.moc"
+
+static QByteArray sourceData(int size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (int i = 0; i < size; ++i) {
+        data[i] = char(i * 7 + i / 251);
+    }
+    return data;
+}
+
+static QByteArray expected(const QByteArray &data)
+{
+    return QByteArray(prefix) + data.toBase64() + suffix;
+}
+
+// reads the whole device @p readSize bytes at a time, or at once if 0
+static QByteArray readAll(QIODevice *device, int readSize)
+{
+    if (readSize == 0) {
+        return device->readAll();
+    }
+    QByteArray result;
+    QByteArray buffer(readSize, Qt::Uninitialized);
+    qint64 count;
+    while ((count = device->read(buffer.data(), readSize)) > 0) {
+        result.append(buffer.constData(), count);
+    }
+    return result;
+}
+
+void testXmlRpcStreamDevice::testRead_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("readSize");
+
+    const QList<int> sizes = QList<int>() << 0 << 1 << 2 << chunkSize - 1
+                                          << chunkSize << chunkSize + 1;
+    const QList<int> readSizes = QList<int>() << 0 << 1 << 2 << 5 << 4096;
+    for (int size : sizes) {
+        for (int readSize : readSizes) {
+            QTest::newRow(QByteArray("size " + QByteArray::number(size) +
+                                     ", read " + QByteArray::number(readSize)).constData())
+                    << size << readSize;
+        }
+    }
+}
+
+void testXmlRpcStreamDevice::testRead()
+{
+    QFETCH(int, size);
+    QFETCH(int, readSize);
+
+    const QByteArray data = sourceData(size);
+    QBuffer source;
+    source.setData(data);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+
+    XmlRpcStreamDevice device(prefix, &source, suffix);
+    // unbuffered, so readData() gets the small sizes as well
+    QVERIFY(device.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+    const QByteArray body = expected(data);
+    QCOMPARE(device.size(), qint64(body.size()));
+    QCOMPARE(readAll(&device, readSize), body);
+}
+
+void testXmlRpcStreamDevice::testReset()
+{
+    const QByteArray data = sourceData(2 * chunkSize + 1);
+    QBuffer source;
+    source.setData(data);
+    QVERIFY(source.open(QIODevice::ReadOnly));
+    // the device starts at the current position of the source
+    QVERIFY(source.seek(2));
+
+    XmlRpcStreamDevice device(prefix, &source, suffix);
+    QVERIFY(device.open(QIODevice::ReadOnly | QIODevice::Unbuffered));
+    const QByteArray body = expected(data.mid(2));
+    QCOMPARE(device.size(), qint64(body.size()));
+
+    // stop in the middle of the second chunk
+    QCOMPARE(device.read(body.size() / 2), body.left(body.size() / 2));
+    QVERIFY(device.reset());
+    QCOMPARE(readAll(&device, 1000), body);
+    QVERIFY(device.reset());
+    QCOMPARE(readAll(&device, 0), body);
+}
+
+QTEST_GUILESS_MAIN(testXmlRpcStreamDevice)
@@ -0,0 +1,135 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QTest>
+
+#include "atomentryencoder_p.h"
+#include "kblog/blogpost.h"
+
+using namespace KBlog;
+
+class benchmarkAtomEncoder: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkConcatenation_data();
+    void benchmarkConcatenation();
+    void benchmarkEncoder_data();
+    void benchmarkEncoder();
+    void reportThroughput();
+};
+
+#include "benchmarkatomencoder.moc"
+
+static BlogPost largePost(int contentSize, int tagCount)
+{
+    BlogPost post(QStringLiteral("1"));
+    post.setTitle(QStringLiteral("A large post & its <tags>"));
+    QString content;
+    content.reserve(contentSize);
+    while (content.size() < contentSize) {
+        content += QStringLiteral("<p>Lorem ipsum dolor sit amet, consectetur &amp; adipiscing elit.</p>\n");
+    }
+    post.setContent(content);
+    QStringList tags;
+    for (int i = 0; i < tagCount; ++i) {
+        tags << QStringLiteral("tag number %1").arg(i);
+    }
+    post.setTags(tags);
+    return post;
+}
+
+// what GData::createPost() did before, without the escaping
+static QByteArray concatenate(const BlogPost &post)
+{
+    QString atomMarkup = QStringLiteral("<entry xmlns='http://www.w3.org/2005/Atom'>");
+    atomMarkup += QStringLiteral("<title type='text'>") + post.title() + QStringLiteral("</title>");
+    atomMarkup += QStringLiteral("<content type='xhtml'>");
+    atomMarkup += QStringLiteral("<div xmlns='http://www.w3.org/1999/xhtml'>");
+    atomMarkup += post.content();
+    atomMarkup += QStringLiteral("</div></content>");
+    const QStringList tags = post.tags();
+    for (const QString &tag : tags) {
+        atomMarkup += QStringLiteral("<category scheme='http://www.blogger.com/atom/ns#' term='") + tag + QStringLiteral("' />");
+    }
+    atomMarkup += QStringLiteral("<author>");
+    atomMarkup += QStringLiteral("<email>") + QStringLiteral("user@example.com") + QStringLiteral("</email>");
+    atomMarkup += QStringLiteral("</author>");
+    atomMarkup += QStringLiteral("</entry>");
+    QByteArray postData;
+    QDataStream stream(&postData, QIODevice::WriteOnly);
+    stream.writeRawData(atomMarkup.toUtf8().constData(), atomMarkup.toUtf8().length());
+    return postData;
+}
+
+static void addPosts()
+{
+    QTest::addColumn<int>("contentSize");
+    QTest::addColumn<int>("tagCount");
+    QTest::newRow("4 KB, 5 tags") << 4 * 1024 << 5;
+    QTest::newRow("1 MB, 200 tags") << 1024 * 1024 << 200;
+    QTest::newRow("8 MB, 1000 tags") << 8 * 1024 * 1024 << 1000;
+}
+
+void benchmarkAtomEncoder::benchmarkConcatenation_data()
+{
+    addPosts();
+}
+
+void benchmarkAtomEncoder::benchmarkConcatenation()
+{
+    QFETCH(int, contentSize);
+    QFETCH(int, tagCount);
+    const BlogPost post = largePost(contentSize, tagCount);
+    QBENCHMARK {
+        concatenate(post);
+    }
+}
+
+void benchmarkAtomEncoder::benchmarkEncoder_data()
+{
+    addPosts();
+}
+
+void benchmarkAtomEncoder::benchmarkEncoder()
+{
+    QFETCH(int, contentSize);
+    QFETCH(int, tagCount);
+    const BlogPost post = largePost(contentSize, tagCount);
+    QBENCHMARK {
+        AtomEntryEncoder::encodePost(post, QString(), QString(), QStringLiteral("user@example.com"));
+    }
+}
+
+void benchmarkAtomEncoder::reportThroughput()
+{
+    const BlogPost post = largePost(8 * 1024 * 1024, 1000);
+    const int runs = 10;
+    QElapsedTimer timer;
+
+    timer.start();
+    qint64 bytes = 0;
+    for (int i = 0; i < runs; ++i) {
+        bytes += concatenate(post).size();
+    }
+    const double concatenation = bytes / 1048576.0 / qMax<qint64>(1, timer.elapsed()) * 1000;
+
+    timer.restart();
+    bytes = 0;
+    for (int i = 0; i < runs; ++i) {
+        bytes += AtomEntryEncoder::encodePost(post, QString(), QString(),
+                                              QStringLiteral("user@example.com")).size();
+    }
+    const double encoder = bytes / 1048576.0 / qMax<qint64>(1, timer.elapsed()) * 1000;
+
+    qInfo("8 MB post with 1000 tags: %.0f MB/s concatenated, %.0f MB/s encoded", concatenation, encoder);
+}
+
+QTEST_GUILESS_MAIN(benchmarkAtomEncoder)
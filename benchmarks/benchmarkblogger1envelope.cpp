@@ -0,0 +1,98 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QRegExp>
+#include <QTest>
+
+#include "blogger1envelope_p.h"
+
+using namespace KBlog;
+
+class benchmarkBlogger1Envelope: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkRegExp_data();
+    void benchmarkRegExp();
+    void benchmarkDecode_data();
+    void benchmarkDecode();
+};
+
+#include "benchmarkblogger1envelope.moc"
+
+static QString envelope(int contentSize)
+{
+    QString content;
+    content.reserve(contentSize);
+    while (content.size() < contentSize) {
+        content += QStringLiteral("<p>Lorem ipsum dolor sit amet, consectetur adipiscing elit.</p>\n");
+    }
+    QStringList categories;
+    for (int i = 0; i < 10; ++i) {
+        categories << QStringLiteral("category %1").arg(i);
+    }
+    return Blogger1Envelope::encode(QStringLiteral("A title"), categories, content);
+}
+
+static void addContents()
+{
+    QTest::addColumn<int>("contentSize");
+    QTest::newRow("4 KB") << 4 * 1024;
+    QTest::newRow("1 MB") << 1024 * 1024;
+    QTest::newRow("8 MB") << 8 * 1024 * 1024;
+}
+
+// what Blogger1Private::readPostFromMap() did before
+static QString decodeWithRegExp(QString contents, QString *title, QStringList *categories)
+{
+    QRegExp titleMatch = QRegExp(QStringLiteral("<title>([^<]*)</title>"));
+    QRegExp categoryMatch = QRegExp(QStringLiteral("<category>([^<]*)</category>"));
+    if (contents.indexOf(titleMatch) != -1) {
+        *title = titleMatch.cap(1);
+    }
+    if (contents.indexOf(categoryMatch) != -1) {
+        *categories = categoryMatch.capturedTexts();
+    }
+    contents.remove(titleMatch);
+    contents.remove(categoryMatch);
+    return contents;
+}
+
+void benchmarkBlogger1Envelope::benchmarkRegExp_data()
+{
+    addContents();
+}
+
+void benchmarkBlogger1Envelope::benchmarkRegExp()
+{
+    QFETCH(int, contentSize);
+    const QString data = envelope(contentSize);
+    QBENCHMARK {
+        QString title;
+        QStringList categories;
+        decodeWithRegExp(data, &title, &categories);
+    }
+}
+
+void benchmarkBlogger1Envelope::benchmarkDecode_data()
+{
+    addContents();
+}
+
+void benchmarkBlogger1Envelope::benchmarkDecode()
+{
+    QFETCH(int, contentSize);
+    const QString data = envelope(contentSize);
+    QBENCHMARK {
+        QString title;
+        QStringList categories;
+        Blogger1Envelope::decode(data, &title, &categories);
+    }
+}
+
+QTEST_GUILESS_MAIN(benchmarkBlogger1Envelope)
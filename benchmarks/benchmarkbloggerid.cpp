@@ -0,0 +1,62 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QRegExp>
+#include <QStringList>
+#include <QTest>
+
+#include "bloggerid_p.h"
+
+using namespace KBlog;
+
+class benchmarkBloggerId: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void benchmarkRegExp();
+    void benchmarkExtractor();
+
+private:
+    QStringList mIds;
+};
+
+#include "benchmarkbloggerid.moc"
+
+void benchmarkBloggerId::initTestCase()
+{
+    // the entry ids of a feed with 10000 posts
+    for (int i = 0; i < 10000; ++i) {
+        mIds << QStringLiteral("tag:blogger.com,1999:blog-4711081542.post-%1").arg(1000000000 + i);
+    }
+}
+
+// what the feed handlers of GData did before
+void benchmarkBloggerId::benchmarkRegExp()
+{
+    QBENCHMARK {
+        for (const QString &id : qAsConst(mIds)) {
+            QRegExp rx(QStringLiteral("post-(\\d+)"));
+            QVERIFY(rx.indexIn(id) != -1);
+            QString postId = rx.cap(1);
+        }
+    }
+}
+
+void benchmarkBloggerId::benchmarkExtractor()
+{
+    QBENCHMARK {
+        for (const QString &id : qAsConst(mIds)) {
+            const QStringRef postId = BloggerId::postId(id);
+            QVERIFY(!postId.isNull());
+            QString copy = postId.toString();
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(benchmarkBloggerId)
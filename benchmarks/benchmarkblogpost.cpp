@@ -0,0 +1,102 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QTest>
+
+#include "kblog/blogpost.h"
+
+using namespace KBlog;
+
+static const int postCount = 10000;
+
+class benchmarkBlogPost: public QObject
+{
+    Q_OBJECT
+Q_SIGNALS:
+    void listed(const QList<KBlog::BlogPost> &posts);
+
+private Q_SLOTS:
+    void initTestCase();
+    void benchmarkCopyList();
+    void benchmarkDeepCopyList();
+    void benchmarkQueuedEmit();
+    void benchmarkMoveList();
+
+private:
+    QList<BlogPost> mPosts;
+};
+
+#include "benchmarkblogpost.moc"
+
+void benchmarkBlogPost::initTestCase()
+{
+    qRegisterMetaType<QList<KBlog::BlogPost> >("QList<KBlog::BlogPost>");
+    const QString content = QString(2048, QLatin1Char('x'));
+    for (int i = 0; i < postCount; ++i) {
+        BlogPost post(QString::number(i));
+        post.setTitle(QStringLiteral("Post %1").arg(i));
+        post.setContent(content + QString::number(i));
+        post.setTags(QStringList() << QStringLiteral("kblog") << QStringLiteral("benchmark"));
+        post.setCreationDateTime(QDateTime::currentDateTime());
+        mPosts.append(post);
+    }
+}
+
+void benchmarkBlogPost::benchmarkCopyList()
+{
+    // what every listedRecentPosts() receiver pays now
+    QBENCHMARK {
+        QList<BlogPost> copy;
+        copy.reserve(mPosts.count());
+        for (const BlogPost &post : qAsConst(mPosts)) {
+            copy.append(post);
+        }
+    }
+}
+
+void benchmarkBlogPost::benchmarkDeepCopyList()
+{
+    // what it cost before the posts were shared: a new private per post
+    QBENCHMARK {
+        QList<BlogPost> copy;
+        copy.reserve(mPosts.count());
+        for (const BlogPost &post : qAsConst(mPosts)) {
+            BlogPost deep(post);
+            deep.setStatus(post.status()); // detaches
+            copy.append(deep);
+        }
+    }
+}
+
+void benchmarkBlogPost::benchmarkQueuedEmit()
+{
+    int received = 0;
+    const QMetaObject::Connection connection = connect(this, &benchmarkBlogPost::listed, this, [&received](const QList<KBlog::BlogPost> &posts) {
+        received += posts.count();
+    }, Qt::QueuedConnection);
+    QBENCHMARK {
+        Q_EMIT listed(mPosts);
+        QCoreApplication::processEvents();
+    }
+    disconnect(connection);
+    QVERIFY(received > 0);
+}
+
+void benchmarkBlogPost::benchmarkMoveList()
+{
+    QBENCHMARK {
+        QList<BlogPost> source = mPosts;
+        QList<BlogPost> target;
+        target.reserve(source.count());
+        for (BlogPost &post : source) {
+            target.append(std::move(post));
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(benchmarkBlogPost)
@@ -0,0 +1,140 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QElapsedTimer>
+#include <QTest>
+
+#include "xmlrpcclient_p.h"
+#include "xmlrpcpostdecoder_p.h"
+
+using namespace KBlog;
+
+class benchmarkPostDecoder: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkMaps_data();
+    void benchmarkMaps();
+    void benchmarkDecoder_data();
+    void benchmarkDecoder();
+    void reportPerPost();
+};
+
+#include "benchmarkpostdecoder.moc"
+
+// a getRecentPosts answer of a Movable Type server
+static QByteArray recentPosts(int count)
+{
+    const QByteArray content = QByteArray(1024, 'x');
+    QByteArray data = "<?xml version=\"1.0\"?>\n<methodResponse><params><param><value><array><data>\n";
+    for (int i = 0; i < count; ++i) {
+        const QByteArray id = QByteArray::number(i);
+        data += "<value><struct>\n"
+                "<member><name>dateCreated</name><value><dateTime.iso8601>20260301T10:20:30</dateTime.iso8601></value></member>\n"
+                "<member><name>userid</name><value><string>1</string></value></member>\n"
+                "<member><name>postid</name><value><string>" + id + "</string></value></member>\n"
+                "<member><name>title</name><value><string>Post " + id + "</string></value></member>\n"
+                "<member><name>description</name><value><string>" + content + "</string></value></member>\n"
+                "<member><name>link</name><value><string>http://example.com/" + id + "</string></value></member>\n"
+                "<member><name>permaLink</name><value><string>http://example.com/" + id + "</string></value></member>\n"
+                "<member><name>categories</name><value><array><data><value><string>kblog</string></value></data></array></value></member>\n"
+                "<member><name>mt_excerpt</name><value><string></string></value></member>\n"
+                "<member><name>mt_text_more</name><value><string></string></value></member>\n"
+                "<member><name>mt_allow_comments</name><value><int>1</int></value></member>\n"
+                "<member><name>mt_allow_pings</name><value><int>0</int></value></member>\n"
+                "<member><name>mt_keywords</name><value><string>benchmark</string></value></member>\n"
+                "<member><name>wp_slug</name><value><string>post-" + id + "</string></value></member>\n"
+                "<member><name>post_status</name><value><string>publish</string></value></member>\n"
+                "</struct></value>\n";
+    }
+    data += "</data></array></value></param></params></methodResponse>\n";
+    return data;
+}
+
+static int decodeWithMaps(const QByteArray &data)
+{
+    QList<QVariant> result;
+    int faultCode;
+    QString faultString;
+    XmlRpcClient::parseResponse(data, &result, &faultCode, &faultString);
+    bool ok;
+    return PostFields::fromResult(result.value(0), &ok).count();
+}
+
+static int decodeDirectly(const QByteArray &data)
+{
+    QList<PostFields> posts;
+    bool isList;
+    int faultCode;
+    QString faultString;
+    XmlRpcPostDecoder::decode(data, &posts, &isList, &faultCode, &faultString);
+    return posts.count();
+}
+
+static void addSizes()
+{
+    QTest::addColumn<int>("count");
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+void benchmarkPostDecoder::benchmarkMaps_data()
+{
+    addSizes();
+}
+
+void benchmarkPostDecoder::benchmarkMaps()
+{
+    QFETCH(int, count);
+    const QByteArray data = recentPosts(count);
+    QCOMPARE(decodeWithMaps(data), count);
+    QBENCHMARK {
+        decodeWithMaps(data);
+    }
+}
+
+void benchmarkPostDecoder::benchmarkDecoder_data()
+{
+    addSizes();
+}
+
+void benchmarkPostDecoder::benchmarkDecoder()
+{
+    QFETCH(int, count);
+    const QByteArray data = recentPosts(count);
+    QCOMPARE(decodeDirectly(data), count);
+    QBENCHMARK {
+        decodeDirectly(data);
+    }
+}
+
+void benchmarkPostDecoder::reportPerPost()
+{
+    const int count = 10000;
+    const int runs = 5;
+    const QByteArray data = recentPosts(count);
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int i = 0; i < runs; ++i) {
+        decodeWithMaps(data);
+    }
+    const qint64 maps = timer.nsecsElapsed() / (qint64(runs) * count);
+
+    timer.restart();
+    for (int i = 0; i < runs; ++i) {
+        decodeDirectly(data);
+    }
+    const qint64 direct = timer.nsecsElapsed() / (qint64(runs) * count);
+
+    qInfo("%d posts: %lld ns/post through QVariant maps, %lld ns/post decoded directly",
+          count, maps, direct);
+}
+
+QTEST_GUILESS_MAIN(benchmarkPostDecoder)
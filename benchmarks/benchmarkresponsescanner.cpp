@@ -0,0 +1,118 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QRegExp>
+#include <QTest>
+
+#include "xmlrpcresponsescanner_p.h"
+
+using namespace KBlog;
+
+class benchmarkResponseScanner: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkRegExp_data();
+    void benchmarkRegExp();
+    void benchmarkScanner_data();
+    void benchmarkScanner();
+    void benchmarkScannerChunked_data();
+    void benchmarkScannerChunked();
+};
+
+#include "benchmarkresponsescanner.moc"
+
+static QByteArray valueResponse(int padding)
+{
+    // some servers append debug output or whitespace after the answer
+    return "<?xml version=\"1.0\"?>\n<methodResponse><params><param><value><string>4711</string>"
+           "</value></param></params></methodResponse>\n" + QByteArray(padding, ' ');
+}
+
+static QByteArray faultResponse(int length)
+{
+    return "<?xml version=\"1.0\"?>\n<methodResponse><fault><value><struct>"
+           "<member><name>faultCode</name><value><int>500</int></value></member>"
+           "<member><name>faultString</name><value><string>" + QByteArray(length, 'x') +
+           "</string></value></member></struct></value></fault></methodResponse>\n";
+}
+
+static void addResponses()
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::newRow("value") << valueResponse(0);
+    QTest::newRow("value, 1 MB trailer") << valueResponse(1024 * 1024);
+    QTest::newRow("fault") << faultResponse(64);
+    QTest::newRow("fault, 1 MB message") << faultResponse(1024 * 1024);
+}
+
+// what slotCreatePost() did before
+static QString scanWithRegExp(const QByteArray &response)
+{
+    const QString data = QString::fromUtf8(response.constData(), response.size());
+    QRegExp rxError(QStringLiteral("faultString"));
+    if (rxError.indexIn(data) != -1) {
+        rxError = QRegExp(QStringLiteral("<string>(.+)</string>"));
+        rxError.indexIn(data);
+        return rxError.cap(1);
+    }
+    QRegExp rxId(QStringLiteral("<string>(.+)</string>"));
+    rxId.indexIn(data);
+    return rxId.cap(1);
+}
+
+void benchmarkResponseScanner::benchmarkRegExp_data()
+{
+    addResponses();
+}
+
+void benchmarkResponseScanner::benchmarkRegExp()
+{
+    QFETCH(QByteArray, data);
+    QBENCHMARK {
+        scanWithRegExp(data);
+    }
+}
+
+void benchmarkResponseScanner::benchmarkScanner_data()
+{
+    addResponses();
+}
+
+void benchmarkResponseScanner::benchmarkScanner()
+{
+    QFETCH(QByteArray, data);
+    QBENCHMARK {
+        XmlRpcResponseScanner scanner;
+        scanner.addData(data);
+        QVERIFY(scanner.finish() != XmlRpcResponseScanner::Invalid);
+    }
+}
+
+void benchmarkResponseScanner::benchmarkScannerChunked_data()
+{
+    addResponses();
+}
+
+void benchmarkResponseScanner::benchmarkScannerChunked()
+{
+    // as the data arrives from the network
+    QFETCH(QByteArray, data);
+    const int chunkSize = 16 * 1024;
+    QBENCHMARK {
+        XmlRpcResponseScanner scanner;
+        for (int i = 0; i < data.size(); i += chunkSize) {
+            if (scanner.addData(data.mid(i, chunkSize)) != XmlRpcResponseScanner::NeedMoreData) {
+                break;
+            }
+        }
+        QVERIFY(scanner.finish() != XmlRpcResponseScanner::Invalid);
+    }
+}
+
+QTEST_GUILESS_MAIN(benchmarkResponseScanner)
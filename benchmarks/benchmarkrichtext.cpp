@@ -0,0 +1,95 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include <QRegExp>
+#include <QTest>
+
+#include "kblog/blogpost.h"
+
+using namespace KBlog;
+
+class benchmarkRichText: public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void benchmarkRegExp_data();
+    void benchmarkRegExp();
+    void benchmarkJournal_data();
+    void benchmarkJournal();
+};
+
+#include "benchmarkrichtext.moc"
+
+// a rich text journal description as written by the editors
+static QString richText(int paragraphs)
+{
+    QString text = QStringLiteral("<!DOCTYPE HTML PUBLIC \"-//W3C//DTD HTML 4.0//EN\">"
+                                  "<html><head><meta name=\"qrichtext\" content=\"1\" /></head>"
+                                  "<body style=\"font-family:'Sans'; font-size:10pt;\">\n");
+    for (int i = 0; i < paragraphs; ++i) {
+        text += QStringLiteral("<p style=\"margin-top:0px; margin-bottom:0px; -qt-block-indent:0;\">"
+                               "Lorem ipsum dolor sit amet, <b>consectetur</b> adipiscing elit.</p>\n");
+    }
+    text += QStringLiteral("</body></html>");
+    return text;
+}
+
+static void addJournals()
+{
+    QTest::addColumn<int>("paragraphs");
+    QTest::newRow("10 paragraphs") << 10;
+    QTest::newRow("1000 paragraphs") << 1000;
+    QTest::newRow("50000 paragraphs") << 50000;
+}
+
+// what BlogPost::BlogPost( journal ) did before, with the body check fixed
+static QString cleanWithRegExp(QString richText)
+{
+    QRegExp getBodyContents(QStringLiteral("<body[^>]*>(.*)</body>"));
+    if (getBodyContents.indexIn(richText) != -1) {
+        richText = getBodyContents.cap(1);
+        richText.remove(QRegExp(QStringLiteral("^\\s+")));
+    }
+    richText.replace(QRegExp(QStringLiteral("<p style=\"[^\"]*\">")), QStringLiteral("<p>"));
+    if (richText == QLatin1String("<p></p>")) {
+        richText.clear();
+    }
+    return richText;
+}
+
+void benchmarkRichText::benchmarkRegExp_data()
+{
+    addJournals();
+}
+
+void benchmarkRichText::benchmarkRegExp()
+{
+    QFETCH(int, paragraphs);
+    const QString text = richText(paragraphs);
+    QBENCHMARK {
+        cleanWithRegExp(text);
+    }
+}
+
+void benchmarkRichText::benchmarkJournal_data()
+{
+    addJournals();
+}
+
+void benchmarkRichText::benchmarkJournal()
+{
+    QFETCH(int, paragraphs);
+    KCalendarCore::Journal::Ptr journal(new KCalendarCore::Journal);
+    journal->setDescription(richText(paragraphs), true);
+    QCOMPARE(BlogPost(journal).content(), cleanWithRegExp(journal->description()));
+    QBENCHMARK {
+        BlogPost post(journal);
+    }
+}
+
+QTEST_GUILESS_MAIN(benchmarkRichText)
@@ -0,0 +1,222 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "mockblogserver.h"
+
+#include "kblog/blogger1.h"
+#include "kblog/blogpost.h"
+#include "kblog/gdata.h"
+#include "kblog/metaweblog.h"
+#include "kblog/movabletype.h"
+#include "kblog/transport.h"
+#include "kblog/transportjob.h"
+#include "kblog/wordpressbuggy.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <QTimer>
+
+#include <algorithm>
+#include <functional>
+
+using namespace KBlog;
+
+/**
+  Sends every request to the mock server, whatever host the backend asks
+  for. GData has its hosts hard coded.
+*/
+class MockTransport : public Transport
+{
+public:
+    explicit MockTransport(MockBlogServer *server) : mServer(server)
+    {
+    }
+
+protected:
+    void startJob(TransportJob *job) override
+    {
+        QUrl url = job->url();
+        url.setScheme(QStringLiteral("http"));
+        url.setHost(QStringLiteral("127.0.0.1"));
+        url.setPort(mServer->serverPort());
+        job->setUrl(url);
+        Transport::startJob(job);
+    }
+
+private:
+    MockBlogServer *mServer;
+};
+
+struct Operation {
+    QString mName;
+    const char *mSignal;
+    std::function<void(Blog *, BlogPost *)> mRun;
+};
+
+struct Result {
+    QList<qint64> mLatencies; // in microseconds
+    qint64 mElapsed = 0;      // in microseconds
+    quint64 mBytes = 0;
+    int mFailures = 0;
+};
+
+static Result run(Blog *blog, MockBlogServer *server, const Operation &operation, int iterations)
+{
+    Result result;
+    int failures = 0;
+    QEventLoop loop;
+    QObject::connect(blog, operation.mSignal, &loop, SLOT(quit()));
+    QObject::connect(blog, &Blog::error, &loop, [&loop, &failures]() {
+        ++failures;
+        loop.quit();
+    });
+    QObject::connect(blog, &Blog::errorPost, &loop, [&loop, &failures]() {
+        ++failures;
+        loop.quit();
+    });
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, [&loop, &failures]() {
+        ++failures;
+        loop.quit();
+    });
+
+    server->resetStatistics();
+    QElapsedTimer total;
+    total.start();
+    for (int i = 0; i < iterations; ++i) {
+        BlogPost post;
+        post.setPostId(QStringLiteral("1"));
+        post.setTitle(QStringLiteral("Benchmark"));
+        post.setContent(QStringLiteral("Benchmark post %1").arg(i));
+        QElapsedTimer latency;
+        latency.start();
+        timeout.start(10000 + server->latency() * 10);
+        operation.mRun(blog, &post);
+        loop.exec();
+        result.mLatencies.append(latency.nsecsElapsed() / 1000);
+    }
+    result.mElapsed = total.nsecsElapsed() / 1000;
+    result.mBytes = server->bytesReceived() + server->bytesSent();
+    result.mFailures = failures;
+    std::sort(result.mLatencies.begin(), result.mLatencies.end());
+    return result;
+}
+
+static double percentile(const QList<qint64> &sorted, double p)
+{
+    if (sorted.isEmpty()) {
+        return 0;
+    }
+    const int index = qBound(0, int(p * sorted.count() + 0.5) - 1, sorted.count() - 1);
+    return sorted.at(index) / 1000.0;
+}
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("kblog-benchmark"));
+    // keep the GData token and sync state away from the user's data
+    QStandardPaths::setTestModeEnabled(true);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Measures KBlog against an in-process mock blog server."));
+    parser.addHelpOption();
+    QCommandLineOption iterationsOption(QStringLiteral("iterations"),
+                                        QStringLiteral("Number of runs of every operation."),
+                                        QStringLiteral("n"), QStringLiteral("100"));
+    QCommandLineOption latencyOption(QStringLiteral("latency"),
+                                     QStringLiteral("Delay of every server answer in milliseconds."),
+                                     QStringLiteral("msecs"), QStringLiteral("0"));
+    QCommandLineOption payloadOption(QStringLiteral("payload"),
+                                     QStringLiteral("Size of the content of every post in bytes."),
+                                     QStringLiteral("bytes"), QStringLiteral("1024"));
+    QCommandLineOption postsOption(QStringLiteral("posts"),
+                                   QStringLiteral("Number of posts listed by the server."),
+                                   QStringLiteral("n"), QStringLiteral("20"));
+    QCommandLineOption backendOption(QStringLiteral("backend"),
+                                     QStringLiteral("Only run this backend, may be given more than once."),
+                                     QStringLiteral("name"));
+    parser.addOption(iterationsOption);
+    parser.addOption(latencyOption);
+    parser.addOption(payloadOption);
+    parser.addOption(postsOption);
+    parser.addOption(backendOption);
+    parser.process(app);
+
+    const int iterations = qMax(1, parser.value(iterationsOption).toInt());
+    MockBlogServer server;
+    server.setLatency(parser.value(latencyOption).toInt());
+    server.setPayloadSize(parser.value(payloadOption).toInt());
+    server.setPostCount(parser.value(postsOption).toInt());
+    if (!server.listen(QHostAddress::LocalHost)) {
+        qCritical() << "Cannot start the mock server:" << server.errorString();
+        return 1;
+    }
+    const int posts = server.postCount();
+
+    const QList<Operation> operations = {
+        { QStringLiteral("listRecentPosts"), SIGNAL(listedRecentPosts(QList<KBlog::BlogPost>)),
+          [posts](Blog *blog, BlogPost *) { blog->listRecentPosts(posts); } },
+        { QStringLiteral("fetchPost"), SIGNAL(fetchedPost(KBlog::BlogPost*)),
+          [](Blog *blog, BlogPost *post) { blog->fetchPost(post); } },
+        { QStringLiteral("createPost"), SIGNAL(createdPost(KBlog::BlogPost*)),
+          [](Blog *blog, BlogPost *post) { blog->createPost(post); } },
+        { QStringLiteral("modifyPost"), SIGNAL(modifiedPost(KBlog::BlogPost*)),
+          [](Blog *blog, BlogPost *post) { blog->modifyPost(post); } },
+        { QStringLiteral("removePost"), SIGNAL(removedPost(KBlog::BlogPost*)),
+          [](Blog *blog, BlogPost *post) { blog->removePost(post); } },
+    };
+
+    MockTransport transport(&server);
+    QList<Blog *> blogs;
+    blogs << new Blogger1(server.xmlRpcUrl())
+          << new MetaWeblog(server.xmlRpcUrl())
+          << new MovableType(server.xmlRpcUrl())
+          << new WordpressBuggy(server.xmlRpcUrl())
+          << new GData(server.blogUrl());
+    const QStringList backends = parser.values(backendOption);
+
+    QTextStream out(stdout);
+    out << QStringLiteral("%1 iterations, %2 ms latency, %3 byte posts, %4 posts per list\n\n")
+        .arg(iterations).arg(server.latency()).arg(server.payloadSize()).arg(posts);
+    out << QStringLiteral("%1 %2 %3 %4 %5 %6 %7 %8\n")
+        .arg(QStringLiteral("backend"), -24).arg(QStringLiteral("operation"), -16)
+        .arg(QStringLiteral("ops/s"), 10).arg(QStringLiteral("p50 ms"), 9)
+        .arg(QStringLiteral("p90 ms"), 9).arg(QStringLiteral("p99 ms"), 9)
+        .arg(QStringLiteral("bytes/op"), 10).arg(QStringLiteral("failed"), 7);
+
+    for (Blog *blog : qAsConst(blogs)) {
+        if (!backends.isEmpty() && !backends.contains(QLatin1String(blog->metaObject()->className()).mid(7))) {
+            continue;
+        }
+        blog->setTransport(&transport);
+        blog->setBlogId(QStringLiteral("1"));
+        blog->setUsername(QStringLiteral("mock"));
+        blog->setPassword(QStringLiteral("mock"));
+        for (const Operation &operation : operations) {
+            const Result result = run(blog, &server, operation, iterations);
+            out << QStringLiteral("%1 %2 %3 %4 %5 %6 %7 %8\n")
+                .arg(QLatin1String(blog->metaObject()->className()), -24).arg(operation.mName, -16)
+                .arg(iterations * 1000000.0 / qMax<qint64>(1, result.mElapsed), 10, 'f', 1)
+                .arg(percentile(result.mLatencies, 0.5), 9, 'f', 2)
+                .arg(percentile(result.mLatencies, 0.9), 9, 'f', 2)
+                .arg(percentile(result.mLatencies, 0.99), 9, 'f', 2)
+                .arg(result.mBytes / iterations, 10)
+                .arg(result.mFailures, 7);
+            out.flush();
+        }
+    }
+    qDeleteAll(blogs);
+    return 0;
+}
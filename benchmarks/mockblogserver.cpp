@@ -0,0 +1,417 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "mockblogserver.h"
+
+#include <QDateTime>
+#include <QRegExp>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUrlQuery>
+
+static const char dateFormat[] = "yyyyMMddTHH:mm:ss";
+static const char atomDateFormat[] = "yyyy-MM-ddTHH:mm:ssZ";
+
+static QByteArray member(const QByteArray &name, const QByteArray &value)
+{
+    return "<member><name>" + name + "</name>" + value + "</member>";
+}
+
+static QByteArray string(const QByteArray &value)
+{
+    return "<value><string>" + value + "</string></value>";
+}
+
+static QByteArray integer(int value)
+{
+    return "<value><int>" + QByteArray::number(value) + "</int></value>";
+}
+
+static QByteArray boolean(bool value)
+{
+    return value ? "<value><boolean>1</boolean></value>" : "<value><boolean>0</boolean></value>";
+}
+
+static QByteArray dateTime(const QDateTime &dt)
+{
+    return "<value><dateTime.iso8601>" + dt.toString(QLatin1String(dateFormat)).toLatin1() +
+           "</dateTime.iso8601></value>";
+}
+
+static QByteArray structure(const QByteArray &members)
+{
+    return "<value><struct>" + members + "</struct></value>";
+}
+
+static QByteArray array(const QByteArray &values)
+{
+    return "<value><array><data>" + values + "</data></array></value>";
+}
+
+static QByteArray response(const QByteArray &value)
+{
+    return "<?xml version=\"1.0\"?>\r\n<methodResponse><params><param>" + value +
+           "</param></params></methodResponse>";
+}
+
+static QByteArray fault(int code, const QByteArray &string)
+{
+    return "<?xml version=\"1.0\"?>\r\n<methodResponse><fault><value><struct>" +
+           member("faultCode", integer(code)) + member("faultString", ::string(string)) +
+           "</struct></value></fault></methodResponse>";
+}
+
+static QDateTime postDateTime(int postId)
+{
+    // newest first: post 1 is the most recent one
+    return QDateTime(QDate(2026, 1, 1), QTime(12, 0), Qt::UTC).addSecs(-3600 * postId);
+}
+
+MockBlogServer::MockBlogServer(QObject *parent)
+    : QTcpServer(parent), mLatency(0), mPayloadSize(1024), mPostCount(20),
+      mNextPostId(1000), mRequestCount(0), mBytesReceived(0), mBytesSent(0)
+{
+}
+
+QUrl MockBlogServer::xmlRpcUrl() const
+{
+    QUrl url(QStringLiteral("http://127.0.0.1/xmlrpc"));
+    url.setPort(serverPort());
+    return url;
+}
+
+QUrl MockBlogServer::blogUrl() const
+{
+    QUrl url(QStringLiteral("http://127.0.0.1/"));
+    url.setPort(serverPort());
+    return url;
+}
+
+int MockBlogServer::latency() const
+{
+    return mLatency;
+}
+
+void MockBlogServer::setLatency(int msecs)
+{
+    mLatency = qMax(0, msecs);
+}
+
+int MockBlogServer::payloadSize() const
+{
+    return mPayloadSize;
+}
+
+void MockBlogServer::setPayloadSize(int bytes)
+{
+    mPayloadSize = qMax(0, bytes);
+}
+
+int MockBlogServer::postCount() const
+{
+    return mPostCount;
+}
+
+void MockBlogServer::setPostCount(int count)
+{
+    mPostCount = qMax(1, count);
+}
+
+quint64 MockBlogServer::requestCount() const
+{
+    return mRequestCount;
+}
+
+quint64 MockBlogServer::bytesReceived() const
+{
+    return mBytesReceived;
+}
+
+quint64 MockBlogServer::bytesSent() const
+{
+    return mBytesSent;
+}
+
+void MockBlogServer::resetStatistics()
+{
+    mRequestCount = 0;
+    mBytesReceived = 0;
+    mBytesSent = 0;
+}
+
+void MockBlogServer::incomingConnection(qintptr handle)
+{
+    QTcpSocket *socket = new QTcpSocket(this);
+    socket->setSocketDescriptor(handle);
+    connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+        readRequests(socket);
+    });
+    connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+}
+
+void MockBlogServer::readRequests(QTcpSocket *socket)
+{
+    const QByteArray data = socket->readAll();
+    mBytesReceived += data.size();
+    QByteArray buffer = socket->property("buffer").toByteArray() + data;
+
+    Q_FOREVER {
+        const int end = buffer.indexOf("\r\n\r\n");
+        if (end < 0) {
+            break;
+        }
+        Request request;
+        const QList<QByteArray> lines = buffer.left(end).split('\n');
+        const QList<QByteArray> requestLine = lines.value(0).trimmed().split(' ');
+        request.mMethod = requestLine.value(0);
+        request.mPath = requestLine.value(1);
+        for (int i = 1; i < lines.count(); ++i) {
+            const int colon = lines.at(i).indexOf(':');
+            if (colon > 0) {
+                request.mHeaders.insert(lines.at(i).left(colon).trimmed().toLower(),
+                                        lines.at(i).mid(colon + 1).trimmed());
+            }
+        }
+        const int length = request.mHeaders.value("content-length").toInt();
+        if (buffer.size() < end + 4 + length) {
+            break;
+        }
+        request.mBody = buffer.mid(end + 4, length);
+        buffer.remove(0, end + 4 + length);
+        ++mRequestCount;
+        respond(socket, request);
+    }
+    socket->setProperty("buffer", buffer);
+}
+
+void MockBlogServer::respond(QTcpSocket *socket, const Request &request)
+{
+    int status = 200;
+    QByteArray body;
+    QByteArray contentType;
+    const QByteArray path = request.mPath.left(request.mPath.indexOf('?'));
+    if (path == "/xmlrpc") {
+        body = answerXmlRpc(request.mBody);
+        contentType = "text/xml";
+    } else {
+        body = answerGData(request, &status);
+        contentType = path.startsWith("/feeds/") ? "application/atom+xml" : "text/html";
+    }
+
+    QByteArray reply = "HTTP/1.1 " + QByteArray::number(status) +
+                       (status == 201 ? " Created" : status == 200 ? " OK" : " Not Found") + "\r\n";
+    reply += "Content-Type: " + contentType + "; charset=UTF-8\r\n";
+    reply += "Content-Length: " + QByteArray::number(body.size()) + "\r\n\r\n";
+    reply += body;
+    mBytesSent += reply.size();
+
+    // the socket is the context, so nothing is written after it is gone;
+    // timers of the same interval fire in order, the answers stay in order
+    QTimer::singleShot(mLatency, socket, [socket, reply]() {
+        socket->write(reply);
+    });
+}
+
+QByteArray MockBlogServer::content(int postId) const
+{
+    static const QByteArray words("Lorem ipsum dolor sit amet, consectetur adipiscing elit. ");
+    QByteArray text = "Post " + QByteArray::number(postId) + ". ";
+    text.reserve(mPayloadSize);
+    while (text.size() < mPayloadSize) {
+        text += words;
+    }
+    text.truncate(mPayloadSize);
+    return text;
+}
+
+QByteArray MockBlogServer::answerXmlRpc(const QByteArray &body)
+{
+    QRegExp rxMethod(QStringLiteral("<methodName>([^<]+)</methodName>"));
+    if (rxMethod.indexIn(QString::fromUtf8(body)) == -1) {
+        return fault(-32700, "parse error. not well formed");
+    }
+    const QString method = rxMethod.cap(1).trimmed();
+
+    if (method == QLatin1String("blogger.getUsersBlogs")) {
+        return response(array(structure(member("blogid", string("1")) +
+                                        member("blogName", string("Mock Blog")) +
+                                        member("url", string(blogUrl().toEncoded())))));
+    }
+    if (method == QLatin1String("blogger.getUserInfo")) {
+        return response(structure(member("nickname", string("mock")) +
+                                  member("userid", string("1")) +
+                                  member("url", string(blogUrl().toEncoded())) +
+                                  member("email", string("mock@example.com")) +
+                                  member("lastname", string("Blog")) +
+                                  member("firstname", string("Mock"))));
+    }
+
+    // Blogger 1.0 and MetaWeblog describe posts with different keys
+    const bool blogger = method.startsWith(QLatin1String("blogger."));
+    auto post = [this, blogger](int postId) {
+        const QDateTime dt = postDateTime(postId);
+        if (blogger) {
+            return structure(member("postid", string(QByteArray::number(postId))) +
+                             member("userid", string("1")) +
+                             member("dateCreated", dateTime(dt)) +
+                             member("content", string(content(postId))));
+        }
+        return structure(member("postid", string(QByteArray::number(postId))) +
+                         member("title", string("Post " + QByteArray::number(postId))) +
+                         member("description", string(content(postId))) +
+                         member("dateCreated", dateTime(dt)) +
+                         member("lastModified", dateTime(dt)) +
+                         member("categories", array(string("News"))) +
+                         member("mt_keywords", string("mock")) +
+                         member("mt_allow_comments", integer(1)) +
+                         member("mt_allow_pings", integer(1)) +
+                         member("link", string(blogUrl().toEncoded() + QByteArray::number(postId))) +
+                         member("permaLink", string(blogUrl().toEncoded() + QByteArray::number(postId))) +
+                         member("post_status", string("publish")));
+    };
+
+    if (method == QLatin1String("blogger.getRecentPosts") ||
+            method == QLatin1String("metaWeblog.getRecentPosts")) {
+        QRegExp rxNumber(QStringLiteral("<int>(\\d+)</int>"));
+        int number = mPostCount;
+        if (rxNumber.lastIndexIn(QString::fromUtf8(body)) != -1) {
+            number = qMin(number, rxNumber.cap(1).toInt());
+        }
+        QByteArray posts;
+        for (int i = 1; i <= number; ++i) {
+            posts += post(i);
+        }
+        return response(array(posts));
+    }
+    if (method == QLatin1String("blogger.getPost") ||
+            method == QLatin1String("metaWeblog.getPost")) {
+        QRegExp rxId(QStringLiteral("<string>(\\d+)</string>"));
+        int postId = 1;
+        if (rxId.indexIn(QString::fromUtf8(body)) != -1) {
+            postId = rxId.cap(1).toInt();
+        }
+        return response(post(postId));
+    }
+    if (method == QLatin1String("wp.getPosts")) {
+        QRegExp rxNumber(QStringLiteral("<name>number</name>\\s*<value><int>(\\d+)</int>"));
+        QRegExp rxOffset(QStringLiteral("<name>offset</name>\\s*<value><int>(\\d+)</int>"));
+        const QString request = QString::fromUtf8(body);
+        const int number = rxNumber.indexIn(request) != -1 ? rxNumber.cap(1).toInt() : 10;
+        const int offset = rxOffset.indexIn(request) != -1 ? rxOffset.cap(1).toInt() : 0;
+        QByteArray posts;
+        for (int i = offset + 1; i <= qMin(mPostCount, offset + number); ++i) {
+            const QByteArray dt = postDateTime(i).toString(QLatin1String(dateFormat)).toLatin1();
+            const QByteArray term = structure(member("taxonomy", string("category")) +
+                                              member("name", string("News")));
+            posts += structure(member("post_id", string(QByteArray::number(i))) +
+                               member("post_title", string("Post " + QByteArray::number(i))) +
+                               member("post_content", string(content(i))) +
+                               member("post_date_gmt", "<value><dateTime.iso8601>" + dt + "</dateTime.iso8601></value>") +
+                               member("post_modified_gmt", "<value><dateTime.iso8601>" + dt + "</dateTime.iso8601></value>") +
+                               member("post_status", string("publish")) +
+                               member("comment_status", string("open")) +
+                               member("ping_status", string("open")) +
+                               member("link", string(blogUrl().toEncoded() + QByteArray::number(i))) +
+                               member("terms", array(term)));
+        }
+        return response(array(posts));
+    }
+    if (method == QLatin1String("blogger.newPost") ||
+            method == QLatin1String("metaWeblog.newPost")) {
+        return response(string(QByteArray::number(++mNextPostId)));
+    }
+    if (method == QLatin1String("metaWeblog.getCategories") ||
+            method == QLatin1String("mt.getCategoryList")) {
+        QByteArray categories;
+        const char *names[] = { "News", "Travel", "Food" };
+        for (int i = 0; i < 3; ++i) {
+            categories += structure(member("categoryId", string(QByteArray::number(i + 1))) +
+                                    member("categoryName", string(names[i])) +
+                                    member("description", string(names[i])) +
+                                    member("htmlUrl", string(blogUrl().toEncoded())) +
+                                    member("rssUrl", string(blogUrl().toEncoded())));
+        }
+        return response(array(categories));
+    }
+    if (method == QLatin1String("mt.getPostCategories")) {
+        return response(array(structure(member("categoryId", string("1")) +
+                                        member("categoryName", string("News")) +
+                                        member("isPrimary", boolean(true)))));
+    }
+    if (method == QLatin1String("mt.getTrackbackPings")) {
+        return response(array(QByteArray()));
+    }
+    if (method == QLatin1String("metaWeblog.newMediaObject")) {
+        return response(structure(member("url", string(blogUrl().toEncoded() + "media"))));
+    }
+    if (method == QLatin1String("blogger.editPost") ||
+            method == QLatin1String("blogger.deletePost") ||
+            method == QLatin1String("metaWeblog.editPost") ||
+            method == QLatin1String("mt.setPostCategories") ||
+            method == QLatin1String("mt.publishPost")) {
+        return response(boolean(true));
+    }
+    return fault(-32601, "server error. requested method " + method.toUtf8() + " does not exist.");
+}
+
+QByteArray MockBlogServer::answerGData(const Request &request, int *status)
+{
+    const QUrl url(QString::fromLatin1(request.mPath));
+    const QString path = url.path();
+    auto entry = [this](int postId) {
+        const QByteArray dt = postDateTime(postId).toString(QLatin1String(atomDateFormat)).toLatin1();
+        return "<entry><id>tag:blogger.com,1999:blog-1.post-" + QByteArray::number(postId) + "</id>"
+               "<published>" + dt + "</published><updated>" + dt + "</updated>"
+               "<category scheme='http://www.blogger.com/atom/ns#' term='mock'/>"
+               "<title type='text'>Post " + QByteArray::number(postId) + "</title>"
+               "<content type='html'>" + content(postId) + "</content>"
+               "<link rel='alternate' type='text/html' href='" + blogUrl().toEncoded() +
+               QByteArray::number(postId) + ".html'/>"
+               "<author><name>Mock</name><email>mock@example.com</email></author></entry>";
+    };
+
+    if (path == QLatin1String("/accounts/ClientLogin")) {
+        return "SID=mock\nLSID=mock\nAuth=mocktoken\n";
+    }
+    if (!path.startsWith(QLatin1String("/feeds/"))) {
+        return "<html><head><title>Mock Blog</title></head><body>"
+               "<a href='http://www.blogger.com/profile/1'>Mock</a></body></html>";
+    }
+
+    if (request.mMethod == "GET") {
+        const QUrlQuery query(url);
+        const int start = qMax(1, query.queryItemValue(QStringLiteral("start-index")).toInt());
+        int number = query.queryItemValue(QStringLiteral("max-results")).toInt();
+        if (number <= 0) {
+            number = mPostCount;
+        }
+        QByteArray feed = "<?xml version='1.0' encoding='UTF-8'?>"
+                          "<feed xmlns='http://www.w3.org/2005/Atom'>"
+                          "<id>tag:blogger.com,1999:blog-1</id>"
+                          "<updated>" + postDateTime(1).toString(QLatin1String(atomDateFormat)).toLatin1() + "</updated>"
+                          "<title type='text'>Mock Blog</title>";
+        if (!path.contains(QLatin1String("/comments/"))) {
+            for (int i = start; i < start + number && i <= mPostCount; ++i) {
+                feed += entry(i);
+            }
+        }
+        feed += "</feed>";
+        return feed;
+    }
+
+    const QByteArray override = request.mHeaders.value("x-http-method-override");
+    if (override == "DELETE") {
+        return QByteArray();
+    }
+    QRegExp rxId(QStringLiteral("/(\\d+)$"));
+    if (override == "PUT" && rxId.indexIn(path) != -1) {
+        return "<?xml version='1.0' encoding='UTF-8'?>" + entry(rxId.cap(1).toInt());
+    }
+    *status = 201;
+    return "<?xml version='1.0' encoding='UTF-8'?>" + entry(++mNextPostId);
+}
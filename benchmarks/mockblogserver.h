@@ -0,0 +1,84 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef MOCKBLOGSERVER_H
+#define MOCKBLOGSERVER_H
+
+#include <QByteArray>
+#include <QMap>
+#include <QTcpServer>
+#include <QUrl>
+
+class QTcpSocket;
+
+/**
+  An in-process HTTP/1.1 server that answers like a blog. It implements
+  the Blogger 1.0, MetaWeblog, Movable Type and WordPress XML-RPC methods
+  used by KBlog on /xmlrpc, and the Blogger Data API Atom feeds,
+  ClientLogin and profile page on every other path.
+
+  Every answer is delayed by latency() to simulate the network, and the
+  size of the posts it sends is set with setPayloadSize().
+*/
+class MockBlogServer : public QTcpServer
+{
+    Q_OBJECT
+public:
+    explicit MockBlogServer(QObject *parent = nullptr);
+
+    /**
+      Returns the URL of the XML-RPC endpoint.
+    */
+    QUrl xmlRpcUrl() const;
+
+    /**
+      Returns the URL of the blog, used by GData for the profile id.
+    */
+    QUrl blogUrl() const;
+
+    int latency() const;
+    void setLatency(int msecs);
+
+    int payloadSize() const;
+    void setPayloadSize(int bytes);
+
+    int postCount() const;
+    void setPostCount(int count);
+
+    quint64 requestCount() const;
+    quint64 bytesReceived() const;
+    quint64 bytesSent() const;
+    void resetStatistics();
+
+protected:
+    void incomingConnection(qintptr handle) override;
+
+private:
+    struct Request {
+        QByteArray mMethod;
+        QByteArray mPath;
+        QMap<QByteArray, QByteArray> mHeaders;
+        QByteArray mBody;
+    };
+
+    void readRequests(QTcpSocket *socket);
+    void respond(QTcpSocket *socket, const Request &request);
+    QByteArray answerXmlRpc(const QByteArray &body);
+    QByteArray answerGData(const Request &request, int *status);
+    QByteArray content(int postId) const;
+
+    int mLatency;
+    int mPayloadSize;
+    int mPostCount;
+    int mNextPostId;
+    quint64 mRequestCount;
+    quint64 mBytesReceived;
+    quint64 mBytesSent;
+};
+
+#endif
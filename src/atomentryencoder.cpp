@@ -0,0 +1,100 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "atomentryencoder_p.h"
+#include "blogcomment.h"
+#include "blogpost.h"
+#include "utf8xmlwriter_p.h"
+
+#include <QDateTime>
+#include <QStringList>
+
+using namespace KBlog;
+
+// room for the markup around the strings and a few escaped characters
+static const int markupSize = 512;
+static const int categorySize = 80;
+
+static QByteArray atomDateTime(const QDateTime &dateTime)
+{
+    return dateTime.toUTC().toString(Qt::ISODate).toLatin1();
+}
+
+QByteArray AtomEntryEncoder::encodePost(const BlogPost &post, const QString &blogId,
+                                        const QString &authorName, const QString &authorEmail)
+{
+    const QString title = post.title();
+    const QString content = post.content();
+    const QStringList tags = post.tags();
+    int capacity = markupSize + title.size() + content.size() + authorName.size() +
+                   authorEmail.size();
+    for (const QString &tag : tags) {
+        capacity += categorySize + tag.size();
+    }
+    // escaped markup usually grows a little
+    capacity += content.size() / 8;
+
+    Utf8XmlWriter writer(capacity);
+    writer.writeMarkup("<entry xmlns='http://www.w3.org/2005/Atom'>");
+    if (!blogId.isEmpty()) {
+        writer.writeMarkup("<id>tag:blogger.com,1999:blog-");
+        writer.writeText(blogId);
+        writer.writeMarkup(".post-");
+        writer.writeText(post.postId());
+        writer.writeMarkup("</id><published>");
+        writer.writeMarkup(atomDateTime(post.creationDateTime()));
+        writer.writeMarkup("</published><updated>");
+        writer.writeMarkup(atomDateTime(post.modificationDateTime()));
+        writer.writeMarkup("</updated>");
+    }
+    writer.writeMarkup("<title type='text'>");
+    writer.writeText(title);
+    writer.writeMarkup("</title>");
+    if (post.isPrivate()) {
+        writer.writeMarkup("<app:control xmlns:app='http://purl.org/atom/app#'>"
+                           "<app:draft>yes</app:draft></app:control>");
+    }
+    writer.writeMarkup("<content type='html'>");
+    writer.writeText(content);
+    writer.writeMarkup("</content>");
+    for (const QString &tag : tags) {
+        writer.writeMarkup("<category scheme='http://www.blogger.com/atom/ns#' term='");
+        writer.writeAttribute(tag);
+        writer.writeMarkup("' />");
+    }
+    writer.writeMarkup("<author>");
+    if (!authorName.isEmpty()) {
+        writer.writeMarkup("<name>");
+        writer.writeText(authorName);
+        writer.writeMarkup("</name>");
+    }
+    writer.writeMarkup("<email>");
+    writer.writeText(authorEmail);
+    writer.writeMarkup("</email></author></entry>");
+    return writer.takeData();
+}
+
+QByteArray AtomEntryEncoder::encodeComment(const BlogComment &comment)
+{
+    const QString title = comment.title();
+    const QString content = comment.content();
+    const QString name = comment.name();
+    const QString email = comment.email();
+    Utf8XmlWriter writer(markupSize + title.size() + content.size() + content.size() / 8 +
+                         name.size() + email.size());
+    writer.writeMarkup("<entry xmlns='http://www.w3.org/2005/Atom'><title type=\"text\">");
+    writer.writeText(title);
+    writer.writeMarkup("</title><content type=\"html\">");
+    writer.writeText(content);
+    writer.writeMarkup("</content><author><name>");
+    writer.writeText(name);
+    writer.writeMarkup("</name><email>");
+    writer.writeText(email);
+    writer.writeMarkup("</email></author></entry>");
+    return writer.takeData();
+}
@@ -0,0 +1,46 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_ATOMENTRYENCODER_P_H
+#define KBLOG_ATOMENTRYENCODER_P_H
+
+#include "kblog_private_export.h"
+
+#include <QByteArray>
+#include <QString>
+
+namespace KBlog
+{
+
+class BlogComment;
+class BlogPost;
+
+/**
+  Writes the Atom entries sent by GData as escaped UTF-8 into one
+  buffer, sized up front for the strings of the entry.
+*/
+class KBLOG_TESTS_EXPORT AtomEntryEncoder
+{
+public:
+    /**
+      Returns the entry for @p post. The id and the dates are only
+      written if @p blogId is not empty, i.e. when the post is modified.
+      The content is sent as escaped HTML.
+    */
+    static QByteArray encodePost(const BlogPost &post, const QString &blogId,
+                                 const QString &authorName, const QString &authorEmail);
+
+    /**
+      Returns the entry for @p comment.
+    */
+    static QByteArray encodeComment(const BlogComment &comment);
+};
+
+}
+
+#endif
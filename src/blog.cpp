@@ -12,8 +12,14 @@
 #include "blog_p.h"
 #include "blogpost_p.h"
 #include "blog_config.h"
+#include "transport.h"
+#include "poststore.h"
 
 #include "kblog_debug.h"
+#include <KLocalizedString>
+
+#include <QDateTime>
+#include <QTimer>
 
 using namespace KBlog;
 
@@ -122,7 +128,228 @@ QTimeZone Blog::timeZone()
     return d->mTimeZone;
 }
 
-BlogPrivate::BlogPrivate() : q_ptr(nullptr)
+void Blog::setTransport(Transport *transport)
+{
+    Q_D(Blog);
+    d->mTransport = transport;
+}
+
+Transport *Blog::transport() const
+{
+    Q_D(const Blog);
+    return d->mTransport ? d->mTransport.data() : Transport::self();
+}
+
+void Blog::setRequestPriority(Transport::Priority priority)
+{
+    Q_D(Blog);
+    d->mPriority = priority;
+}
+
+Transport::Priority Blog::requestPriority() const
+{
+    Q_D(const Blog);
+    return d->mPriority;
+}
+
+quint64 Blog::sharedRequests() const
+{
+    Q_D(const Blog);
+    return d->mSharedRequests;
+}
+
+void Blog::setPostStore(PostStore *store)
+{
+    Q_D(Blog);
+    if (store) {
+        // the slots do nothing while no store is set
+        connect(this, SIGNAL(fetchedPost(KBlog::BlogPost*)),
+                this, SLOT(slotStorePost(KBlog::BlogPost*)), Qt::UniqueConnection);
+        connect(this, SIGNAL(createdPost(KBlog::BlogPost*)),
+                this, SLOT(slotStorePost(KBlog::BlogPost*)), Qt::UniqueConnection);
+        connect(this, SIGNAL(modifiedPost(KBlog::BlogPost*)),
+                this, SLOT(slotStorePost(KBlog::BlogPost*)), Qt::UniqueConnection);
+        connect(this, SIGNAL(removedPost(KBlog::BlogPost*)),
+                this, SLOT(slotRemoveStoredPost(KBlog::BlogPost*)), Qt::UniqueConnection);
+        connect(this, SIGNAL(listedRecentPosts(QList<KBlog::BlogPost>)),
+                this, SLOT(slotStorePosts(QList<KBlog::BlogPost>)), Qt::UniqueConnection);
+        connect(this, SIGNAL(listedRecentPostsPage(QList<KBlog::BlogPost>,int,bool)),
+                this, SLOT(slotStorePosts(QList<KBlog::BlogPost>)), Qt::UniqueConnection);
+        connect(this, SIGNAL(syncedPosts(QList<KBlog::BlogPost>,QList<KBlog::BlogPost>,QList<KBlog::BlogPost>)),
+                this, SLOT(slotStoreSyncedPosts(QList<KBlog::BlogPost>,QList<KBlog::BlogPost>,QList<KBlog::BlogPost>)), Qt::UniqueConnection);
+    }
+    d->mPostStore = store;
+}
+
+PostStore *Blog::postStore() const
+{
+    Q_D(const Blog);
+    return d->mPostStore;
+}
+
+void Blog::listRecentPostsPaged(int number, int pageSize)
+{
+    Q_UNUSED(number);
+    Q_UNUSED(pageSize);
+    Q_EMIT error(NotSupported, i18n("Listing posts page by page is not supported by %1.", interfaceName()));
+}
+
+void Blog::stopListingRecentPosts()
+{
+    Q_D(Blog);
+    ++d->mPageGeneration;
+    d->mPageNumber = 0;
+}
+
+void Blog::syncPosts()
+{
+    Q_EMIT error(NotSupported, i18n("Synchronizing posts is not supported by %1.", interfaceName()));
+}
+
+QDateTime Blog::lastSyncDateTime() const
+{
+    Q_D(const Blog);
+    return d->syncState().mHighWaterMark;
+}
+
+void Blog::resetSync()
+{
+    Q_D(Blog);
+    d->syncState().clear();
+}
+
+SyncState &BlogPrivate::syncState() const
+{
+    mSyncState.load(SyncState::fileName(mUrl, mBlogId, mUsername));
+    return mSyncState;
+}
+
+bool BlogPrivate::startSync()
+{
+    if (mSyncing) {
+        qCDebug(KBLOG_LOG) << "Joining the sync which is running already";
+        return false;
+    }
+    mSyncing = true;
+    return true;
+}
+
+void BlogPrivate::finishSync(const QList<BlogPost> &posts, bool complete)
+{
+    Q_Q(Blog);
+    mSyncing = false;
+    QList<BlogPost> created;
+    QList<BlogPost> updated;
+    QList<BlogPost> removed;
+    SyncState &state = syncState();
+    state.apply(posts, complete, &created, &updated, &removed);
+    state.save();
+    qCDebug(KBLOG_LOG) << "Emitting syncedPosts():" << created.count() << "created,"
+                       << updated.count() << "updated," << removed.count() << "removed";
+    Q_EMIT q->syncedPosts(created, updated, removed);
+}
+
+bool BlogPrivate::fetchPostFromStore(BlogPost *post)
+{
+    Q_Q(Blog);
+    if (!mPostStore || mPostStore->maxAge() == 0 || post->postId().isEmpty()) {
+        return false;
+    }
+    QDateTime storedAt;
+    const BlogPost stored = mPostStore->post(*q, post->postId(), &storedAt);
+    if (stored.postId().isEmpty() ||
+            storedAt.secsTo(QDateTime::currentDateTime()) > mPostStore->maxAge()) {
+        return false;
+    }
+    qCDebug(KBLOG_LOG) << "Answering fetchPost() from the post store:" << post->postId();
+    *post = stored;
+    post->setStatus(BlogPost::Fetched);
+    mStoreServed.append(post);
+    QTimer::singleShot(0, q, [q, post]() {
+        Q_EMIT q->fetchedPost(post);
+    });
+    return true;
+}
+
+void BlogPrivate::startPaging(int number, int pageSize)
+{
+    ++mPageGeneration;
+    mPageNumber = qMax(0, number);
+    mPageSize = qMax(1, pageSize);
+    mPageOffset = 0;
+}
+
+int BlogPrivate::nextPageSize() const
+{
+    return qMin(mPageSize, mPageNumber - mPageOffset);
+}
+
+bool BlogPrivate::pageReceived(const QList<BlogPost> &posts, bool last, int skipped)
+{
+    Q_Q(Blog);
+    const int offset = mPageOffset;
+    mPageOffset += posts.count() + skipped;
+    if (mPageOffset >= mPageNumber || posts.count() + skipped == 0) {
+        last = true;
+    }
+    const quint32 generation = mPageGeneration;
+    qCDebug(KBLOG_LOG) << "Emitting listedRecentPostsPage() at" << offset << "last:" << last;
+    Q_EMIT q->listedRecentPostsPage(posts, offset, last);
+    if (last) {
+        if (generation == mPageGeneration) {
+            mPageNumber = 0;
+        }
+        return false;
+    }
+    return generation == mPageGeneration;
+}
+
+void BlogPrivate::slotStorePost(BlogPost *post)
+{
+    Q_Q(Blog);
+    if (mStoreServed.removeOne(post) || !mPostStore || !post) {
+        return;
+    }
+    mPostStore->store(*q, *post);
+}
+
+void BlogPrivate::slotRemoveStoredPost(BlogPost *post)
+{
+    Q_Q(Blog);
+    if (mPostStore && post) {
+        mPostStore->remove(*q, post->postId());
+    }
+}
+
+void BlogPrivate::slotStorePosts(const QList<BlogPost> &posts)
+{
+    Q_Q(Blog);
+    if (!mPostStore) {
+        return;
+    }
+    for (const BlogPost &post : posts) {
+        mPostStore->store(*q, post);
+    }
+}
+
+void BlogPrivate::slotStoreSyncedPosts(const QList<BlogPost> &created,
+                                       const QList<BlogPost> &updated,
+                                       const QList<BlogPost> &removed)
+{
+    Q_Q(Blog);
+    if (!mPostStore) {
+        return;
+    }
+    slotStorePosts(created);
+    slotStorePosts(updated);
+    for (const BlogPost &post : removed) {
+        mPostStore->remove(*q, post.postId());
+    }
+}
+
+BlogPrivate::BlogPrivate() : q_ptr(nullptr), mPriority(Transport::Interactive), mSyncing(false),
+    mPostStore(nullptr),
+    mPageNumber(0), mPageSize(0), mPageOffset(0), mPageGeneration(0), mSharedRequests(0)
 {
 }
 
@@ -130,3 +357,5 @@ BlogPrivate::~BlogPrivate()
 {
     qCDebug(KBLOG_LOG) << "~BlogPrivate()";
 }
+
+#include "moc_blog.cpp"
@@ -12,11 +12,13 @@
 #define KBLOG_BLOG_H
 
 #include <kblog_export.h>
+#include <transport.h>
 
 #include <QObject>
 
 template <class T, class S> class QMap;
 
+class QDateTime;
 class QTimeZone;
 class QUrl;
 
@@ -44,6 +46,7 @@ class BlogPost;
 class BlogComment;
 class BlogMedia;
 class BlogPrivate;
+class PostStore;
 
 /**
   @brief
@@ -190,6 +193,73 @@ public:
     */
     QTimeZone timeZone();
 
+    /**
+      Sets the HTTP transport used for all requests of this object. Blog
+      objects talking to the same server should share one transport so
+      they can reuse its keep-alive connections.
+
+      @param transport the transport, or null for the default transport.
+      The transport is not owned by this object.
+      @see transport()
+      @see Transport::self()
+    */
+    virtual void setTransport(KBlog::Transport *transport);
+
+    /**
+      Returns the HTTP transport used for all requests of this object.
+
+      @see setTransport()
+    */
+    KBlog::Transport *transport() const;
+
+    /**
+      Sets the priority of all requests sent by this object from now on.
+      While a server is busy with the maximum number of requests, the
+      queued interactive requests are sent before all background ones.
+      Use Transport::Background for bulk operations, so the requests the
+      user is waiting for are not held up by them.
+
+      @param priority the priority, defaults to Transport::Interactive.
+      @see requestPriority()
+      @see Transport::setMaxRequestsPerHost()
+    */
+    virtual void setRequestPriority(KBlog::Transport::Priority priority);
+
+    /**
+      Returns the priority of the requests sent by this object.
+
+      @see setRequestPriority()
+    */
+    KBlog::Transport::Priority requestPriority() const;
+
+    /**
+      Returns the number of reads, e.g. fetchPost(), listBlogs() or
+      listCategories(), that were answered by an identical request
+      already in flight instead of a request of their own.
+    */
+    quint64 sharedRequests() const;
+
+    /**
+      Sets the store that keeps a local copy of the posts of this object.
+      Every post that is fetched, listed, synchronized, created or
+      modified is stored, removed posts are removed from it, and
+      fetchPost() is answered from the store while the stored copy is
+      younger than PostStore::maxAge().
+
+      @param store the store, or null to disable storing posts, which is
+      the default. The store is not owned by this object.
+      @see postStore()
+      @see PostStore::self()
+    */
+    void setPostStore(KBlog::PostStore *store);
+
+    /**
+      Returns the store that keeps a local copy of the posts, or null.
+
+      @see setPostStore()
+    */
+    KBlog::PostStore *postStore() const;
+
     /**
       List a number of recent posts from the server.
       The posts are returned in descending chronological order.
@@ -199,6 +269,30 @@ public:
     */
     virtual void listRecentPosts(int number) = 0;
 
+    /**
+      List a number of recent posts from the server page by page. Each
+      page is emitted with listedRecentPostsPage() as soon as it has been
+      received, so the first posts can be used long before the last ones
+      arrive. Only one paged listing runs at a time, starting another one
+      stops the previous one. The default implementation emits error()
+      with NotSupported.
+
+      @param number the number of posts to list.
+      @param pageSize the number of posts per page.
+      @see listedRecentPostsPage()
+      @see stopListingRecentPosts()
+    */
+    virtual void listRecentPostsPaged(int number, int pageSize);
+
+    /**
+      Stops the running listRecentPostsPaged() job. No further pages are
+      emitted. It is safe to call this from a slot connected to
+      listedRecentPostsPage().
+
+      @see listRecentPostsPaged()
+    */
+    void stopListingRecentPosts();
+
     /**
       Fetch a blog post from the server with a specific ID.
       The ID of the existing post must be retrieved using getRecentPosts
@@ -242,7 +336,58 @@ public:
     */
     virtual void removePost(KBlog::BlogPost *post) = 0;
 
+    /**
+      Fetches the posts that have been created, modified or removed since
+      the last call and emits syncedPosts(). The newest modification date
+      seen and a fingerprint of every known post are stored per blog, url
+      and username, so this works across restarts. The first call reports
+      all posts as created.
+
+      Backends that can ask the server for the posts changed after a date
+      only download those, others download the list of recent posts and
+      report only the changed ones. The default implementation emits
+      error() with NotSupported.
+
+      While a sync is running, another call does not start a second one.
+      The running sync emits syncedPosts() once, which answers both calls.
+
+      @see syncedPosts()
+      @see lastSyncDateTime()
+      @see resetSync()
+    */
+    virtual void syncPosts();
+
+    /**
+      Returns the newest modification date seen by syncPosts(), or an
+      invalid date if the blog has not been synchronized yet.
+
+      @see syncPosts()
+    */
+    QDateTime lastSyncDateTime() const;
+
+    /**
+      Forgets everything the previous syncPosts() calls have seen, so the
+      next one reports all posts as created.
+
+      @see syncPosts()
+    */
+    void resetSync();
+
 Q_SIGNALS:
+    /**
+      This signal is emitted when a syncPosts() job has finished.
+
+      @param created the posts that are new since the last sync.
+      @param updated the posts that changed since the last sync.
+      @param removed the posts that have been removed since the last sync.
+      Only their postId() is set. Backends that cannot list all posts
+      report no removed posts.
+      @see syncPosts()
+    */
+    void syncedPosts(const QList<KBlog::BlogPost> &created,
+                     const QList<KBlog::BlogPost> &updated,
+                     const QList<KBlog::BlogPost> &removed);
+
     /**
       This signal is emitted when a listRecentPosts() job fetches a post
       from the blogging server.
@@ -253,6 +398,20 @@ Q_SIGNALS:
     void listedRecentPosts(
         const QList<KBlog::BlogPost> &posts);
 
+    /**
+      This signal is emitted for every page of a listRecentPostsPaged()
+      job. The posts are in descending chronological order.
+
+      @param posts the posts of this page. Posts which could not be read
+      are left out, an error() is emitted for each of them.
+      @param offset the position of the first post of this page in the
+      whole listing.
+      @param last whether this is the last page.
+      @see listRecentPostsPaged()
+    */
+    void listedRecentPostsPage(const QList<KBlog::BlogPost> &posts,
+                               int offset, bool last);
+
     /**
       This signal is emitted when a createPost() job creates a new blog post
       on the blogging server.
@@ -358,6 +517,16 @@ protected:
 
 private:
     Q_DECLARE_PRIVATE(Blog)
+    Q_PRIVATE_SLOT(d_func(),
+                   void slotStorePost(KBlog::BlogPost *))
+    Q_PRIVATE_SLOT(d_func(),
+                   void slotRemoveStoredPost(KBlog::BlogPost *))
+    Q_PRIVATE_SLOT(d_func(),
+                   void slotStorePosts(const QList<KBlog::BlogPost> &))
+    Q_PRIVATE_SLOT(d_func(),
+                   void slotStoreSyncedPosts(const QList<KBlog::BlogPost> &,
+                                             const QList<KBlog::BlogPost> &,
+                                             const QList<KBlog::BlogPost> &))
 };
 
 } //namespace KBlog
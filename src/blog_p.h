@@ -11,12 +11,14 @@
 #define BLOG_P_H
 
 #include "blog.h"
+#include "transport.h"
+#include "syncstate_p.h"
+#include "poststore.h"
 
+#include <QPointer>
 #include <QTimeZone>
 #include <QUrl>
 
-#include <kxmlrpcclient/client.h>
-
 namespace KBlog
 {
 
@@ -32,6 +34,68 @@ public:
     QString mUserAgent;
     QUrl mUrl;
     QTimeZone mTimeZone;
+    QPointer<Transport> mTransport;
+    Transport::Priority mPriority;
+    mutable SyncState mSyncState;
+    bool mSyncing;
+    PostStore *mPostStore;
+    int mPageNumber;
+    int mPageSize;
+    int mPageOffset;
+    quint32 mPageGeneration;
+    QList<BlogPost *> mStoreServed;
+    quint64 mSharedRequests;
+
+    /**
+      Returns the sync state of the blog identified by the current url,
+      blogId and username.
+    */
+    SyncState &syncState() const;
+
+    /**
+      Marks a syncPosts() call as running. Returns false if one is running
+      already, its syncedPosts() then answers this call as well.
+    */
+    bool startSync();
+
+    /**
+      Turns the posts fetched by a syncPosts() call into the created,
+      updated and removed posts and emits syncedPosts(). Set @p complete
+      if @p posts contains all posts of the blog. A sync that fails sets
+      mSyncing to false instead.
+    */
+    void finishSync(const QList<BlogPost> &posts, bool complete);
+
+    /**
+      Answers a fetchPost() from the post store if it holds a fresh copy
+      of @p post. fetchedPost() is emitted from the event loop.
+    */
+    bool fetchPostFromStore(BlogPost *post);
+
+    /**
+      Starts a paged listing, stopping the running one.
+    */
+    void startPaging(int number, int pageSize);
+
+    /**
+      Returns the number of posts to ask for with the next page.
+    */
+    int nextPageSize() const;
+
+    /**
+      Emits listedRecentPostsPage() for @p posts. @p skipped is the number
+      of posts of the page which could not be read and are left out, they
+      still count for the offset of the next page. Returns true if the
+      next page should be requested, i.e. this was not the last page and
+      the listing has not been stopped by a receiver.
+    */
+    bool pageReceived(const QList<BlogPost> &posts, bool last, int skipped = 0);
+    void slotStorePost(KBlog::BlogPost *post);
+    void slotRemoveStoredPost(KBlog::BlogPost *post);
+    void slotStorePosts(const QList<KBlog::BlogPost> &posts);
+    void slotStoreSyncedPosts(const QList<KBlog::BlogPost> &created,
+                              const QList<KBlog::BlogPost> &updated,
+                              const QList<KBlog::BlogPost> &removed);
     Q_DECLARE_PUBLIC(Blog)
 };
 
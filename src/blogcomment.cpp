@@ -14,32 +14,23 @@ namespace KBlog
 {
 
 BlogComment::BlogComment(const BlogComment &c)
-    : d_ptr(new BlogCommentPrivate)
+    : d_ptr(c.d_ptr)
+{
+}
+
+BlogComment::BlogComment(BlogComment &&c) noexcept
+    : d_ptr(std::move(c.d_ptr))
 {
-    d_ptr->q_ptr = this;
-    d_ptr->mTitle = c.title();
-    d_ptr->mContent = c.content();
-    d_ptr->mEmail = c.email();
-    d_ptr->mName = c.name();
-    d_ptr->mCommentId = c.commentId();
-    d_ptr->mUrl = c.url();
-    d_ptr->mError = c.error();
-    d_ptr->mStatus = c.status();
-    d_ptr->mModificationDateTime = c.modificationDateTime();
-    d_ptr->mCreationDateTime = c.creationDateTime();
 }
 
 BlogComment::BlogComment(const QString &commentId)
     : d_ptr(new BlogCommentPrivate)
 {
-    d_ptr->q_ptr = this;
-    d_ptr->mStatus = New;
     d_ptr->mCommentId = commentId;
 }
 
 BlogComment::~BlogComment()
 {
-    delete d_ptr;
 }
 
 QString BlogComment::title() const
@@ -144,8 +135,13 @@ void BlogComment::setError(const QString &error)
 
 BlogComment &BlogComment::operator=(const BlogComment &c)
 {
-    BlogComment copy(c);
-    swap(copy);
+    d_ptr = c.d_ptr;
+    return *this;
+}
+
+BlogComment &BlogComment::operator=(BlogComment &&c) noexcept
+{
+    d_ptr = std::move(c.d_ptr);
     return *this;
 }
 
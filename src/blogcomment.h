@@ -12,6 +12,7 @@
 
 #include <kblog_export.h>
 
+#include <QSharedDataPointer>
 #include <QString>
 #include <QtAlgorithms>
 
@@ -240,16 +241,27 @@ public:
     */
     BlogComment &operator=(const BlogComment &comment);
 
+    /**
+      The move constructor. @p comment is left empty and may only be
+      assigned to or destroyed.
+    */
+    BlogComment(BlogComment &&comment) noexcept;
+
+    /**
+      The move assignment operator.
+    */
+    BlogComment &operator=(BlogComment &&comment) noexcept;
+
     /**
       The swap operator.
     */
-    void swap(BlogComment &other)
+    void swap(BlogComment &other) noexcept
     {
-        qSwap(this->d_ptr, other.d_ptr);
+        d_ptr.swap(other.d_ptr);
     }
 
 private:
-    BlogCommentPrivate *d_ptr; //krazy:exclude=dpointer can't constify due to bic and swap being declared inline
+    QSharedDataPointer<BlogCommentPrivate> d_ptr;
 };
 
 } //namespace KBlog
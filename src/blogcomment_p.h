@@ -13,15 +13,18 @@
 #include "blogcomment.h"
 
 #include <QDateTime>
+#include <QSharedData>
 #include <QUrl>
 
 namespace KBlog
 {
 
-class BlogCommentPrivate
+class BlogCommentPrivate : public QSharedData
 {
 public:
-    BlogComment *q_ptr;
+    BlogCommentPrivate() : mStatus(BlogComment::New)
+    {
+    }
     QString mTitle;
     QString mContent;
     QString mEmail;
@@ -10,10 +10,9 @@
 
 #include "blogger1.h"
 #include "blogger1_p.h"
+#include "blogger1envelope_p.h"
 #include "blogpost.h"
 
-#include <kxmlrpcclient/client.h>
-
 #include "kblog_debug.h"
 #include <KLocalizedString>
 
@@ -51,11 +50,54 @@ void Blogger1::setUrl(const QUrl &server)
 {
     Q_D(Blogger1);
     Blog::setUrl(server);
-    delete d->mXmlRpcClient;
-    d->mXmlRpcClient = new KXmlRpc::Client(server);
+    if (!d->mXmlRpcClient) {
+        d->mXmlRpcClient = new XmlRpcClient(server);
+        d->mXmlRpcClient->setTransport(transport());
+        d->mXmlRpcClient->setPriority(requestPriority());
+    }
+    // keep the client, so the connection to the server stays pooled
+    d->mXmlRpcClient->setUrl(server);
     d->mXmlRpcClient->setUserAgent(userAgent());
 }
 
+void Blogger1::setTransport(Transport *transport)
+{
+    Q_D(Blogger1);
+    Blog::setTransport(transport);
+    d->mXmlRpcClient->setTransport(transport);
+}
+
+void Blogger1::setRequestPriority(Transport::Priority priority)
+{
+    Q_D(Blogger1);
+    Blog::setRequestPriority(priority);
+    d->mXmlRpcClient->setPriority(priority);
+}
+
+void Blogger1::setBatchingEnabled(bool enabled)
+{
+    Q_D(Blogger1);
+    d->mXmlRpcClient->setBatchingEnabled(enabled);
+}
+
+bool Blogger1::isBatchingEnabled() const
+{
+    Q_D(const Blogger1);
+    return d->mXmlRpcClient->isBatchingEnabled();
+}
+
+void Blogger1::setBatchWindow(int msecs)
+{
+    Q_D(Blogger1);
+    d->mXmlRpcClient->setBatchWindow(msecs);
+}
+
+int Blogger1::batchWindow() const
+{
+    Q_D(const Blogger1);
+    return d->mXmlRpcClient->batchWindow();
+}
+
 void Blogger1::fetchUserInfo()
 {
     Q_D(Blogger1);
@@ -72,10 +114,13 @@ void Blogger1::listBlogs()
     Q_D(Blogger1);
     qCDebug(KBLOG_LOG) << "Fetch List of Blogs...";
     QList<QVariant> args(d->blogger1Args());
-    d->mXmlRpcClient->call(
-        QStringLiteral("blogger.getUsersBlogs"), args,
-        this, SLOT(slotListBlogs(QList<QVariant>,QVariant)),
-        this, SLOT(slotError(int,QString,QVariant)));
+    if (d->mXmlRpcClient->call(
+                QStringLiteral("blogger.getUsersBlogs"), args,
+                this, SLOT(slotListBlogs(QList<QVariant>,QVariant)),
+                this, SLOT(slotError(int,QString,QVariant)),
+                QVariant(), true)) {
+        ++d->mSharedRequests;
+    }
 }
 
 void Blogger1::listRecentPosts(int number)
@@ -84,13 +129,43 @@ void Blogger1::listRecentPosts(int number)
     qCDebug(KBLOG_LOG) << "Fetching List of Posts...";
     QList<QVariant> args(d->defaultArgs(blogId()));
     args << QVariant(number);
-    d->mXmlRpcClient->call(
+    d->mXmlRpcClient->callPosts(
         d->getCallFromFunction(Blogger1Private::GetRecentPosts), args,
         this, SLOT(slotListRecentPosts(QList<QVariant>,QVariant)),
         this, SLOT(slotError(int,QString,QVariant)),
         QVariant(number));
 }
 
+void Blogger1::listRecentPostsPaged(int number, int pageSize)
+{
+    Q_D(Blogger1);
+    qCDebug(KBLOG_LOG) << "Fetching list of posts in pages of" << pageSize;
+    d->startPaging(number, pageSize);
+    if (number <= 0) {
+        d->pageReceived(QList<BlogPost>(), true);
+        return;
+    }
+    d->mListPagedGeneration = d->mPageGeneration;
+    QList<QVariant> args(d->defaultArgs(blogId()));
+    args << QVariant(number);
+    d->mXmlRpcClient->callPosts(
+        d->getCallFromFunction(Blogger1Private::GetRecentPosts), args,
+        this, SLOT(slotListRecentPostsPaged(QList<QVariant>,QVariant)),
+        this, SLOT(slotError(int,QString,QVariant)));
+}
+
+void Blogger1::syncPosts()
+{
+    Q_D(Blogger1);
+    qCDebug(KBLOG_LOG) << "Synchronizing posts...";
+    if (!d->startSync()) {
+        return;
+    }
+    // room for the posts created since the last sync
+    d->mSyncNumber = d->syncState().mPosts.count() + 50;
+    d->callSyncPosts();
+}
+
 void Blogger1::fetchPost(KBlog::BlogPost *post)
 {
     if (!post) {
@@ -99,15 +174,21 @@ void Blogger1::fetchPost(KBlog::BlogPost *post)
     }
 
     Q_D(Blogger1);
+    if (d->fetchPostFromStore(post)) {
+        return;
+    }
     qCDebug(KBLOG_LOG) << "Fetching Post with url" << post->postId();
     QList<QVariant> args(d->defaultArgs(post->postId()));
     unsigned int i = d->mCallCounter++;
     d->mCallMap[ i ] = post;
-    d->mXmlRpcClient->call(
-        d->getCallFromFunction(Blogger1Private::FetchPost), args,
-        this, SLOT(slotFetchPost(QList<QVariant>,QVariant)),
-        this, SLOT(slotError(int,QString,QVariant)),
-        QVariant(i));
+    // the same post fetched twice, e.g. by the UI and a sync, is only sent once
+    if (d->mXmlRpcClient->callPosts(
+                d->getCallFromFunction(Blogger1Private::FetchPost), args,
+                this, SLOT(slotFetchPost(QList<QVariant>,QVariant)),
+                this, SLOT(slotError(int,QString,QVariant)),
+                QVariant(i), true)) {
+        ++d->mSharedRequests;
+    }
 }
 
 void Blogger1::modifyPost(KBlog::BlogPost *post)
@@ -174,7 +255,7 @@ void Blogger1::removePost(KBlog::BlogPost *post)
 }
 
 Blogger1Private::Blogger1Private() :
-    mXmlRpcClient(nullptr)
+    mXmlRpcClient(nullptr), mSyncNumber(0), mListPagedGeneration(0)
 {
     qCDebug(KBLOG_LOG);
     mCallCounter = 1;
@@ -215,6 +296,19 @@ QList<QVariant> Blogger1Private::blogger1Args(const QString &id)
     return args;
 }
 
+bool Blogger1Private::isSupported(const QString &method)
+{
+    Q_Q(Blogger1);
+    const ServerCapabilities::Entry capabilities = mXmlRpcClient->capabilities();
+    if (!ServerCapabilities::self()->isFresh(capabilities) || capabilities.supports(method)) {
+        return true;
+    }
+    qCDebug(KBLOG_LOG) << "The server does not list" << method;
+    Q_EMIT q->error(Blogger1::NotSupported,
+                    i18n("The server does not support %1.", method));
+    return false;
+}
+
 void Blogger1Private::slotFetchUserInfo(const QList<QVariant> &result, const QVariant &id)
 {
     Q_Q(Blogger1);
@@ -287,7 +381,9 @@ void Blogger1Private::slotListRecentPosts(const QList<QVariant> &result, const Q
 
     QList <BlogPost> fetchedPostList;
 
-    if (result[0].type() != QVariant::List) {
+    bool ok;
+    const QList<PostFields> postReceived = PostFields::fromResult(result[0], &ok);
+    if (!ok) {
         qCritical() << "Could not fetch list of posts out of the"
                     << "result from the server, not a list.";
         Q_EMIT q->error(Blogger1::ParsingError,
@@ -295,21 +391,19 @@ void Blogger1Private::slotListRecentPosts(const QList<QVariant> &result, const Q
                            "from the server, not a list."));
         return;
     }
-    const QList<QVariant> postReceived = result[0].toList();
-    QList<QVariant>::ConstIterator it = postReceived.begin();
-    QList<QVariant>::ConstIterator end = postReceived.end();
+    fetchedPostList.reserve(postReceived.count());
+    QList<PostFields>::ConstIterator it = postReceived.begin();
+    QList<PostFields>::ConstIterator end = postReceived.end();
     for (; it != end; ++it) {
         BlogPost post;
-        qCDebug(KBLOG_LOG) << "MIDDLE:" << (*it).typeName();
-        const QMap<QString, QVariant> postInfo = (*it).toMap();
-        if (readPostFromMap(&post, postInfo)) {
+        if (readPostFromFields(&post, *it)) {
             qCDebug(KBLOG_LOG) << "Post with ID:"
                                << post.postId()
                                << "appended in fetchedPostList";
             post.setStatus(BlogPost::Fetched);
             fetchedPostList.append(post);
         } else {
-            qCritical() << "readPostFromMap failed!";
+            qCritical() << "readPostFromFields failed!";
             Q_EMIT q->error(Blogger1::ParsingError, i18n("Could not read post."));
         }
         if (--count == 0) {
@@ -320,6 +414,118 @@ void Blogger1Private::slotListRecentPosts(const QList<QVariant> &result, const Q
     Q_EMIT q->listedRecentPosts(fetchedPostList);
 }
 
+void Blogger1Private::slotListRecentPostsPaged(const QList<QVariant> &result, const QVariant &id)
+{
+    Q_Q(Blogger1);
+    Q_UNUSED(id);
+
+    if (mListPagedGeneration != mPageGeneration) {
+        qCDebug(KBLOG_LOG) << "Dropping the result of a stopped listing";
+        return;
+    }
+    bool ok;
+    const QList<PostFields> postReceived = PostFields::fromResult(result[0], &ok);
+    if (!ok) {
+        qCritical() << "Could not fetch list of posts out of the"
+                    << "result from the server, not a list.";
+        mPageNumber = 0;
+        Q_EMIT q->error(Blogger1::ParsingError,
+                      i18n("Could not fetch list of posts out of the result "
+                           "from the server, not a list."));
+        return;
+    }
+    // only convert one page at a time, a receiver may stop early
+    const int total = qMin(postReceived.count(), mPageNumber);
+    int index = 0;
+    do {
+        const int size = qMin(nextPageSize(), total - index);
+        QList<BlogPost> page;
+        page.reserve(size);
+        int skipped = 0;
+        for (int i = index; i < index + size; ++i) {
+            BlogPost post;
+            if (!readPostFromFields(&post, postReceived.at(i))) {
+                qCritical() << "readPostFromFields failed!";
+                Q_EMIT q->error(Blogger1::ParsingError, i18n("Could not read post."));
+                ++skipped;
+                continue;
+            }
+            post.setStatus(BlogPost::Fetched);
+            page.append(post);
+        }
+        index += size;
+        if (!pageReceived(page, index >= total, skipped)) {
+            return;
+        }
+    } while (index < total);
+}
+
+void Blogger1Private::callSyncPosts()
+{
+    Q_Q(Blogger1);
+    QList<QVariant> args(defaultArgs(q->blogId()));
+    args << QVariant(mSyncNumber);
+    mXmlRpcClient->callPosts(
+        getCallFromFunction(GetRecentPosts), args,
+        q, SLOT(slotSyncPosts(QList<QVariant>,QVariant)),
+        q, SLOT(slotSyncPostsError(int,QString,QVariant)));
+}
+
+void Blogger1Private::slotSyncPosts(const QList<QVariant> &result, const QVariant &id)
+{
+    Q_Q(Blogger1);
+    Q_UNUSED(id);
+
+    bool ok;
+    const QList<PostFields> postReceived = PostFields::fromResult(result[0], &ok);
+    if (!ok) {
+        qCritical() << "Could not fetch list of posts out of the"
+                    << "result from the server, not a list.";
+        mSyncing = false;
+        Q_EMIT q->error(Blogger1::ParsingError,
+                      i18n("Could not fetch list of posts out of the result "
+                           "from the server, not a list."));
+        return;
+    }
+    SyncState &state = syncState();
+    // servers like Blogger and WordPress return 20 posts or so, whatever
+    // number is asked for, so a short list is only known to hold all posts
+    // if the server has returned more posts before
+    const bool complete = postReceived.count() < state.mLargestList;
+    state.mLargestList = qMax(state.mLargestList, postReceived.count());
+    if (postReceived.count() >= mSyncNumber) {
+        // there may be more posts, the list has to be complete to find
+        // the removed ones
+        mSyncNumber *= 2;
+        qCDebug(KBLOG_LOG) << "Asking for" << mSyncNumber << "posts";
+        callSyncPosts();
+        return;
+    }
+
+    QList<BlogPost> posts;
+    posts.reserve(postReceived.count());
+    for (const PostFields &fields : postReceived) {
+        BlogPost post;
+        if (readPostFromFields(&post, fields)) {
+            post.setStatus(BlogPost::Fetched);
+            posts.append(post);
+        } else {
+            qCritical() << "readPostFromFields failed!";
+            mSyncing = false;
+            Q_EMIT q->error(Blogger1::ParsingError, i18n("Could not read post."));
+            return;
+        }
+    }
+    finishSync(posts, complete);
+}
+
+void Blogger1Private::slotSyncPostsError(int number, const QString &errorString,
+                                         const QVariant &id)
+{
+    mSyncing = false;
+    slotError(number, errorString, id);
+}
+
 void Blogger1Private::slotFetchPost(const QList<QVariant> &result, const QVariant &id)
 {
     Q_Q(Blogger1);
@@ -332,8 +538,10 @@ void Blogger1Private::slotFetchPost(const QList<QVariant> &result, const QVarian
     // dateCreated, String userid, String postid, String content;
     // TODO: Time zone for the dateCreated!
     qCDebug(KBLOG_LOG) << "TOP:" << result[0].typeName();
-    if (result[0].type() == QVariant::Map &&
-            readPostFromMap(post, result[0].toMap())) {
+    bool ok;
+    const QList<PostFields> postReceived = PostFields::fromResult(result[0], &ok);
+    if (ok && postReceived.count() == 1 &&
+            readPostFromFields(post, postReceived.first())) {
         qCDebug(KBLOG_LOG) << "Emitting fetchedPost()";
         post->setStatus(KBlog::BlogPost::Fetched);
         Q_EMIT q->fetchedPost(post);
@@ -444,68 +652,32 @@ void Blogger1Private::slotError(int number,
     }
 }
 
-bool Blogger1Private::readPostFromMap(
-    BlogPost *post, const QMap<QString, QVariant> &postInfo)
+bool Blogger1Private::readPostFromFields(BlogPost *post, const PostFields &fields)
 {
     // FIXME: integrate error handling
     if (!post) {
         return false;
     }
 
-    qCDebug(KBLOG_LOG)
-        #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
-            << endl
-           #else
-            << Qt::endl
-           #endif
-            << "Keys:" << QStringList(postInfo.keys()).join(QLatin1String(", "));
-    qCDebug(KBLOG_LOG)
-        #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
-            << endl
-           #else
-            << Qt::endl
-           #endif
-               ;
-
-    QDateTime dt = postInfo[QStringLiteral("dateCreated")].toDateTime();
+    QDateTime dt = fields.mDateCreated;
     if (dt.isValid() && !dt.isNull()) {
         post->setCreationDateTime(dt.toLocalTime());
     }
-    dt = postInfo[QStringLiteral("lastModified")].toDateTime();
+    dt = fields.mLastModified;
     if (dt.isValid() && !dt.isNull()) {
         post->setModificationDateTime(dt.toLocalTime());
     }
-    post->setPostId(postInfo[QStringLiteral("postid")].toString().isEmpty() ? postInfo[QStringLiteral("postId")].toString() :
-                    postInfo[QStringLiteral("postid")].toString());
+    post->setPostId(fields.mPostId);
 
-    QString title(postInfo[QStringLiteral("title")].toString());
-    //QString description( postInfo["description"].toString() );
-    QString contents;
-    if (postInfo[QStringLiteral("content")].type() == QVariant::ByteArray) {
-        QByteArray tmpContent = postInfo[QStringLiteral("content")].toByteArray();
-        contents = QString::fromUtf8(tmpContent.data(), tmpContent.size());
-    } else {
-        contents = postInfo[QStringLiteral("content")].toString();
-    }
-    QStringList category;
+    QString title(fields.mTitle);
+    QStringList categories;
 
     // Check for hacked title/category support (e.g. in Wordpress)
-    QRegExp titleMatch = QRegExp(QStringLiteral("<title>([^<]*)</title>"));
-    QRegExp categoryMatch = QRegExp(QStringLiteral("<category>([^<]*)</category>"));
-    if (contents.indexOf(titleMatch) != -1) {
-        // Get the title value from the regular expression match
-        title = titleMatch.cap(1);
-    }
-    if (contents.indexOf(categoryMatch) != -1) {
-        // Get the category value from the regular expression match
-        category = categoryMatch.capturedTexts();
-    }
-    contents.remove(titleMatch);
-    contents.remove(categoryMatch);
+    const QString contents = Blogger1Envelope::decode(fields.mContent, &title, &categories);
 
     post->setTitle(title);
     post->setContent(contents);
-    post->setCategories(category);
+    post->setCategories(categories);
     return true;
 }
 
@@ -514,15 +686,7 @@ bool Blogger1Private::readArgsFromPost(QList<QVariant> *args, const BlogPost &po
     if (!args) {
         return false;
     }
-    const QStringList categories = post.categories();
-    QString content = QStringLiteral("<title>") + post.title() + QStringLiteral("</title>");
-    QStringList::const_iterator it;
-    QStringList::const_iterator end(categories.constEnd());
-    for (it = categories.constBegin(); it != end; ++it) {
-        content += QStringLiteral("<category>") + *it + QStringLiteral("</category>");
-    }
-    content += post.content();
-    *args << QVariant(content);
+    *args << QVariant(Blogger1Envelope::encode(post.title(), post.categories(), post.content()));
     *args << QVariant(!post.isPrivate());
     return true;
 }
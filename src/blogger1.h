@@ -79,6 +79,52 @@ public:
     */
     void setUrl(const QUrl &server) override;
 
+    /**
+       Set the HTTP transport used for the XML-RPC calls.
+       @param transport the transport, or null for the default one.
+    */
+    void setTransport(KBlog::Transport *transport) override;
+
+    /**
+       Set the priority of the XML-RPC calls.
+       @param priority the priority of the calls.
+    */
+    void setRequestPriority(KBlog::Transport::Priority priority) override;
+
+    /**
+       Enable or disable batching of calls. When enabled, calls issued
+       within the batch window are sent together in a single
+       system.multicall request and their results are delivered as if
+       they had been sent one by one. Servers that do not support
+       system.multicall are detected and called one by one.
+       Batching is disabled by default.
+
+       @param enabled whether calls should be batched.
+       @see setBatchWindow()
+    */
+    void setBatchingEnabled(bool enabled);
+
+    /**
+       Returns whether calls are batched into system.multicall requests.
+       @see setBatchingEnabled()
+    */
+    bool isBatchingEnabled() const;
+
+    /**
+       Set the time calls are collected before a batch is sent.
+
+       @param msecs the window in milliseconds. The default of 0 collects
+       the calls issued before control returns to the event loop.
+       @see setBatchingEnabled()
+    */
+    void setBatchWindow(int msecs);
+
+    /**
+       Returns the time in milliseconds calls are collected for a batch.
+       @see setBatchWindow()
+    */
+    int batchWindow() const;
+
     /**
         Get information about the user from the blog. Note: This is not
         supported on the server side.
@@ -103,6 +149,29 @@ public:
     */
     void listRecentPosts(int number) override;
 
+    /**
+      List recent posts page by page. The Blogger 1.0 API has no offsets,
+      so all posts are requested at once, but they are converted and
+      emitted one page at a time.
+
+      @see Blog::listRecentPostsPaged()
+      @see listedRecentPostsPage()
+    */
+    void listRecentPostsPaged(int number, int pageSize) override;
+
+    /**
+      Synchronize the posts with the server. XML-RPC cannot ask for the
+      posts changed after a date, so the recent posts are listed and
+      compared with the posts seen before; only the changes are emitted.
+      Many servers return only the newest posts, however many are asked
+      for, so removed posts are only reported once the server returns
+      fewer posts than it has returned before.
+
+      @see Blog::syncPosts()
+      @see syncedPosts()
+    */
+    void syncPosts() override;
+
     /**
       Fetch a post from the server.
 
@@ -183,6 +252,12 @@ private:
                    void slotListBlogs(const QList<QVariant> &, const QVariant &))
     Q_PRIVATE_SLOT(d_func(),
                    void slotListRecentPosts(const QList<QVariant> &, const QVariant &))
+    Q_PRIVATE_SLOT(d_func(),
+                   void slotSyncPosts(const QList<QVariant> &, const QVariant &))
+    Q_PRIVATE_SLOT(d_func(),
+                   void slotSyncPostsError(int, const QString &, const QVariant &))
+    Q_PRIVATE_SLOT(d_func(),
+                   void slotListRecentPostsPaged(const QList<QVariant> &, const QVariant &))
     Q_PRIVATE_SLOT(d_func(),
                    void slotFetchPost(const QList<QVariant> &, const QVariant &))
     Q_PRIVATE_SLOT(d_func(),
@@ -12,8 +12,8 @@
 
 #include "blogger1.h"
 #include "blog_p.h"
-
-#include <kxmlrpcclient/client.h>
+#include "xmlrpcclient_p.h"
+#include "xmlrpcpostdecoder_p.h"
 
 #include <QList>
 
@@ -24,15 +24,20 @@ class Blogger1Private : public BlogPrivate
 {
 public:
     QString mAppId;
-    KXmlRpc::Client *mXmlRpcClient;
+    XmlRpcClient *mXmlRpcClient;
     unsigned int mCallCounter; // TODO a better counter
     QMap<unsigned int, KBlog::BlogPost *> mCallMap;
+    int mSyncNumber;
+    quint32 mListPagedGeneration;
     Blogger1Private();
     virtual ~Blogger1Private();
 
     virtual void slotFetchUserInfo(const QList<QVariant> &result, const QVariant &id);
     virtual void slotListBlogs(const QList<QVariant> &result, const QVariant &id);
     virtual void slotListRecentPosts(const QList<QVariant> &result, const QVariant &id);
+    virtual void slotSyncPosts(const QList<QVariant> &result, const QVariant &id);
+    virtual void slotSyncPostsError(int number, const QString &errorString, const QVariant &id);
+    virtual void slotListRecentPostsPaged(const QList<QVariant> &result, const QVariant &id);
     virtual void slotFetchPost(const QList<QVariant> &result, const QVariant &id);
     virtual void slotCreatePost(const QList<QVariant> &result, const QVariant &id);
     virtual void slotModifyPost(const QList<QVariant> &result, const QVariant &id);
@@ -49,8 +54,11 @@ public:
     };
     virtual QList<QVariant> defaultArgs(const QString &id = QString());
     QList<QVariant> blogger1Args(const QString &id = QString());
-    virtual bool readPostFromMap(BlogPost *post,
-                                 const QMap<QString, QVariant> &postInfo);
+    // emits error() with NotSupported if the server listed its methods
+    // without @p method, so the call is not sent at all
+    bool isSupported(const QString &method);
+    void callSyncPosts();
+    virtual bool readPostFromFields(BlogPost *post, const PostFields &fields);
     virtual bool readArgsFromPost(QList<QVariant> *args, const BlogPost &post);
     virtual QString getCallFromFunction(FunctionToCall type);
 };
@@ -0,0 +1,87 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "blogger1envelope_p.h"
+
+using namespace KBlog;
+
+static const QLatin1String titleOpen("<title>");
+static const QLatin1String titleClose("</title>");
+static const QLatin1String categoryOpen("<category>");
+static const QLatin1String categoryClose("</category>");
+
+// Reads the text of the element starting at @p pos and returns the position
+// after it, or -1 if the element is not closed. The text must not contain a
+// '<', so only the element itself is scanned.
+static int readElement(const QString &envelope, int pos, QLatin1String open,
+                       QLatin1String close, QStringRef *text)
+{
+    const int begin = pos + open.size();
+    const int end = envelope.indexOf(QLatin1Char('<'), begin);
+    if (end == -1 || envelope.midRef(end, close.size()) != close) {
+        return -1;
+    }
+    *text = envelope.midRef(begin, end - begin);
+    return end + close.size();
+}
+
+QString Blogger1Envelope::encode(const QString &title, const QStringList &categories,
+                                 const QString &content)
+{
+    int size = titleOpen.size() + title.size() + titleClose.size() + content.size();
+    for (const QString &category : categories) {
+        size += categoryOpen.size() + category.size() + categoryClose.size();
+    }
+
+    QString envelope;
+    envelope.reserve(size);
+    envelope += titleOpen;
+    envelope += title;
+    envelope += titleClose;
+    for (const QString &category : categories) {
+        envelope += categoryOpen;
+        envelope += category;
+        envelope += categoryClose;
+    }
+    envelope += content;
+    return envelope;
+}
+
+QString Blogger1Envelope::decode(const QString &envelope, QString *title, QStringList *categories)
+{
+    const int size = envelope.size();
+    int contentBegin = 0;
+    int pos = 0;
+    while (true) {
+        while (pos < size && envelope.at(pos).isSpace()) {
+            ++pos;
+        }
+        QStringRef text;
+        int next = -1;
+        if (envelope.midRef(pos, titleOpen.size()) == titleOpen) {
+            next = readElement(envelope, pos, titleOpen, titleClose, &text);
+            if (next != -1) {
+                *title = text.toString();
+            }
+        } else if (envelope.midRef(pos, categoryOpen.size()) == categoryOpen) {
+            next = readElement(envelope, pos, categoryOpen, categoryClose, &text);
+            if (next != -1) {
+                categories->append(text.toString());
+            }
+        }
+        if (next == -1) {
+            break;
+        }
+        pos = contentBegin = next;
+    }
+
+    if (contentBegin == 0) {
+        return envelope;
+    }
+    return envelope.mid(contentBegin);
+}
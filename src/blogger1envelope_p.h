@@ -0,0 +1,45 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_BLOGGER1ENVELOPE_P_H
+#define KBLOG_BLOGGER1ENVELOPE_P_H
+
+#include "kblog_private_export.h"
+
+#include <QString>
+#include <QStringList>
+
+namespace KBlog
+{
+
+/**
+  Blogger 1.0 has no title or category fields, so they are sent in front
+  of the content as <title> and <category> pseudo-tags. Only that prefix
+  is scanned when reading them back, the content itself is left alone.
+*/
+class KBLOG_TESTS_EXPORT Blogger1Envelope
+{
+public:
+    /**
+      Returns @p content with @p title and @p categories in front of it.
+    */
+    static QString encode(const QString &title, const QStringList &categories,
+                          const QString &content);
+
+    /**
+      Returns the content following the pseudo-tags at the start of
+      @p envelope. Sets @p title if there is a title tag and appends
+      every category to @p categories. Whitespace between the tags is
+      skipped.
+    */
+    static QString decode(const QString &envelope, QString *title, QStringList *categories);
+};
+
+}
+
+#endif
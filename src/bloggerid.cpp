@@ -0,0 +1,48 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "bloggerid_p.h"
+
+using namespace KBlog;
+
+static inline bool isDigit(QChar c)
+{
+    return c.unicode() >= '0' && c.unicode() <= '9';
+}
+
+// the same as QRegExp( prefix + "(\\d+)" ), restricted to ASCII digits
+static QStringRef numberAfter(const QString &id, QLatin1String prefix)
+{
+    const int size = id.size();
+    int from = 0;
+    while (true) {
+        const int pos = id.indexOf(prefix, from);
+        if (pos == -1) {
+            return QStringRef();
+        }
+        const int begin = pos + prefix.size();
+        int end = begin;
+        while (end < size && isDigit(id.at(end))) {
+            ++end;
+        }
+        if (end > begin) {
+            return id.midRef(begin, end - begin);
+        }
+        from = pos + 1;
+    }
+}
+
+QStringRef BloggerId::blogId(const QString &id)
+{
+    return numberAfter(id, QLatin1String("blog-"));
+}
+
+QStringRef BloggerId::postId(const QString &id)
+{
+    return numberAfter(id, QLatin1String("post-"));
+}
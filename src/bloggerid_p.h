@@ -0,0 +1,45 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_BLOGGERID_P_H
+#define KBLOG_BLOGGERID_P_H
+
+#include "kblog_private_export.h"
+
+#include <QString>
+#include <QStringRef>
+
+namespace KBlog
+{
+
+/**
+  Extracts the numbers from Blogger Atom ids such as
+  "tag:blogger.com,1999:blog-N.post-M". The ids are scanned in place,
+  so nothing is allocated unless the caller copies the result.
+*/
+class KBLOG_TESTS_EXPORT BloggerId
+{
+public:
+    /**
+      Returns the digits of the first "blog-" within @p id that is
+      followed by a digit, or a null reference if there is none. The
+      reference points into @p id.
+    */
+    static QStringRef blogId(const QString &id);
+
+    /**
+      Returns the digits of the first "post-" within @p id that is
+      followed by a digit, or a null reference if there is none. The
+      reference points into @p id.
+    */
+    static QStringRef postId(const QString &id);
+};
+
+}
+
+#endif
@@ -10,44 +10,47 @@
 #include "blogmedia.h"
 
 #include <QByteArray>
+#include <QIODevice>
+#include <QPointer>
+#include <QSharedData>
 #include <QString>
 #include <QUrl>
 
 namespace KBlog
 {
 
-class BlogMediaPrivate
+class BlogMediaPrivate : public QSharedData
 {
 public:
-    BlogMedia *q_ptr;
+    BlogMediaPrivate() : mStatus(BlogMedia::New)
+    {
+    }
     QString mName;
     QUrl mUrl;
     QString mMimetype;
     QString mError;
     QByteArray mData;
+    QString mFileName;
+    QPointer<QIODevice> mDevice;
     BlogMedia::Status mStatus;
 };
 
 BlogMedia::BlogMedia(): d_ptr(new BlogMediaPrivate)
 {
-    d_ptr->q_ptr = this;
 }
 
 BlogMedia::BlogMedia(const BlogMedia &m)
-    : d_ptr(new BlogMediaPrivate)
+    : d_ptr(m.d_ptr)
+{
+}
+
+BlogMedia::BlogMedia(BlogMedia &&m) noexcept
+    : d_ptr(std::move(m.d_ptr))
 {
-    d_ptr->q_ptr = this;
-    d_ptr->mName = m.name();
-    d_ptr->mUrl = m.url();
-    d_ptr->mMimetype = m.mimetype();
-    d_ptr->mData = m.data();
-    d_ptr->mStatus = m.status();
-    d_ptr->mError = m.error();
 }
 
 BlogMedia::~BlogMedia()
 {
-    delete d_ptr;
 }
 
 QString BlogMedia::name() const
@@ -90,6 +93,26 @@ void BlogMedia::setData(const QByteArray &data)
     d_ptr->mData = data;
 }
 
+QString BlogMedia::fileName() const
+{
+    return d_ptr->mFileName;
+}
+
+void BlogMedia::setFileName(const QString &fileName)
+{
+    d_ptr->mFileName = fileName;
+}
+
+QIODevice *BlogMedia::device() const
+{
+    return d_ptr->mDevice;
+}
+
+void BlogMedia::setDevice(QIODevice *device)
+{
+    d_ptr->mDevice = device;
+}
+
 BlogMedia::Status BlogMedia::status() const
 {
     return d_ptr->mStatus;
@@ -112,8 +135,13 @@ void BlogMedia::setError(const QString &error)
 
 BlogMedia &BlogMedia::operator=(const BlogMedia &m)
 {
-    BlogMedia copy(m);
-    swap(copy);
+    d_ptr = m.d_ptr;
+    return *this;
+}
+
+BlogMedia &BlogMedia::operator=(BlogMedia &&m) noexcept
+{
+    d_ptr = std::move(m.d_ptr);
     return *this;
 }
 
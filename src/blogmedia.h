@@ -12,8 +12,10 @@
 
 #include <kblog_export.h>
 
+#include <QSharedDataPointer>
 #include <QtAlgorithms>
 
+class QIODevice;
 class QUrl;
 
 namespace KBlog
@@ -119,6 +121,44 @@ public:
     */
     void setData(const QByteArray &data);
 
+    /**
+       Returns the name of the local file that is uploaded.
+       @return The file name.
+
+       @see setFileName( const QString& )
+    */
+    QString fileName() const;
+
+    /**
+       Set a local file to upload instead of data(). The file is read and
+       encoded piece by piece while it is sent, so it is never held in
+       memory as a whole. This is the preferred way to upload big files.
+       @param fileName The path of the file.
+
+       @see fileName()
+       @see setDevice( QIODevice* )
+    */
+    void setFileName(const QString &fileName);
+
+    /**
+       Returns the device that is uploaded.
+       @return The device or null.
+
+       @see setDevice( QIODevice* )
+    */
+    QIODevice *device() const;
+
+    /**
+       Set a device to upload instead of data(). It is read from its current
+       position to its end while the request is sent. The device has to be
+       open for reading and stay valid until the upload has finished; it is
+       not deleted. A device takes precedence over fileName().
+       @param device The device to read from.
+
+       @see device()
+    */
+    void setDevice(QIODevice *device);
+
     /**
        The different possible status. At the moment you cannot do
        much with media objects.
@@ -170,16 +210,27 @@ public:
     */
     BlogMedia &operator=(const BlogMedia &media);
 
+    /**
+      The move constructor. @p media is left empty and may only be
+      assigned to or destroyed.
+    */
+    BlogMedia(BlogMedia &&media) noexcept;
+
+    /**
+      The move assignment operator.
+    */
+    BlogMedia &operator=(BlogMedia &&media) noexcept;
+
     /**
       The swap operator.
     */
-    void swap(BlogMedia &other)
+    void swap(BlogMedia &other) noexcept
     {
-        qSwap(this->d_ptr, other.d_ptr);
+        d_ptr.swap(other.d_ptr);
     }
 
 private:
-    BlogMediaPrivate *d_ptr; //krazy:exclude=dpointer can't constify due to bic and swap being declared inline
+    QSharedDataPointer<BlogMediaPrivate> d_ptr;
 };
 
 } //namespace KBlog
@@ -18,52 +18,30 @@ namespace KBlog
 {
 
 BlogPost::BlogPost(const KBlog::BlogPost &post)
-    : d_ptr(new BlogPostPrivate)
+    : d_ptr(post.d_ptr)
+{
+}
+
+BlogPost::BlogPost(BlogPost &&post) noexcept
+    : d_ptr(std::move(post.d_ptr))
 {
-    d_ptr->q_ptr = this;
-    d_ptr->mPrivate = post.isPrivate();
-    d_ptr->mPostId = post.postId();
-    d_ptr->mTitle = post.title();
-    d_ptr->mContent = post.content();
-    d_ptr->mAdditionalContent = post.additionalContent();
-    d_ptr->mWpSlug = post.slug();
-    d_ptr->mCategories = post.categories();
-    d_ptr->mTags = post.tags();
-    d_ptr->mMood = post.mood();
-    d_ptr->mPermaLink = post.permaLink();
-    d_ptr->mSummary = post.summary();
-    d_ptr->mLink = post.link();
-    d_ptr->mMusic = post.music();
-    d_ptr->mTrackBackAllowed = post.isTrackBackAllowed();
-    d_ptr->mCommentAllowed = post.isCommentAllowed();
-    d_ptr->mError = post.error();
-    d_ptr->mJournalId = post.journalId();
-    d_ptr->mStatus = post.status();
-    d_ptr->mCreationDateTime = post.creationDateTime();
-    d_ptr->mModificationDateTime = post.modificationDateTime();
 }
 
 BlogPost::BlogPost(const QString &postId)
     : d_ptr(new BlogPostPrivate)
 {
-    d_ptr->q_ptr = this;
-    d_ptr->mPrivate = false;
     d_ptr->mPostId = postId;
-    d_ptr->mStatus = New;
 }
 
 BlogPost::BlogPost(const KCalendarCore::Journal::Ptr &journal)
     : d_ptr(new BlogPostPrivate)
 {
     Q_ASSERT(journal);
-    d_ptr->q_ptr = this;
-    d_ptr->mPrivate = false;
     d_ptr->mPostId = journal->customProperty("KBLOG", "ID");
     d_ptr->mJournalId = journal->uid();
-    d_ptr->mStatus = New;
     d_ptr->mTitle = journal->summary();
     if (journal->descriptionIsRich()) {
-        d_ptr->mContent = d_ptr->cleanRichText(journal->description());
+        d_ptr->mContent = BlogPostPrivate::cleanRichText(journal->description());
     } else {
         d_ptr->mContent = journal->description();
     }
@@ -87,27 +65,16 @@ BlogPost::BlogPost(const KCalendarCore::Journal::Ptr &journal)
 
 BlogPost::~BlogPost()
 {
-    delete d_ptr;
 }
 
 KCalendarCore::Journal::Ptr BlogPost::journal(const Blog &blog) const
 {
-    QString url = blog.url().url();
-    QString username = blog.username();
-    QString blogId = blog.blogId();
-    // Generate unique ID. Should be unique enough...
-    QString id = QStringLiteral("kblog-") + url + QLatin1Char('-') + blogId  + QLatin1Char('-') + username +
-                 QLatin1Char('-') + d_ptr->mPostId;
+    const QString url = blog.url().url();
+    const QString username = blog.username();
+    const QString blogId = blog.blogId();
     KCalendarCore::Journal::Ptr journal(new KCalendarCore::Journal());
-    journal->setUid(id);
-    journal->setSummary(d_ptr->mTitle);
-    journal->setCategories(d_ptr->mCategories);
-    journal->setDescription(d_ptr->mContent, true);
-    journal->setDtStart(d_ptr->mCreationDateTime);
-    journal->setCustomProperty("KBLOG", "URL", url);
-    journal->setCustomProperty("KBLOG", "USER", blog.username());
-    journal->setCustomProperty("KBLOG", "BLOG", blogId);
-    journal->setCustomProperty("KBLOG", "ID", d_ptr->mPostId);
+    journal->setUid(BlogPostPrivate::journalUidPrefix(url, blogId, username) + d_ptr->mPostId);
+    BlogPostPrivate::writeJournal(*this, journal.data(), url, blogId, username);
     return journal;
 }
 
@@ -193,7 +160,7 @@ QUrl BlogPost::link() const
     return d_ptr->mLink;
 }
 
-void BlogPost::setLink(const QUrl &link) const
+void BlogPost::setLink(const QUrl &link)
 {
     d_ptr->mLink = link;
 }
@@ -203,7 +170,7 @@ QUrl BlogPost::permaLink() const
     return d_ptr->mPermaLink;
 }
 
-void BlogPost::setPermaLink(const QUrl &permalink) const
+void BlogPost::setPermaLink(const QUrl &permalink)
 {
     d_ptr->mPermaLink = permalink;
 }
@@ -332,29 +299,101 @@ void BlogPost::setError(const QString &error)
 
 BlogPost &BlogPost::operator=(const BlogPost &other)
 {
-    BlogPost copy(other);
-    swap(copy);
+    d_ptr = other.d_ptr;
     return *this;
 }
 
-QString BlogPostPrivate::cleanRichText(QString richText) const
+BlogPost &BlogPost::operator=(BlogPost &&other) noexcept
 {
-    QRegExp getBodyContents(QStringLiteral("<body[^>]*>(.*)</body>"));
-    if (getBodyContents.indexIn(richText)) {
-        // Get anything inside but excluding the body tags
-        richText = getBodyContents.cap(1);
-        // Get rid of any whitespace
-        richText.remove(QRegExp(QStringLiteral("^\\s+")));
+    d_ptr = std::move(other.d_ptr);
+    return *this;
+}
+
+QString BlogPostPrivate::cleanRichText(const QString &richText)
+{
+    int begin = 0;
+    int end = richText.size();
+
+    // Get anything inside but excluding the body tags
+    const int bodyTag = richText.indexOf(QLatin1String("<body"));
+    if (bodyTag != -1) {
+        const int contentsBegin = richText.indexOf(QLatin1Char('>'), bodyTag);
+        const int contentsEnd = richText.lastIndexOf(QLatin1String("</body>"));
+        if (contentsBegin != -1 && contentsEnd > contentsBegin) {
+            begin = contentsBegin + 1;
+            end = contentsEnd;
+            // Get rid of any whitespace
+            while (begin < end && richText.at(begin).isSpace()) {
+                ++begin;
+            }
+        }
+    }
+
+    // Get rid of styled paragraphs while copying the rest once
+    const QLatin1String styledParagraph("<p style=\"");
+    QString cleanText;
+    int copied = begin;
+    int from = begin;
+    while (true) {
+        const int tag = richText.indexOf(styledParagraph, from);
+        if (tag == -1 || tag >= end) {
+            break;
+        }
+        const int quote = richText.indexOf(QLatin1Char('"'), tag + styledParagraph.size());
+        if (quote == -1 || quote + 1 >= end) {
+            break;
+        }
+        from = tag + 1;
+        if (richText.at(quote + 1) != QLatin1Char('>')) {
+            continue;
+        }
+        if (cleanText.isNull()) {
+            cleanText.reserve(end - begin);
+        }
+        cleanText.append(richText.constData() + copied, tag - copied);
+        cleanText.append(QLatin1String("<p>"));
+        copied = from = quote + 2;
+    }
+
+    if (cleanText.isNull()) {
+        // Nothing to replace, so share the data if the whole text is kept
+        if (begin == 0 && end == richText.size()) {
+            cleanText = richText;
+        } else {
+            cleanText = richText.mid(begin, end - begin);
+        }
+    } else {
+        cleanText.append(richText.constData() + copied, end - copied);
     }
-    // Get rid of styled paragraphs
-    richText.replace(QRegExp(QStringLiteral("<p style=\"[^\"]*\">")), QStringLiteral("<p>"));
 
     // If we're left with empty content then return a clean empty string
-    if (richText == QLatin1String("<p></p>")) {
-        richText.clear();
+    if (cleanText == QLatin1String("<p></p>")) {
+        cleanText.clear();
     }
 
-    return richText;
+    return cleanText;
+}
+
+QString BlogPostPrivate::journalUidPrefix(const QString &url, const QString &blogId,
+                                          const QString &username)
+{
+    // Generate unique ID. Should be unique enough...
+    return QStringLiteral("kblog-") + url + QLatin1Char('-') + blogId + QLatin1Char('-') + username +
+           QLatin1Char('-');
+}
+
+void BlogPostPrivate::writeJournal(const BlogPost &post, KCalendarCore::Journal *journal,
+                                   const QString &url, const QString &blogId,
+                                   const QString &username)
+{
+    journal->setSummary(post.title());
+    journal->setCategories(post.categories());
+    journal->setDescription(post.content(), true);
+    journal->setDtStart(post.creationDateTime());
+    journal->setCustomProperty("KBLOG", "URL", url);
+    journal->setCustomProperty("KBLOG", "USER", username);
+    journal->setCustomProperty("KBLOG", "BLOG", blogId);
+    journal->setCustomProperty("KBLOG", "ID", post.postId());
 }
 
 } // namespace KBlog
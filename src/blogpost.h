@@ -12,6 +12,7 @@
 
 #include <kblog_export.h>
 
+#include <QSharedDataPointer>
 #include <QUrl>
 #include <kcalendarcore/journal.h>
 #include <QtAlgorithms>
@@ -203,7 +204,7 @@ public:
 
       @see link()
     */
-    void setLink(const QUrl &link) const;
+    void setLink(const QUrl &link);
 
     /**
       Returns the perma link path.
@@ -219,7 +220,7 @@ public:
 
       @see permaLink()
     */
-    void setPermaLink(const QUrl &permalink) const;
+    void setPermaLink(const QUrl &permalink);
 
     /**
       Returns whether comments should be allowed.
@@ -431,16 +432,28 @@ public:
     */
     BlogPost &operator=(const BlogPost &post);
 
+    /**
+      The move constructor. @p post is left empty and may only be
+      assigned to or destroyed.
+    */
+    BlogPost(BlogPost &&post) noexcept;
+
+    /**
+      The move assignment operator.
+    */
+    BlogPost &operator=(BlogPost &&post) noexcept;
+
     /**
       The swap operator.
     */
-    void swap(BlogPost &other)
+    void swap(BlogPost &other) noexcept
     {
-        qSwap(this->d_ptr, other.d_ptr);
+        d_ptr.swap(other.d_ptr);
     }
 
 private:
-    BlogPostPrivate *d_ptr;  //krazy:exclude=dpointer can't constify due to bic and swap being declared inline
+    // implicitly shared, copies are cheap until one of them is modified
+    QSharedDataPointer<BlogPostPrivate> d_ptr;
 };
 
 } //namespace KBlog
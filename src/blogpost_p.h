@@ -12,6 +12,7 @@
 
 #include "blogpost.h"
 
+#include <QSharedData>
 #include <QStringList>
 #include <QDateTime>
 #include <QUrl>
@@ -19,11 +20,15 @@
 namespace KBlog
 {
 
-class BlogPostPrivate
+class BlogPostPrivate : public QSharedData
 {
 public:
+    BlogPostPrivate()
+        : mPrivate(false), mCommentAllowed(true), mTrackBackAllowed(true),
+          mStatus(BlogPost::New)
+    {
+    }
     bool mPrivate;
-    BlogPost *q_ptr;
     QString mPostId;
     QString mTitle;
     QString mContent;
@@ -42,7 +47,25 @@ public:
     BlogPost::Status mStatus;
     QDateTime mCreationDateTime;
     QDateTime mModificationDateTime;
-    QString cleanRichText(QString richText) const;
+    /**
+      Returns the contents of the body of @p richText, without leading
+      whitespace and with the style attributes of the paragraphs
+      removed. The text is scanned once.
+    */
+    static QString cleanRichText(const QString &richText);
+
+    /**
+      Returns the start of the journal uids of the posts of a blog.
+    */
+    static QString journalUidPrefix(const QString &url, const QString &blogId,
+                                    const QString &username);
+
+    /**
+      Writes the fields of @p post into @p journal, all but the uid.
+    */
+    static void writeJournal(const BlogPost &post, KCalendarCore::Journal *journal,
+                             const QString &url, const QString &blogId,
+                             const QString &username);
 };
 
 } // namespace
@@ -0,0 +1,121 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "categorycache_p.h"
+
+#include <QDataStream>
+#include <QFile>
+#include <QStandardPaths>
+
+using namespace KBlog;
+
+Q_GLOBAL_STATIC(CategoryCache, s_categoryCache)
+
+static const quint32 cacheMagic = 0x4b424343; // "KBCC"
+static const quint32 cacheVersion = 1;
+
+static QString cacheDirectory(const QString &directory)
+{
+    if (!directory.isEmpty()) {
+        return directory;
+    }
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) +
+           QLatin1String("/kblog");
+}
+
+CategoryCache::CategoryCache(const QString &directory)
+    : TtlFileCache<CategoryCacheEntry>(cacheDirectory(directory), "categories",
+                                       cacheMagic, cacheVersion, 24 * 60 * 60)
+{
+}
+
+CategoryCache *CategoryCache::self()
+{
+    return s_categoryCache();
+}
+
+QString CategoryCache::key(const QString &host, const QString &blogId, const QString &username)
+{
+    return host + QLatin1Char('_') + blogId + QLatin1Char('_') + username;
+}
+
+CategoryCache::Entry CategoryCache::makeEntry(const QList<QMap<QString, QString> > &categories,
+        const QDateTime &listedAt)
+{
+    Entry entry;
+    entry.mCategories = categories;
+    entry.mListedAt = listedAt;
+    entry.mCategoryIds.reserve(categories.count());
+    entry.mCategoryNames.reserve(categories.count());
+    QList<QMap<QString, QString> >::ConstIterator it = categories.constBegin();
+    QList<QMap<QString, QString> >::ConstIterator end = categories.constEnd();
+    for (; it != end; ++it) {
+        const QString name = it->value(QStringLiteral("name"));
+        const QString categoryId = it->value(QStringLiteral("categoryId"));
+        // the first category of a name wins, as with the former linear search
+        if (!entry.mCategoryIds.contains(name)) {
+            entry.mCategoryIds.insert(name, categoryId);
+        }
+        if (!entry.mCategoryNames.contains(categoryId)) {
+            entry.mCategoryNames.insert(categoryId, name);
+        }
+    }
+    return entry;
+}
+
+CategoryCache::Entry CategoryCache::store(const QString &key,
+        const QList<QMap<QString, QString> > &categories)
+{
+    const Entry entry = makeEntry(categories, QDateTime::currentDateTimeUtc());
+    storeEntry(key, entry);
+    return entry;
+}
+
+bool CategoryCache::startRefresh(const QString &key)
+{
+    return startUpdate(key);
+}
+
+void CategoryCache::cancelRefresh(const QString &key)
+{
+    cancelUpdate(key);
+}
+
+QDateTime CategoryCache::timestamp(const Entry &entry) const
+{
+    return entry.mListedAt;
+}
+
+bool CategoryCache::readEntry(QDataStream &stream, const QString &key, Entry *entry) const
+{
+    Q_UNUSED(key);
+    QDateTime listedAt;
+    QList<QMap<QString, QString> > categories;
+    stream >> listedAt >> categories;
+    *entry = makeEntry(categories, listedAt);
+    return true;
+}
+
+void CategoryCache::writeEntry(QDataStream &stream, const QString &key, const Entry &entry) const
+{
+    Q_UNUSED(key);
+    stream << entry.mListedAt << entry.mCategories;
+}
+
+bool CategoryCache::readLegacy(QFile &file, Entry *entry) const
+{
+    // written without a header by earlier versions, so its age is unknown
+    QDataStream legacy(&file);
+    QList<QMap<QString, QString> > categories;
+    legacy >> categories;
+    if (legacy.status() != QDataStream::Ok) {
+        return false;
+    }
+    *entry = makeEntry(categories, QDateTime());
+    return true;
+}
@@ -0,0 +1,81 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_CATEGORYCACHE_P_H
+#define KBLOG_CATEGORYCACHE_P_H
+
+#include "kblog_private_export.h"
+#include "ttlfilecache_p.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+
+namespace KBlog
+{
+
+class CategoryCacheEntry
+{
+public:
+    QList<QMap<QString, QString> > mCategories;
+    // name to categoryId and categoryId to name
+    QHash<QString, QString> mCategoryIds;
+    QHash<QString, QString> mCategoryNames;
+    // invalid if the categories have never been listed by this version
+    QDateTime mListedAt;
+};
+
+/**
+  The categories listed by MetaWeblog::listCategories(), shared by all
+  objects of the process that access the same blog and stored in
+  kblog/<host>_<blogId>_<username> in the generic data location.
+  Categories older than maxAge() are still used, but should be listed
+  again in the background.
+*/
+class KBLOG_TESTS_EXPORT CategoryCache : public TtlFileCache<CategoryCacheEntry>
+{
+public:
+    typedef CategoryCacheEntry Entry;
+
+    explicit CategoryCache(const QString &directory = QString());
+
+    static CategoryCache *self();
+
+    static QString key(const QString &host, const QString &blogId, const QString &username);
+
+    /**
+      Returns an entry for @p categories with the indexes built.
+    */
+    static Entry makeEntry(const QList<QMap<QString, QString> > &categories,
+                           const QDateTime &listedAt);
+
+    /**
+      Replaces the categories of the blog @p key, in memory and on disk,
+      and returns the new entry.
+    */
+    Entry store(const QString &key, const QList<QMap<QString, QString> > &categories);
+
+    /**
+      Returns true if the caller should list the categories of @p key
+      again. The refresh ends with store() or cancelRefresh().
+    */
+    bool startRefresh(const QString &key);
+    void cancelRefresh(const QString &key);
+
+protected:
+    QDateTime timestamp(const Entry &entry) const override;
+    bool readEntry(QDataStream &stream, const QString &key, Entry *entry) const override;
+    void writeEntry(QDataStream &stream, const QString &key, const Entry &entry) const override;
+    bool readLegacy(QFile &file, Entry *entry) const override;
+};
+
+}
+
+#endif
@@ -0,0 +1,327 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "feedcache.h"
+#include "feedcache_p.h"
+
+#include "kblog_debug.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrlQuery>
+
+using namespace KBlog;
+
+static const quint32 indexMagic = 0x4b424643; // "KBFC"
+static const quint32 indexVersion = 1;
+static const int maxParsedFeeds = 32;
+
+FeedCachePrivate::FeedCachePrivate()
+    : mDirectory(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+                 QLatin1String("/kblog/feeds")),
+      mMaxSize(10 * 1024 * 1024), mSize(0), mHits(0), mMisses(0), mLoaded(false),
+      mDirty(false)
+{
+}
+
+QString FeedCachePrivate::key(const QUrl &url)
+{
+    return QString::fromLatin1(
+               QCryptographicHash::hash(url.toEncoded(), QCryptographicHash::Sha1).toHex());
+}
+
+bool FeedCachePrivate::isCacheable(const QUrl &url)
+{
+    // the date changes with every sync, a copy would never be asked for again
+    return !QUrlQuery(url).hasQueryItem(QStringLiteral("updated-min"));
+}
+
+QString FeedCachePrivate::fileName(const QString &key) const
+{
+    return mDirectory + QLatin1Char('/') + key;
+}
+
+void FeedCachePrivate::load()
+{
+    if (mLoaded) {
+        return;
+    }
+    mLoaded = true;
+
+    QFile file(mDirectory + QLatin1String("/index"));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    quint32 magic, version;
+    qint32 count;
+    stream >> magic >> version >> count;
+    if (magic != indexMagic || version != indexVersion) {
+        qCDebug(KBLOG_LOG) << "Ignoring feed cache index of unknown version";
+        return;
+    }
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString key;
+        FeedCacheEntry entry;
+        stream >> key >> entry.mUrl >> entry.mETag >> entry.mLastModified
+               >> entry.mSize >> entry.mLastUsed;
+        if (stream.status() == QDataStream::Ok && QFile::exists(fileName(key))) {
+            mEntries.insert(key, entry);
+            mSize += entry.mSize;
+        }
+    }
+}
+
+void FeedCachePrivate::save()
+{
+    mDirty = false;
+    if (!QDir().mkpath(mDirectory)) {
+        qCWarning(KBLOG_LOG) << "Cannot create feed cache directory" << mDirectory;
+        return;
+    }
+    QSaveFile file(mDirectory + QLatin1String("/index"));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KBLOG_LOG) << "Cannot write feed cache index" << file.fileName();
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << indexMagic << indexVersion << qint32(mEntries.count());
+    for (QHash<QString, FeedCacheEntry>::ConstIterator it = mEntries.constBegin();
+            it != mEntries.constEnd(); ++it) {
+        stream << it.key() << it->mUrl << it->mETag << it->mLastModified
+               << it->mSize << it->mLastUsed;
+    }
+    file.commit();
+}
+
+bool FeedCachePrivate::lookup(const QUrl &url, QByteArray *etag, QByteArray *lastModified)
+{
+    if (!isCacheable(url)) {
+        return false;
+    }
+    load();
+    QHash<QString, FeedCacheEntry>::Iterator it = mEntries.find(key(url));
+    if (it == mEntries.end()) {
+        return false;
+    }
+    *etag = it->mETag;
+    *lastModified = it->mLastModified;
+    return true;
+}
+
+QByteArray FeedCachePrivate::body(const QUrl &url)
+{
+    load();
+    const QString k = key(url);
+    QHash<QString, FeedCacheEntry>::Iterator it = mEntries.find(k);
+    if (it == mEntries.end()) {
+        return QByteArray();
+    }
+    QFile file(fileName(k));
+    if (!file.open(QIODevice::ReadOnly)) {
+        remove(k);
+        return QByteArray();
+    }
+    it->mLastUsed = QDateTime::currentMSecsSinceEpoch();
+    mDirty = true;
+    return file.readAll();
+}
+
+void FeedCachePrivate::store(const QUrl &url, const QByteArray &etag,
+                             const QByteArray &lastModified, const QByteArray &body)
+{
+    if (!isCacheable(url)) {
+        return;
+    }
+    load();
+    const QString k = key(url);
+    remove(k);
+    if (etag.isEmpty() && lastModified.isEmpty()) {
+        // nothing to send a conditional request with
+        save();
+        return;
+    }
+    if (body.size() > mMaxSize || !QDir().mkpath(mDirectory)) {
+        save();
+        return;
+    }
+
+    QSaveFile file(fileName(k));
+    if (!file.open(QIODevice::WriteOnly) || file.write(body) != body.size() || !file.commit()) {
+        qCWarning(KBLOG_LOG) << "Cannot write feed cache file" << file.fileName();
+        save();
+        return;
+    }
+
+    FeedCacheEntry entry;
+    entry.mUrl = url;
+    entry.mETag = etag;
+    entry.mLastModified = lastModified;
+    entry.mSize = body.size();
+    entry.mLastUsed = QDateTime::currentMSecsSinceEpoch();
+    mEntries.insert(k, entry);
+    mSize += entry.mSize;
+    evict(k);
+    save();
+}
+
+Syndication::FeedPtr FeedCachePrivate::feed(const QUrl &url)
+{
+    const QString k = key(url);
+    const Syndication::FeedPtr feed = mFeeds.value(k);
+    if (feed) {
+        mFeedOrder.removeOne(k);
+        mFeedOrder.append(k);
+        QHash<QString, FeedCacheEntry>::Iterator it = mEntries.find(k);
+        if (it != mEntries.end()) {
+            it->mLastUsed = QDateTime::currentMSecsSinceEpoch();
+            mDirty = true;
+        }
+    }
+    return feed;
+}
+
+void FeedCachePrivate::storeFeed(const QUrl &url, const Syndication::FeedPtr &feed)
+{
+    const QString k = key(url);
+    if (!feed || !mEntries.contains(k)) {
+        return;
+    }
+    mFeedOrder.removeOne(k);
+    mFeedOrder.append(k);
+    mFeeds.insert(k, feed);
+    while (mFeedOrder.count() > maxParsedFeeds) {
+        mFeeds.remove(mFeedOrder.takeFirst());
+    }
+}
+
+void FeedCachePrivate::remove(const QString &key)
+{
+    QHash<QString, FeedCacheEntry>::Iterator it = mEntries.find(key);
+    if (it != mEntries.end()) {
+        mSize -= it->mSize;
+        mEntries.erase(it);
+        QFile::remove(fileName(key));
+    }
+    mFeeds.remove(key);
+    mFeedOrder.removeOne(key);
+}
+
+void FeedCachePrivate::evict(const QString &keep)
+{
+    while (mSize > mMaxSize && mEntries.count() > 1) {
+        QString oldest;
+        qint64 oldestUse = 0;
+        for (QHash<QString, FeedCacheEntry>::ConstIterator it = mEntries.constBegin();
+                it != mEntries.constEnd(); ++it) {
+            if (it.key() != keep && (oldest.isEmpty() || it->mLastUsed < oldestUse)) {
+                oldest = it.key();
+                oldestUse = it->mLastUsed;
+            }
+        }
+        if (oldest.isEmpty()) {
+            break;
+        }
+        qCDebug(KBLOG_LOG) << "Evicting" << mEntries.value(oldest).mUrl << "from the feed cache";
+        remove(oldest);
+    }
+}
+
+FeedCache::FeedCache()
+    : d(new FeedCachePrivate)
+{
+}
+
+FeedCache::~FeedCache()
+{
+    if (d->mDirty) {
+        d->save();
+    }
+    delete d;
+}
+
+FeedCache *FeedCache::self()
+{
+    // not Q_GLOBAL_STATIC, which cannot call the private constructor
+    static FeedCache cache;
+    return &cache;
+}
+
+QString FeedCache::directory() const
+{
+    return d->mDirectory;
+}
+
+qint64 FeedCache::maxSize() const
+{
+    return d->mMaxSize;
+}
+
+void FeedCache::setMaxSize(qint64 bytes)
+{
+    d->load();
+    d->mMaxSize = qMax<qint64>(0, bytes);
+    if (d->mSize > d->mMaxSize) {
+        d->evict(QString());
+        // a single entry is kept by evict(), drop it as well if it is too big
+        if (d->mSize > d->mMaxSize) {
+            const QList<QString> keys = d->mEntries.keys();
+            for (const QString &key : keys) {
+                d->remove(key);
+            }
+        }
+        d->save();
+    }
+}
+
+qint64 FeedCache::size() const
+{
+    d->load();
+    return d->mSize;
+}
+
+int FeedCache::count() const
+{
+    d->load();
+    return d->mEntries.count();
+}
+
+quint64 FeedCache::hits() const
+{
+    return d->mHits;
+}
+
+quint64 FeedCache::misses() const
+{
+    return d->mMisses;
+}
+
+void FeedCache::resetStatistics()
+{
+    d->mHits = 0;
+    d->mMisses = 0;
+}
+
+void FeedCache::clear()
+{
+    d->load();
+    const QList<QString> keys = d->mEntries.keys();
+    for (const QString &key : keys) {
+        d->remove(key);
+    }
+    d->mFeeds.clear();
+    d->mFeedOrder.clear();
+    d->save();
+}
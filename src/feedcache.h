@@ -0,0 +1,121 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_FEEDCACHE_H
+#define KBLOG_FEEDCACHE_H
+
+#include <kblog_export.h>
+
+#include <QString>
+
+/**
+  @file
+  This file is part of the library for accessing blogs and defines the
+  FeedCache class.
+*/
+
+namespace KBlog
+{
+
+class FeedCachePrivate;
+
+/**
+  @brief
+  The cache of downloaded feeds used by the GData backend.
+
+  Every feed is stored on disk together with its ETag and Last-Modified
+  headers. The next request for the same URL is sent as a conditional GET,
+  and if the server answers that the feed did not change, the already
+  parsed feed is used instead of downloading and parsing it again.
+  The cache is shared by all GData objects of the process. When it grows
+  beyond maxSize(), the least recently used feeds are removed. Feeds
+  asked for with an updated-min parameter, like those fetched by
+  GData::syncPosts(), are not cached, as the next request asks for a
+  different date anyway.
+
+  @code
+  KBlog::FeedCache::self()->setMaxSize( 4 * 1024 * 1024 );
+  ...
+  qDebug() << KBlog::FeedCache::self()->hits() << "of"
+           << KBlog::FeedCache::self()->hits() + KBlog::FeedCache::self()->misses()
+           << "feed requests were served from the cache";
+  @endcode
+*/
+class KBLOG_EXPORT FeedCache
+{
+public:
+    /**
+      Destroys the cache object. The cached feeds stay on disk.
+    */
+    ~FeedCache();
+
+    /**
+      Returns the process wide feed cache.
+    */
+    static FeedCache *self();
+
+    /**
+      Returns the directory the feeds are stored in.
+    */
+    QString directory() const;
+
+    /**
+      Returns the maximum size in bytes of all cached feeds.
+      @see setMaxSize()
+    */
+    qint64 maxSize() const;
+
+    /**
+      Sets the maximum size in bytes of all cached feeds. The least recently
+      used feeds are removed until the cache fits.
+
+      @param bytes the maximum size, defaults to 10 MiB.
+    */
+    void setMaxSize(qint64 bytes);
+
+    /**
+      Returns the size in bytes of all cached feeds.
+    */
+    qint64 size() const;
+
+    /**
+      Returns the number of cached feeds.
+    */
+    int count() const;
+
+    /**
+      Returns the number of requests the server answered with
+      "not modified", so the cached feed was used.
+    */
+    quint64 hits() const;
+
+    /**
+      Returns the number of requests that downloaded the complete feed.
+    */
+    quint64 misses() const;
+
+    /**
+      Resets hits() and misses() to zero.
+    */
+    void resetStatistics();
+
+    /**
+      Removes all feeds from the cache.
+    */
+    void clear();
+
+private:
+    FeedCache();
+    friend class FeedRetriever;
+    friend class FeedLoader;
+    FeedCachePrivate *const d;
+    Q_DISABLE_COPY(FeedCache)
+};
+
+} //namespace KBlog
+#endif
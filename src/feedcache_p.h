@@ -0,0 +1,67 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_FEEDCACHE_P_H
+#define KBLOG_FEEDCACHE_P_H
+
+#include "feedcache.h"
+
+#include <syndication/feed.h>
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QUrl>
+
+namespace KBlog
+{
+
+class FeedCacheEntry
+{
+public:
+    QUrl mUrl;
+    QByteArray mETag;
+    QByteArray mLastModified;
+    qint64 mSize = 0;
+    qint64 mLastUsed = 0;
+};
+
+class FeedCachePrivate
+{
+public:
+    FeedCachePrivate();
+    QString mDirectory;
+    qint64 mMaxSize;
+    qint64 mSize;
+    quint64 mHits;
+    quint64 mMisses;
+    bool mLoaded;
+    bool mDirty;
+    QHash<QString, FeedCacheEntry> mEntries;
+    // parsed feeds, the most recently used one last
+    QHash<QString, Syndication::FeedPtr> mFeeds;
+    QList<QString> mFeedOrder;
+
+    static QString key(const QUrl &url);
+    static bool isCacheable(const QUrl &url);
+    QString fileName(const QString &key) const;
+    void load();
+    void save();
+    bool lookup(const QUrl &url, QByteArray *etag, QByteArray *lastModified);
+    QByteArray body(const QUrl &url);
+    void store(const QUrl &url, const QByteArray &etag,
+               const QByteArray &lastModified, const QByteArray &body);
+    Syndication::FeedPtr feed(const QUrl &url);
+    void storeFeed(const QUrl &url, const Syndication::FeedPtr &feed);
+    void remove(const QString &key);
+    void evict(const QString &keep);
+};
+
+} //namespace KBlog
+
+#endif
@@ -0,0 +1,63 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "feedloader.h"
+#include "feedretriever.h"
+#include "feedcache_p.h"
+
+#include <syndication/documentsource.h>
+
+#include "kblog_debug.h"
+
+using namespace KBlog;
+
+FeedLoader::FeedLoader()
+    : QObject(), mRetriever(nullptr)
+{
+}
+
+FeedLoader::~FeedLoader()
+{
+    delete mRetriever;
+}
+
+void FeedLoader::loadFrom(const QUrl &url, FeedRetriever *retriever)
+{
+    mUrl = url;
+    mRetriever = retriever;
+    connect(mRetriever, &Syndication::DataRetriever::dataRetrieved,
+            this, &FeedLoader::slotDataRetrieved);
+    mRetriever->retrieveData(url);
+}
+
+void FeedLoader::slotDataRetrieved(const QByteArray &data, bool success)
+{
+    Syndication::FeedPtr feed;
+    Syndication::ErrorCode error = Syndication::Success;
+
+    if (!success) {
+        error = Syndication::OtherRetrieverError;
+    } else {
+        FeedCachePrivate *cache = FeedCache::self()->d;
+        if (mRetriever->isNotModified()) {
+            feed = cache->feed(mUrl);
+        }
+        if (!feed) {
+            feed = Syndication::parse(Syndication::DocumentSource(data, mUrl.toString()));
+            if (feed) {
+                cache->storeFeed(mUrl, feed);
+            } else {
+                qCDebug(KBLOG_LOG) << "Could not parse the feed of" << mUrl;
+                error = Syndication::InvalidFormat;
+            }
+        }
+    }
+
+    Q_EMIT loadingComplete(this, feed, error);
+    deleteLater();
+}
@@ -0,0 +1,57 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_FEEDLOADER_H
+#define KBLOG_FEEDLOADER_H
+
+#include "kblog_private_export.h"
+
+#include <syndication/feed.h>
+#include <syndication/global.h>
+
+#include <QObject>
+#include <QUrl>
+
+namespace KBlog
+{
+
+class FeedRetriever;
+
+/**
+  Loads a feed like Syndication::Loader, but takes the parsed feed from
+  the FeedCache when the server reports that it did not change. The
+  loader deletes itself after loadingComplete() has been emitted.
+*/
+class KBLOG_TESTS_EXPORT FeedLoader : public QObject
+{
+    Q_OBJECT
+public:
+    FeedLoader();
+    ~FeedLoader();
+
+    /**
+      Starts loading @p url with @p retriever, which is owned by the
+      loader from now on.
+    */
+    void loadFrom(const QUrl &url, FeedRetriever *retriever);
+
+Q_SIGNALS:
+    void loadingComplete(KBlog::FeedLoader *loader, Syndication::FeedPtr feed,
+                         Syndication::ErrorCode error);
+
+private Q_SLOTS:
+    void slotDataRetrieved(const QByteArray &data, bool success);
+
+private:
+    QUrl mUrl;
+    FeedRetriever *mRetriever;
+};
+
+} //namespace KBlog
+
+#endif
@@ -7,26 +7,59 @@
 */
 
 #include "feedretriever.h"
-
-#include <KIO/StoredTransferJob>
+#include "transport.h"
+#include "transportjob.h"
+#include "feedcache_p.h"
 
 #include <QUrl>
 
 using namespace KBlog;
 
-FeedRetriever::FeedRetriever()
+FeedRetriever::FeedRetriever(Transport *transport, const QString &userAgent,
+                             Transport::Priority priority)
     : Syndication::DataRetriever()
+    , mTransport(transport)
+    , mUserAgent(userAgent)
+    , mPriority(priority)
 {
 }
 
 void FeedRetriever::retrieveData(const QUrl &url)
 {
-    auto job = KIO::storedGet(url, KIO::NoReload, KIO::HideProgressInfo);
+    mUrl = url;
+    get(true);
+}
+
+void FeedRetriever::get(bool conditional)
+{
+    Transport *transport = mTransport ? mTransport.data() : Transport::self();
+    auto job = transport->get(mUrl);
+    job->setPriority(mPriority);
+    if (!mUserAgent.isEmpty()) {
+        job->setRequestHeader("User-Agent", mUserAgent.toUtf8());
+    }
+    QByteArray etag;
+    QByteArray lastModified;
+    mConditional = conditional &&
+                   FeedCache::self()->d->lookup(mUrl, &etag, &lastModified);
+    if (mConditional) {
+        if (!etag.isEmpty()) {
+            job->setRequestHeader("If-None-Match", etag);
+        }
+        if (!lastModified.isEmpty()) {
+            job->setRequestHeader("If-Modified-Since", lastModified);
+        }
+    }
     connect(job, &KJob::result, this, &FeedRetriever::getFinished);
     mJob = job;
     mJob->start();
 }
 
+bool FeedRetriever::isNotModified() const
+{
+    return mNotModified;
+}
+
 int FeedRetriever::errorCode() const
 {
     return mError;
@@ -42,11 +75,34 @@ void FeedRetriever::abort()
 
 void FeedRetriever::getFinished(KJob *job)
 {
+    mJob = nullptr;
+    auto transportJob = static_cast<TransportJob*>(job);
+    FeedCachePrivate *cache = FeedCache::self()->d;
+    if (!job->error() && mConditional && transportJob->statusCode() == 304) {
+        // the feed is only read from the file if it is not held parsed
+        QByteArray data;
+        if (!cache->feed(mUrl)) {
+            data = cache->body(mUrl);
+            if (data.isEmpty()) {
+                // the cached copy is gone, fetch the whole feed
+                get(false);
+                return;
+            }
+        }
+        ++cache->mHits;
+        mNotModified = true;
+        Q_EMIT dataRetrieved(data, true);
+        return;
+    }
+
     if (job->error()) {
         mError = job->error();
         Q_EMIT dataRetrieved({}, false);
         return;
     }
 
-    Q_EMIT dataRetrieved(static_cast<KIO::StoredTransferJob*>(job)->data(), true);
+    ++cache->mMisses;
+    cache->store(mUrl, transportJob->responseHeader("ETag"),
+                 transportJob->responseHeader("Last-Modified"), transportJob->data());
+    Q_EMIT dataRetrieved(transportJob->data(), true);
 }
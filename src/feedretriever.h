@@ -9,28 +9,52 @@
 #ifndef FEEDRETRIEVER_H_
 #define FEEDRETRIEVER_H_
 
+#include "transport.h"
+#include "kblog_private_export.h"
+
 #include <syndication/dataretriever.h>
 
+#include <QPointer>
+#include <QUrl>
+
 class KJob;
 
 namespace KBlog {
 
-class FeedRetriever : public Syndication::DataRetriever
+class TransportJob;
+
+class KBLOG_TESTS_EXPORT FeedRetriever : public Syndication::DataRetriever
 {
     Q_OBJECT
 public:
-    explicit FeedRetriever();
+    explicit FeedRetriever(Transport *transport, const QString &userAgent = QString(),
+                           Transport::Priority priority = Transport::Interactive);
 
     void retrieveData(const QUrl &url) override;
     void abort() override;
     int errorCode() const override;
 
+    /**
+      Returns true if the server answered the conditional request with
+      "not modified" and the data was taken from the FeedCache. The data is
+      empty if the FeedCache still holds the parsed feed.
+    */
+    bool isNotModified() const;
+
 private Q_SLOTS:
     void getFinished(KJob *job);
 
 private:
-    KJob *mJob = nullptr;
+    void get(bool conditional);
+
+    QPointer<Transport> mTransport;
+    QString mUserAgent;
+    Transport::Priority mPriority;
+    QUrl mUrl;
+    TransportJob *mJob = nullptr;
     int mError = 0;
+    bool mConditional = false;
+    bool mNotModified = false;
 };
 
 }
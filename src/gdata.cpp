@@ -8,24 +8,39 @@
 
 #include "gdata.h"
 #include "gdata_p.h"
+#include "atomentryencoder_p.h"
+#include "bloggerid_p.h"
 #include "blogpost.h"
 #include "blogcomment.h"
+#include "feedloader.h"
 #include "feedretriever.h"
+#include "transport.h"
+#include "transportjob.h"
 
-#include <syndication/loader.h>
 #include <syndication/item.h>
 #include <syndication/category.h>
 
-#include <kio/job.h>
 #include "kblog_debug.h"
 #include <KLocalizedString>
 #include <QUrl>
 #include <QUrlQuery>
 
 #include <QByteArray>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QRegExp>
+#include <QSaveFile>
+#include <QStandardPaths>
 
-#define TIMEOUT 600
+// ClientLogin tokens are valid for two weeks
+static const qint64 tokenLifetime = 14 * 24 * 60 * 60;
+
+// the maximum number of entries Blogger returns in one feed
+static const int syncPageSize = 500;
 
 using namespace KBlog;
 
@@ -77,21 +92,24 @@ void GData::fetchProfileId()
 {
     qCDebug(KBLOG_LOG);
     QByteArray data;
-    KIO::StoredTransferJob *job = KIO::storedGet(url(), KIO::NoReload, KIO::HideProgressInfo);
+    TransportJob *job = transport()->get(url());
+    job->setPriority(requestPriority());
     QUrl blogUrl = url();
+    job->setRequestHeader("User-Agent", userAgent().toUtf8());
     connect(job, SIGNAL(result(KJob*)),
             this, SLOT(slotFetchProfileId(KJob*)));
+    job->start();
 }
 
 void GData::listBlogs()
 {
     qCDebug(KBLOG_LOG);
-    Syndication::Loader *loader = Syndication::Loader::create();
+    FeedLoader *loader = new FeedLoader;
     connect(loader,
-            SIGNAL(loadingComplete(Syndication::Loader*,Syndication::FeedPtr,Syndication::ErrorCode)),
+            SIGNAL(loadingComplete(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)),
             this,
-            SLOT(slotListBlogs(Syndication::Loader*,Syndication::FeedPtr,Syndication::ErrorCode)));
-    loader->loadFrom(QUrl(QStringLiteral("http://www.blogger.com/feeds/%1/blogs").arg(profileId())), new FeedRetriever);
+            SLOT(slotListBlogs(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)));
+    loader->loadFrom(QUrl(QStringLiteral("http://www.blogger.com/feeds/%1/blogs").arg(profileId())), new FeedRetriever(transport(), userAgent(), requestPriority()));
 }
 
 void GData::listRecentPosts(const QStringList &labels, int number,
@@ -125,15 +143,15 @@ void GData::listRecentPosts(const QStringList &labels, int number,
     }
     url.setQuery(q);
 
-    Syndication::Loader *loader = Syndication::Loader::create();
+    FeedLoader *loader = new FeedLoader;
     if (number > 0) {
         d->mListRecentPostsMap[ loader ] = number;
     }
     connect(loader,
-            SIGNAL(loadingComplete(Syndication::Loader*,Syndication::FeedPtr,Syndication::ErrorCode)),
+            SIGNAL(loadingComplete(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)),
             this,
-            SLOT(slotListRecentPosts(Syndication::Loader*,Syndication::FeedPtr,Syndication::ErrorCode)));
-    loader->loadFrom(url, new FeedRetriever);
+            SLOT(slotListRecentPosts(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)));
+    loader->loadFrom(url, new FeedRetriever(transport(), userAgent(), requestPriority()));
 }
 
 void GData::listRecentPosts(int number)
@@ -142,29 +160,52 @@ void GData::listRecentPosts(int number)
     listRecentPosts(QStringList(), number);
 }
 
+void GData::syncPosts()
+{
+    qCDebug(KBLOG_LOG);
+    Q_D(GData);
+    if (!d->startSync()) {
+        return;
+    }
+    d->mSyncPosts.clear();
+    d->syncPosts(1);
+}
+
+void GData::listRecentPostsPaged(int number, int pageSize)
+{
+    qCDebug(KBLOG_LOG);
+    Q_D(GData);
+    d->startPaging(number, pageSize);
+    if (number <= 0) {
+        d->pageReceived(QList<BlogPost>(), true);
+        return;
+    }
+    d->listRecentPostsPage();
+}
+
 void GData::listComments(KBlog::BlogPost *post)
 {
     qCDebug(KBLOG_LOG);
     Q_D(GData);
-    Syndication::Loader *loader = Syndication::Loader::create();
+    FeedLoader *loader = new FeedLoader;
     d->mListCommentsMap[ loader ] = post;
     connect(loader,
-            SIGNAL(loadingComplete(Syndication::Loader*,Syndication::FeedPtr,Syndication::ErrorCode)),
+            SIGNAL(loadingComplete(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)),
             this,
-            SLOT(slotListComments(Syndication::Loader*,Syndication::FeedPtr,Syndication::ErrorCode)));
+            SLOT(slotListComments(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)));
     loader->loadFrom(QUrl(QStringLiteral("http://www.blogger.com/feeds/") + blogId() + QLatin1Char('/') +
-                                  post->postId() + QStringLiteral("/comments/default")), new FeedRetriever);
+                                  post->postId() + QStringLiteral("/comments/default")), new FeedRetriever(transport(), userAgent(), requestPriority()));
 }
 
 void GData::listAllComments()
 {
     qCDebug(KBLOG_LOG);
-    Syndication::Loader *loader = Syndication::Loader::create();
+    FeedLoader *loader = new FeedLoader;
     connect(loader,
-            SIGNAL(loadingComplete(Syndication::Loader*,Syndication::FeedPtr,Syndication::ErrorCode)),
+            SIGNAL(loadingComplete(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)),
             this,
-            SLOT(slotListAllComments(Syndication::Loader*,Syndication::FeedPtr,Syndication::ErrorCode)));
-    loader->loadFrom(QUrl(QStringLiteral("http://www.blogger.com/feeds/%1/comments/default").arg(blogId())), new FeedRetriever);
+            SLOT(slotListAllComments(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)));
+    loader->loadFrom(QUrl(QStringLiteral("http://www.blogger.com/feeds/%1/comments/default").arg(blogId())), new FeedRetriever(transport(), userAgent(), requestPriority()));
 }
 
 void GData::fetchPost(KBlog::BlogPost *post)
@@ -176,15 +217,26 @@ void GData::fetchPost(KBlog::BlogPost *post)
         qCritical() << "post is null pointer";
         return;
     }
+    if (d->fetchPostFromStore(post)) {
+        return;
+    }
 
-    qCDebug(KBLOG_LOG);
-    Syndication::Loader *loader = Syndication::Loader::create();
-    d->mFetchPostMap[ loader ] = post;
+    const QUrl url(QStringLiteral("http://www.blogger.com/feeds/%1/posts/default").arg(blogId()));
+    FeedLoader *loader = d->mFetchPostLoaders.value(url);
+    if (loader) {
+        qCDebug(KBLOG_LOG) << "Waiting for the feed already requested";
+        d->mFetchPostMap[ loader ] << post;
+        ++d->mSharedRequests;
+        return;
+    }
+    loader = new FeedLoader;
+    d->mFetchPostLoaders.insert(url, loader);
+    d->mFetchPostMap[ loader ] << post;
     connect(loader,
-            SIGNAL(loadingComplete(Syndication::Loader*,Syndication::FeedPtr,Syndication::ErrorCode)),
+            SIGNAL(loadingComplete(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)),
             this,
-            SLOT(slotFetchPost(Syndication::Loader*,Syndication::FeedPtr,Syndication::ErrorCode)));
-    loader->loadFrom(QUrl(QStringLiteral("http://www.blogger.com/feeds/%1/posts/default").arg(blogId())), new FeedRetriever);
+            SLOT(slotFetchPost(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)));
+    loader->loadFrom(url, new FeedRetriever(transport(), userAgent(), requestPriority()));
 }
 
 void GData::modifyPost(KBlog::BlogPost *post)
@@ -197,58 +249,27 @@ void GData::modifyPost(KBlog::BlogPost *post)
         return;
     }
 
-    if (!d->authenticate()) {
-        qCritical() << "Authentication failed.";
-        Q_EMIT errorPost(Atom, i18n("Authentication failed."), post);
+    if (!d->authenticate(GDataPrivate::ModifyPost, post)) {
         return;
     }
 
-    QString atomMarkup = QStringLiteral("<entry xmlns='http://www.w3.org/2005/Atom'>");
-    atomMarkup += QStringLiteral("<id>tag:blogger.com,1999:blog-") + blogId();
-    atomMarkup += QStringLiteral(".post-") + post->postId() + QStringLiteral("</id>");
-    atomMarkup += QStringLiteral("<published>") + post->creationDateTime().toString() + QStringLiteral("</published>");
-    atomMarkup += QStringLiteral("<updated>") + post->modificationDateTime().toString() + QStringLiteral("</updated>");
-    atomMarkup += QStringLiteral("<title type='text'>") + post->title() + QStringLiteral("</title>");
-    if (post->isPrivate()) {
-        atomMarkup += QStringLiteral("<app:control xmlns:app='http://purl.org/atom/app#'>");
-        atomMarkup += QStringLiteral("<app:draft>yes</app:draft></app:control>");
-    }
-    atomMarkup += QStringLiteral("<content type='xhtml'>");
-    atomMarkup += QStringLiteral("<div xmlns='http://www.w3.org/1999/xhtml'>");
-    atomMarkup += post->content();
-    atomMarkup += QStringLiteral("</div></content>");
-    const auto tags = post->tags();
-    for (const QString &tag : tags) {
-        atomMarkup += QStringLiteral("<category scheme='http://www.blogger.com/atom/ns#' term='") + tag + QStringLiteral("' />");
-    }
-    atomMarkup += QStringLiteral("<author>");
-    if (!fullName().isEmpty()) {
-        atomMarkup += QStringLiteral("<name>") + fullName() + QStringLiteral("</name>");
-    }
-    atomMarkup += QStringLiteral("<email>") + username() + QStringLiteral("</email>");
-    atomMarkup += QStringLiteral("</author>");
-    atomMarkup += QStringLiteral("</entry>");
-    QByteArray postData;
-    QDataStream stream(&postData, QIODevice::WriteOnly);
-    stream.writeRawData(atomMarkup.toUtf8().constData(), atomMarkup.toUtf8().length());
+    const QByteArray postData = AtomEntryEncoder::encodePost(*post, blogId(), fullName(), username());
 
-    KIO::StoredTransferJob *job = KIO::storedHttpPost(postData,
-                                  QUrl(QStringLiteral("http://www.blogger.com/feeds/") + blogId() + QStringLiteral("/posts/default/") + post->postId()),
-                                  KIO::HideProgressInfo);
+    TransportJob *job = transport()->post(QUrl(QStringLiteral("http://www.blogger.com/feeds/") + blogId() + QStringLiteral("/posts/default/") + post->postId()), postData);
+    job->setPriority(requestPriority());
 
     Q_ASSERT(job);
 
     d->mModifyPostMap[ job ] = post;
 
-    job->addMetaData(QStringLiteral("content-type"), QStringLiteral("Content-Type: application/atom+xml; charset=utf-8"));
-    job->addMetaData(QStringLiteral("ConnectTimeout"), QStringLiteral("50"));
-    job->addMetaData(QStringLiteral("UserAgent"), userAgent());
-    job->addMetaData(QStringLiteral("customHTTPHeader"),
-                     QStringLiteral("Authorization: GoogleLogin auth=") + d->mAuthenticationString +
-                     QStringLiteral("\r\nX-HTTP-Method-Override: PUT"));
+    job->setRequestHeader("Content-Type", "application/atom+xml; charset=utf-8");
+    job->setRequestHeader("User-Agent", userAgent().toUtf8());
+    job->setRequestHeader("Authorization", "GoogleLogin auth=" + d->mAuthenticationString.toUtf8());
+    job->setRequestHeader("X-HTTP-Method-Override", "PUT");
 
     connect(job, SIGNAL(result(KJob*)),
             this, SLOT(slotModifyPost(KJob*)));
+    job->start();
 }
 
 void GData::createPost(KBlog::BlogPost *post)
@@ -261,54 +282,25 @@ void GData::createPost(KBlog::BlogPost *post)
         return;
     }
 
-    if (!d->authenticate()) {
-        qCritical() << "Authentication failed.";
-        Q_EMIT errorPost(Atom, i18n("Authentication failed."), post);
+    if (!d->authenticate(GDataPrivate::CreatePost, post)) {
         return;
     }
 
-    QString atomMarkup = QStringLiteral("<entry xmlns='http://www.w3.org/2005/Atom'>");
-    atomMarkup += QStringLiteral("<title type='text'>") + post->title() + QStringLiteral("</title>");
-    if (post->isPrivate()) {
-        atomMarkup += QStringLiteral("<app:control xmlns:app='http://purl.org/atom/app#'>");
-        atomMarkup += QStringLiteral("<app:draft>yes</app:draft></app:control>");
-    }
-    atomMarkup += QStringLiteral("<content type='xhtml'>");
-    atomMarkup += QStringLiteral("<div xmlns='http://www.w3.org/1999/xhtml'>");
-    atomMarkup += post->content(); // FIXME check for Utf
-    atomMarkup += QStringLiteral("</div></content>");
-    QList<QString>::ConstIterator it = post->tags().constBegin();
-    QList<QString>::ConstIterator end = post->tags().constEnd();
-    for (; it != end; ++it) {
-        atomMarkup += QStringLiteral("<category scheme='http://www.blogger.com/atom/ns#' term='") + (*it) + QStringLiteral("' />");
-    }
-    atomMarkup += QStringLiteral("<author>");
-    if (!fullName().isEmpty()) {
-        atomMarkup += QStringLiteral("<name>") + fullName() + QStringLiteral("</name>");
-    }
-    atomMarkup += QStringLiteral("<email>") + username() + QStringLiteral("</email>");
-    atomMarkup += QStringLiteral("</author>");
-    atomMarkup += QStringLiteral("</entry>");
-
-    QByteArray postData;
-    QDataStream stream(&postData, QIODevice::WriteOnly);
-    stream.writeRawData(atomMarkup.toUtf8().constData(), atomMarkup.toUtf8().length());
+    const QByteArray postData = AtomEntryEncoder::encodePost(*post, QString(), fullName(), username());
 
-    KIO::StoredTransferJob *job = KIO::storedHttpPost(postData,
-                                  QUrl(QStringLiteral("http://www.blogger.com/feeds/") + blogId() + QStringLiteral("/posts/default")),
-                                  KIO::HideProgressInfo);
+    TransportJob *job = transport()->post(QUrl(QStringLiteral("http://www.blogger.com/feeds/") + blogId() + QStringLiteral("/posts/default")), postData);
+    job->setPriority(requestPriority());
 
     Q_ASSERT(job);
     d->mCreatePostMap[ job ] = post;
 
-    job->addMetaData(QStringLiteral("content-type"), QStringLiteral("Content-Type: application/atom+xml; charset=utf-8"));
-    job->addMetaData(QStringLiteral("ConnectTimeout"), QStringLiteral("50"));
-    job->addMetaData(QStringLiteral("UserAgent"), userAgent());
-    job->addMetaData(QStringLiteral("customHTTPHeader"),
-                     QStringLiteral("Authorization: GoogleLogin auth=") + d->mAuthenticationString);
+    job->setRequestHeader("Content-Type", "application/atom+xml; charset=utf-8");
+    job->setRequestHeader("User-Agent", userAgent().toUtf8());
+    job->setRequestHeader("Authorization", "GoogleLogin auth=" + d->mAuthenticationString.toUtf8());
 
     connect(job, SIGNAL(result(KJob*)),
             this, SLOT(slotCreatePost(KJob*)));
+    job->start();
 }
 
 void GData::removePost(KBlog::BlogPost *post)
@@ -321,34 +313,30 @@ void GData::removePost(KBlog::BlogPost *post)
         return;
     }
 
-    if (!d->authenticate()) {
-        qCritical() << "Authentication failed.";
-        Q_EMIT errorPost(Atom, i18n("Authentication failed."), post);
+    if (!d->authenticate(GDataPrivate::RemovePost, post)) {
         return;
     }
 
     QByteArray postData;
 
-    KIO::StoredTransferJob *job = KIO::storedHttpPost(postData,
-                                  QUrl(QStringLiteral("http://www.blogger.com/feeds/") + blogId() + QStringLiteral("/posts/default/") + post->postId()),
-                                  KIO::HideProgressInfo);
+    TransportJob *job = transport()->post(QUrl(QStringLiteral("http://www.blogger.com/feeds/") + blogId() + QStringLiteral("/posts/default/") + post->postId()), postData);
     if (!job) {
-        qCWarning(KBLOG_LOG) << "Unable to create KIO job for http://www.blogger.com/feeds/"
+        qCWarning(KBLOG_LOG) << "Unable to create job for http://www.blogger.com/feeds/"
                              << blogId() << QStringLiteral("/posts/default/") + post->postId();
         return;
     }
+    job->setPriority(requestPriority());
 
     d->mRemovePostMap[ job ] = post;
 
 
-    job->addMetaData(QStringLiteral("ConnectTimeout"), QStringLiteral("50"));
-    job->addMetaData(QStringLiteral("UserAgent"), userAgent());
-    job->addMetaData(QStringLiteral("customHTTPHeader"),
-                     QStringLiteral("Authorization: GoogleLogin auth=") + d->mAuthenticationString +
-                     QStringLiteral("\r\nX-HTTP-Method-Override: DELETE"));
+    job->setRequestHeader("User-Agent", userAgent().toUtf8());
+    job->setRequestHeader("Authorization", "GoogleLogin auth=" + d->mAuthenticationString.toUtf8());
+    job->setRequestHeader("X-HTTP-Method-Override", "DELETE");
 
     connect(job, SIGNAL(result(KJob*)),
             this, SLOT(slotRemovePost(KJob*)));
+    job->start();
 }
 
 void GData::createComment(KBlog::BlogPost *post, KBlog::BlogComment *comment)
@@ -366,44 +354,29 @@ void GData::createComment(KBlog::BlogPost *post, KBlog::BlogComment *comment)
     }
 
     Q_D(GData);
-    if (!d->authenticate()) {
-        qCritical() << "Authentication failed.";
-        Q_EMIT errorComment(Atom, i18n("Authentication failed."), post, comment);
+    if (!d->authenticate(GDataPrivate::CreateComment, post, comment)) {
         return;
     }
-    QString atomMarkup = QStringLiteral("<entry xmlns='http://www.w3.org/2005/Atom'>");
-    atomMarkup += QStringLiteral("<title type=\"text\">") + comment->title() + QStringLiteral("</title>");
-    atomMarkup += QStringLiteral("<content type=\"html\">") + comment->content() + QStringLiteral("</content>");
-    atomMarkup += QStringLiteral("<author>");
-    atomMarkup += QStringLiteral("<name>") + comment->name() + QStringLiteral("</name>");
-    atomMarkup += QStringLiteral("<email>") + comment->email() + QStringLiteral("</email>");
-    atomMarkup += QStringLiteral("</author></entry>");
-
-    QByteArray postData;
-    qCDebug(KBLOG_LOG) <<  postData;
-    QDataStream stream(&postData, QIODevice::WriteOnly);
-    stream.writeRawData(atomMarkup.toUtf8().constData(), atomMarkup.toUtf8().length());
+    const QByteArray postData = AtomEntryEncoder::encodeComment(*comment);
 
-    KIO::StoredTransferJob *job = KIO::storedHttpPost(postData,
-                                  QUrl(QStringLiteral("http://www.blogger.com/feeds/") + blogId() + QStringLiteral("/") + post->postId() + QStringLiteral("/comments/default")),
-                                  KIO::HideProgressInfo);
+    TransportJob *job = transport()->post(QUrl(QStringLiteral("http://www.blogger.com/feeds/") + blogId() + QStringLiteral("/") + post->postId() + QStringLiteral("/comments/default")), postData);
 
     if (!job) {
-        qCWarning(KBLOG_LOG) << "Unable to create KIO job for http://www.blogger.com/feeds/"
+        qCWarning(KBLOG_LOG) << "Unable to create job for http://www.blogger.com/feeds/"
                              << blogId() << "/" << post->postId() << "/comments/default";
         return;
     }
+    job->setPriority(requestPriority());
     d->mCreateCommentMap[ job ][post] = comment;
 
 
-    job->addMetaData(QStringLiteral("content-type"), QStringLiteral("Content-Type: application/atom+xml; charset=utf-8"));
-    job->addMetaData(QStringLiteral("ConnectTimeout"), QStringLiteral("50"));
-    job->addMetaData(QStringLiteral("customHTTPHeader"),
-                     QStringLiteral("Authorization: GoogleLogin auth=") + d->mAuthenticationString);
-    job->addMetaData(QStringLiteral("UserAgent"), userAgent());
+    job->setRequestHeader("Content-Type", "application/atom+xml; charset=utf-8");
+    job->setRequestHeader("Authorization", "GoogleLogin auth=" + d->mAuthenticationString.toUtf8());
+    job->setRequestHeader("User-Agent", userAgent().toUtf8());
 
     connect(job, SIGNAL(result(KJob*)),
             this, SLOT(slotCreateComment(KJob*)));
+    job->start();
 }
 
 void GData::removeComment(KBlog::BlogPost *post, KBlog::BlogComment *comment)
@@ -422,36 +395,34 @@ void GData::removeComment(KBlog::BlogPost *post, KBlog::BlogComment *comment)
         return;
     }
 
-    if (!d->authenticate()) {
-        qCritical() << "Authentication failed.";
-        Q_EMIT errorComment(Atom, i18n("Authentication failed."), post, comment);
+    if (!d->authenticate(GDataPrivate::RemoveComment, post, comment)) {
         return;
     }
 
     QByteArray postData;
 
-    KIO::StoredTransferJob *job = KIO::storedHttpPost(postData,
-                                  QUrl(QStringLiteral("http://www.blogger.com/feeds/") + blogId() + QStringLiteral("/") + post->postId() +
-                                       QStringLiteral("/comments/default/") + comment->commentId()), KIO::HideProgressInfo);
+    TransportJob *job = transport()->post(QUrl(QStringLiteral("http://www.blogger.com/feeds/") + blogId() + QStringLiteral("/") + post->postId() +
+                                       QStringLiteral("/comments/default/") + comment->commentId()), postData);
     d->mRemoveCommentMap[ job ][ post ] = comment;
 
     if (!job) {
-        qCWarning(KBLOG_LOG) << "Unable to create KIO job for http://www.blogger.com/feeds/"
+        qCWarning(KBLOG_LOG) << "Unable to create job for http://www.blogger.com/feeds/"
                              << blogId() << post->postId()
                              << "/comments/default/" << comment->commentId();
     }
 
-    job->addMetaData(QStringLiteral("ConnectTimeout"), QStringLiteral("50"));
-    job->addMetaData(QStringLiteral("UserAgent"), userAgent());
-    job->addMetaData(QStringLiteral("customHTTPHeader"),
-                     QStringLiteral("Authorization: GoogleLogin auth=") +
-                     d->mAuthenticationString + QStringLiteral("\r\nX-HTTP-Method-Override: DELETE"));
+    job->setPriority(requestPriority());
+    job->setRequestHeader("User-Agent", userAgent().toUtf8());
+    job->setRequestHeader("Authorization", "GoogleLogin auth=" + d->mAuthenticationString.toUtf8());
+    job->setRequestHeader("X-HTTP-Method-Override", "DELETE");
 
     connect(job, SIGNAL(result(KJob*)),
             this, SLOT(slotRemoveComment(KJob*)));
+    job->start();
 }
 
-GDataPrivate::GDataPrivate(): mAuthenticationString(), mAuthenticationTime()
+GDataPrivate::GDataPrivate(): mAuthenticationString(), mAuthenticationTime(),
+    mAuthState(NotAuthenticated)
 {
     qCDebug(KBLOG_LOG);
 }
@@ -461,11 +432,137 @@ GDataPrivate::~GDataPrivate()
     qCDebug(KBLOG_LOG);
 }
 
-bool GDataPrivate::authenticate()
+QString GDataPrivate::tokenFileName() const
+{
+    Q_Q(const GData);
+    const QByteArray account = QCryptographicHash::hash(q->username().toUtf8(),
+                               QCryptographicHash::Sha1).toHex();
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) +
+           QLatin1String("/kblog/gdata/") + QString::fromLatin1(account);
+}
+
+void GDataPrivate::loadToken()
+{
+    Q_Q(GData);
+    if (mTokenUser == q->username()) {
+        return;
+    }
+    mTokenUser = q->username();
+    mGrantedToken.clear();
+    mAuthenticationString.clear();
+    mAuthenticationTime = QDateTime();
+
+    QFile file(tokenFileName());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    QString token;
+    QDateTime time;
+    stream >> token >> time;
+    if (stream.status() == QDataStream::Ok) {
+        qCDebug(KBLOG_LOG) << "Loaded authentication token from" << file.fileName();
+        mAuthenticationString = token;
+        mAuthenticationTime = time;
+    }
+}
+
+void GDataPrivate::saveToken()
+{
+    const QString fileName = tokenFileName();
+    if (!QDir().mkpath(QFileInfo(fileName).absolutePath())) {
+        qCWarning(KBLOG_LOG) << "Cannot create directory for" << fileName;
+        return;
+    }
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KBLOG_LOG) << "Cannot write authentication token to" << fileName;
+        return;
+    }
+    // the token grants write access to the blog
+    file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << mAuthenticationString << mAuthenticationTime;
+    if (file.commit()) {
+        QFile::setPermissions(fileName, QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    }
+}
+
+bool GDataPrivate::invalidateToken(KJob *job, OperationType type, BlogPost *post, BlogComment *comment)
+{
+    const TransportJob *transportJob = qobject_cast<TransportJob *>(job);
+    if (!transportJob || (transportJob->statusCode() != 401 && transportJob->statusCode() != 403)) {
+        return false;
+    }
+    const QByteArray token = transportJob->requestHeader("Authorization").mid(qstrlen("GoogleLogin auth="));
+    // an older job may have been sent with a token which is already replaced
+    if (token == mAuthenticationString.toUtf8()) {
+        qCDebug(KBLOG_LOG) << "Authentication token was rejected";
+        mAuthenticationString.clear();
+        mAuthenticationTime = QDateTime();
+        QFile::remove(tokenFileName());
+    }
+    // a token the login has just granted would be rejected again
+    if (token == mGrantedToken.toUtf8()) {
+        return false;
+    }
+
+    if (authenticate(type, post, comment)) {
+        // another operation has already fetched a new token
+        PendingOperation operation;
+        operation.mType = type;
+        operation.mPost = post;
+        operation.mComment = comment;
+        sendOperation(operation);
+    }
+    return true;
+}
+
+void GDataPrivate::sendOperation(const PendingOperation &operation)
+{
+    Q_Q(GData);
+    switch (operation.mType) {
+    case CreatePost:
+        q->createPost(operation.mPost);
+        break;
+    case ModifyPost:
+        q->modifyPost(operation.mPost);
+        break;
+    case RemovePost:
+        q->removePost(operation.mPost);
+        break;
+    case CreateComment:
+        q->createComment(operation.mPost, operation.mComment);
+        break;
+    case RemoveComment:
+        q->removeComment(operation.mPost, operation.mComment);
+        break;
+    }
+}
+
+bool GDataPrivate::authenticate(OperationType type, BlogPost *post, BlogComment *comment)
 {
     qCDebug(KBLOG_LOG);
     Q_Q(GData);
-    QByteArray data;
+    loadToken();
+    if (mAuthState != Authenticating && !mAuthenticationString.isEmpty() &&
+            mAuthenticationTime.isValid() &&
+            mAuthenticationTime.secsTo(QDateTime::currentDateTime()) < tokenLifetime) {
+        return true;
+    }
+
+    // the operation is sent again once the authentication has finished
+    PendingOperation operation;
+    operation.mType = type;
+    operation.mPost = post;
+    operation.mComment = comment;
+    mPendingOperations.append(operation);
+    if (mAuthState == Authenticating) {
+        return false;
+    }
+
     QUrl authGateway(QStringLiteral("https://www.google.com/accounts/ClientLogin"));
     QUrlQuery query;
     query.addQueryItem(QStringLiteral("Email"), q->username());
@@ -473,27 +570,51 @@ bool GDataPrivate::authenticate()
     query.addQueryItem(QStringLiteral("source"), q->userAgent());
     query.addQueryItem(QStringLiteral("service"), QStringLiteral("blogger"));
     authGateway.setQuery(query);
-    if (!mAuthenticationTime.isValid() ||
-            QDateTime::currentDateTime().currentSecsSinceEpoch() - mAuthenticationTime.currentSecsSinceEpoch() > TIMEOUT ||
-            mAuthenticationString.isEmpty()) {
-        KIO::TransferJob *job = KIO::http_post(authGateway, QByteArray(), KIO::HideProgressInfo);
-        QObject::connect(job, &KIO::TransferJob::data,
-                         q, [&data](KIO::Job *, const QByteArray &newdata) {
-                            data.reserve(data.size() + newdata.size());
-                            memcpy(data.data() + data.size(), newdata.data(), newdata.size());
-                         });
-        if (job->exec()) {
-            QRegExp rx(QStringLiteral("Auth=(.+)"));
-            if (rx.indexIn(QLatin1String(data)) != -1) {
-                qCDebug(KBLOG_LOG) << "RegExp got authentication string:" << rx.cap(1);
-                mAuthenticationString = rx.cap(1);
-                mAuthenticationTime = QDateTime::currentDateTime();
-                return true;
+
+    mAuthState = Authenticating;
+    TransportJob *job = q->transport()->post(authGateway, QByteArray());
+    job->setPriority(q->requestPriority());
+    job->setRequestHeader("User-Agent", q->userAgent().toUtf8());
+    q->connect(job, SIGNAL(result(KJob*)),
+               q, SLOT(slotAuthenticate(KJob*)));
+    job->start();
+    return false;
+}
+
+void GDataPrivate::slotAuthenticate(KJob *job)
+{
+    qCDebug(KBLOG_LOG);
+    Q_Q(GData);
+    mAuthState = NotAuthenticated;
+    if (!job->error()) {
+        const TransportJob *stj = qobject_cast<TransportJob *>(job);
+        QRegExp rx(QStringLiteral("Auth=(.+)"));
+        if (rx.indexIn(QString::fromLatin1(stj->data())) != -1) {
+            qCDebug(KBLOG_LOG) << "RegExp got authentication string:" << rx.cap(1);
+            mAuthenticationString = rx.cap(1).trimmed();
+            mAuthenticationTime = QDateTime::currentDateTime();
+            mGrantedToken = mAuthenticationString;
+            mAuthState = Authenticated;
+            saveToken();
+        }
+    }
+
+    const QList<PendingOperation> operations = mPendingOperations;
+    mPendingOperations.clear();
+    for (const PendingOperation &operation : operations) {
+        if (mAuthState != Authenticated) {
+            qCritical() << "Authentication failed.";
+            if (operation.mComment) {
+                Q_EMIT q->errorComment(GData::AuthenticationError, i18n("Authentication failed."),
+                                       operation.mPost, operation.mComment);
+            } else {
+                Q_EMIT q->errorPost(GData::AuthenticationError, i18n("Authentication failed."),
+                                    operation.mPost);
             }
+            continue;
         }
-        return false;
+        sendOperation(operation);
     }
-    return true;
 }
 
 void GDataPrivate::slotFetchProfileId(KJob *job)
@@ -504,7 +625,7 @@ void GDataPrivate::slotFetchProfileId(KJob *job)
         return;
     }
     Q_Q(GData);
-    KIO::StoredTransferJob *stj = qobject_cast<KIO::StoredTransferJob *>(job);
+    TransportJob *stj = qobject_cast<TransportJob *>(job);
     const QString data = QString::fromUtf8(stj->data().constData(), stj->data().size());
     if (!job->error()) {
         QRegExp pid(QStringLiteral("http://www.blogger.com/profile/(\\d+)"));
@@ -525,7 +646,7 @@ void GDataPrivate::slotFetchProfileId(KJob *job)
     }
 }
 
-void GDataPrivate::slotListBlogs(Syndication::Loader *loader,
+void GDataPrivate::slotListBlogs(KBlog::FeedLoader *loader,
                                  const Syndication::FeedPtr &feed,
                                  Syndication::ErrorCode status)
 {
@@ -546,18 +667,18 @@ void GDataPrivate::slotListBlogs(Syndication::Loader *loader,
     QList<Syndication::ItemPtr>::ConstIterator it = items.constBegin();
     QList<Syndication::ItemPtr>::ConstIterator end = items.constEnd();
     for (; it != end; ++it) {
-        QRegExp rx(QStringLiteral("blog-(\\d+)"));
+        const QString id = (*it)->id();
+        const QStringRef blogId = BloggerId::blogId(id);
         QMap<QString, QString> blogInfo;
-        if (rx.indexIn((*it)->id()) != -1) {
-            qCDebug(KBLOG_LOG) << "QRegExp rx( 'blog-(\\d+)' matches" << rx.cap(1);
-            blogInfo[QStringLiteral("id")] = rx.cap(1);
+        if (!blogId.isNull()) {
+            qCDebug(KBLOG_LOG) << "Blog id" << blogId;
+            blogInfo[QStringLiteral("id")] = blogId.toString();
             blogInfo[QStringLiteral("title")] = (*it)->title();
             blogInfo[QStringLiteral("url")] = (*it)->link();
             blogInfo[QStringLiteral("summary")] = (*it)->description();   //TODO fix/add more
             blogsList << blogInfo;
         } else {
-            qCritical() << "QRegExp rx( 'blog-(\\d+)' does not match anything in:"
-                        << (*it)->id();
+            qCritical() << "Could not find the blog id in:" << id;
             Q_EMIT q->error(GData::Other, i18n("Could not regexp the blog id path."));
         }
     }
@@ -565,7 +686,7 @@ void GDataPrivate::slotListBlogs(Syndication::Loader *loader,
     Q_EMIT q->listedBlogs(blogsList);
 }
 
-void GDataPrivate::slotListComments(Syndication::Loader *loader,
+void GDataPrivate::slotListComments(KBlog::FeedLoader *loader,
                                     const Syndication::FeedPtr &feed,
                                     Syndication::ErrorCode status)
 {
@@ -590,14 +711,15 @@ void GDataPrivate::slotListComments(Syndication::Loader *loader,
     QList<Syndication::ItemPtr>::ConstIterator end = items.constEnd();
     for (; it != end; ++it) {
         BlogComment comment;
-        QRegExp rx(QStringLiteral("post-(\\d+)"));
-        if (rx.indexIn((*it)->id()) == -1) {
-            qCritical() << "QRegExp rx( 'post-(\\d+)' does not match" << rx.cap(1);
+        const QString id = (*it)->id();
+        const QStringRef commentId = BloggerId::postId(id);
+        if (commentId.isNull()) {
+            qCritical() << "Could not find the comment id in:" << id;
             Q_EMIT q->error(GData::Other, i18n("Could not regexp the comment id path."));
         } else {
-            comment.setCommentId(rx.cap(1));
+            qCDebug(KBLOG_LOG) << "Comment id" << commentId;
+            comment.setCommentId(commentId.toString());
         }
-        qCDebug(KBLOG_LOG) << "QRegExp rx( 'post-(\\d+)' matches" << rx.cap(1);
         comment.setTitle((*it)->title());
         comment.setContent((*it)->content());
 //  FIXME: assuming UTC for now
@@ -609,7 +731,7 @@ void GDataPrivate::slotListComments(Syndication::Loader *loader,
     Q_EMIT q->listedComments(post, commentList);
 }
 
-void GDataPrivate::slotListAllComments(Syndication::Loader *loader,
+void GDataPrivate::slotListAllComments(KBlog::FeedLoader *loader,
                                        const Syndication::FeedPtr &feed,
                                        Syndication::ErrorCode status)
 {
@@ -632,15 +754,15 @@ void GDataPrivate::slotListAllComments(Syndication::Loader *loader,
     QList<Syndication::ItemPtr>::ConstIterator end = items.constEnd();
     for (; it != end; ++it) {
         BlogComment comment;
-        QRegExp rx(QStringLiteral("post-(\\d+)"));
-        if (rx.indexIn((*it)->id()) == -1) {
-            qCritical() << "QRegExp rx( 'post-(\\d+)' does not match" << rx.cap(1);
+        const QString id = (*it)->id();
+        const QStringRef commentId = BloggerId::postId(id);
+        if (commentId.isNull()) {
+            qCritical() << "Could not find the comment id in:" << id;
             Q_EMIT q->error(GData::Other, i18n("Could not regexp the comment id path."));
         } else {
-            comment.setCommentId(rx.cap(1));
+            qCDebug(KBLOG_LOG) << "Comment id" << commentId;
+            comment.setCommentId(commentId.toString());
         }
-
-        qCDebug(KBLOG_LOG) << "QRegExp rx( 'post-(\\d+)' matches" << rx.cap(1);
         comment.setTitle((*it)->title());
         comment.setContent((*it)->content());
 //  FIXME: assuming UTC for now
@@ -652,7 +774,7 @@ void GDataPrivate::slotListAllComments(Syndication::Loader *loader,
     Q_EMIT q->listedAllComments(commentList);
 }
 
-void GDataPrivate::slotListRecentPosts(Syndication::Loader *loader,
+void GDataPrivate::slotListRecentPosts(KBlog::FeedLoader *loader,
                                        const Syndication::FeedPtr &feed,
                                        Syndication::ErrorCode status)
 {
@@ -681,33 +803,9 @@ void GDataPrivate::slotListRecentPosts(Syndication::Loader *loader,
     QList<Syndication::ItemPtr>::ConstIterator end = items.constEnd();
     for (; it != end; ++it) {
         BlogPost post;
-        QRegExp rx(QStringLiteral("post-(\\d+)"));
-        if (rx.indexIn((*it)->id()) == -1) {
-            qCritical() << "QRegExp rx( 'post-(\\d+)' does not match" << rx.cap(1);
+        if (!readPostFromItem(*it, &post)) {
             Q_EMIT q->error(GData::Other, i18n("Could not regexp the post id path."));
-        } else {
-            post.setPostId(rx.cap(1));
         }
-
-        qCDebug(KBLOG_LOG) << "QRegExp rx( 'post-(\\d+)' matches" << rx.cap(1);
-        post.setTitle((*it)->title());
-        post.setContent((*it)->content());
-        post.setLink(QUrl((*it)->link()));
-        QStringList labels;
-        int catCount = (*it)->categories().count();
-        QList< Syndication::CategoryPtr > cats = (*it)->categories();
-        for (int i = 0; i < catCount; ++i) {
-            if (cats[i]->label().isEmpty()) {
-                labels.append(cats[i]->term());
-            } else {
-                labels.append(cats[i]->label());
-            }
-        }
-        post.setTags(labels);
-//  FIXME: assuming UTC for now
-        post.setCreationDateTime(QDateTime::fromSecsSinceEpoch((*it)->datePublished()));
-        post.setModificationDateTime(QDateTime::fromSecsSinceEpoch((*it)->dateUpdated()));
-        post.setStatus(BlogPost::Fetched);
         postList.append(post);
         if (number-- == 0) {
             break;
@@ -717,54 +815,203 @@ void GDataPrivate::slotListRecentPosts(Syndication::Loader *loader,
     Q_EMIT q->listedRecentPosts(postList);
 }
 
-void GDataPrivate::slotFetchPost(Syndication::Loader *loader,
+bool GDataPrivate::readPostFromItem(const Syndication::ItemPtr &item, BlogPost *post)
+{
+    bool success = true;
+    const QString id = item->id();
+    const QStringRef postId = BloggerId::postId(id);
+    if (postId.isNull()) {
+        qCritical() << "Could not find the post id in:" << id;
+        success = false;
+    } else {
+        qCDebug(KBLOG_LOG) << "Post id" << postId;
+        post->setPostId(postId.toString());
+    }
+
+    post->setTitle(item->title());
+    post->setContent(item->content());
+    post->setLink(QUrl(item->link()));
+    QStringList labels;
+    const QList<Syndication::CategoryPtr> cats = item->categories();
+    for (const Syndication::CategoryPtr &cat : cats) {
+        if (cat->label().isEmpty()) {
+            labels.append(cat->term());
+        } else {
+            labels.append(cat->label());
+        }
+    }
+    post->setTags(labels);
+//  FIXME: assuming UTC for now
+    post->setCreationDateTime(QDateTime::fromSecsSinceEpoch(item->datePublished()));
+    post->setModificationDateTime(QDateTime::fromSecsSinceEpoch(item->dateUpdated()));
+    post->setStatus(BlogPost::Fetched);
+    return success;
+}
+
+void GDataPrivate::listRecentPostsPage()
+{
+    Q_Q(GData);
+    QUrl url(QStringLiteral("http://www.blogger.com/feeds/") + q->blogId() + QStringLiteral("/posts/default"));
+    QUrlQuery query;
+    // start-index is 1-based
+    query.addQueryItem(QStringLiteral("start-index"), QString::number(mPageOffset + 1));
+    query.addQueryItem(QStringLiteral("max-results"), QString::number(nextPageSize()));
+    url.setQuery(query);
+
+    FeedLoader *loader = new FeedLoader;
+    mListRecentPostsPageMap[ loader ] = mPageGeneration;
+    q->connect(loader,
+               SIGNAL(loadingComplete(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)),
+               q,
+               SLOT(slotListRecentPostsPage(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)));
+    loader->loadFrom(url, new FeedRetriever(q->transport(), q->userAgent(), q->requestPriority()));
+}
+
+void GDataPrivate::slotListRecentPostsPage(KBlog::FeedLoader *loader,
+                                           const Syndication::FeedPtr &feed,
+                                           Syndication::ErrorCode status)
+{
+    qCDebug(KBLOG_LOG);
+    Q_Q(GData);
+    if (mListRecentPostsPageMap.take(loader) != mPageGeneration) {
+        qCDebug(KBLOG_LOG) << "Dropping a page of a stopped listing";
+        return;
+    }
+    if (status != Syndication::Success) {
+        mPageNumber = 0;
+        Q_EMIT q->error(GData::Atom, i18n("Could not get posts."));
+        return;
+    }
+
+    const int requested = nextPageSize();
+    const QList<Syndication::ItemPtr> items = feed->items();
+    QList<KBlog::BlogPost> postList;
+    int skipped = 0;
+    for (const Syndication::ItemPtr &item : items) {
+        if (postList.count() + skipped == requested) {
+            break;
+        }
+        BlogPost post;
+        if (!readPostFromItem(item, &post)) {
+            Q_EMIT q->error(GData::Other, i18n("Could not regexp the post id path."));
+            ++skipped;
+            continue;
+        }
+        postList.append(post);
+    }
+    if (pageReceived(postList, items.count() < requested, skipped)) {
+        listRecentPostsPage();
+    }
+}
+
+void GDataPrivate::syncPosts(int startIndex)
+{
+    Q_Q(GData);
+    QUrl url(QStringLiteral("http://www.blogger.com/feeds/") + q->blogId() + QStringLiteral("/posts/default"));
+    QUrlQuery query;
+    // updated-min is only honoured when ordering by the update date
+    query.addQueryItem(QStringLiteral("orderby"), QStringLiteral("updated"));
+    const QDateTime since = syncState().mHighWaterMark;
+    if (since.isValid()) {
+        query.addQueryItem(QStringLiteral("updated-min"), since.toUTC().toString(QStringLiteral("yyyy-MM-ddTHH:mm:ssZ")));
+    }
+    query.addQueryItem(QStringLiteral("start-index"), QString::number(startIndex));
+    query.addQueryItem(QStringLiteral("max-results"), QString::number(syncPageSize));
+    url.setQuery(query);
+
+    FeedLoader *loader = new FeedLoader;
+    mSyncPostsMap[ loader ] = startIndex;
+    q->connect(loader,
+               SIGNAL(loadingComplete(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)),
+               q,
+               SLOT(slotSyncPosts(KBlog::FeedLoader*,Syndication::FeedPtr,Syndication::ErrorCode)));
+    loader->loadFrom(url, new FeedRetriever(q->transport(), q->userAgent(), q->requestPriority()));
+}
+
+void GDataPrivate::slotSyncPosts(KBlog::FeedLoader *loader,
                                  const Syndication::FeedPtr &feed,
                                  Syndication::ErrorCode status)
 {
     qCDebug(KBLOG_LOG);
     Q_Q(GData);
-    if (!loader) {
-        qCritical() << "loader is a null pointer.";
+    const int startIndex = mSyncPostsMap.take(loader);
+    if (status != Syndication::Success) {
+        mSyncPosts.clear();
+        mSyncing = false;
+        Q_EMIT q->error(GData::Atom, i18n("Could not get posts."));
         return;
     }
 
-    bool success = false;
+    const QList<Syndication::ItemPtr> items = feed->items();
+    for (const Syndication::ItemPtr &item : items) {
+        BlogPost post;
+        if (readPostFromItem(item, &post)) {
+            mSyncPosts.append(post);
+        }
+    }
+    if (items.count() >= syncPageSize) {
+        syncPosts(startIndex + items.count());
+        return;
+    }
 
-    BlogPost *post = mFetchPostMap.take(loader);
-    qCritical() << "Post" << post;
-    post->postId();
+    const QList<BlogPost> posts = mSyncPosts;
+    mSyncPosts.clear();
+    finishSync(posts, false);
+}
 
-    if (status != Syndication::Success) {
-        Q_EMIT q->errorPost(GData::Atom, i18n("Could not get posts."), post);
+void GDataPrivate::slotFetchPost(KBlog::FeedLoader *loader,
+                                 const Syndication::FeedPtr &feed,
+                                 Syndication::ErrorCode status)
+{
+    qCDebug(KBLOG_LOG);
+    Q_Q(GData);
+    if (!loader) {
+        qCritical() << "loader is a null pointer.";
         return;
     }
 
-    QString postId = post->postId();
-    QList<Syndication::ItemPtr> items = feed->items();
-    QList<Syndication::ItemPtr>::ConstIterator it = items.constBegin();
-    QList<Syndication::ItemPtr>::ConstIterator end = items.constEnd();
-    for (; it != end; ++it) {
-        QRegExp rx(QStringLiteral("post-(\\d+)"));
-        if (rx.indexIn((*it)->id()) != -1 &&
-                rx.cap(1) == postId) {
-            qCDebug(KBLOG_LOG) << "QRegExp rx( 'post-(\\d+)' matches" << rx.cap(1);
-            post->setPostId(rx.cap(1));
-            post->setTitle((*it)->title());
-            post->setContent((*it)->content());
-            post->setStatus(BlogPost::Fetched);
-            post->setLink(QUrl((*it)->link()));
-            post->setCreationDateTime(QDateTime::fromSecsSinceEpoch((*it)->datePublished()).toLocalTime());
-            post->setModificationDateTime(QDateTime::fromSecsSinceEpoch((*it)->dateUpdated()).toLocalTime());
-            qCDebug(KBLOG_LOG) << "Emitting fetchedPost( postId=" << postId << ");";
-            success = true;
-            Q_EMIT q->fetchedPost(post);
+    const QList<BlogPost *> posts = mFetchPostMap.take(loader);
+    for (auto it = mFetchPostLoaders.begin(); it != mFetchPostLoaders.end(); ++it) {
+        if (it.value() == loader) {
+            mFetchPostLoaders.erase(it);
             break;
         }
     }
-    if (!success) {
-        qCritical() << "QRegExp rx( 'post-(\\d+)' does not match"
-                    << mFetchPostMap[ loader ]->postId() << ".";
-        Q_EMIT q->errorPost(GData::Other, i18n("Could not regexp the blog id path."), post);
+
+    if (status != Syndication::Success) {
+        for (BlogPost *post : posts) {
+            Q_EMIT q->errorPost(GData::Atom, i18n("Could not get posts."), post);
+        }
+        return;
+    }
+
+    const QList<Syndication::ItemPtr> items = feed->items();
+    for (BlogPost *post : posts) {
+        const QString postId = post->postId();
+        bool success = false;
+        QList<Syndication::ItemPtr>::ConstIterator it = items.constBegin();
+        QList<Syndication::ItemPtr>::ConstIterator end = items.constEnd();
+        for (; it != end; ++it) {
+            const QString id = (*it)->id();
+            const QStringRef itemId = BloggerId::postId(id);
+            if (!itemId.isNull() && itemId == postId) {
+                qCDebug(KBLOG_LOG) << "Post id" << postId;
+                post->setTitle((*it)->title());
+                post->setContent((*it)->content());
+                post->setStatus(BlogPost::Fetched);
+                post->setLink(QUrl((*it)->link()));
+                post->setCreationDateTime(QDateTime::fromSecsSinceEpoch((*it)->datePublished()).toLocalTime());
+                post->setModificationDateTime(QDateTime::fromSecsSinceEpoch((*it)->dateUpdated()).toLocalTime());
+                qCDebug(KBLOG_LOG) << "Emitting fetchedPost( postId=" << postId << ");";
+                success = true;
+                Q_EMIT q->fetchedPost(post);
+                break;
+            }
+        }
+        if (!success) {
+            qCritical() << "Could not find the post" << postId << "in the feed.";
+            Q_EMIT q->errorPost(GData::Other, i18n("Could not regexp the blog id path."), post);
+        }
     }
 }
 
@@ -775,7 +1022,7 @@ void GDataPrivate::slotCreatePost(KJob *job)
         qCritical() << "job is a null pointer.";
         return;
     }
-    KIO::StoredTransferJob *stj = qobject_cast<KIO::StoredTransferJob *>(job);
+    TransportJob *stj = qobject_cast<TransportJob *>(job);
     const QString data = QString::fromUtf8(stj->data().constData(), stj->data().size());
 
     Q_Q(GData);
@@ -785,18 +1032,21 @@ void GDataPrivate::slotCreatePost(KJob *job)
 
     if (job->error() != 0) {
         qCritical() << "slotCreatePost error:" << job->errorString();
+        if (invalidateToken(job, CreatePost, post)) {
+            return;
+        }
         Q_EMIT q->errorPost(GData::Atom, job->errorString(), post);
         return;
     }
 
-    QRegExp rxId(QStringLiteral("post-(\\d+)"));   //FIXME check and do better handling, esp the creation date time
-    if (rxId.indexIn(data) == -1) {
+    const QStringRef postId = BloggerId::postId(data);   //FIXME check and do better handling, esp the creation date time
+    if (postId.isNull()) {
         qCritical() << "Could not regexp the id out of the result:" << data;
         Q_EMIT q->errorPost(GData::Atom,
                           i18n("Could not regexp the id out of the result."), post);
         return;
     }
-    qCDebug(KBLOG_LOG) << "QRegExp rx( 'post-(\\d+)' ) matches" << rxId.cap(1);
+    qCDebug(KBLOG_LOG) << "Post id" << postId;
 
     QRegExp rxPub(QStringLiteral("<published>(.+)</published>"));
     if (rxPub.indexIn(data) == -1) {
@@ -816,7 +1066,7 @@ void GDataPrivate::slotCreatePost(KJob *job)
     }
     qCDebug(KBLOG_LOG) << "QRegExp rx( '<updated>(.+)</updated>' ) matches" << rxUp.cap(1);
 
-    post->setPostId(rxId.cap(1));
+    post->setPostId(postId.toString());
     post->setCreationDateTime(QDateTime::fromString(rxPub.cap(1)));
     post->setModificationDateTime(QDateTime::fromString(rxUp.cap(1)));
     post->setStatus(BlogPost::Created);
@@ -831,7 +1081,7 @@ void GDataPrivate::slotModifyPost(KJob *job)
         qCritical() << "job is a null pointer.";
         return;
     }
-    KIO::StoredTransferJob *stj = qobject_cast<KIO::StoredTransferJob *>(job);
+    TransportJob *stj = qobject_cast<TransportJob *>(job);
     const QString data = QString::fromUtf8(stj->data().constData(), stj->data().size());
 
     KBlog::BlogPost *post = mModifyPostMap[ job ];
@@ -839,18 +1089,21 @@ void GDataPrivate::slotModifyPost(KJob *job)
     Q_Q(GData);
     if (job->error() != 0) {
         qCritical() << "slotModifyPost error:" << job->errorString();
+        if (invalidateToken(job, ModifyPost, post)) {
+            return;
+        }
         Q_EMIT q->errorPost(GData::Atom, job->errorString(), post);
         return;
     }
 
-    QRegExp rxId(QStringLiteral("post-(\\d+)"));   //FIXME check and do better handling, esp creation date time
-    if (rxId.indexIn(data) == -1) {
+    const QStringRef postId = BloggerId::postId(data);   //FIXME check and do better handling, esp creation date time
+    if (postId.isNull()) {
         qCritical() << "Could not regexp the id out of the result:" << data;
         Q_EMIT q->errorPost(GData::Atom,
                           i18n("Could not regexp the id out of the result."), post);
         return;
     }
-    qCDebug(KBLOG_LOG) << "QRegExp rx( 'post-(\\d+)' ) matches" << rxId.cap(1);
+    qCDebug(KBLOG_LOG) << "Post id" << postId;
 
     QRegExp rxPub(QStringLiteral("<published>(.+)</published>"));
     if (rxPub.indexIn(data) == -1) {
@@ -869,7 +1122,7 @@ void GDataPrivate::slotModifyPost(KJob *job)
         return;
     }
     qCDebug(KBLOG_LOG) << "QRegExp rx( '<updated>(.+)</updated>' ) matches" << rxUp.cap(1);
-    post->setPostId(rxId.cap(1));
+    post->setPostId(postId.toString());
     post->setCreationDateTime(QDateTime::fromString(rxPub.cap(1)));
     post->setModificationDateTime(QDateTime::fromString(rxUp.cap(1)));
     post->setStatus(BlogPost::Modified);
@@ -883,7 +1136,7 @@ void GDataPrivate::slotRemovePost(KJob *job)
         qCritical() << "job is a null pointer.";
         return;
     }
-    KIO::StoredTransferJob *stj = qobject_cast<KIO::StoredTransferJob *>(job);
+    TransportJob *stj = qobject_cast<TransportJob *>(job);
     const QString data = QString::fromUtf8(stj->data().constData(), stj->data().size());
 
     KBlog::BlogPost *post = mRemovePostMap[ job ];
@@ -891,6 +1144,9 @@ void GDataPrivate::slotRemovePost(KJob *job)
     Q_Q(GData);
     if (job->error() != 0) {
         qCritical() << "slotRemovePost error:" << job->errorString();
+        if (invalidateToken(job, RemovePost, post)) {
+            return;
+        }
         Q_EMIT q->errorPost(GData::Atom, job->errorString(), post);
         return;
     }
@@ -907,7 +1163,7 @@ void GDataPrivate::slotCreateComment(KJob *job)
         qCritical() << "job is a null pointer.";
         return;
     }
-    KIO::StoredTransferJob *stj = qobject_cast<KIO::StoredTransferJob *>(job);
+    TransportJob *stj = qobject_cast<TransportJob *>(job);
     const QString data = QString::fromUtf8(stj->data().constData(), stj->data().size());
     qCDebug(KBLOG_LOG) << "Dump data: " << data;
 
@@ -919,19 +1175,22 @@ void GDataPrivate::slotCreateComment(KJob *job)
 
     if (job->error() != 0) {
         qCritical() << "slotCreateComment error:" << job->errorString();
+        if (invalidateToken(job, CreateComment, post, comment)) {
+            return;
+        }
         Q_EMIT q->errorComment(GData::Atom, job->errorString(), post, comment);
         return;
     }
 
 // TODO check for result and fit appropriately
-    QRegExp rxId(QStringLiteral("post-(\\d+)"));
-    if (rxId.indexIn(data) == -1) {
+    const QStringRef postId = BloggerId::postId(data);
+    if (postId.isNull()) {
         qCritical() << "Could not regexp the id out of the result:" << data;
         Q_EMIT q->errorPost(GData::Atom,
                           i18n("Could not regexp the id out of the result."), post);
         return;
     }
-    qCDebug(KBLOG_LOG) << "QRegExp rx( 'post-(\\d+)' ) matches" << rxId.cap(1);
+    qCDebug(KBLOG_LOG) << "Post id" << postId;
 
     QRegExp rxPub(QStringLiteral("<published>(.+)</published>"));
     if (rxPub.indexIn(data) == -1) {
@@ -950,7 +1209,7 @@ void GDataPrivate::slotCreateComment(KJob *job)
         return;
     }
     qCDebug(KBLOG_LOG) << "QRegExp rx( '<updated>(.+)</updated>' ) matches" << rxUp.cap(1);
-    comment->setCommentId(rxId.cap(1));
+    comment->setCommentId(postId.toString());
     comment->setCreationDateTime(QDateTime::fromString(rxPub.cap(1)));
     comment->setModificationDateTime(QDateTime::fromString(rxUp.cap(1)));
     comment->setStatus(BlogComment::Created);
@@ -965,7 +1224,7 @@ void GDataPrivate::slotRemoveComment(KJob *job)
         qCritical() << "job is a null pointer.";
         return;
     }
-    KIO::StoredTransferJob *stj = qobject_cast<KIO::StoredTransferJob *>(job);
+    TransportJob *stj = qobject_cast<TransportJob *>(job);
     const QString data = QString::fromUtf8(stj->data().constData(), stj->data().size());
 
     Q_Q(GData);
@@ -976,6 +1235,9 @@ void GDataPrivate::slotRemoveComment(KJob *job)
 
     if (job->error() != 0) {
         qCritical() << "slotRemoveComment error:" << job->errorString();
+        if (invalidateToken(job, RemoveComment, post, comment)) {
+            return;
+        }
         Q_EMIT q->errorComment(GData::Atom, job->errorString(), post, comment);
         return;
     }
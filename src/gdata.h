@@ -150,6 +150,26 @@ public:
     */
     void listRecentPosts(int number) override;
 
+    /**
+      Synchronize the posts with the server. Only the posts updated since
+      the last sync are downloaded. The Atom feed does not list removed
+      posts, so none are reported.
+
+      @see Blog::syncPosts()
+      @see syncedPosts()
+    */
+    void syncPosts() override;
+
+    /**
+      List recent posts page by page. Every page is a separate request to
+      the Atom feed using start-index and max-results, so only one page is
+      held in memory at a time.
+
+      @see Blog::listRecentPostsPaged()
+      @see listedRecentPostsPage()
+    */
+    void listRecentPostsPaged(int number, int pageSize) override;
+
     /**
       List recent posts on the server depending on meta information about the post.
       @param label The lables of posts to fetch.
@@ -287,22 +307,30 @@ protected:
 
 private:
     Q_DECLARE_PRIVATE(GData)
+    Q_PRIVATE_SLOT(d_func(),
+                   void slotAuthenticate(KJob *))
     Q_PRIVATE_SLOT(d_func(),
                    void slotFetchProfileId(KJob *))
     Q_PRIVATE_SLOT(d_func(),
-                   void slotListBlogs(Syndication::Loader *,
+                   void slotListBlogs(KBlog::FeedLoader *,
                                       const Syndication::FeedPtr &, Syndication::ErrorCode))
     Q_PRIVATE_SLOT(d_func(),
-                   void slotListComments(Syndication::Loader *,
+                   void slotListComments(KBlog::FeedLoader *,
                                          const Syndication::FeedPtr &, Syndication::ErrorCode))
     Q_PRIVATE_SLOT(d_func(),
-                   void slotListAllComments(Syndication::Loader *,
+                   void slotListAllComments(KBlog::FeedLoader *,
                                             const Syndication::FeedPtr &, Syndication::ErrorCode))
     Q_PRIVATE_SLOT(d_func(),
-                   void slotListRecentPosts(Syndication::Loader *,
+                   void slotListRecentPosts(KBlog::FeedLoader *,
                                             const Syndication::FeedPtr &, Syndication::ErrorCode))
     Q_PRIVATE_SLOT(d_func(),
-                   void slotFetchPost(Syndication::Loader *,
+                   void slotListRecentPostsPage(KBlog::FeedLoader *,
+                                                const Syndication::FeedPtr &, Syndication::ErrorCode))
+    Q_PRIVATE_SLOT(d_func(),
+                   void slotSyncPosts(KBlog::FeedLoader *,
+                                      const Syndication::FeedPtr &, Syndication::ErrorCode))
+    Q_PRIVATE_SLOT(d_func(),
+                   void slotFetchPost(KBlog::FeedLoader *,
                                       const Syndication::FeedPtr &, Syndication::ErrorCode))
     Q_PRIVATE_SLOT(d_func(),
                    void slotCreatePost(KJob *))
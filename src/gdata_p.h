@@ -11,18 +11,16 @@
 
 #include "gdata.h"
 #include "blog_p.h"
+#include "feedloader.h"
 
-#include <syndication/loader.h>
+#include <syndication/item.h>
+
+#include <QHash>
 
 class KJob;
 class QDateTime;
 template <class T, class S>class QMap;
 
-namespace KIO
-{
-class Job;
-}
-
 namespace KBlog
 {
 
@@ -36,24 +34,69 @@ public:
     QMap<KJob *, QMap<KBlog::BlogPost *, KBlog::BlogComment *> > mRemoveCommentMap;
     QMap<KJob *, KBlog::BlogPost *> mModifyPostMap;
     QMap<KJob *, KBlog::BlogPost *> mRemovePostMap;
-    QMap<Syndication::Loader *, KBlog::BlogPost *> mFetchPostMap;
-    QMap<Syndication::Loader *, KBlog::BlogPost *> mListCommentsMap;
-    QMap<Syndication::Loader *, int> mListRecentPostsMap;
+    // all posts are looked up in the same feed, so the fetches in flight
+    // share the loader of their feed
+    QMap<KBlog::FeedLoader *, QList<KBlog::BlogPost *> > mFetchPostMap;
+    QHash<QUrl, KBlog::FeedLoader *> mFetchPostLoaders;
+    QMap<KBlog::FeedLoader *, KBlog::BlogPost *> mListCommentsMap;
+    QMap<KBlog::FeedLoader *, int> mListRecentPostsMap;
+    QMap<KBlog::FeedLoader *, int> mSyncPostsMap;
+    QMap<KBlog::FeedLoader *, quint32> mListRecentPostsPageMap;
+    QList<KBlog::BlogPost> mSyncPosts;
     QString mFullName;
     QString mProfileId;
     GDataPrivate();
     ~GDataPrivate();
-    bool authenticate();
+
+    enum OperationType {
+        CreatePost,
+        ModifyPost,
+        RemovePost,
+        CreateComment,
+        RemoveComment
+    };
+    struct PendingOperation {
+        OperationType mType;
+        KBlog::BlogPost *mPost;
+        KBlog::BlogComment *mComment;
+    };
+    enum AuthState {
+        NotAuthenticated,
+        Authenticating,
+        Authenticated
+    };
+    AuthState mAuthState;
+    QString mTokenUser;
+    // the token the last login has granted
+    QString mGrantedToken;
+    QList<PendingOperation> mPendingOperations;
+
+    bool authenticate(OperationType type, KBlog::BlogPost *post,
+                      KBlog::BlogComment *comment = nullptr);
+    QString tokenFileName() const;
+    void loadToken();
+    void saveToken();
+    bool invalidateToken(KJob *job, OperationType type, KBlog::BlogPost *post,
+                         KBlog::BlogComment *comment = nullptr);
+    void sendOperation(const PendingOperation &operation);
+    bool readPostFromItem(const Syndication::ItemPtr &item, KBlog::BlogPost *post);
+    void syncPosts(int startIndex);
+    void listRecentPostsPage();
+    virtual void slotAuthenticate(KJob *);
     virtual void slotFetchProfileId(KJob *);
-    virtual void slotListBlogs(Syndication::Loader *,
+    virtual void slotListBlogs(KBlog::FeedLoader *,
                                const Syndication::FeedPtr &, Syndication::ErrorCode);
-    virtual void slotListComments(Syndication::Loader *,
+    virtual void slotListComments(KBlog::FeedLoader *,
                                   const Syndication::FeedPtr &, Syndication::ErrorCode);
-    virtual void slotListAllComments(Syndication::Loader *,
+    virtual void slotListAllComments(KBlog::FeedLoader *,
                                      const Syndication::FeedPtr &, Syndication::ErrorCode);
-    virtual void slotListRecentPosts(Syndication::Loader *,
+    virtual void slotListRecentPosts(KBlog::FeedLoader *,
                                      const Syndication::FeedPtr &, Syndication::ErrorCode);
-    virtual void slotFetchPost(Syndication::Loader *,
+    virtual void slotListRecentPostsPage(KBlog::FeedLoader *,
+                                         const Syndication::FeedPtr &, Syndication::ErrorCode);
+    virtual void slotSyncPosts(KBlog::FeedLoader *,
+                               const Syndication::FeedPtr &, Syndication::ErrorCode);
+    virtual void slotFetchPost(KBlog::FeedLoader *,
                                const Syndication::FeedPtr &, Syndication::ErrorCode);
     virtual void slotCreatePost(KJob *);
     virtual void slotModifyPost(KJob *);
@@ -0,0 +1,124 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "journalmirror.h"
+#include "journalmirror_p.h"
+#include "blog.h"
+#include "blogpost.h"
+#include "blogpost_p.h"
+
+#include "kblog_debug.h"
+
+#include <QCryptographicHash>
+#include <QUrl>
+
+using namespace KBlog;
+
+JournalMirror::JournalMirror(const Blog &blog)
+    : d(new JournalMirrorPrivate)
+{
+    d->mUrl = blog.url().url();
+    d->mBlogId = blog.blogId();
+    d->mUsername = blog.username();
+    d->mUidPrefix = BlogPostPrivate::journalUidPrefix(d->mUrl, d->mBlogId, d->mUsername);
+}
+
+JournalMirror::~JournalMirror()
+{
+    delete d;
+}
+
+QByteArray JournalMirrorPrivate::contentHash(const QString &title, const QString &content,
+                                             const QStringList &categories,
+                                             const QDateTime &dtStart)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(dtStart.toUTC().toString(Qt::ISODate).toUtf8());
+    hash.addData("\n", 1);
+    hash.addData(title.toUtf8());
+    hash.addData("\n", 1);
+    hash.addData(categories.join(QLatin1Char('\n')).toUtf8());
+    hash.addData("\n", 1);
+    hash.addData(content.toUtf8());
+    return hash.result().toHex();
+}
+
+QString JournalMirror::journalUid(const QString &postId) const
+{
+    return d->mUidPrefix + postId;
+}
+
+int JournalMirror::exportPosts(const QList<BlogPost> &posts,
+                               const KCalendarCore::Calendar::Ptr &calendar)
+{
+    if (!calendar) {
+        qCritical() << "calendar is a null pointer.";
+        return 0;
+    }
+
+    int changed = 0;
+    calendar->startBatchAdding();
+    for (const BlogPost &post : posts) {
+        if (post.postId().isEmpty()) {
+            continue;
+        }
+        const QString uid = d->mUidPrefix + post.postId();
+        const QString hash = QString::fromLatin1(
+                                 JournalMirrorPrivate::contentHash(post.title(), post.content(),
+                                                                   post.categories(),
+                                                                   post.creationDateTime()));
+        KCalendarCore::Journal::Ptr journal = calendar->journal(uid);
+        if (journal) {
+            if (journal->customProperty("KBLOG", "HASH") == hash) {
+                continue;
+            }
+            journal->startUpdates();
+            BlogPostPrivate::writeJournal(post, journal.data(), d->mUrl, d->mBlogId, d->mUsername);
+            journal->setCustomProperty("KBLOG", "HASH", hash);
+            journal->endUpdates();
+        } else {
+            journal = KCalendarCore::Journal::Ptr(new KCalendarCore::Journal());
+            journal->setUid(uid);
+            BlogPostPrivate::writeJournal(post, journal.data(), d->mUrl, d->mBlogId, d->mUsername);
+            journal->setCustomProperty("KBLOG", "HASH", hash);
+            calendar->addJournal(journal);
+        }
+        ++changed;
+    }
+    calendar->endBatchAdding();
+    qCDebug(KBLOG_LOG) << "Exported" << changed << "of" << posts.count() << "posts";
+    return changed;
+}
+
+QList<BlogPost> JournalMirror::importJournals(const KCalendarCore::Journal::List &journals) const
+{
+    QList<BlogPost> posts;
+    for (const KCalendarCore::Journal::Ptr &journal : journals) {
+        if (!journal) {
+            continue;
+        }
+        const QString hash = journal->customProperty("KBLOG", "HASH");
+        if (!journal->customProperty("KBLOG", "ID").isEmpty()) {
+            if (!journal->uid().startsWith(d->mUidPrefix)) {
+                // a journal of another blog
+                continue;
+            }
+            if (!hash.isEmpty() &&
+                    hash == QString::fromLatin1(
+                        JournalMirrorPrivate::contentHash(journal->summary(),
+                                                          journal->description(),
+                                                          journal->categories(),
+                                                          journal->dtStart()))) {
+                continue;
+            }
+        }
+        posts.append(BlogPost(journal));
+    }
+    qCDebug(KBLOG_LOG) << "Imported" << posts.count() << "of" << journals.count() << "journals";
+    return posts;
+}
@@ -0,0 +1,103 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_JOURNALMIRROR_H
+#define KBLOG_JOURNALMIRROR_H
+
+#include <kblog_export.h>
+
+#include <kcalendarcore/calendar.h>
+
+#include <QList>
+#include <QString>
+
+/**
+  @file
+  This file is part of the library for accessing blogs and defines the
+  JournalMirror class.
+*/
+
+namespace KBlog
+{
+
+class Blog;
+class BlogPost;
+class JournalMirrorPrivate;
+
+/**
+  @brief
+  Mirrors the posts of a blog into the journals of a calendar and back.
+
+  The journals are the ones BlogPost::journal() creates, with the same
+  uids, and carry a hash of their content in addition. Exporting skips
+  posts whose journal already has that content, so a calendar can be
+  refreshed with every list of posts the blog delivers. Importing skips
+  journals that have not been changed since they were exported, so only
+  the journals edited or created in the calendar are turned into posts.
+
+  The posts and journals are handed over in batches of any size, e.g.
+  as Blog::listedRecentPosts() delivers them:
+
+  @code
+  KBlog::JournalMirror mirror( *myblog );
+  connect( myblog, &KBlog::Blog::listedRecentPosts, this,
+           [&]( const QList<KBlog::BlogPost> &posts ) {
+             mirror.exportPosts( posts, calendar );
+           } );
+  ...
+  const QList<KBlog::BlogPost> changed = mirror.importJournals( calendar->journals() );
+  @endcode
+*/
+class KBLOG_EXPORT JournalMirror
+{
+public:
+    /**
+      Creates a mirror for the posts of @p blog. The url, blogId and
+      username of @p blog are copied, so later changes to them are not
+      seen by the mirror.
+    */
+    explicit JournalMirror(const Blog &blog);
+
+    /**
+      Destroys the mirror.
+    */
+    ~JournalMirror();
+
+    /**
+      Returns the uid of the journal of the post @p postId, the same
+      BlogPost::journal() uses.
+    */
+    QString journalUid(const QString &postId) const;
+
+    /**
+      Adds a journal for every post of @p posts to @p calendar, or updates
+      the journal already there. Journals that already have the content of
+      their post are left alone, as are posts without id.
+
+      @param posts the posts to export.
+      @param calendar the calendar to add the journals to.
+      @return the number of journals added or changed.
+    */
+    int exportPosts(const QList<BlogPost> &posts, const KCalendarCore::Calendar::Ptr &calendar);
+
+    /**
+      Returns a post for every journal of @p journals that has been changed
+      since it was exported, or that has never been exported. Journals of
+      other blogs are skipped.
+
+      @param journals the journals to import, e.g. Calendar::journals().
+    */
+    QList<BlogPost> importJournals(const KCalendarCore::Journal::List &journals) const;
+
+private:
+    JournalMirrorPrivate *const d;
+    Q_DISABLE_COPY(JournalMirror)
+};
+
+} //namespace KBlog
+#endif
@@ -0,0 +1,34 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_JOURNALMIRROR_P_H
+#define KBLOG_JOURNALMIRROR_P_H
+
+#include "journalmirror.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QStringList>
+
+namespace KBlog
+{
+
+class JournalMirrorPrivate
+{
+public:
+    QString mUrl;
+    QString mBlogId;
+    QString mUsername;
+    QString mUidPrefix;
+
+    static QByteArray contentHash(const QString &title, const QString &content,
+                                  const QStringList &categories, const QDateTime &dtStart);
+};
+
+} //namespace KBlog
+#endif
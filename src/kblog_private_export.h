@@ -0,0 +1,23 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_PRIVATE_EXPORT_H
+#define KBLOG_PRIVATE_EXPORT_H
+
+#include "kblog_export.h"
+
+/* Classes which are exported only for unit tests and benchmarks */
+#ifdef KBLOG_BUILD_TESTS
+# ifndef KBLOG_TESTS_EXPORT
+#  define KBLOG_TESTS_EXPORT KBLOG_EXPORT
+# endif
+#else /* not compiling tests */
+# define KBLOG_TESTS_EXPORT
+#endif
+
+#endif
@@ -10,18 +10,14 @@
 
 #include "metaweblog.h"
 #include "metaweblog_p.h"
+#include "categorycache_p.h"
 #include "blogpost.h"
 #include "blogmedia.h"
 
-#include <kxmlrpcclient/client.h>
 #include "kblog_debug.h"
 #include <KLocalizedString>
 
-#include <QFile>
-#include <QDataStream>
-#include <QStandardPaths>
-#include <QDir>
-#include <QFileInfo>
+#include <QDateTime>
 
 using namespace KBlog;
 
@@ -51,11 +47,17 @@ void MetaWeblog::listCategories()
 {
     Q_D(MetaWeblog);
     qCDebug(KBLOG_LOG) << "Fetching List of Categories...";
+    if (!d->isSupported(QStringLiteral("metaWeblog.getCategories"))) {
+        return;
+    }
     QList<QVariant> args(d->defaultArgs(blogId()));
-    d->mXmlRpcClient->call(
-        QStringLiteral("metaWeblog.getCategories"), args,
-        this, SLOT(slotListCategories(QList<QVariant>,QVariant)),
-        this, SLOT(slotError(int,QString,QVariant)));
+    if (d->mXmlRpcClient->call(
+                QStringLiteral("metaWeblog.getCategories"), args,
+                this, SLOT(slotListCategories(QList<QVariant>,QVariant)),
+                this, SLOT(slotError(int,QString,QVariant)),
+                QVariant(), true)) {
+        ++d->mSharedRequests;
+    }
 }
 
 void MetaWeblog::createMedia(KBlog::BlogMedia *media)
@@ -66,6 +68,9 @@ void MetaWeblog::createMedia(KBlog::BlogMedia *media)
         Q_EMIT error(Other, i18n("Media is a null pointer."));
         return;
     }
+    if (!d->isSupported(QStringLiteral("metaWeblog.newMediaObject"))) {
+        return;
+    }
     unsigned int i = d->mCallMediaCounter++;
     d->mCallMediaMap[ i ] = media;
     qCDebug(KBLOG_LOG) << "MetaWeblog::createMedia: name=" << media->name();
@@ -73,7 +78,15 @@ void MetaWeblog::createMedia(KBlog::BlogMedia *media)
     QMap<QString, QVariant> map;
     map[QStringLiteral("name")] = media->name();
     map[QStringLiteral("type")] = media->mimetype();
-    map[QStringLiteral("bits")] = media->data();
+    if (media->device() || !media->fileName().isEmpty()) {
+        // the data is encoded while it is sent, so it is never loaded as a whole
+        XmlRpcStream stream;
+        stream.mDevice = media->device();
+        stream.mFileName = media->fileName();
+        map[QStringLiteral("bits")] = QVariant::fromValue(stream);
+    } else {
+        map[QStringLiteral("bits")] = media->data();
+    }
     args << map;
     d->mXmlRpcClient->call(
         QStringLiteral("metaWeblog.newMediaObject"), args,
@@ -87,7 +100,6 @@ MetaWeblogPrivate::MetaWeblogPrivate()
 {
     qCDebug(KBLOG_LOG);
     mCallMediaCounter = 1;
-    mCatLoaded = false;
 }
 
 MetaWeblogPrivate::~MetaWeblogPrivate()
@@ -107,61 +119,73 @@ QList<QVariant> MetaWeblogPrivate::defaultArgs(const QString &id)
     return args;
 }
 
-void MetaWeblogPrivate::loadCategories()
+bool MetaWeblogPrivate::categoryCacheKey(QString *key) const
 {
-    qCDebug(KBLOG_LOG);
-
-    if (mCatLoaded) {
-        return;
-    }
-    mCatLoaded = true;
-
     if (mUrl.isEmpty() || mBlogId.isEmpty() || mUsername.isEmpty()) {
         qCDebug(KBLOG_LOG) << "We need at least url, blogId and the username to create a unique filename.";
-        return;
+        return false;
     }
+    *key = CategoryCache::key(mUrl.host(), mBlogId, mUsername);
+    return true;
+}
+
+void MetaWeblogPrivate::setCategories(const CategoryCache::Entry &entry)
+{
+    mCategoriesList = entry.mCategories;
+    mCategoryIds = entry.mCategoryIds;
+    mCategoryNames = entry.mCategoryNames;
+}
 
-    QString filename = QStringLiteral("kblog/") + mUrl.host() + QLatin1Char('_') + mBlogId + QLatin1Char('_') + mUsername;
-    filename = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QLatin1Char('/') + filename;
-    QDir().mkpath(QFileInfo(filename).absolutePath());
-    QFile file(filename);
-    if (!file.open(QIODevice::ReadOnly)) {
-        qCDebug(KBLOG_LOG) << "Cannot open cached categories file: " << filename;
+void MetaWeblogPrivate::loadCategories()
+{
+    qCDebug(KBLOG_LOG);
+
+    QString key;
+    if (!categoryCacheKey(&key)) {
         return;
     }
 
-    QDataStream stream(&file);
-    stream >> mCategoriesList;
-    file.close();
+    // the cache reads the file once for all objects of the blog and hands
+    // out the categories another object has listed since
+    CategoryCache *cache = CategoryCache::self();
+    const CategoryCache::Entry entry = cache->entry(key);
+    setCategories(entry);
+    if (!entry.mCategories.isEmpty() && !cache->isFresh(entry) && cache->startRefresh(key)) {
+        refreshCategories();
+    }
 }
 
 void MetaWeblogPrivate::saveCategories()
 {
     qCDebug(KBLOG_LOG);
-    if (mUrl.isEmpty() || mBlogId.isEmpty() || mUsername.isEmpty()) {
-        qCDebug(KBLOG_LOG) << "We need at least url, blogId and the username to create a unique filename.";
-        return;
-    }
 
-    QString filename = QStringLiteral("kblog/") + mUrl.host() + QLatin1Char('_') + mBlogId + QLatin1Char('_') + mUsername;
-    filename = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) + QLatin1Char('/') + filename;
-    QDir().mkpath(QFileInfo(filename).absolutePath());
-    QFile file(filename);
-    if (!file.open(QIODevice::WriteOnly)) {
-        qCDebug(KBLOG_LOG) << "Cannot open cached categories file: " << filename;
+    QString key;
+    if (!categoryCacheKey(&key)) {
+        setCategories(CategoryCache::makeEntry(mCategoriesList, QDateTime::currentDateTimeUtc()));
         return;
     }
+    setCategories(CategoryCache::self()->store(key, mCategoriesList));
+}
 
-    QDataStream stream(&file);
-    stream << mCategoriesList;
-    file.close();
+void MetaWeblogPrivate::refreshCategories()
+{
+    Q_Q(MetaWeblog);
+    qCDebug(KBLOG_LOG) << "Refreshing the cached categories in the background";
+    if (mXmlRpcClient->call(
+                QStringLiteral("metaWeblog.getCategories"), defaultArgs(mBlogId),
+                q, SLOT(slotListCategories(QList<QVariant>,QVariant)),
+                q, SLOT(slotRefreshCategoriesError(int,QString,QVariant)),
+                QVariant(true), true)) {
+        ++mSharedRequests;
+    }
 }
 
 void MetaWeblogPrivate::slotListCategories(const QList<QVariant> &result,
         const QVariant &id)
 {
     Q_Q(MetaWeblog);
-    Q_UNUSED(id);
+    // true for refreshCategories(), which does not bother the application
+    const bool refresh = id.toBool();
 
     qCDebug(KBLOG_LOG) << "MetaWeblogPrivate::slotListCategories";
     qCDebug(KBLOG_LOG) << "TOP:" << result[0].typeName();
@@ -170,30 +194,35 @@ void MetaWeblogPrivate::slotListCategories(const QList<QVariant> &result,
         // include fix for not metaweblog standard compatible apis with
         // array of structs instead of struct of structs, e.g. wordpress
         qCritical() << "Could not list categories out of the result from the server.";
+        if (refresh) {
+            QString key;
+            if (categoryCacheKey(&key)) {
+                CategoryCache::self()->cancelRefresh(key);
+            }
+            return;
+        }
         Q_EMIT q->error(MetaWeblog::ParsingError,
                       i18n("Could not list categories out of the result "
                            "from the server."));
-    } else {
-        if (result[0].type() == QVariant::Map) {
-            const QMap<QString, QVariant> serverMap = result[0].toMap();
-            for (auto it = serverMap.cbegin(), end = serverMap.cend(); it != end; ++it) {
-                const QString &key = it.key();
-                qCDebug(KBLOG_LOG) << "MIDDLE:" << key;
-                QMap<QString, QString> category;
-                const QMap<QString, QVariant> serverCategory = it.value().toMap();
-                category[QStringLiteral("name")] = key;
-                category[QStringLiteral("description")] = serverCategory[ QStringLiteral("description") ].toString();
-                category[QStringLiteral("htmlUrl")] = serverCategory[ QStringLiteral("htmlUrl") ].toString();
-                category[QStringLiteral("rssUrl")] = serverCategory[ QStringLiteral("rssUrl") ].toString();
-                category[QStringLiteral("categoryId")] = serverCategory[ QStringLiteral("categoryId") ].toString();
-                category[QStringLiteral("parentId")] = serverCategory[ QStringLiteral("parentId") ].toString();
-                mCategoriesList.append(category);
-            }
-            qCDebug(KBLOG_LOG) << "Emitting listedCategories";
-            Q_EMIT q->listedCategories(mCategoriesList);
-        }
+        return;
     }
-    if (result[0].type() == QVariant::List) {
+    mCategoriesList.clear();
+    if (result[0].type() == QVariant::Map) {
+        const QMap<QString, QVariant> serverMap = result[0].toMap();
+        for (auto it = serverMap.cbegin(), end = serverMap.cend(); it != end; ++it) {
+            const QString &key = it.key();
+            qCDebug(KBLOG_LOG) << "MIDDLE:" << key;
+            QMap<QString, QString> category;
+            const QMap<QString, QVariant> serverCategory = it.value().toMap();
+            category[QStringLiteral("name")] = key;
+            category[QStringLiteral("description")] = serverCategory[ QStringLiteral("description") ].toString();
+            category[QStringLiteral("htmlUrl")] = serverCategory[ QStringLiteral("htmlUrl") ].toString();
+            category[QStringLiteral("rssUrl")] = serverCategory[ QStringLiteral("rssUrl") ].toString();
+            category[QStringLiteral("categoryId")] = serverCategory[ QStringLiteral("categoryId") ].toString();
+            category[QStringLiteral("parentId")] = serverCategory[ QStringLiteral("parentId") ].toString();
+            mCategoriesList.append(category);
+        }
+    } else {
         // include fix for not metaweblog standard compatible apis with
         // array of structs instead of struct of structs, e.g. wordpress
         const QList<QVariant> serverList = result[0].toList();
@@ -211,10 +240,24 @@ void MetaWeblogPrivate::slotListCategories(const QList<QVariant> &result,
             category[QStringLiteral("parentId")] = serverCategory[ QStringLiteral("parentId") ].toString();
             mCategoriesList.append(category);
         }
+    }
+    saveCategories();
+    if (!refresh) {
         qCDebug(KBLOG_LOG) << "Emitting listedCategories()";
         Q_EMIT q->listedCategories(mCategoriesList);
     }
-    saveCategories();
+}
+
+void MetaWeblogPrivate::slotRefreshCategoriesError(int number, const QString &errorString,
+        const QVariant &id)
+{
+    Q_UNUSED(number);
+    Q_UNUSED(id);
+    qCWarning(KBLOG_LOG) << "Could not refresh the cached categories:" << errorString;
+    QString key;
+    if (categoryCacheKey(&key)) {
+        CategoryCache::self()->cancelRefresh(key);
+    }
 }
 
 void MetaWeblogPrivate::slotCreateMedia(const QList<QVariant> &result,
@@ -246,52 +289,31 @@ void MetaWeblogPrivate::slotCreateMedia(const QList<QVariant> &result,
     }
 }
 
-bool MetaWeblogPrivate::readPostFromMap(BlogPost *post,
-                                        const QMap<QString, QVariant> &postInfo)
+bool MetaWeblogPrivate::readPostFromFields(BlogPost *post, const PostFields &fields)
 {
     // FIXME: integrate error handling
-    qCDebug(KBLOG_LOG) << "readPostFromMap()";
+    qCDebug(KBLOG_LOG) << "readPostFromFields()";
     if (!post) {
         return false;
     }
 
-    qCDebug(KBLOG_LOG)
-        #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
-            << endl
-           #else
-            << Qt::endl
-           #endif
-            << "Keys:" << QStringList(postInfo.keys()).join(QLatin1String(", "));
-    qCDebug(KBLOG_LOG)
-        #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
-            << endl
-           #else
-            << Qt::endl
-           #endif
-               ;
-
-    QDateTime dt = postInfo[QStringLiteral("dateCreated")].toDateTime();
+    QDateTime dt = fields.mDateCreated;
     if (dt.isValid() && !dt.isNull()) {
         post->setCreationDateTime(dt.toLocalTime());
     }
 
-    dt = postInfo[QStringLiteral("lastModified")].toDateTime();
+    dt = fields.mLastModified;
     if (dt.isValid() && !dt.isNull()) {
         post->setModificationDateTime(dt.toLocalTime());
     }
 
-    post->setPostId(postInfo[QStringLiteral("postid")].toString().isEmpty() ? postInfo[QStringLiteral("postId")].toString() :
-                    postInfo[QStringLiteral("postid")].toString());
-
-    QString title(postInfo[QStringLiteral("title")].toString());
-    QString description(postInfo[QStringLiteral("description")].toString());
-    QStringList categories(postInfo[QStringLiteral("categories")].toStringList());
+    post->setPostId(fields.mPostId);
 
-    post->setTitle(title);
-    post->setContent(description);
-    if (!categories.isEmpty()) {
-        qCDebug(KBLOG_LOG) << "Categories:" << categories;
-        post->setCategories(categories);
+    post->setTitle(fields.mTitle);
+    post->setContent(fields.mDescription);
+    if (!fields.mCategories.isEmpty()) {
+        qCDebug(KBLOG_LOG) << "Categories:" << fields.mCategories;
+        post->setCategories(fields.mCategories);
     }
     return true;
 }
@@ -121,6 +121,8 @@ private:
                    void slotListCategories(const QList<QVariant> &, const QVariant &))
     Q_PRIVATE_SLOT(d_func(),
                    void slotCreateMedia(const QList<QVariant> &, const QVariant &))
+    Q_PRIVATE_SLOT(d_func(),
+                   void slotRefreshCategoriesError(int, const QString &, const QVariant &))
 };
 
 } //namespace KBlog
@@ -12,8 +12,9 @@
 
 #include "metaweblog.h"
 #include "blogger1_p.h"
+#include "categorycache_p.h"
 
-#include <kxmlrpcclient/client.h>
+#include <QHash>
 
 namespace KBlog
 {
@@ -23,23 +24,30 @@ class MetaWeblogPrivate : public Blogger1Private
 public:
     QMap<QString, QString> mCategories;
     QList<QMap<QString, QString> > mCategoriesList;
+    // the indexes of mCategoriesList, built by the CategoryCache
+    QHash<QString, QString> mCategoryIds;
+    QHash<QString, QString> mCategoryNames;
     unsigned int mCallMediaCounter;
     QMap<unsigned int, KBlog::BlogMedia *> mCallMediaMap;
     MetaWeblogPrivate();
     ~MetaWeblogPrivate();
     virtual void loadCategories();
     virtual void saveCategories();
+    bool categoryCacheKey(QString *key) const;
+    void setCategories(const CategoryCache::Entry &entry);
+    void refreshCategories();
     virtual void slotListCategories(const QList<QVariant> &result,
                                     const QVariant &id);
+    void slotRefreshCategoriesError(int number, const QString &errorString,
+                                    const QVariant &id);
     virtual void slotCreateMedia(const QList<QVariant> &result,
                                  const QVariant &id);
     Q_DECLARE_PUBLIC(MetaWeblog)
 
     QList<QVariant> defaultArgs(const QString &id = QString()) override;
-    bool readPostFromMap(BlogPost *post, const QMap<QString, QVariant> &postInfo) override;
+    bool readPostFromFields(BlogPost *post, const PostFields &fields) override;
     bool readArgsFromPost(QList<QVariant> *args, const BlogPost &post) override;
     QString getCallFromFunction(FunctionToCall type) override;
-    bool mCatLoaded;
 };
 
 }
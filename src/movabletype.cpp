@@ -12,9 +12,6 @@
 #include "movabletype_p.h"
 #include "blogpost.h"
 
-#include <kxmlrpcclient/client.h>
-#include <kio/job.h>
-
 #include "kblog_debug.h"
 #include <KLocalizedString>
 
@@ -51,7 +48,7 @@ void MovableType::listRecentPosts(int number)
     qCDebug(KBLOG_LOG);
     QList<QVariant> args(d->defaultArgs(blogId()));
     args << QVariant(number);
-    d->mXmlRpcClient->call(
+    d->mXmlRpcClient->callPosts(
         QStringLiteral("metaWeblog.getRecentPosts"), args,
         this, SLOT(slotListRecentPosts(QList<QVariant>,QVariant)),
         this, SLOT(slotError(int,QString,QVariant)),
@@ -62,6 +59,9 @@ void MovableType::listTrackBackPings(KBlog::BlogPost *post)
 {
     Q_D(MovableType);
     qCDebug(KBLOG_LOG);
+    if (!d->isSupported(QStringLiteral("mt.getTrackbackPings"))) {
+        return;
+    }
     QList<QVariant> args;
     args << QVariant(post->postId());
     unsigned int i = d->mCallCounter++;
@@ -77,22 +77,35 @@ void MovableType::fetchPost(BlogPost *post)
 {
     Q_D(MovableType);
     qCDebug(KBLOG_LOG);
+    if (d->fetchPostFromStore(post)) {
+        return;
+    }
     d->loadCategories();
-    if (d->mCategoriesList.isEmpty() &&
-            post->categories().count()) {
-        d->mFetchPostCache << post;
-        if (d->mFetchPostCache.count()) {
-            // we are already trying to fetch another post, so we don't need to start
-            // another listCategories() job
-            return;
-        }
+    if (!post->categories().isEmpty() &&
+            d->waitForCategories(MovableTypePrivate::WaitingFetch, post)) {
+        return;
+    }
+    MetaWeblog::fetchPost(post);
+}
 
-        connect(this, SIGNAL(listedCategories(QList<QMap<QString,QString> >)),
-                this, SLOT(slotTriggerFetchPost()));
-        listCategories();
-    } else {
-        MetaWeblog::fetchPost(post);
+QList<QStringList> MovableType::resolveCategories(const QList<BlogPost *> &posts)
+{
+    Q_D(MovableType);
+    d->loadCategories();
+    QList<QStringList> categoryIds;
+    categoryIds.reserve(posts.count());
+    for (BlogPost *post : posts) {
+        QStringList unknown;
+        if (post) {
+            categoryIds << d->resolveCategories(post->categories(), &unknown);
+        } else {
+            categoryIds << QStringList();
+        }
+        if (!unknown.isEmpty()) {
+            Q_EMIT unresolvedCategories(post, unknown);
+        }
     }
+    return categoryIds;
 }
 
 void MovableType::createPost(BlogPost *post)
@@ -105,29 +118,30 @@ void MovableType::createPost(BlogPost *post)
     // we need mCategoriesList to be loaded first, since we cannot use the post->categories()
     // names later, but we need to map them to categoryId of the blog
     d->loadCategories();
-    if (d->mCategoriesList.isEmpty() &&
-            !post->categories().isEmpty()) {
+    if (!post->categories().isEmpty() &&
+            d->waitForCategories(MovableTypePrivate::WaitingCreate, post)) {
         qCDebug(KBLOG_LOG) << "No categories in the cache yet. Have to fetch them first.";
-        d->mCreatePostCache << post;
-        connect(this, SIGNAL(listedCategories(QList<QMap<QString,QString> >)),
-                this, SLOT(slotTriggerCreatePost()));
-        listCategories();
-    } else {
-        bool publish = post->isPrivate();
-        // If we do setPostCategories() later than we disable publishing first.
-        if (!post->categories().isEmpty()) {
-            post->setPrivate(true);
-            if (d->mSilentCreationList.contains(post)) {
-                qCDebug(KBLOG_LOG) << "Post already in mSilentCreationList, this *should* never happen!";
-            } else {
-                d->mSilentCreationList << post;
-            }
-        }
+        return;
+    }
+    if (d->mNewPostCategories == MovableTypePrivate::NewPostCategoriesSupported) {
+        // one request, the server sets the categories itself
         MetaWeblog::createPost(post);
-        // HACK: uuh this a bit ugly now... reenable the original publish argument,
-        // since createPost should have parsed now
-        post->setPrivate(publish);
+        return;
     }
+    bool publish = post->isPrivate();
+    // If we do setPostCategories() later than we disable publishing first.
+    if (!post->categories().isEmpty()) {
+        post->setPrivate(true);
+        if (d->mSilentCreationList.contains(post)) {
+            qCDebug(KBLOG_LOG) << "Post already in mSilentCreationList, this *should* never happen!";
+        } else {
+            d->mSilentCreationList << post;
+        }
+    }
+    MetaWeblog::createPost(post);
+    // HACK: uuh this a bit ugly now... reenable the original publish argument,
+    // since createPost should have parsed now
+    post->setPrivate(publish);
 }
 
 void MovableType::modifyPost(BlogPost *post)
@@ -140,73 +154,150 @@ void MovableType::modifyPost(BlogPost *post)
     // we need mCategoriesList to be loaded first, since we cannot use the post->categories()
     // names later, but we need to map them to categoryId of the blog
     d->loadCategories();
-    if (d->mCategoriesList.isEmpty() &&
-            !post->categories().isEmpty()) {
+    if (!post->categories().isEmpty() &&
+            d->waitForCategories(MovableTypePrivate::WaitingModify, post)) {
         qCDebug(KBLOG_LOG) << "No categories in the cache yet. Have to fetch them first.";
-        d->mModifyPostCache << post;
-        connect(this, SIGNAL(listedCategories(QList<QMap<QString,QString> >)),
-                this, SLOT(slotTriggerModifyPost()));
-        listCategories();
-    } else {
-        MetaWeblog::modifyPost(post);
+        return;
     }
+    MetaWeblog::modifyPost(post);
 }
 
-void MovableTypePrivate::slotTriggerCreatePost()
+MovableTypePrivate::MovableTypePrivate()
+    : mNewPostCategories(NewPostCategoriesUnknown),
+      mPrefetchingCategories(false),
+      mReleasingCategoryWaiters(false)
 {
     qCDebug(KBLOG_LOG);
-    Q_Q(MovableType);
-
-    q->disconnect(q, SIGNAL(listedCategories(QList<QMap<QString,QString> >)),
-                  q, SLOT(slotTriggerCreatePost()));
-    // now we can recall createPost with the posts from the cache
-    QList<BlogPost *>::Iterator it = mCreatePostCache.begin();
-    QList<BlogPost *>::Iterator end = mCreatePostCache.end();
-    for (; it != end; it++) {
-        q->createPost(*it);
-    }
-    mCreatePostCache.clear();
 }
 
-void MovableTypePrivate::slotTriggerModifyPost()
+MovableTypePrivate::~MovableTypePrivate()
 {
     qCDebug(KBLOG_LOG);
+}
+
+bool MovableTypePrivate::waitForCategories(CategoryWaiter waiter, BlogPost *post)
+{
     Q_Q(MovableType);
+    // the operations replayed by releaseCategoryWaiters() go ahead, even if
+    // the blog turned out to have no categories
+    if (mReleasingCategoryWaiters) {
+        return false;
+    }
+    const bool create = waiter == WaitingCreate && post && !post->categories().isEmpty();
+    if (create && mNewPostCategories == NewPostCategoriesUnknown) {
+        // answered right away if the methods of the server are cached
+        probeNewPostCategories();
+    }
+    // the names are enough if metaWeblog.newPost takes them
+    if (create && mNewPostCategories == NewPostCategoriesSupported) {
+        return false;
+    }
+    const bool probe = create && mNewPostCategories == NewPostCategoriesProbing;
+    if (!probe && !mCategoriesList.isEmpty()) {
+        return false;
+    }
+    mCategoryWaiters.append(qMakePair(waiter, post));
+    // in parallel to the probe, in case the server needs the ids after all
+    if (mCategoriesList.isEmpty() && !mPrefetchingCategories) {
+        mPrefetchingCategories = true;
+        if (mXmlRpcClient->call(
+                    QStringLiteral("metaWeblog.getCategories"), defaultArgs(mBlogId),
+                    q, SLOT(slotListCategories(QList<QVariant>,QVariant)),
+                    q, SLOT(slotPrefetchCategoriesError(int,QString,QVariant)),
+                    QVariant(), true)) {
+            ++mSharedRequests;
+        }
+    } else {
+        qCDebug(KBLOG_LOG) << "The server is already asked,"
+                           << mCategoryWaiters.count() << "operations waiting";
+    }
+    return true;
+}
 
-    q->disconnect(q, SIGNAL(listedCategories(QList<QMap<QString,QString> >)),
-                  q, SLOT(slotTriggerModifyPost()));
-    // now we can recall createPost with the posts from the cache
-    QList<BlogPost *>::Iterator it = mModifyPostCache.begin();
-    QList<BlogPost *>::Iterator end = mModifyPostCache.end();
-    for (; it != end; it++) {
-        q->modifyPost(*it);
+void MovableTypePrivate::releaseCategoryWaiters()
+{
+    Q_Q(MovableType);
+    if (mCategoryWaiters.isEmpty() || mPrefetchingCategories ||
+            mNewPostCategories == NewPostCategoriesProbing) {
+        return;
     }
-    mModifyPostCache.clear();
+    qCDebug(KBLOG_LOG) << "Releasing" << mCategoryWaiters.count() << "operations";
+    const QList<QPair<CategoryWaiter, BlogPost *> > waiters = mCategoryWaiters;
+    mCategoryWaiters.clear();
+    mReleasingCategoryWaiters = true;
+    for (const QPair<CategoryWaiter, BlogPost *> &waiter : waiters) {
+        switch (waiter.first) {
+        case WaitingCreate:
+            q->createPost(waiter.second);
+            break;
+        case WaitingModify:
+            q->modifyPost(waiter.second);
+            break;
+        case WaitingFetch:
+            q->fetchPost(waiter.second);
+            break;
+        }
+    }
+    mReleasingCategoryWaiters = false;
 }
 
-void MovableTypePrivate::slotTriggerFetchPost()
+void MovableTypePrivate::slotListCategories(const QList<QVariant> &result,
+        const QVariant &id)
+{
+    // any listing will do, whether it was the prefetch, listCategories()
+    // or a background refresh
+    MetaWeblogPrivate::slotListCategories(result, id);
+    mPrefetchingCategories = false;
+    releaseCategoryWaiters();
+}
+
+void MovableTypePrivate::slotPrefetchCategoriesError(int number, const QString &errorString,
+        const QVariant &id)
 {
-    qCDebug(KBLOG_LOG);
     Q_Q(MovableType);
+    Q_UNUSED(number);
+    Q_UNUSED(id);
+    qCDebug(KBLOG_LOG) << "An error occurred: " << errorString;
+    Q_EMIT q->error(MovableType::XmlRpc, errorString);
+    // rather than stalling, send the operations without the category ids;
+    // unresolvedCategories() reports the categories they lose
+    mPrefetchingCategories = false;
+    releaseCategoryWaiters();
+}
 
-    q->disconnect(q, SIGNAL(listedCategories(QList<QMap<QString,QString> >)),
-                  q, SLOT(slotTriggerFetchPost()));
-    QList<BlogPost *>::Iterator it = mFetchPostCache.begin();
-    QList<BlogPost *>::Iterator end = mFetchPostCache.end();
-    for (; it != end; it++) {
-        q->fetchPost(*it);
+void MovableTypePrivate::probeNewPostCategories()
+{
+    Q_Q(MovableType);
+    if (!mXmlRpcClient->probeMethods()) {
+        readNewPostCategories();
+        return;
     }
-    mFetchPostCache.clear();
+    qCDebug(KBLOG_LOG) << "Waiting for the methods of the server";
+    mNewPostCategories = NewPostCategoriesProbing;
+    QObject::connect(mXmlRpcClient, SIGNAL(methodsProbed()),
+                     q, SLOT(slotMethodsProbed()), Qt::UniqueConnection);
 }
 
-MovableTypePrivate::MovableTypePrivate()
+void MovableTypePrivate::readNewPostCategories()
 {
-    qCDebug(KBLOG_LOG);
+    // WordPress has always read the category names in metaWeblog.newPost,
+    // Movable Type itself ignores them
+    if (mXmlRpcClient->capabilities().lists(QStringLiteral("wp.getCategories"))) {
+        qCDebug(KBLOG_LOG) << "metaWeblog.newPost takes the categories";
+        mNewPostCategories = NewPostCategoriesSupported;
+    } else {
+        qCDebug(KBLOG_LOG) << "The categories have to be set after metaWeblog.newPost";
+        mNewPostCategories = NewPostCategoriesUnsupported;
+    }
 }
 
-MovableTypePrivate::~MovableTypePrivate()
+void MovableTypePrivate::slotMethodsProbed()
 {
-    qCDebug(KBLOG_LOG);
+    if (mNewPostCategories != NewPostCategoriesProbing) {
+        return;
+    }
+    readNewPostCategories();
+    releaseCategoryWaiters();
 }
 
 void MovableTypePrivate::slotCreatePost(const QList<QVariant> &result, const QVariant &id)
@@ -260,8 +351,10 @@ void MovableTypePrivate::slotFetchPost(const QList<QVariant> &result, const QVar
     //array of structs containing ISO.8601
     // dateCreated, String userid, String postid, String content;
     qCDebug(KBLOG_LOG) << "TOP:" << result[0].typeName();
-    if (result[0].type() == QVariant::Map &&
-            readPostFromMap(post, result[0].toMap())) {
+    bool ok;
+    const QList<PostFields> postReceived = PostFields::fromResult(result[0], &ok);
+    if (ok && postReceived.count() == 1 &&
+            readPostFromFields(post, postReceived.first())) {
     } else {
         qCritical() << "Could not fetch post out of the result from the server.";
         post->setError(i18n("Could not fetch post out of the result from the server."));
@@ -273,11 +366,13 @@ void MovableTypePrivate::slotFetchPost(const QList<QVariant> &result, const QVar
         QList<QVariant> args(defaultArgs(post->postId()));
         unsigned int i = mCallCounter++;
         mCallMap[ i ] = post;
-        mXmlRpcClient->call(
-            QStringLiteral("mt.getPostCategories"), args,
-            q, SLOT(slotGetPostCategories(QList<QVariant>,QVariant)),
-            q, SLOT(slotError(int,QString,QVariant)),
-            QVariant(i));
+        if (mXmlRpcClient->call(
+                    QStringLiteral("mt.getPostCategories"), args,
+                    q, SLOT(slotGetPostCategories(QList<QVariant>,QVariant)),
+                    q, SLOT(slotError(int,QString,QVariant)),
+                    QVariant(i), true)) {
+            ++mSharedRequests;
+        }
     } else {
         qCDebug(KBLOG_LOG) << "Emitting fetchedPost()";
         post->setStatus(KBlog::BlogPost::Fetched);
@@ -326,23 +421,19 @@ void MovableTypePrivate::setPostCategories(BlogPost *post, bool publishAfterCate
     QList<QVariant> catList;
     QList<QVariant> args(defaultArgs(post->postId()));
 
-    // map the categoryId of the server to the name
-    QStringList categories = post->categories();
-    for (int j = 0; j < categories.count(); j++) {
-        for (int k = 0; k < mCategoriesList.count(); k++) {
-            if (mCategoriesList[k][QStringLiteral("name")] == categories[j]) {
-                qCDebug(KBLOG_LOG) << "Matched category with name: " << categories[ j ] << " and id: " << mCategoriesList[ k ][ QStringLiteral("categoryId") ];
-                QMap<QString, QVariant> category;
-                //the first in the QStringList of post->categories()
-                // is the primary category
-                category[QStringLiteral("categoryId")] = mCategoriesList[k][QStringLiteral("categoryId")].toInt();
-                catList << QVariant(category);
-                break;
-            }
-            if (k == mCategoriesList.count()) {
-                qCDebug(KBLOG_LOG) << "Couldn't find categoryId for: " << categories[j];
-            }
-        }
+    // map the name to the categoryId of the server
+    QStringList unknown;
+    const QStringList categoryIds = resolveCategories(post->categories(), &unknown);
+    for (const QString &categoryId : categoryIds) {
+        QMap<QString, QVariant> category;
+        //the first in the QStringList of post->categories()
+        // is the primary category
+        category[QStringLiteral("categoryId")] = categoryId.toInt();
+        catList << QVariant(category);
+    }
+    if (!unknown.isEmpty()) {
+        qCDebug(KBLOG_LOG) << "Couldn't find categoryId for: " << unknown;
+        Q_EMIT q->unresolvedCategories(post, unknown);
     }
     args << QVariant(catList);
 
@@ -353,6 +444,22 @@ void MovableTypePrivate::setPostCategories(BlogPost *post, bool publishAfterCate
         QVariant(i));
 }
 
+QStringList MovableTypePrivate::resolveCategories(const QStringList &names,
+                                                  QStringList *unknown) const
+{
+    QStringList categoryIds;
+    categoryIds.reserve(names.count());
+    for (const QString &name : names) {
+        const QHash<QString, QString>::ConstIterator it = mCategoryIds.constFind(name);
+        if (it == mCategoryIds.constEnd()) {
+            unknown->append(name);
+        } else {
+            categoryIds.append(*it);
+        }
+    }
+    return categoryIds;
+}
+
 void MovableTypePrivate::slotGetPostCategories(const QList<QVariant> &result, const QVariant &id)
 {
     qCDebug(KBLOG_LOG);
@@ -438,72 +545,55 @@ QList<QVariant> MovableTypePrivate::defaultArgs(const QString &id)
     return args;
 }
 
-bool MovableTypePrivate::readPostFromMap(BlogPost *post, const QMap<QString, QVariant> &postInfo)
+bool MovableTypePrivate::readPostFromFields(BlogPost *post, const PostFields &fields)
 {
 
     // FIXME: integrate error handling
-    qCDebug(KBLOG_LOG) << "readPostFromMap()";
+    qCDebug(KBLOG_LOG) << "readPostFromFields()";
     if (!post) {
         return false;
     }
 
-    qCDebug(KBLOG_LOG)
-        #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
-            << endl
-           #else
-            << Qt::endl
-           #endif
-            << "Keys:" << QStringList(postInfo.keys()).join(QLatin1String(", "));
-    qCDebug(KBLOG_LOG)
-        #if (QT_VERSION < QT_VERSION_CHECK(5, 15, 0))
-            << endl
-           #else
-            << Qt::endl
-           #endif
-               ;
-
-    QDateTime dt = postInfo[QStringLiteral("dateCreated")].toDateTime();
+    QDateTime dt = fields.mDateCreated;
     if (dt.isValid() && !dt.isNull()) {
         post->setCreationDateTime(dt.toLocalTime());
     }
 
-    dt = postInfo[QStringLiteral("lastModified")].toDateTime();
+    dt = fields.mLastModified;
     if (dt.isValid() && !dt.isNull()) {
         post->setModificationDateTime(dt.toLocalTime());
     }
 
-    post->setPostId(postInfo[QStringLiteral("postid")].toString().isEmpty() ? postInfo[QStringLiteral("postId")].toString() :
-                    postInfo[QStringLiteral("postid")].toString());
+    post->setPostId(fields.mPostId);
 
-    QString title(postInfo[QStringLiteral("title")].toString());
-    QString description(postInfo[QStringLiteral("description")].toString());
-    QStringList categoryIdList = postInfo[QStringLiteral("categories")].toStringList();
+    const QStringList &categoryIdList = fields.mCategories;
     QStringList categories;
     // since the metaweblog definition is ambigious, we try different
     // category mappings
-    for (int i = 0; i < categoryIdList.count(); i++) {
-        for (int k = 0; k < mCategoriesList.count(); k++) {
-            if (mCategoriesList[ k ][ QStringLiteral("name") ] == categoryIdList[ i ]) {
-                categories << mCategoriesList[ k ][ QStringLiteral("name") ];
-            } else if (mCategoriesList[ k ][ QStringLiteral("categoryId") ] == categoryIdList[ i ]) {
-                categories << mCategoriesList[ k ][ QStringLiteral("name") ];
+    for (const QString &category : categoryIdList) {
+        if (mCategoryIds.contains(category)) {
+            categories << category;
+        } else {
+            const QHash<QString, QString>::ConstIterator it = mCategoryNames.constFind(category);
+            if (it != mCategoryNames.constEnd()) {
+                categories << *it;
             }
         }
     }
 
     //TODO 2 new keys are:
     // String mt_convert_breaks, the value for the convert_breaks field
-    post->setSlug(postInfo[QStringLiteral("wp_slug")].toString());
-    post->setAdditionalContent(postInfo[QStringLiteral("mt_text_more")].toString());
-    post->setTitle(title);
-    post->setContent(description);
-    post->setCommentAllowed((bool)postInfo[QStringLiteral("mt_allow_comments")].toInt());
-    post->setTrackBackAllowed((bool)postInfo[QStringLiteral("mt_allow_pings")].toInt());
-    post->setSummary(postInfo[QStringLiteral("mt_excerpt")].toString());
-    post->setTags(postInfo[QStringLiteral("mt_keywords")].toStringList());
-    post->setLink(QUrl(postInfo[QStringLiteral("link")].toString()));
-    post->setPermaLink(QUrl(postInfo[QStringLiteral("permaLink")].toString()));
-    QString postStatus = postInfo[QStringLiteral("post_status")].toString();
+    post->setSlug(fields.mSlug);
+    post->setAdditionalContent(fields.mTextMore);
+    post->setTitle(fields.mTitle);
+    post->setContent(fields.mDescription);
+    post->setCommentAllowed(fields.mAllowComments);
+    post->setTrackBackAllowed(fields.mAllowPings);
+    post->setSummary(fields.mExcerpt);
+    post->setTags(fields.mKeywords);
+    post->setLink(QUrl(fields.mLink));
+    post->setPermaLink(QUrl(fields.mPermaLink));
+    const QString &postStatus = fields.mPostStatus;
     if (postStatus != QLatin1String("publish") &&
             !postStatus.isEmpty()) {
         /**
@@ -95,6 +95,19 @@ public:
 
     void fetchPost(KBlog::BlogPost *post) override;
 
+    /**
+      Maps the category names of every post in @p posts to the categoryIds
+      of the blog, as known from the last listCategories(). Categories the
+      blog does not know are left out and reported by
+      unresolvedCategories().
+
+      @param posts the posts whose categories to resolve.
+      @return the categoryIds of every post, in the order of @p posts.
+
+      @see unresolvedCategories( KBlog::BlogPost *, const QStringList& )
+    */
+    QList<QStringList> resolveCategories(const QList<KBlog::BlogPost *> &posts);
+
 Q_SIGNALS:
     /**
       This signal is emitted when the trackback pings are fetched completely.
@@ -106,6 +119,18 @@ Q_SIGNALS:
     */
     void listedTrackBackPings(KBlog::BlogPost *post, const QList<QMap<QString, QString> > &pings);
 
+    /**
+      This signal is emitted when categories of a post are not known to
+      the blog, so they cannot be set on the server.
+
+      @param post This is the post with the categories.
+      @param categories This is the list of unknown category names.
+
+      @see resolveCategories()
+      @see listCategories()
+    */
+    void unresolvedCategories(KBlog::BlogPost *post, const QStringList &categories);
+
 protected:
     /**
       Constructor needed for private inheritance.
@@ -125,11 +150,9 @@ private:
     Q_PRIVATE_SLOT(d_func(),
                    void slotSetPostCategories(const QList<QVariant> &, const QVariant &))
     Q_PRIVATE_SLOT(d_func(),
-                   void slotTriggerCreatePost())
-    Q_PRIVATE_SLOT(d_func(),
-                   void slotTriggerModifyPost())
+                   void slotPrefetchCategoriesError(int, const QString &, const QVariant &))
     Q_PRIVATE_SLOT(d_func(),
-                   void slotTriggerFetchPost())
+                   void slotMethodsProbed())
 };
 
 } //namespace KBlog
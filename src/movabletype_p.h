@@ -13,15 +13,11 @@
 #include "movabletype.h"
 #include "metaweblog_p.h"
 
-#include <kxmlrpcclient/client.h>
+#include <QPair>
+
 class KJob;
 class QByteArray;
 
-namespace KIO
-{
-class Job;
-}
-
 namespace KBlog
 {
 
@@ -39,19 +35,45 @@ public:
     void slotModifyPost(const QList<QVariant> &, const QVariant &) override;
     void slotSetPostCategories(const QList<QVariant> &, const QVariant &);
     void slotGetPostCategories(const QList<QVariant> &, const QVariant &);
-    void slotTriggerCreatePost();
-    void slotTriggerModifyPost();
-    void slotTriggerFetchPost();
+    void slotListCategories(const QList<QVariant> &result, const QVariant &id) override;
+    void slotPrefetchCategoriesError(int number, const QString &errorString,
+                                     const QVariant &id);
+    void slotMethodsProbed();
     Q_DECLARE_PUBLIC(MovableType)
 
     QList<QVariant> defaultArgs(const QString &id = QString()) override;
     virtual void setPostCategories(BlogPost *post, bool publishAfterCategories);
-    bool readPostFromMap(BlogPost *post, const QMap<QString, QVariant> &postInfo) override;
+    QStringList resolveCategories(const QStringList &names, QStringList *unknown) const;
+    bool readPostFromFields(BlogPost *post, const PostFields &fields) override;
     bool readArgsFromPost(QList<QVariant> *args, const BlogPost &post) override;
     QMap<int, bool> mPublishAfterCategories;
-    QList<BlogPost *> mCreatePostCache;
-    QList<BlogPost *> mModifyPostCache;
-    QList<BlogPost *> mFetchPostCache;
+
+    // whether metaWeblog.newPost takes the categories itself, so a post
+    // does not need mt.setPostCategories and a second edit after it
+    enum NewPostCategories {
+        NewPostCategoriesUnknown,
+        NewPostCategoriesProbing,
+        NewPostCategoriesSupported,
+        NewPostCategoriesUnsupported
+    };
+    void probeNewPostCategories();
+    void readNewPostCategories();
+    NewPostCategories mNewPostCategories;
+
+    // the operations which need the category ids, or for a create the
+    // result of probeNewPostCategories(), before they can be sent
+    enum CategoryWaiter {
+        WaitingCreate,
+        WaitingModify,
+        WaitingFetch
+    };
+    bool waitForCategories(CategoryWaiter waiter, BlogPost *post);
+    void releaseCategoryWaiters();
+    // in the order they were requested, released together once the
+    // metaWeblog.getCategories call and the probe have come back
+    QList<QPair<CategoryWaiter, BlogPost *> > mCategoryWaiters;
+    bool mPrefetchingCategories;
+    bool mReleasingCategoryWaiters;
     QList<BlogPost *> mSilentCreationList;
 };
 
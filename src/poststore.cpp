@@ -0,0 +1,462 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "poststore.h"
+#include "poststore_p.h"
+#include "blog.h"
+#include "blogpost.h"
+#include "blogpost_p.h"
+
+#include "kblog_debug.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QLockFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QUrl>
+
+using namespace KBlog;
+
+Q_GLOBAL_STATIC(PostStore, s_postStore)
+
+static const quint32 logMagic = 0x4b425053; // "KBPS"
+static const quint32 logVersion = 2;
+// magic, version and generation
+static const qint64 logHeaderSize = 12;
+// length and checksum in front of every record
+static const qint64 recordHeaderSize = 6;
+static const qint64 minCompactSize = 1024 * 1024;
+
+enum RecordType {
+    StoreRecord = 1,
+    RemoveRecord = 2
+};
+
+static void writePost(QDataStream &stream, const BlogPost &post)
+{
+    stream << post.postId() << post.title() << post.content()
+           << post.additionalContent() << post.slug() << post.categories()
+           << post.tags() << post.summary() << post.mood() << post.music()
+           << post.link() << post.permaLink() << post.isPrivate()
+           << post.isCommentAllowed() << post.isTrackBackAllowed()
+           << post.creationDateTime() << post.modificationDateTime()
+           << qint32(post.status());
+}
+
+static void readPost(QDataStream &stream, BlogPost *post)
+{
+    QString postId, title, content, additionalContent, slug, summary, mood, music;
+    QStringList categories, tags;
+    QUrl link, permaLink;
+    bool isPrivate, commentAllowed, trackBackAllowed;
+    QDateTime creationDateTime, modificationDateTime;
+    qint32 status;
+    stream >> postId >> title >> content >> additionalContent >> slug
+           >> categories >> tags >> summary >> mood >> music >> link >> permaLink
+           >> isPrivate >> commentAllowed >> trackBackAllowed
+           >> creationDateTime >> modificationDateTime >> status;
+    post->setPostId(postId);
+    post->setTitle(title);
+    post->setContent(content);
+    post->setAdditionalContent(additionalContent);
+    post->setSlug(slug);
+    post->setCategories(categories);
+    post->setTags(tags);
+    post->setSummary(summary);
+    post->setMood(mood);
+    post->setMusic(music);
+    post->setLink(link);
+    post->setPermaLink(permaLink);
+    post->setPrivate(isPrivate);
+    post->setCommentAllowed(commentAllowed);
+    post->setTrackBackAllowed(trackBackAllowed);
+    post->setCreationDateTime(creationDateTime);
+    post->setModificationDateTime(modificationDateTime);
+    post->setStatus(static_cast<BlogPost::Status>(status));
+}
+
+PostStorePrivate::PostStorePrivate(const QString &directory)
+    : mDirectory(directory), mMaxAge(300), mGeneration(0), mIndexedSize(logHeaderSize),
+      mLiveSize(0)
+{
+    if (mDirectory.isEmpty()) {
+        mDirectory = QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) +
+                     QLatin1String("/kblog/posts");
+    }
+}
+
+QString PostStorePrivate::blogKey(const Blog &blog)
+{
+    // the same identity BlogPost::journal() builds
+    return BlogPostPrivate::journalUidPrefix(blog.url().url(), blog.blogId(), blog.username());
+}
+
+QString PostStorePrivate::key(const Blog &blog, const QString &postId)
+{
+    return blogKey(blog) + postId;
+}
+
+bool PostStorePrivate::load(QLockFile *lock)
+{
+    if (!QDir().mkpath(mDirectory)) {
+        qCWarning(KBLOG_LOG) << "Cannot create post store directory" << mDirectory;
+        return false;
+    }
+    if (!lock->lock()) {
+        qCWarning(KBLOG_LOG) << "Cannot lock post store" << lock->error();
+        return false;
+    }
+
+    // opened again every time, another process may have replaced the file
+    mLog.close();
+    mLog.setFileName(mDirectory + QLatin1String("/posts.log"));
+    if (!mLog.open(QIODevice::ReadWrite)) {
+        qCWarning(KBLOG_LOG) << "Cannot open post store" << mLog.fileName();
+        clearIndex();
+        return false;
+    }
+
+    QDataStream header(&mLog);
+    quint32 magic = 0, version = 0, generation = 0;
+    if (mLog.size() >= logHeaderSize) {
+        header >> magic >> version >> generation;
+    }
+    if (magic != logMagic || version != logVersion) {
+        if (mLog.size() > 0) {
+            qCDebug(KBLOG_LOG) << "Ignoring post store of unknown version";
+        }
+        clearIndex();
+        return writeHeader(mGeneration + 1);
+    }
+    if (generation != mGeneration || mLog.size() < mIndexedSize) {
+        // compacted or cleared, so the offsets known so far are wrong
+        clearIndex();
+        mGeneration = generation;
+    }
+
+    // only the records appended since the last call
+    qint64 offset = mIndexedSize;
+    QByteArray payload;
+    qint64 size;
+    while (readRecord(offset, &payload, &size)) {
+        QDataStream stream(payload);
+        stream.setVersion(QDataStream::Qt_5_0);
+        quint8 type;
+        QString blogKey, postId;
+        stream >> type >> blogKey >> postId;
+        if (type == StoreRecord) {
+            qint64 storedAt;
+            BlogPost post;
+            stream >> storedAt;
+            readPost(stream, &post);
+            insert(blogKey, postId, offset, size, post.modificationDateTime());
+        } else {
+            erase(blogKey + postId);
+        }
+        offset += size;
+    }
+    if (offset < mLog.size()) {
+        // the last write did not complete
+        qCWarning(KBLOG_LOG) << "Discarding" << mLog.size() - offset
+                             << "bytes of an incomplete record in" << mLog.fileName();
+        mLog.resize(offset);
+    }
+    mIndexedSize = offset;
+    return true;
+}
+
+QString PostStorePrivate::lockFileName() const
+{
+    return mDirectory + QLatin1String("/posts.lock");
+}
+
+bool PostStorePrivate::writeHeader(quint32 generation)
+{
+    mLog.resize(0);
+    mLog.seek(0);
+    QDataStream header(&mLog);
+    header << logMagic << logVersion << generation;
+    if (!mLog.flush()) {
+        qCWarning(KBLOG_LOG) << "Cannot write to post store" << mLog.fileName();
+        return false;
+    }
+    mGeneration = generation;
+    mIndexedSize = logHeaderSize;
+    return true;
+}
+
+void PostStorePrivate::clearIndex()
+{
+    mEntries.clear();
+    mByModification.clear();
+    mIndexedSize = logHeaderSize;
+    mLiveSize = 0;
+}
+
+bool PostStorePrivate::readRecord(qint64 offset, QByteArray *payload, qint64 *size)
+{
+    if (offset + recordHeaderSize > mLog.size() || !mLog.seek(offset)) {
+        return false;
+    }
+    QDataStream stream(&mLog);
+    quint32 length;
+    quint16 checksum;
+    stream >> length >> checksum;
+    if (offset + recordHeaderSize + length > mLog.size()) {
+        return false;
+    }
+    *payload = mLog.read(length);
+    if (payload->size() != int(length) ||
+            qChecksum(payload->constData(), payload->size()) != checksum) {
+        return false;
+    }
+    *size = recordHeaderSize + length;
+    return true;
+}
+
+bool PostStorePrivate::append(const QByteArray &payload)
+{
+    const qint64 end = mLog.size();
+    if (!mLog.seek(end)) {
+        return false;
+    }
+    QDataStream stream(&mLog);
+    stream << quint32(payload.size()) << qChecksum(payload.constData(), payload.size());
+    if (mLog.write(payload) != payload.size() || !mLog.flush()) {
+        qCWarning(KBLOG_LOG) << "Cannot write to post store" << mLog.fileName();
+        mLog.resize(end);
+        return false;
+    }
+    mIndexedSize = mLog.size();
+    return true;
+}
+
+void PostStorePrivate::insert(const QString &blogKey, const QString &postId, qint64 offset,
+                              qint64 size, const QDateTime &modified)
+{
+    const QString key = blogKey + postId;
+    erase(key);
+    PostStoreEntry entry;
+    entry.mBlogKey = blogKey;
+    entry.mPostId = postId;
+    entry.mOffset = offset;
+    entry.mSize = size;
+    entry.mModified = modified;
+    mEntries.insert(key, entry);
+    mByModification[blogKey].insert(modified, postId);
+    mLiveSize += size;
+}
+
+void PostStorePrivate::erase(const QString &key)
+{
+    QHash<QString, PostStoreEntry>::Iterator it = mEntries.find(key);
+    if (it == mEntries.end()) {
+        return;
+    }
+    QHash<QString, QMultiMap<QDateTime, QString> >::Iterator index = mByModification.find(it->mBlogKey);
+    if (index != mByModification.end()) {
+        index->remove(it->mModified, it->mPostId);
+        if (index->isEmpty()) {
+            mByModification.erase(index);
+        }
+    }
+    mLiveSize -= it->mSize;
+    mEntries.erase(it);
+}
+
+void PostStorePrivate::compact()
+{
+    if (mLog.size() < minCompactSize || mLog.size() < 2 * mLiveSize) {
+        return;
+    }
+    qCDebug(KBLOG_LOG) << "Compacting post store from" << mLog.size() << "to" << mLiveSize << "bytes";
+
+    QSaveFile file(mLog.fileName());
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KBLOG_LOG) << "Cannot compact post store" << mLog.fileName();
+        return;
+    }
+    // tells the other processes to read the new file from the start
+    QDataStream stream(&file);
+    stream << logMagic << logVersion << mGeneration + 1;
+    QHash<QString, qint64> offsets;
+    qint64 offset = logHeaderSize;
+    for (QHash<QString, PostStoreEntry>::ConstIterator it = mEntries.constBegin();
+            it != mEntries.constEnd(); ++it) {
+        if (!mLog.seek(it->mOffset)) {
+            file.cancelWriting();
+            return;
+        }
+        const QByteArray record = mLog.read(it->mSize);
+        if (record.size() != it->mSize || file.write(record) != record.size()) {
+            file.cancelWriting();
+            return;
+        }
+        offsets.insert(it.key(), offset);
+        offset += it->mSize;
+    }
+    if (!file.commit()) {
+        qCWarning(KBLOG_LOG) << "Cannot compact post store" << mLog.fileName();
+        return;
+    }
+
+    mLog.close();
+    ++mGeneration;
+    if (!mLog.open(QIODevice::ReadWrite)) {
+        qCWarning(KBLOG_LOG) << "Cannot open post store" << mLog.fileName();
+        clearIndex();
+        return;
+    }
+    for (QHash<QString, PostStoreEntry>::Iterator it = mEntries.begin(); it != mEntries.end(); ++it) {
+        it->mOffset = offsets.value(it.key());
+    }
+    mIndexedSize = offset;
+}
+
+PostStore::PostStore(const QString &directory)
+    : d(new PostStorePrivate(directory))
+{
+}
+
+PostStore::~PostStore()
+{
+    delete d;
+}
+
+PostStore *PostStore::self()
+{
+    return s_postStore();
+}
+
+QString PostStore::directory() const
+{
+    return d->mDirectory;
+}
+
+int PostStore::maxAge() const
+{
+    return d->mMaxAge;
+}
+
+void PostStore::setMaxAge(int seconds)
+{
+    d->mMaxAge = qMax(0, seconds);
+}
+
+bool PostStore::contains(const Blog &blog, const QString &postId) const
+{
+    QLockFile lock(d->lockFileName());
+    d->load(&lock);
+    return d->mEntries.contains(PostStorePrivate::key(blog, postId));
+}
+
+BlogPost PostStore::post(const Blog &blog, const QString &postId, QDateTime *storedAt) const
+{
+    BlogPost post;
+    QLockFile lock(d->lockFileName());
+    if (!d->load(&lock)) {
+        return post;
+    }
+    const QString key = PostStorePrivate::key(blog, postId);
+    const QHash<QString, PostStoreEntry>::ConstIterator it = d->mEntries.constFind(key);
+    QByteArray payload;
+    qint64 size;
+    if (it == d->mEntries.constEnd() || !d->readRecord(it->mOffset, &payload, &size)) {
+        return post;
+    }
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_5_0);
+    quint8 type;
+    QString blogKey, storedPostId;
+    qint64 stored;
+    stream >> type >> blogKey >> storedPostId >> stored;
+    readPost(stream, &post);
+    if (storedAt) {
+        *storedAt = QDateTime::fromMSecsSinceEpoch(stored);
+    }
+    return post;
+}
+
+void PostStore::store(const Blog &blog, const BlogPost &post)
+{
+    QLockFile lock(d->lockFileName());
+    if (post.postId().isEmpty() || !d->load(&lock)) {
+        return;
+    }
+    const QString blogKey = PostStorePrivate::blogKey(blog);
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << quint8(StoreRecord) << blogKey << post.postId() << QDateTime::currentMSecsSinceEpoch();
+    writePost(stream, post);
+
+    const qint64 offset = d->mLog.size();
+    if (d->append(payload)) {
+        d->insert(blogKey, post.postId(), offset, recordHeaderSize + payload.size(),
+                  post.modificationDateTime());
+        d->compact();
+    }
+}
+
+void PostStore::remove(const Blog &blog, const QString &postId)
+{
+    QLockFile lock(d->lockFileName());
+    if (!d->load(&lock)) {
+        return;
+    }
+    const QString blogKey = PostStorePrivate::blogKey(blog);
+    const QString key = blogKey + postId;
+    if (!d->mEntries.contains(key)) {
+        return;
+    }
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << quint8(RemoveRecord) << blogKey << postId;
+    if (d->append(payload)) {
+        d->erase(key);
+        d->compact();
+    }
+}
+
+QList<QString> PostStore::modifiedSince(const Blog &blog, const QDateTime &since) const
+{
+    QList<QString> postIds;
+    QLockFile lock(d->lockFileName());
+    d->load(&lock);
+    const QHash<QString, QMultiMap<QDateTime, QString> >::ConstIterator index =
+        d->mByModification.constFind(PostStorePrivate::blogKey(blog));
+    if (index == d->mByModification.constEnd()) {
+        return postIds;
+    }
+    QMultiMap<QDateTime, QString>::ConstIterator it = since.isValid() ?
+            index->lowerBound(since) : index->constBegin();
+    for (; it != index->constEnd(); ++it) {
+        postIds.append(it.value());
+    }
+    return postIds;
+}
+
+int PostStore::count() const
+{
+    QLockFile lock(d->lockFileName());
+    d->load(&lock);
+    return d->mEntries.count();
+}
+
+void PostStore::clear()
+{
+    QLockFile lock(d->lockFileName());
+    if (!d->load(&lock)) {
+        return;
+    }
+    d->clearIndex();
+    d->writeHeader(d->mGeneration + 1);
+}
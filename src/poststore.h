@@ -0,0 +1,168 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_POSTSTORE_H
+#define KBLOG_POSTSTORE_H
+
+#include <kblog_export.h>
+
+#include <QList>
+#include <QString>
+
+class QDateTime;
+
+/**
+  @file
+  This file is part of the library for accessing blogs and defines the
+  PostStore class.
+*/
+
+namespace KBlog
+{
+
+class Blog;
+class BlogPost;
+class PostStorePrivate;
+
+/**
+  @brief
+  A persistent local store of blog posts.
+
+  Posts are identified by the url, blogId and username of their blog and
+  their postId, the same identity BlogPost::journal() uses. Looking up a
+  post by its identity takes constant time, and the posts of a blog can
+  be listed by their modification date.
+
+  The store is an append-only log: every change is written as one record
+  with a checksum, so a crash in the middle of a write loses at most
+  that change and never corrupts older ones. The log is compacted when
+  most of it consists of outdated records.
+
+  Several processes can share a store. Every access takes a lock file
+  next to the log and first reads the records the other processes have
+  written since.
+
+  A Blog with a store set through Blog::setPostStore() keeps the store up
+  to date with every post it fetches, lists, creates, modifies or removes,
+  and answers fetchPost() from the store while the stored copy is younger
+  than maxAge().
+
+  @code
+  KBlog::PostStore store( QStringLiteral( "/path/to/store" ) );
+  myblog->setPostStore( &store );
+  ...
+  if ( store.contains( *myblog, postId ) ) {
+    KBlog::BlogPost post = store.post( *myblog, postId );
+  }
+  @endcode
+*/
+class KBLOG_EXPORT PostStore
+{
+public:
+    /**
+      Creates a store that keeps its log in @p directory.
+      Most applications should use self() instead.
+
+      @param directory the store directory, defaults to kblog/posts in the
+      generic data location.
+    */
+    explicit PostStore(const QString &directory = QString());
+
+    /**
+      Destroys the store object. The stored posts stay on disk.
+    */
+    ~PostStore();
+
+    /**
+      Returns the process wide post store.
+    */
+    static PostStore *self();
+
+    /**
+      Returns the directory the store keeps its log in.
+    */
+    QString directory() const;
+
+    /**
+      Returns the time in seconds a stored post is considered fresh.
+      @see setMaxAge()
+    */
+    int maxAge() const;
+
+    /**
+      Sets the time in seconds a stored post is considered fresh, so
+      Blog::fetchPost() answers from the store instead of the server.
+
+      @param seconds the age, 0 never answers from the store. Defaults to
+      5 minutes.
+    */
+    void setMaxAge(int seconds);
+
+    /**
+      Returns whether the post @p postId of @p blog is stored.
+
+      @param blog the blog of the post.
+      @param postId the id of the post.
+    */
+    bool contains(const Blog &blog, const QString &postId) const;
+
+    /**
+      Returns the post @p postId of @p blog, or a post without id if it is
+      not stored.
+
+      @param blog the blog of the post.
+      @param postId the id of the post.
+      @param storedAt if not null, set to the time the post was stored.
+    */
+    BlogPost post(const Blog &blog, const QString &postId,
+                  QDateTime *storedAt = nullptr) const;
+
+    /**
+      Stores @p post, replacing a stored post with the same id. Posts
+      without an id are ignored.
+
+      @param blog the blog of the post.
+      @param post the post to store.
+    */
+    void store(const Blog &blog, const BlogPost &post);
+
+    /**
+      Removes the post @p postId of @p blog from the store.
+
+      @param blog the blog of the post.
+      @param postId the id of the post.
+    */
+    void remove(const Blog &blog, const QString &postId);
+
+    /**
+      Returns the ids of the stored posts of @p blog that have been
+      modified at or after @p since, oldest first.
+
+      @param blog the blog of the posts.
+      @param since the earliest modification date, an invalid date returns
+      all posts of the blog.
+    */
+    QList<QString> modifiedSince(const Blog &blog, const QDateTime &since) const;
+
+    /**
+      Returns the number of stored posts of all blogs.
+    */
+    int count() const;
+
+    /**
+      Removes all posts from the store.
+    */
+    void clear();
+
+private:
+    PostStorePrivate *const d;
+    Q_DISABLE_COPY(PostStore)
+};
+
+} //namespace KBlog
+#endif
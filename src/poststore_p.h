@@ -0,0 +1,64 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_POSTSTORE_P_H
+#define KBLOG_POSTSTORE_P_H
+
+#include "poststore.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QMultiMap>
+
+class QLockFile;
+
+namespace KBlog
+{
+
+class PostStoreEntry
+{
+public:
+    QString mBlogKey;
+    QString mPostId;
+    qint64 mOffset = 0;
+    qint64 mSize = 0;
+    QDateTime mModified;
+};
+
+class PostStorePrivate
+{
+public:
+    explicit PostStorePrivate(const QString &directory);
+    QString mDirectory;
+    int mMaxAge;
+    QFile mLog;
+    // the generation of the log the index was read from, and how far
+    quint32 mGeneration;
+    qint64 mIndexedSize;
+    QHash<QString, PostStoreEntry> mEntries;
+    // the post ids of every blog by their modification date
+    QHash<QString, QMultiMap<QDateTime, QString> > mByModification;
+    qint64 mLiveSize;
+
+    static QString blogKey(const Blog &blog);
+    static QString key(const Blog &blog, const QString &postId);
+    QString lockFileName() const;
+    bool load(QLockFile *lock);
+    bool writeHeader(quint32 generation);
+    void clearIndex();
+    bool readRecord(qint64 offset, QByteArray *payload, qint64 *size);
+    bool append(const QByteArray &payload);
+    void insert(const QString &blogKey, const QString &postId, qint64 offset, qint64 size,
+                const QDateTime &modified);
+    void erase(const QString &key);
+    void compact();
+};
+
+} //namespace KBlog
+#endif
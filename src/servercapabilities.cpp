@@ -0,0 +1,109 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "servercapabilities_p.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QStandardPaths>
+#include <QUrl>
+
+using namespace KBlog;
+
+Q_GLOBAL_STATIC(ServerCapabilities, s_serverCapabilities)
+
+static const quint32 cacheMagic = 0x4b425343; // "KBSC"
+static const quint32 cacheVersion = 1;
+
+static QString cacheDirectory(const QString &directory)
+{
+    if (!directory.isEmpty()) {
+        return directory;
+    }
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) +
+           QLatin1String("/kblog/capabilities");
+}
+
+bool ServerCapabilitiesEntry::lists(const QString &method) const
+{
+    return mMethods.contains(method);
+}
+
+bool ServerCapabilitiesEntry::supports(const QString &method) const
+{
+    if (!mProbedAt.isValid() || mMethods.isEmpty()) {
+        return true;
+    }
+    if (mComplete || method.startsWith(QLatin1String("mt."))) {
+        return mMethods.contains(method);
+    }
+    return true;
+}
+
+ServerCapabilities::ServerCapabilities(const QString &directory)
+    : TtlFileCache<ServerCapabilitiesEntry>(cacheDirectory(directory), "capabilities",
+                                            cacheMagic, cacheVersion, 7 * 24 * 60 * 60)
+{
+}
+
+ServerCapabilities *ServerCapabilities::self()
+{
+    return s_serverCapabilities();
+}
+
+QString ServerCapabilities::key(const QUrl &url)
+{
+    return url.toString(QUrl::RemoveUserInfo | QUrl::StripTrailingSlash);
+}
+
+ServerCapabilities::Entry ServerCapabilities::store(const QString &key,
+        const QStringList &methods, bool complete)
+{
+    Entry entry;
+    entry.mMethods = methods;
+    entry.mComplete = complete;
+    entry.mProbedAt = QDateTime::currentDateTimeUtc();
+    storeEntry(key, entry);
+    Q_EMIT probeFinished(key);
+    return entry;
+}
+
+bool ServerCapabilities::startProbe(const QString &key)
+{
+    return startUpdate(key);
+}
+
+void ServerCapabilities::cancelProbe(const QString &key)
+{
+    cancelUpdate(key);
+    Q_EMIT probeFinished(key);
+}
+
+QString ServerCapabilities::fileName(const QString &key) const
+{
+    // URLs contain slashes, so name the file after a hash
+    return directory() + QLatin1Char('/') +
+           QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+QDateTime ServerCapabilities::timestamp(const Entry &entry) const
+{
+    return entry.mProbedAt;
+}
+
+bool ServerCapabilities::readEntry(QDataStream &stream, const QString &key, Entry *entry) const
+{
+    QString storedKey;
+    stream >> storedKey >> entry->mProbedAt >> entry->mComplete >> entry->mMethods;
+    return storedKey == key;
+}
+
+void ServerCapabilities::writeEntry(QDataStream &stream, const QString &key, const Entry &entry) const
+{
+    stream << key << entry.mProbedAt << entry.mComplete << entry.mMethods;
+}
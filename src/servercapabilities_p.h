@@ -0,0 +1,99 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_SERVERCAPABILITIES_P_H
+#define KBLOG_SERVERCAPABILITIES_P_H
+
+#include "kblog_private_export.h"
+#include "ttlfilecache_p.h"
+
+#include <QDateTime>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+class QUrl;
+
+namespace KBlog
+{
+
+class KBLOG_TESTS_EXPORT ServerCapabilitiesEntry
+{
+public:
+    ServerCapabilitiesEntry() : mComplete(false) {}
+
+    /**
+      Returns whether the server listed @p method.
+    */
+    bool lists(const QString &method) const;
+
+    /**
+      Returns false only if the server is known not to support
+      @p method, i.e. it listed its methods without it.
+    */
+    bool supports(const QString &method) const;
+
+    QStringList mMethods;
+    // true if the methods come from system.listMethods, false if from
+    // mt.supportedMethods, which lists the mt.* methods only
+    bool mComplete;
+    // invalid if the server has never been probed by this version
+    QDateTime mProbedAt;
+};
+
+/**
+  The XML-RPC methods a server said it supports, probed once per URL and
+  shared by all objects of the process. They are stored in
+  kblog/capabilities in the generic data location, in a file named after
+  a hash of the URL. Methods older than maxAge() have to be probed again.
+*/
+class KBLOG_TESTS_EXPORT ServerCapabilities : public QObject,
+    public TtlFileCache<ServerCapabilitiesEntry>
+{
+    Q_OBJECT
+public:
+    typedef ServerCapabilitiesEntry Entry;
+
+    explicit ServerCapabilities(const QString &directory = QString());
+
+    static ServerCapabilities *self();
+
+    static QString key(const QUrl &url);
+
+    /**
+      Replaces the methods of the server @p key, in memory and on disk,
+      emits probeFinished() and returns the new entry. An empty list
+      means that the server could not tell.
+    */
+    Entry store(const QString &key, const QStringList &methods, bool complete);
+
+    /**
+      Returns true if the caller should probe the server @p key, i.e. no
+      other object has started to do so in the last minute. The probe
+      ends with store() or cancelProbe().
+    */
+    bool startProbe(const QString &key);
+    void cancelProbe(const QString &key);
+
+Q_SIGNALS:
+    /**
+      This signal is emitted when the probe of the server @p key has
+      ended, whether it was stored or cancelled.
+    */
+    void probeFinished(const QString &key);
+
+protected:
+    QString fileName(const QString &key) const override;
+    QDateTime timestamp(const Entry &entry) const override;
+    bool readEntry(QDataStream &stream, const QString &key, Entry *entry) const override;
+    void writeEntry(QDataStream &stream, const QString &key, const Entry &entry) const override;
+};
+
+}
+
+#endif
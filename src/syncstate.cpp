@@ -0,0 +1,162 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "syncstate_p.h"
+
+#include "kblog_debug.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringList>
+#include <QUrl>
+
+using namespace KBlog;
+
+static const quint32 stateMagic = 0x4b425353; // "KBSS"
+static const quint32 stateVersion = 2;
+
+SyncState::SyncState()
+    : mLargestList(0), mLoaded(false)
+{
+}
+
+QString SyncState::fileName(const QUrl &url, const QString &blogId,
+                            const QString &username)
+{
+    const QByteArray identity = url.toEncoded() + '\n' + blogId.toUtf8() + '\n' +
+                                username.toUtf8();
+    return QStandardPaths::writableLocation(QStandardPaths::GenericDataLocation) +
+           QLatin1String("/kblog/sync/") +
+           QString::fromLatin1(QCryptographicHash::hash(identity, QCryptographicHash::Sha1).toHex());
+}
+
+void SyncState::load(const QString &fileName)
+{
+    if (mLoaded && fileName == mFileName) {
+        return;
+    }
+    mFileName = fileName;
+    mHighWaterMark = QDateTime();
+    mPosts.clear();
+    mLargestList = 0;
+    mLoaded = true;
+
+    QFile file(mFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    quint32 magic, version;
+    stream >> magic >> version;
+    if (magic != stateMagic || version < 1 || version > stateVersion) {
+        qCDebug(KBLOG_LOG) << "Ignoring sync state of unknown version" << mFileName;
+        return;
+    }
+    stream >> mHighWaterMark >> mPosts;
+    // version 1 did not know the largest list
+    if (version >= 2) {
+        qint32 largestList;
+        stream >> largestList;
+        mLargestList = largestList;
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(KBLOG_LOG) << "Ignoring corrupt sync state" << mFileName;
+        mHighWaterMark = QDateTime();
+        mPosts.clear();
+        mLargestList = 0;
+    }
+}
+
+void SyncState::save()
+{
+    if (!QDir().mkpath(QFileInfo(mFileName).absolutePath())) {
+        qCWarning(KBLOG_LOG) << "Cannot create sync state directory for" << mFileName;
+        return;
+    }
+    QSaveFile file(mFileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(KBLOG_LOG) << "Cannot write sync state" << mFileName;
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << stateMagic << stateVersion << mHighWaterMark << mPosts << qint32(mLargestList);
+    file.commit();
+}
+
+void SyncState::clear()
+{
+    mHighWaterMark = QDateTime();
+    mPosts.clear();
+    mLargestList = 0;
+    if (mLoaded) {
+        QFile::remove(mFileName);
+    }
+}
+
+QByteArray SyncState::fingerprint(const BlogPost &post)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(post.modificationDateTime().toUTC().toString(Qt::ISODate).toUtf8());
+    hash.addData(post.title().toUtf8());
+    hash.addData(post.content().toUtf8());
+    hash.addData(post.additionalContent().toUtf8());
+    hash.addData(post.categories().join(QLatin1Char('\n')).toUtf8());
+    hash.addData(post.tags().join(QLatin1Char('\n')).toUtf8());
+    hash.addData(post.isPrivate() ? "1" : "0");
+    return hash.result();
+}
+
+void SyncState::apply(const QList<BlogPost> &posts, bool complete,
+                      QList<BlogPost> *created, QList<BlogPost> *updated,
+                      QList<BlogPost> *removed)
+{
+    QHash<QString, QByteArray> seen;
+    for (const BlogPost &post : posts) {
+        if (post.postId().isEmpty()) {
+            continue;
+        }
+        const QByteArray print = fingerprint(post);
+        seen.insert(post.postId(), print);
+
+        QHash<QString, QByteArray>::Iterator it = mPosts.find(post.postId());
+        if (it == mPosts.end()) {
+            created->append(post);
+            mPosts.insert(post.postId(), print);
+        } else if (*it != print) {
+            updated->append(post);
+            *it = print;
+        }
+
+        const QDateTime modified = post.modificationDateTime().isValid() ?
+                                   post.modificationDateTime() : post.creationDateTime();
+        if (modified.isValid() && (!mHighWaterMark.isValid() || modified > mHighWaterMark)) {
+            mHighWaterMark = modified;
+        }
+    }
+
+    if (complete) {
+        for (QHash<QString, QByteArray>::Iterator it = mPosts.begin(); it != mPosts.end();) {
+            if (seen.contains(it.key())) {
+                ++it;
+                continue;
+            }
+            BlogPost post;
+            post.setPostId(it.key());
+            post.setStatus(BlogPost::Removed);
+            removed->append(post);
+            it = mPosts.erase(it);
+        }
+    }
+}
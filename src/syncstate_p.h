@@ -0,0 +1,68 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_SYNCSTATE_P_H
+#define KBLOG_SYNCSTATE_P_H
+
+#include "blogpost.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class QUrl;
+
+namespace KBlog
+{
+
+/**
+  What the last Blog::syncPosts() has seen of one blog: the high-water
+  mark, i.e. the newest modification date, and a fingerprint of every
+  known post, so created, updated and removed posts can be told apart.
+  It is stored in kblog/sync in the generic data location.
+*/
+class SyncState
+{
+public:
+    SyncState();
+
+    static QString fileName(const QUrl &url, const QString &blogId,
+                            const QString &username);
+
+    /**
+      Loads the state stored in @p fileName unless it is already loaded.
+    */
+    void load(const QString &fileName);
+    void save();
+    void clear();
+
+    /**
+      Compares the changed @p posts with the known posts and updates the
+      state. If @p complete is true, @p posts contains all posts of the
+      blog, so known posts missing from it have been removed.
+    */
+    void apply(const QList<BlogPost> &posts, bool complete,
+               QList<BlogPost> *created, QList<BlogPost> *updated,
+               QList<BlogPost> *removed);
+
+    QString mFileName;
+    QDateTime mHighWaterMark;
+    QHash<QString, QByteArray> mPosts;
+    // the most posts the server has returned for one request, servers
+    // that cap the number of recent posts never return more
+    int mLargestList;
+    bool mLoaded;
+
+private:
+    static QByteArray fingerprint(const BlogPost &post);
+};
+
+} //namespace KBlog
+#endif
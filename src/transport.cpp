@@ -0,0 +1,1084 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "transport.h"
+#include "transport_p.h"
+
+#include "kblog_debug.h"
+#include <KLocalizedString>
+
+#include <QAuthenticator>
+#include <QHostAddress>
+#include <QIODevice>
+#include <QNetworkProxyFactory>
+#include <QTcpSocket>
+#ifndef QT_NO_SSL
+#include <QSslSocket>
+#endif
+
+using namespace KBlog;
+
+Q_GLOBAL_STATIC(Transport, s_defaultTransport)
+
+static const int maxRedirects = 5;
+static const int maxLineLength = 65536;
+// data of a request body read from a device that may wait in the socket
+static const qint64 maxWriteBuffer = 65536;
+// the rest of a response finished early that is read to keep the connection
+static const qint64 maxDiscard = 65536;
+
+TransportPrivate::TransportPrivate()
+    : q_ptr(nullptr), mMaxRequestsPerHost(6), mMaxIdleConnectionsPerHost(6),
+      mIdleTimeout(10000), mConnectTimeout(50000), mReadTimeout(60000), mRequestCount(0),
+      mConnectionsOpened(0), mConnectionsReused(0), mBytesSent(0),
+      mBytesReceived(0), mQueuedRequests(0), mTotalWaitTime(0), mMaxWaitTime(0)
+{
+}
+
+QString TransportPrivate::poolKey(const QUrl &url)
+{
+    const QString scheme = url.scheme().toLower();
+    if ((scheme != QLatin1String("http") && scheme != QLatin1String("https")) ||
+            url.host().isEmpty()) {
+        return QString();
+    }
+    const int port = url.port(scheme == QLatin1String("https") ? 443 : 80);
+    return scheme + QLatin1String("://") + url.host().toLower() +
+           QLatin1Char(':') + QString::number(port);
+}
+
+QString TransportPrivate::proxyKey(const QNetworkProxy &proxy)
+{
+    return proxy.hostName().toLower() + QLatin1Char(':') + QString::number(proxy.port());
+}
+
+QNetworkProxy TransportPrivate::proxyFor(const QUrl &url) const
+{
+    if (url.host().compare(QLatin1String("localhost"), Qt::CaseInsensitive) == 0 ||
+            QHostAddress(url.host()).isLoopback()) {
+        return QNetworkProxy(QNetworkProxy::NoProxy);
+    }
+    const QNetworkProxyQuery query(url);
+    QList<QNetworkProxy> proxies = QNetworkProxyFactory::proxyForQuery(query);
+    if (QNetworkProxy::applicationProxy().type() == QNetworkProxy::DefaultProxy &&
+            (proxies.isEmpty() || proxies.first().type() == QNetworkProxy::NoProxy)) {
+        // the application did not choose a proxy, use those of the system
+        proxies = QNetworkProxyFactory::systemProxyForQuery(query);
+    }
+    // the first one a connection can go through
+    for (QNetworkProxy proxy : qAsConst(proxies)) {
+        switch (proxy.type()) {
+        case QNetworkProxy::NoProxy:
+            return proxy;
+        case QNetworkProxy::Socks5Proxy:
+            break;
+        case QNetworkProxy::HttpProxy:
+        case QNetworkProxy::HttpCachingProxy:
+            proxy.setType(QNetworkProxy::HttpProxy);
+            break;
+        default:
+            continue;
+        }
+        const QPair<QString, QString> credentials = mProxyCredentials.value(proxyKey(proxy));
+        if (!credentials.first.isEmpty()) {
+            proxy.setUser(credentials.first);
+            proxy.setPassword(credentials.second);
+        }
+        return proxy;
+    }
+    return QNetworkProxy(QNetworkProxy::NoProxy);
+}
+
+bool TransportPrivate::askProxyCredentials(const QNetworkProxy &proxy, QAuthenticator *authenticator)
+{
+    Q_Q(Transport);
+    Q_EMIT q->proxyAuthenticationRequired(proxy, authenticator);
+    if (authenticator->user().isEmpty()) {
+        return false;
+    }
+    mProxyCredentials.insert(proxyKey(proxy),
+                             qMakePair(authenticator->user(), authenticator->password()));
+    return true;
+}
+
+void TransportPrivate::dispatch(TransportJob *job, bool resend)
+{
+    const QString key = poolKey(job->d->mUrl);
+    if (key.isEmpty()) {
+        const QString errorText = i18n("Unsupported URL: %1", job->d->mUrl.toDisplayString());
+        QTimer::singleShot(0, job, [job, errorText]() {
+            job->finish(KJob::UserDefinedError, errorText);
+        });
+        return;
+    }
+
+    HostPool &pool = mPools[key];
+    if (pool.mBusy.count() >= mMaxRequestsPerHost) {
+        QList<TransportJob *> &queue = pool.mQueued[job->d->mPriority];
+        if (resend) {
+            // it already had its turn
+            queue.prepend(job);
+        } else {
+            queue.append(job);
+        }
+        job->d->mQueued = true;
+        job->d->mQueueTimer.start();
+        ++mQueuedRequests;
+        return;
+    }
+
+    HttpConnection *connection = nullptr;
+    if (!pool.mIdle.isEmpty()) {
+        connection = pool.mIdle.takeLast();
+        ++mConnectionsReused;
+    } else {
+        connection = new HttpConnection(this, job->d->mUrl);
+        ++mConnectionsOpened;
+    }
+    pool.mBusy.append(connection);
+    ++mRequestCount;
+    qCDebug(KBLOG_LOG) << job->d->mMethod << job->d->mUrl;
+    connection->send(job);
+}
+
+void TransportPrivate::releaseConnection(HttpConnection *connection, bool keepAlive)
+{
+    HostPool &pool = mPools[connection->key()];
+    pool.mBusy.removeOne(connection);
+    if (keepAlive && pool.mIdle.count() < mMaxIdleConnectionsPerHost) {
+        pool.mIdle.append(connection);
+        connection->startIdleTimer();
+    } else {
+        connection->close();
+        connection->deleteLater();
+    }
+    dispatchQueued(connection->key());
+}
+
+bool TransportPrivate::isRedirect(const TransportJob *job)
+{
+    const int status = job->d->mStatusCode;
+    const bool keepMethod = (status == 307 || status == 308);
+    const bool idempotent = (job->d->mMethod == "GET" || job->d->mMethod == "HEAD");
+    return (status == 301 || status == 302 || status == 303 || keepMethod) &&
+           (idempotent || keepMethod) && !job->responseHeader("Location").isEmpty();
+}
+
+void TransportPrivate::finishJob(TransportJob *job)
+{
+    const int status = job->d->mStatusCode;
+    if (status >= 400) {
+        job->finish(TransportJob::HttpError,
+                    i18n("The server returned HTTP status %1.", status));
+    } else if (status >= 300 && !job->responseHeader("Location").isEmpty()) {
+        // e.g. a POST moved elsewhere, its data would go to the wrong place
+        job->finish(TransportJob::HttpError,
+                    i18n("The request was redirected to %1, which is not followed for %2 requests.",
+                         QString::fromLatin1(job->responseHeader("Location")),
+                         QString::fromLatin1(job->d->mMethod)));
+    } else {
+        job->finish(KJob::NoError, QString());
+    }
+}
+
+void TransportPrivate::jobFinished(HttpConnection *connection, TransportJob *job,
+                                   bool keepAlive)
+{
+    releaseConnection(connection, keepAlive);
+
+    TransportJobPrivate *jobPrivate = job->d;
+    const int status = jobPrivate->mStatusCode;
+    if (status == 407 && connection->isForwarding() && !jobPrivate->mProxyCredentialsAsked &&
+            (!jobPrivate->mDevice || jobPrivate->mDevice->reset())) {
+        jobPrivate->mProxyCredentialsAsked = true;
+        QAuthenticator authenticator;
+        if (askProxyCredentials(connection->proxy(), &authenticator)) {
+            jobPrivate->mStatusCode = 0;
+            jobPrivate->mResponseHeaders.clear();
+            jobPrivate->mData.clear();
+            jobPrivate->mRetried = false;
+            dispatch(job, true);
+            return;
+        }
+    }
+    if (isRedirect(job)) {
+        const bool idempotent = (jobPrivate->mMethod == "GET" || jobPrivate->mMethod == "HEAD");
+        if (jobPrivate->mRedirectCount >= maxRedirects) {
+            job->finish(TransportJob::HttpError, i18n("Too many redirections."));
+            return;
+        }
+        if (jobPrivate->mDevice && !idempotent && !jobPrivate->mDevice->reset()) {
+            job->finish(TransportJob::HttpError,
+                        i18n("The request was redirected, but its data cannot be sent again."));
+            return;
+        }
+        const QUrl target = jobPrivate->mUrl.resolved(QUrl::fromEncoded(job->responseHeader("Location")));
+        if (jobPrivate->mUrl.scheme().toLower() == QLatin1String("https") &&
+                target.scheme().toLower() != QLatin1String("https")) {
+            job->finish(TransportJob::HttpError,
+                        i18n("The request was redirected to an insecure address: %1",
+                             target.toDisplayString()));
+            return;
+        }
+        if (poolKey(target) != poolKey(jobPrivate->mUrl)) {
+            // the credentials are meant for the original server only
+            jobPrivate->removeRequestHeader("Authorization");
+            jobPrivate->removeRequestHeader("Cookie");
+        }
+        qCDebug(KBLOG_LOG) << "redirected to" << target;
+        ++jobPrivate->mRedirectCount;
+        jobPrivate->mUrl = target;
+        jobPrivate->mStatusCode = 0;
+        jobPrivate->mResponseHeaders.clear();
+        jobPrivate->mData.clear();
+        jobPrivate->mRetried = false;
+        dispatch(job);
+        return;
+    }
+    finishJob(job);
+}
+
+void TransportPrivate::connectionClosed(HttpConnection *connection)
+{
+    QHash<QString, HostPool>::iterator it = mPools.find(connection->key());
+    if (it != mPools.end()) {
+        it->mIdle.removeOne(connection);
+        it->mBusy.removeOne(connection);
+    }
+    connection->close();
+    connection->deleteLater();
+
+    const QString key = connection->key();
+    dispatchQueued(key);
+    it = mPools.find(key);
+    if (it != mPools.end() && it->mIdle.isEmpty() && it->mBusy.isEmpty() &&
+            it->mQueued[Transport::Interactive].isEmpty() &&
+            it->mQueued[Transport::Background].isEmpty()) {
+        mPools.erase(it);
+    }
+}
+
+void TransportPrivate::dispatchQueued(const QString &key)
+{
+    for (;;) {
+        // sending may close connections and thus change the pools
+        QHash<QString, HostPool>::iterator it = mPools.find(key);
+        if (it == mPools.end() || it->mBusy.count() >= mMaxRequestsPerHost) {
+            return;
+        }
+        QList<TransportJob *> &queue = it->mQueued[Transport::Interactive].isEmpty() ?
+                                       it->mQueued[Transport::Background] :
+                                       it->mQueued[Transport::Interactive];
+        if (queue.isEmpty()) {
+            return;
+        }
+        TransportJob *job = queue.takeFirst();
+        const quint64 waited = job->d->mQueueTimer.elapsed();
+        mTotalWaitTime += waited;
+        mMaxWaitTime = qMax(mMaxWaitTime, waited);
+        job->d->mQueued = false;
+        qCDebug(KBLOG_LOG) << "dequeued" << job->d->mUrl << "after" << waited << "ms";
+        dispatch(job);
+    }
+}
+
+void TransportPrivate::unqueue(TransportJob *job)
+{
+    for (QHash<QString, HostPool>::iterator it = mPools.begin(); it != mPools.end(); ++it) {
+        if (it->mQueued[Transport::Interactive].removeOne(job) ||
+                it->mQueued[Transport::Background].removeOne(job)) {
+            break;
+        }
+    }
+    job->d->mQueued = false;
+}
+
+HttpConnection::HttpConnection(TransportPrivate *transport, const QUrl &url)
+    : QObject(), mTransport(transport), mKey(TransportPrivate::poolKey(url)),
+      mForwarding(false), mSocket(nullptr), mState(Idle), mRemaining(0), mUploadRemaining(0), mServedRequests(0),
+      mConnected(false), mChunked(false), mUntilClose(false), mKeepAlive(true),
+      mResponseStarted(false), mDiscarding(false), mDiscarded(0)
+{
+    mOrigin.setScheme(url.scheme().toLower());
+    mOrigin.setHost(url.host());
+    mOrigin.setPort(url.port());
+    mProxy = transport->proxyFor(url);
+    mForwarding = (mProxy.type() == QNetworkProxy::HttpProxy &&
+                   mOrigin.scheme() == QLatin1String("http"));
+
+#ifndef QT_NO_SSL
+    if (mOrigin.scheme() == QLatin1String("https")) {
+        QSslSocket *socket = new QSslSocket(this);
+        connect(socket, &QSslSocket::encrypted, this, &HttpConnection::slotConnected);
+        connect(socket, QOverload<const QList<QSslError> &>::of(&QSslSocket::sslErrors),
+                this, &HttpConnection::sslErrors);
+        mSocket = socket;
+    } else
+#endif
+    {
+        mSocket = new QTcpSocket(this);
+        connect(mSocket, &QTcpSocket::connected, this, &HttpConnection::slotConnected);
+    }
+    // when forwarding, the connection goes to the proxy itself
+    mSocket->setProxy(mForwarding ? QNetworkProxy(QNetworkProxy::NoProxy) : mProxy);
+    connect(mSocket, &QAbstractSocket::proxyAuthenticationRequired, this,
+            [this](const QNetworkProxy &proxy, QAuthenticator *authenticator) {
+        mTransport->askProxyCredentials(proxy, authenticator);
+    });
+    connect(mSocket, &QTcpSocket::readyRead, this, &HttpConnection::slotReadyRead);
+    connect(mSocket, &QTcpSocket::disconnected, this, &HttpConnection::slotDisconnected);
+    connect(mSocket, &QTcpSocket::bytesWritten, this, &HttpConnection::slotBytesWritten);
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
+    connect(mSocket, QOverload<QAbstractSocket::SocketError>::of(&QAbstractSocket::error),
+            this, &HttpConnection::slotError);
+#else
+    connect(mSocket, &QAbstractSocket::errorOccurred, this, &HttpConnection::slotError);
+#endif
+
+    mTimer.setSingleShot(true);
+    connect(&mTimer, &QTimer::timeout, this, &HttpConnection::slotTimeout);
+}
+
+HttpConnection::~HttpConnection()
+{
+}
+
+QString HttpConnection::key() const
+{
+    return mKey;
+}
+
+QNetworkProxy HttpConnection::proxy() const
+{
+    return mProxy;
+}
+
+bool HttpConnection::isForwarding() const
+{
+    return mForwarding;
+}
+
+void HttpConnection::send(TransportJob *job)
+{
+    mJob = job;
+    job->d->mConnection = this;
+    job->d->mConnectionReused = (mServedRequests > 0);
+    mResponseStarted = false;
+    mTimer.stop();
+
+    if (mConnected) {
+        writeRequest();
+        return;
+    }
+    if (mState == Connecting) {
+        return;
+    }
+
+    const bool secure = (mOrigin.scheme() == QLatin1String("https"));
+    const quint16 port = mOrigin.port(secure ? 443 : 80);
+    mState = Connecting;
+    mTimer.start(mTransport->mConnectTimeout);
+#ifndef QT_NO_SSL
+    if (secure) {
+        static_cast<QSslSocket *>(mSocket)->connectToHostEncrypted(mOrigin.host(), port);
+        return;
+    }
+#else
+    if (secure) {
+        fail(TransportJob::ConnectionError, i18n("Secure connections are not supported."));
+        return;
+    }
+#endif
+    if (mForwarding) {
+        mSocket->connectToHost(mProxy.hostName(), mProxy.port());
+        return;
+    }
+    mSocket->connectToHost(mOrigin.host(), port);
+}
+
+TransportJob *HttpConnection::takeJob()
+{
+    TransportJob *job = mJob;
+    mJob = nullptr;
+    if (job) {
+        job->d->mConnection = nullptr;
+    }
+    return job;
+}
+
+void HttpConnection::startIdleTimer()
+{
+    mTimer.start(mTransport->mIdleTimeout);
+}
+
+void HttpConnection::close()
+{
+    mTimer.stop();
+    mJob = nullptr;
+    mState = Idle;
+    mUploadRemaining = 0;
+    mDiscarding = false;
+    mConnected = false;
+    mBuffer.clear();
+    mSocket->disconnect(this);
+    mSocket->abort();
+}
+
+void HttpConnection::writeRequest()
+{
+    TransportJobPrivate *job = mJob->d;
+    mState = StatusLine;
+    mBuffer.clear();
+    // restarted whenever the server sends or accepts data
+    mTimer.start(mTransport->mReadTimeout);
+
+    QByteArray path = job->mUrl.path(QUrl::FullyEncoded).toLatin1();
+    if (path.isEmpty()) {
+        path = "/";
+    }
+    if (job->mUrl.hasQuery()) {
+        path += '?' + job->mUrl.query(QUrl::FullyEncoded).toLatin1();
+    }
+    QByteArray host = job->mUrl.host(QUrl::FullyEncoded).toLatin1();
+    if (job->mUrl.port() != -1) {
+        host += ':' + QByteArray::number(job->mUrl.port());
+    }
+
+    QByteArray request;
+    request.reserve(256 + path.size());
+    if (mForwarding) {
+        // the proxy needs to know where to forward the request to
+        path.prepend("http://" + host);
+    }
+    request += job->mMethod + ' ' + path + " HTTP/1.1\r\n";
+    request += "Host: " + host + "\r\n";
+    if (mForwarding) {
+        // entered after the connection was opened, or part of the settings
+        const QPair<QString, QString> credentials =
+            mTransport->mProxyCredentials.value(TransportPrivate::proxyKey(mProxy),
+                                                qMakePair(mProxy.user(), mProxy.password()));
+        if (!credentials.first.isEmpty()) {
+            // only basic authentication, as most HTTP proxies offer it
+            request += "Proxy-Authorization: Basic " +
+                       (credentials.first + QLatin1Char(':') + credentials.second).toUtf8().toBase64() +
+                       "\r\n";
+        }
+    }
+    for (const QPair<QByteArray, QByteArray> &header : qAsConst(job->mRequestHeaders)) {
+        request += header.first + ": " + header.second + "\r\n";
+    }
+    const qint64 length = job->mDevice ? job->mDeviceSize : job->mPostData.size();
+    if (length > 0 || (job->mMethod != "GET" && job->mMethod != "HEAD")) {
+        request += "Content-Length: " + QByteArray::number(length) + "\r\n";
+    }
+    request += "Connection: keep-alive\r\n\r\n";
+
+    mSocket->write(request);
+    mTransport->mBytesSent += request.size();
+    if (job->mDevice) {
+        mUploadRemaining = job->mDeviceSize;
+        writeBody();
+    } else {
+        mSocket->write(job->mPostData);
+        mTransport->mBytesSent += job->mPostData.size();
+    }
+}
+
+void HttpConnection::writeBody()
+{
+    QIODevice *device = mJob->d->mDevice;
+    char buffer[16384];
+    while (mUploadRemaining > 0 && mSocket->bytesToWrite() < maxWriteBuffer) {
+        const qint64 count = device->read(buffer, qMin<qint64>(sizeof(buffer), mUploadRemaining));
+        if (count <= 0) {
+            // the data is gone, sending it again would not help
+            mJob->d->mRetried = true;
+            fail(TransportJob::ConnectionError, i18n("Could not read the data to send."));
+            return;
+        }
+        mSocket->write(buffer, count);
+        mUploadRemaining -= count;
+        mTransport->mBytesSent += count;
+    }
+}
+
+void HttpConnection::slotBytesWritten()
+{
+    if (mJob && mState != Connecting) {
+        mTimer.start(mTransport->mReadTimeout);
+    }
+    if (mJob && mUploadRemaining > 0) {
+        writeBody();
+    }
+}
+
+void HttpConnection::slotConnected()
+{
+    mTimer.stop();
+    mConnected = true;
+    if (mJob) {
+        writeRequest();
+    } else {
+        mState = Idle;
+        startIdleTimer();
+    }
+}
+
+void HttpConnection::slotReadyRead()
+{
+    const QByteArray data = mSocket->readAll();
+    mTransport->mBytesReceived += data.size();
+    if (!mJob && !mDiscarding) {
+        // nothing was asked for, the connection can not be trusted anymore
+        mTransport->connectionClosed(this);
+        return;
+    }
+    mResponseStarted = true;
+    mTimer.start(mTransport->mReadTimeout);
+    mBuffer += data;
+    if (!parseResponse()) {
+        fail(TransportJob::ProtocolError, i18n("Invalid response from the server."));
+    }
+}
+
+void HttpConnection::slotDisconnected()
+{
+    mConnected = false;
+    if (!mJob) {
+        mTransport->connectionClosed(this);
+        return;
+    }
+    if (mState == Body && mUntilClose) {
+        mKeepAlive = false;
+        finishResponse();
+        return;
+    }
+    fail(TransportJob::ConnectionError, i18n("The server closed the connection."));
+}
+
+void HttpConnection::slotError(QAbstractSocket::SocketError error)
+{
+    if (error == QAbstractSocket::RemoteHostClosedError) {
+        // handled in slotDisconnected()
+        return;
+    }
+    qCDebug(KBLOG_LOG) << mKey << mSocket->errorString();
+    if (!mJob) {
+        mTransport->connectionClosed(this);
+        return;
+    }
+    fail(TransportJob::ConnectionError, mSocket->errorString());
+}
+
+void HttpConnection::slotTimeout()
+{
+    if (!mJob) {
+        mTransport->connectionClosed(this);
+        return;
+    }
+    if (mState == Connecting) {
+        fail(TransportJob::TimeoutError,
+             i18n("Timeout while connecting to %1.", mOrigin.host()));
+        return;
+    }
+    // the server might be working on the request, sending it again could
+    // e.g. create a post twice
+    mJob->d->mRetried = true;
+    fail(TransportJob::TimeoutError,
+         i18n("Timeout while waiting for a response from %1.", mOrigin.host()));
+}
+
+bool HttpConnection::parseResponse()
+{
+    while (mJob || mDiscarding) {
+        switch (mState) {
+        case StatusLine: {
+            const int eol = mBuffer.indexOf("\r\n");
+            if (eol < 0) {
+                return mBuffer.size() < maxLineLength;
+            }
+            const QByteArray line = mBuffer.left(eol);
+            mBuffer.remove(0, eol + 2);
+            if (!line.startsWith("HTTP/1.")) {
+                return false;
+            }
+            const int start = line.indexOf(' ');
+            if (start < 0) {
+                return false;
+            }
+            bool ok;
+            const int status = line.mid(start + 1, 3).toInt(&ok);
+            if (!ok) {
+                return false;
+            }
+            mJob->d->mStatusCode = status;
+            mJob->d->mResponseHeaders.clear();
+            mKeepAlive = line.startsWith("HTTP/1.1");
+            mState = Headers;
+            break;
+        }
+        case Headers: {
+            const int eol = mBuffer.indexOf("\r\n");
+            if (eol < 0) {
+                return mBuffer.size() < maxLineLength;
+            }
+            const QByteArray line = mBuffer.left(eol);
+            mBuffer.remove(0, eol + 2);
+            if (line.isEmpty()) {
+                if (!headersComplete()) {
+                    return false;
+                }
+                break;
+            }
+            const int colon = line.indexOf(':');
+            if (colon <= 0) {
+                return false;
+            }
+            mJob->d->mResponseHeaders.append(qMakePair(line.left(colon).trimmed(),
+                                             line.mid(colon + 1).trimmed()));
+            break;
+        }
+        case Body: {
+            if (mBuffer.isEmpty()) {
+                return true;
+            }
+            if (mUntilClose) {
+                appendBody(mBuffer);
+                mBuffer.clear();
+                return true;
+            }
+            const int count = static_cast<int>(qMin<qint64>(mRemaining, mBuffer.size()));
+            appendBody(mBuffer.left(count));
+            mBuffer.remove(0, count);
+            mRemaining -= count;
+            if (mRemaining == 0) {
+                finishResponse();
+            }
+            break;
+        }
+        case ChunkSize: {
+            const int eol = mBuffer.indexOf("\r\n");
+            if (eol < 0) {
+                return mBuffer.size() < maxLineLength;
+            }
+            QByteArray line = mBuffer.left(eol);
+            mBuffer.remove(0, eol + 2);
+            const int extension = line.indexOf(';');
+            if (extension >= 0) {
+                line.truncate(extension);
+            }
+            bool ok;
+            mRemaining = line.trimmed().toLongLong(&ok, 16);
+            if (!ok || mRemaining < 0) {
+                return false;
+            }
+            mState = (mRemaining == 0) ? ChunkTrailer : ChunkData;
+            break;
+        }
+        case ChunkData: {
+            if (mRemaining > 0) {
+                const int count = static_cast<int>(qMin<qint64>(mRemaining, mBuffer.size()));
+                appendBody(mBuffer.left(count));
+                mBuffer.remove(0, count);
+                mRemaining -= count;
+                if (mRemaining > 0) {
+                    return true;
+                }
+            }
+            // every chunk is terminated by CRLF
+            if (mBuffer.size() < 2) {
+                return true;
+            }
+            if (!mBuffer.startsWith("\r\n")) {
+                return false;
+            }
+            mBuffer.remove(0, 2);
+            mState = ChunkSize;
+            break;
+        }
+        case ChunkTrailer: {
+            const int eol = mBuffer.indexOf("\r\n");
+            if (eol < 0) {
+                return mBuffer.size() < maxLineLength;
+            }
+            const bool last = (eol == 0);
+            mBuffer.remove(0, eol + 2);
+            if (last) {
+                finishResponse();
+            }
+            break;
+        }
+        case Idle:
+        case Connecting:
+            return false;
+        }
+    }
+    return true;
+}
+
+bool HttpConnection::headersComplete()
+{
+    const int status = mJob->d->mStatusCode;
+    if (status >= 100 && status < 200) {
+        // interim response, the real one follows
+        mState = StatusLine;
+        return true;
+    }
+
+    const QByteArray connection = mJob->responseHeader("Connection").toLower();
+    if (connection.contains("close")) {
+        mKeepAlive = false;
+    } else if (connection.contains("keep-alive")) {
+        mKeepAlive = true;
+    }
+
+    mChunked = mJob->responseHeader("Transfer-Encoding").toLower().contains("chunked");
+    mUntilClose = false;
+    mRemaining = 0;
+    if (mJob->d->mMethod == "HEAD" || status == 204 || status == 304) {
+        finishResponse();
+        return true;
+    }
+    if (mChunked) {
+        mState = ChunkSize;
+        return true;
+    }
+
+    const QByteArray length = mJob->responseHeader("Content-Length");
+    if (length.isEmpty()) {
+        mUntilClose = true;
+        mKeepAlive = false;
+        mState = Body;
+        return true;
+    }
+    bool ok;
+    mRemaining = length.toLongLong(&ok);
+    if (!ok || mRemaining < 0) {
+        return false;
+    }
+    if (mRemaining == 0) {
+        finishResponse();
+    } else {
+        mState = Body;
+    }
+    return true;
+}
+
+void HttpConnection::appendBody(const QByteArray &data)
+{
+    if (mDiscarding) {
+        mDiscarded += data.size();
+        if (mDiscarded > maxDiscard) {
+            // cheaper to open a new connection than to read all of it
+            mTransport->connectionClosed(this);
+        }
+        return;
+    }
+    TransportJob *job = mJob;
+    if (job->d->mBufferData) {
+        job->d->mData += data;
+    }
+    const int status = job->d->mStatusCode;
+    if (status == 407 && mForwarding && !job->d->mProxyCredentialsAsked) {
+        // most likely sent again with credentials
+        return;
+    }
+    if (TransportPrivate::isRedirect(job)) {
+        // followed or failed, either way the body is of no interest
+        return;
+    }
+    Q_EMIT job->dataReceived(job, data);
+    if (mJob && mJob->d->mFinishEarly) {
+        // read the rest of the response without passing it on
+        TransportJob *finished = takeJob();
+        mDiscarding = true;
+        mDiscarded = 0;
+        ++mServedRequests;
+        mTransport->finishJob(finished);
+    }
+}
+
+#ifndef QT_NO_SSL
+void HttpConnection::sslErrors(const QList<QSslError> &errors)
+{
+    const QList<QSslError> accepted = mTransport->mAcceptedSslErrors.value(mKey);
+    bool known = true;
+    for (const QSslError &error : errors) {
+        if (!accepted.contains(error)) {
+            known = false;
+            break;
+        }
+    }
+    if (!known && mJob) {
+        mJob->d->mIgnoreSslErrors = false;
+        Q_EMIT mTransport->q_ptr->sslErrors(mJob.data(), errors);
+        // the job might have been killed in the meantime
+        if (mJob && mJob->d->mIgnoreSslErrors) {
+            mTransport->mAcceptedSslErrors.insert(mKey, accepted + errors);
+            known = true;
+        }
+    }
+    if (known) {
+        static_cast<QSslSocket *>(mSocket)->ignoreSslErrors();
+    }
+}
+#endif
+
+void HttpConnection::finishResponse()
+{
+    if (mDiscarding) {
+        mDiscarding = false;
+        mState = Idle;
+        mBuffer.clear();
+        mTransport->releaseConnection(this, mKeepAlive && mUploadRemaining == 0);
+        mUploadRemaining = 0;
+        return;
+    }
+    if (!mJob) {
+        // closed while the response was read
+        return;
+    }
+    if (mUploadRemaining > 0) {
+        // the server answered before the whole request body was sent
+        mKeepAlive = false;
+        mUploadRemaining = 0;
+    }
+    TransportJob *job = takeJob();
+    mState = Idle;
+    mBuffer.clear();
+    ++mServedRequests;
+    mTransport->jobFinished(this, job, mKeepAlive);
+}
+
+void HttpConnection::fail(int error, const QString &errorText)
+{
+    TransportJob *job = takeJob();
+    // a reused connection may have been closed by the server in the
+    // meantime, so the request is sent once more over a new connection
+    const bool retry = job && !mResponseStarted && mServedRequests > 0 && !job->d->mRetried &&
+                       (!job->d->mDevice || job->d->mDevice->reset());
+    mTransport->connectionClosed(this);
+    if (!job) {
+        return;
+    }
+    if (retry) {
+        qCDebug(KBLOG_LOG) << "retrying on a new connection:" << errorText;
+        job->d->mRetried = true;
+        job->d->mStatusCode = 0;
+        job->d->mResponseHeaders.clear();
+        job->d->mData.clear();
+        mTransport->dispatch(job, true);
+        return;
+    }
+    job->finish(error, errorText);
+}
+
+Transport::Transport(QObject *parent)
+    : QObject(parent), d_ptr(new TransportPrivate)
+{
+    d_ptr->q_ptr = this;
+}
+
+Transport::~Transport()
+{
+    Q_D(Transport);
+    const QList<HostPool> pools = d->mPools.values();
+    d->mPools.clear();
+    for (const HostPool &pool : pools) {
+        for (const QList<TransportJob *> &queue : pool.mQueued) {
+            for (TransportJob *job : queue) {
+                job->d->mQueued = false;
+                job->finish(TransportJob::ConnectionError,
+                            i18n("The connection has been closed."));
+            }
+        }
+        for (HttpConnection *connection : pool.mIdle) {
+            connection->close();
+            delete connection;
+        }
+        for (HttpConnection *connection : pool.mBusy) {
+            TransportJob *job = connection->takeJob();
+            connection->close();
+            delete connection;
+            if (job) {
+                job->finish(TransportJob::ConnectionError,
+                            i18n("The connection has been closed."));
+            }
+        }
+    }
+    delete d_ptr;
+}
+
+Transport *Transport::self()
+{
+    return s_defaultTransport();
+}
+
+TransportJob *Transport::get(const QUrl &url)
+{
+    return new TransportJob(this, "GET", url, QByteArray());
+}
+
+TransportJob *Transport::post(const QUrl &url, const QByteArray &data)
+{
+    return new TransportJob(this, "POST", url, data);
+}
+
+TransportJob *Transport::post(const QUrl &url, QIODevice *device, qint64 size)
+{
+    TransportJob *job = new TransportJob(this, "POST", url, QByteArray());
+    job->d->mDevice = device;
+    job->d->mDeviceSize = size;
+    return job;
+}
+
+int Transport::maxRequestsPerHost() const
+{
+    Q_D(const Transport);
+    return d->mMaxRequestsPerHost;
+}
+
+void Transport::setMaxRequestsPerHost(int count)
+{
+    Q_D(Transport);
+    d->mMaxRequestsPerHost = qMax(1, count);
+    const QList<QString> keys = d->mPools.keys();
+    for (const QString &key : keys) {
+        d->dispatchQueued(key);
+    }
+}
+
+int Transport::maxIdleConnectionsPerHost() const
+{
+    Q_D(const Transport);
+    return d->mMaxIdleConnectionsPerHost;
+}
+
+void Transport::setMaxIdleConnectionsPerHost(int count)
+{
+    Q_D(Transport);
+    d->mMaxIdleConnectionsPerHost = qMax(0, count);
+}
+
+int Transport::idleTimeout() const
+{
+    Q_D(const Transport);
+    return d->mIdleTimeout;
+}
+
+void Transport::setIdleTimeout(int msecs)
+{
+    Q_D(Transport);
+    d->mIdleTimeout = msecs;
+}
+
+int Transport::connectTimeout() const
+{
+    Q_D(const Transport);
+    return d->mConnectTimeout;
+}
+
+void Transport::setConnectTimeout(int msecs)
+{
+    Q_D(Transport);
+    d->mConnectTimeout = msecs;
+}
+
+int Transport::readTimeout() const
+{
+    Q_D(const Transport);
+    return d->mReadTimeout;
+}
+
+void Transport::setReadTimeout(int msecs)
+{
+    Q_D(Transport);
+    d->mReadTimeout = msecs;
+}
+
+quint64 Transport::requestCount() const
+{
+    Q_D(const Transport);
+    return d->mRequestCount;
+}
+
+quint64 Transport::connectionsOpened() const
+{
+    Q_D(const Transport);
+    return d->mConnectionsOpened;
+}
+
+quint64 Transport::connectionsReused() const
+{
+    Q_D(const Transport);
+    return d->mConnectionsReused;
+}
+
+quint64 Transport::bytesSent() const
+{
+    Q_D(const Transport);
+    return d->mBytesSent;
+}
+
+quint64 Transport::bytesReceived() const
+{
+    Q_D(const Transport);
+    return d->mBytesReceived;
+}
+
+int Transport::queueDepth() const
+{
+    return queueDepth(Interactive) + queueDepth(Background);
+}
+
+int Transport::queueDepth(Priority priority) const
+{
+    Q_D(const Transport);
+    int depth = 0;
+    for (const HostPool &pool : d->mPools) {
+        depth += pool.mQueued[priority].count();
+    }
+    return depth;
+}
+
+quint64 Transport::queuedRequests() const
+{
+    Q_D(const Transport);
+    return d->mQueuedRequests;
+}
+
+quint64 Transport::totalWaitTime() const
+{
+    Q_D(const Transport);
+    return d->mTotalWaitTime;
+}
+
+quint64 Transport::maxWaitTime() const
+{
+    Q_D(const Transport);
+    return d->mMaxWaitTime;
+}
+
+void Transport::resetStatistics()
+{
+    Q_D(Transport);
+    d->mQueuedRequests = 0;
+    d->mTotalWaitTime = 0;
+    d->mMaxWaitTime = 0;
+    d->mRequestCount = 0;
+    d->mConnectionsOpened = 0;
+    d->mConnectionsReused = 0;
+    d->mBytesSent = 0;
+    d->mBytesReceived = 0;
+}
+
+void Transport::startJob(TransportJob *job)
+{
+    Q_D(Transport);
+    d->dispatch(job);
+}
@@ -0,0 +1,315 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_TRANSPORT_H
+#define KBLOG_TRANSPORT_H
+
+#include <kblog_export.h>
+
+#include <QObject>
+#include <QSslError>
+
+class QAuthenticator;
+class QByteArray;
+class QIODevice;
+class QNetworkProxy;
+class QUrl;
+
+/**
+  @file
+  This file is part of the library for accessing blogs and defines the
+  Transport class.
+*/
+
+namespace KBlog
+{
+
+class TransportJob;
+class TransportPrivate;
+
+/**
+  @brief
+  The HTTP transport shared by all blogging backends.
+
+  The transport keeps a pool of persistent HTTP/1.1 keep-alive connections
+  per host. Every Blog object uses the process wide default transport
+  returned by self() unless another one was set with Blog::setTransport(),
+  so subsequent requests to the same server are sent over an already
+  established connection instead of opening a new one each time.
+
+  At most maxRequestsPerHost() requests are sent to one host at a time.
+  Further requests wait in a queue per host and priority: interactive
+  requests are sent before all background requests, and requests of the
+  same priority are sent in the order they were started. A bulk upload
+  running at Background priority thus does not delay a request the user
+  is waiting for.
+
+  Redirects of GET and HEAD requests, and 307 and 308 redirects of any
+  request, are followed. When a redirect leads to another scheme, host or
+  port, the Authorization and Cookie headers are not sent to it. A
+  redirect from https to http fails with TransportJob::HttpError.
+
+  Connections go through the proxy QNetworkProxyFactory::proxyForQuery()
+  returns. Unless the application has chosen a proxy, the proxy settings
+  of the system are used as QNetworkProxyFactory::systemProxyForQuery()
+  reports them. Plain HTTP requests are forwarded by HTTP proxies, all
+  others are tunneled through them with CONNECT; SOCKS5 proxies are
+  supported as well. A proxy asking for credentials emits
+  proxyAuthenticationRequired(), a certificate that cannot be verified
+  emits sslErrors().
+
+  @code
+  KBlog::TransportJob *job = KBlog::Transport::self()->get( url );
+  connect( job, SIGNAL(result(KJob*)), this, SLOT(slotResult(KJob*)) );
+  job->start();
+  ...
+  qDebug() << "reused" << KBlog::Transport::self()->connectionsReused()
+           << "of" << KBlog::Transport::self()->requestCount() << "requests";
+  @endcode
+*/
+class KBLOG_EXPORT Transport : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+      The priority of a request.
+      @see TransportJob::setPriority()
+      @see Blog::setRequestPriority()
+    */
+    enum Priority {
+        /** A request the user is waiting for. This is the default. */
+        Interactive = 0,
+        /** A request of a bulk operation, e.g. a synchronization. */
+        Background
+    };
+
+    /**
+      Creates a transport with its own connection pool.
+      Most applications should use self() instead.
+
+      @param parent the parent of this object, defaults to null.
+    */
+    explicit Transport(QObject *parent = nullptr);
+
+    /**
+      Destroys the transport and closes all pooled connections.
+    */
+    virtual ~Transport();
+
+    /**
+      Returns the process wide transport used by default by all Blog objects.
+    */
+    static Transport *self();
+
+    /**
+      Creates a GET request for @p url. The job is not started yet, set the
+      request headers and call TransportJob::start().
+
+      @param url the URL to fetch.
+    */
+    TransportJob *get(const QUrl &url);
+
+    /**
+      Creates a POST request for @p url. The job is not started yet, set the
+      request headers and call TransportJob::start().
+
+      @param url the URL to post to.
+      @param data the request body.
+    */
+    TransportJob *post(const QUrl &url, const QByteArray &data);
+
+    /**
+      Creates a POST request for @p url that sends @p size bytes read from
+      @p device. The body is read piece by piece while it is written to the
+      connection, so it is never held in memory as a whole. The device has
+      to be open and must stay valid until the job has finished; it is not
+      deleted. If the request has to be sent again, e.g. after a redirect,
+      QIODevice::reset() is called on the device first.
+
+      @param url the URL to post to.
+      @param device the device to read the request body from.
+      @param size the number of bytes to send.
+    */
+    TransportJob *post(const QUrl &url, QIODevice *device, qint64 size);
+
+    /**
+      Returns the maximum number of requests sent to one host at a time.
+      @see setMaxRequestsPerHost()
+    */
+    int maxRequestsPerHost() const;
+
+    /**
+      Sets the maximum number of requests sent to one host at a time.
+      Further requests are queued until a running one has finished.
+      @param count the number of requests, at least 1, defaults to 6.
+    */
+    void setMaxRequestsPerHost(int count);
+
+    /**
+      Returns the number of idle connections kept open per host.
+      @see setMaxIdleConnectionsPerHost()
+    */
+    int maxIdleConnectionsPerHost() const;
+
+    /**
+      Sets the number of idle connections kept open per host. Connections
+      beyond that number are closed once their request has finished.
+      @param count the number of connections, defaults to 6.
+    */
+    void setMaxIdleConnectionsPerHost(int count);
+
+    /**
+      Returns the time in milliseconds an idle connection is kept open.
+      @see setIdleTimeout()
+    */
+    int idleTimeout() const;
+
+    /**
+      Sets the time in milliseconds an idle connection is kept open before
+      it is closed.
+      @param msecs the timeout, defaults to 10 seconds.
+    */
+    void setIdleTimeout(int msecs);
+
+    /**
+      Returns the timeout in milliseconds for establishing a connection.
+      @see setConnectTimeout()
+    */
+    int connectTimeout() const;
+
+    /**
+      Sets the timeout in milliseconds for establishing a connection.
+      @param msecs the timeout, defaults to 50 seconds.
+    */
+    void setConnectTimeout(int msecs);
+
+    /**
+      Returns the timeout in milliseconds for the server to send or
+      accept data while a request is running.
+      @see setReadTimeout()
+    */
+    int readTimeout() const;
+
+    /**
+      Sets the timeout in milliseconds for the server to send or accept
+      data while a request is running. It starts again whenever data
+      arrives or is written, so a slow but steady response does not time
+      out. A request that times out fails with TransportJob::TimeoutError
+      and is not sent again.
+      @param msecs the timeout, defaults to 60 seconds.
+    */
+    void setReadTimeout(int msecs);
+
+    /**
+      Returns the number of HTTP requests sent, including redirects.
+    */
+    quint64 requestCount() const;
+
+    /**
+      Returns the number of connections that have been opened.
+    */
+    quint64 connectionsOpened() const;
+
+    /**
+      Returns the number of requests that have been sent over an already
+      established keep-alive connection.
+    */
+    quint64 connectionsReused() const;
+
+    /**
+      Returns the number of bytes written to the network.
+    */
+    quint64 bytesSent() const;
+
+    /**
+      Returns the number of bytes read from the network.
+    */
+    quint64 bytesReceived() const;
+
+    /**
+      Returns the number of requests currently waiting in the queues of
+      all hosts.
+    */
+    int queueDepth() const;
+
+    /**
+      Returns the number of requests of @p priority currently waiting in
+      the queues of all hosts.
+
+      @param priority the priority of the requests to count.
+    */
+    int queueDepth(Priority priority) const;
+
+    /**
+      Returns the number of requests that had to wait in a queue because
+      their host was busy.
+    */
+    quint64 queuedRequests() const;
+
+    /**
+      Returns the time in milliseconds all requests together waited in the
+      queues.
+    */
+    quint64 totalWaitTime() const;
+
+    /**
+      Returns the longest time in milliseconds a request waited in a queue.
+    */
+    quint64 maxWaitTime() const;
+
+    /**
+      Resets all counters to zero.
+    */
+    void resetStatistics();
+
+Q_SIGNALS:
+    /**
+      Emitted when @p proxy asks for credentials. Set them on
+      @p authenticator in a slot connected directly to this signal; they
+      are used for all later connections through the proxy as well. If
+      none are set, the request fails.
+
+      @param proxy the proxy.
+      @param authenticator the credentials to send.
+    */
+    void proxyAuthenticationRequired(const QNetworkProxy &proxy, QAuthenticator *authenticator);
+
+#ifndef QT_NO_SSL
+    /**
+      Emitted when the certificate of a server cannot be verified while
+      @p job connects to it. To continue anyway, e.g. after the user has
+      accepted the certificate, call TransportJob::ignoreSslErrors() in a
+      slot connected directly to this signal; the errors are then accepted
+      for all later connections to the same host as well. Otherwise the
+      request fails with TransportJob::ConnectionError.
+
+      @param job the job that connects to the server.
+      @param errors the errors of the certificate.
+    */
+    void sslErrors(KBlog::TransportJob *job, const QList<QSslError> &errors);
+#endif
+
+protected:
+    /**
+      Sends the request of @p job. Reimplement this to route requests
+      differently, e.g. to rewrite the URL, and call the base
+      implementation to send it over the pool.
+
+      @param job the job to send.
+    */
+    virtual void startJob(KBlog::TransportJob *job);
+
+private:
+    friend class TransportJob;
+    TransportPrivate *const d_ptr;
+    Q_DECLARE_PRIVATE(Transport)
+    Q_DISABLE_COPY(Transport)
+};
+
+} //namespace KBlog
+#endif
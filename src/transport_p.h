@@ -0,0 +1,189 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_TRANSPORT_P_H
+#define KBLOG_TRANSPORT_P_H
+
+#include "transport.h"
+#include "transportjob.h"
+
+#include <QAbstractSocket>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QNetworkProxy>
+#include <QPointer>
+#include <QSslError>
+#include <QTimer>
+#include <QUrl>
+
+class QTcpSocket;
+
+namespace KBlog
+{
+
+class HttpConnection;
+
+class TransportJobPrivate
+{
+public:
+    TransportJobPrivate();
+    void removeRequestHeader(const QByteArray &name);
+    Transport *mTransport;
+    QByteArray mMethod;
+    QUrl mUrl;
+    QByteArray mPostData;
+    QIODevice *mDevice;
+    qint64 mDeviceSize;
+    QList<QPair<QByteArray, QByteArray> > mRequestHeaders;
+    QList<QPair<QByteArray, QByteArray> > mResponseHeaders;
+    QByteArray mData;
+    HttpConnection *mConnection;
+    Transport::Priority mPriority;
+    QElapsedTimer mQueueTimer;
+    bool mQueued;
+    int mStatusCode;
+    int mRedirectCount;
+    bool mConnectionReused;
+    bool mRetried;
+    bool mStarted;
+    bool mDispatching;
+    bool mIgnoreSslErrors;
+    bool mProxyCredentialsAsked;
+    bool mBufferData;
+    bool mFinishEarly;
+};
+
+class HostPool
+{
+public:
+    QList<HttpConnection *> mIdle;
+    QList<HttpConnection *> mBusy;
+    // the jobs waiting for a free slot, indexed by Transport::Priority
+    QList<TransportJob *> mQueued[2];
+};
+
+class TransportPrivate
+{
+public:
+    TransportPrivate();
+    Transport *q_ptr;
+    QHash<QString, HostPool> mPools;
+    int mMaxRequestsPerHost;
+    int mMaxIdleConnectionsPerHost;
+    int mIdleTimeout;
+    int mConnectTimeout;
+    int mReadTimeout;
+    quint64 mRequestCount;
+    quint64 mConnectionsOpened;
+    quint64 mConnectionsReused;
+    quint64 mBytesSent;
+    quint64 mBytesReceived;
+    quint64 mQueuedRequests;
+    quint64 mTotalWaitTime;
+    quint64 mMaxWaitTime;
+    // the user and password entered for a proxy, by proxyKey()
+    QHash<QString, QPair<QString, QString> > mProxyCredentials;
+#ifndef QT_NO_SSL
+    // the certificate errors accepted for a host, by poolKey()
+    QHash<QString, QList<QSslError> > mAcceptedSslErrors;
+#endif
+
+    static QString poolKey(const QUrl &url);
+    static QString proxyKey(const QNetworkProxy &proxy);
+    // whether the response of @p job is a redirect jobFinished() acts on
+    static bool isRedirect(const TransportJob *job);
+    QNetworkProxy proxyFor(const QUrl &url) const;
+    bool askProxyCredentials(const QNetworkProxy &proxy, QAuthenticator *authenticator);
+    void dispatch(TransportJob *job, bool resend = false);
+    void dispatchQueued(const QString &key);
+    void unqueue(TransportJob *job);
+    void releaseConnection(HttpConnection *connection, bool keepAlive);
+    void finishJob(TransportJob *job);
+    void jobFinished(HttpConnection *connection, TransportJob *job, bool keepAlive);
+    void connectionClosed(HttpConnection *connection);
+    Q_DECLARE_PUBLIC(Transport)
+};
+
+/**
+  One persistent connection to a host. It serves one request at a time
+  and is handed back to the pool of its host once the response has been
+  read completely.
+*/
+class HttpConnection : public QObject
+{
+    Q_OBJECT
+public:
+    HttpConnection(TransportPrivate *transport, const QUrl &url);
+    ~HttpConnection();
+
+    QString key() const;
+    QNetworkProxy proxy() const;
+    bool isForwarding() const;
+    void send(TransportJob *job);
+    TransportJob *takeJob();
+    void startIdleTimer();
+    void close();
+
+private Q_SLOTS:
+    void slotConnected();
+    void slotReadyRead();
+    void slotDisconnected();
+    void slotError(QAbstractSocket::SocketError error);
+    void slotTimeout();
+    void slotBytesWritten();
+
+private:
+    enum State {
+        Idle,
+        Connecting,
+        StatusLine,
+        Headers,
+        Body,
+        ChunkSize,
+        ChunkData,
+        ChunkTrailer
+    };
+
+    void writeRequest();
+    void writeBody();
+    bool parseResponse();
+    bool headersComplete();
+    void appendBody(const QByteArray &data);
+    void finishResponse();
+    void fail(int error, const QString &errorText);
+#ifndef QT_NO_SSL
+    void sslErrors(const QList<QSslError> &errors);
+#endif
+
+    TransportPrivate *mTransport;
+    QString mKey;
+    QUrl mOrigin;
+    QNetworkProxy mProxy;
+    // whether requests are sent to an HTTP proxy instead of through a tunnel
+    bool mForwarding;
+    QTcpSocket *mSocket;
+    QPointer<TransportJob> mJob;
+    QTimer mTimer;
+    State mState;
+    QByteArray mBuffer;
+    qint64 mRemaining;
+    qint64 mUploadRemaining;
+    int mServedRequests;
+    bool mConnected;
+    bool mChunked;
+    bool mUntilClose;
+    bool mKeepAlive;
+    bool mResponseStarted;
+    // reading the rest of a response whose job finished early
+    bool mDiscarding;
+    qint64 mDiscarded;
+};
+
+} //namespace KBlog
+#endif
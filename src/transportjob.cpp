@@ -0,0 +1,196 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "transportjob.h"
+#include "transport_p.h"
+
+#include "kblog_debug.h"
+
+using namespace KBlog;
+
+TransportJobPrivate::TransportJobPrivate()
+    : mTransport(nullptr), mDevice(nullptr), mDeviceSize(0),
+      mConnection(nullptr), mPriority(Transport::Interactive), mQueued(false),
+      mStatusCode(0),
+      mRedirectCount(0), mConnectionReused(false), mRetried(false),
+      mStarted(false), mDispatching(false), mIgnoreSslErrors(false),
+      mProxyCredentialsAsked(false), mBufferData(true), mFinishEarly(false)
+{
+}
+
+void TransportJobPrivate::removeRequestHeader(const QByteArray &name)
+{
+    for (int i = mRequestHeaders.count() - 1; i >= 0; --i) {
+        if (qstricmp(mRequestHeaders.at(i).first.constData(), name.constData()) == 0) {
+            mRequestHeaders.removeAt(i);
+        }
+    }
+}
+
+TransportJob::TransportJob(Transport *transport, const QByteArray &method,
+                           const QUrl &url, const QByteArray &data)
+    : KJob(transport), d(new TransportJobPrivate)
+{
+    d->mTransport = transport;
+    d->mMethod = method;
+    d->mUrl = url;
+    d->mPostData = data;
+}
+
+TransportJob::~TransportJob()
+{
+    if (d->mQueued) {
+        d->mTransport->d_func()->unqueue(this);
+    }
+    if (d->mConnection) {
+        d->mConnection->takeJob();
+        d->mTransport->d_func()->connectionClosed(d->mConnection);
+    }
+    delete d;
+}
+
+QByteArray TransportJob::method() const
+{
+    return d->mMethod;
+}
+
+QUrl TransportJob::url() const
+{
+    return d->mUrl;
+}
+
+void TransportJob::setUrl(const QUrl &url)
+{
+    if (d->mStarted) {
+        qCWarning(KBLOG_LOG) << "setUrl() called on a running job";
+        return;
+    }
+    d->mUrl = url;
+}
+
+Transport::Priority TransportJob::priority() const
+{
+    return d->mPriority;
+}
+
+void TransportJob::setPriority(Transport::Priority priority)
+{
+    if (d->mStarted) {
+        qCWarning(KBLOG_LOG) << "setPriority() called on a running job";
+        return;
+    }
+    d->mPriority = priority;
+}
+
+QByteArray TransportJob::postData() const
+{
+    return d->mPostData;
+}
+
+void TransportJob::setRequestHeader(const QByteArray &name, const QByteArray &value)
+{
+    for (QPair<QByteArray, QByteArray> &header : d->mRequestHeaders) {
+        if (qstricmp(header.first.constData(), name.constData()) == 0) {
+            header.second = value;
+            return;
+        }
+    }
+    d->mRequestHeaders.append(qMakePair(name, value));
+}
+
+QByteArray TransportJob::requestHeader(const QByteArray &name) const
+{
+    for (const QPair<QByteArray, QByteArray> &header : qAsConst(d->mRequestHeaders)) {
+        if (qstricmp(header.first.constData(), name.constData()) == 0) {
+            return header.second;
+        }
+    }
+    return QByteArray();
+}
+
+QList<QPair<QByteArray, QByteArray> > TransportJob::requestHeaders() const
+{
+    return d->mRequestHeaders;
+}
+
+int TransportJob::statusCode() const
+{
+    return d->mStatusCode;
+}
+
+QByteArray TransportJob::responseHeader(const QByteArray &name) const
+{
+    for (const QPair<QByteArray, QByteArray> &header : qAsConst(d->mResponseHeaders)) {
+        if (qstricmp(header.first.constData(), name.constData()) == 0) {
+            return header.second;
+        }
+    }
+    return QByteArray();
+}
+
+QByteArray TransportJob::data() const
+{
+    return d->mData;
+}
+
+bool TransportJob::isConnectionReused() const
+{
+    return d->mConnectionReused;
+}
+
+void TransportJob::setBufferData(bool buffer)
+{
+    d->mBufferData = buffer;
+}
+
+bool TransportJob::bufferData() const
+{
+    return d->mBufferData;
+}
+
+void TransportJob::finishEarly()
+{
+    d->mFinishEarly = true;
+}
+
+void TransportJob::ignoreSslErrors()
+{
+    d->mIgnoreSslErrors = true;
+}
+
+void TransportJob::start()
+{
+    if (d->mStarted || d->mDispatching) {
+        return;
+    }
+    // Transport::startJob() may still rewrite the URL or the priority
+    d->mDispatching = true;
+    d->mTransport->startJob(this);
+    d->mDispatching = false;
+    d->mStarted = true;
+}
+
+bool TransportJob::doKill()
+{
+    if (d->mQueued) {
+        d->mTransport->d_func()->unqueue(this);
+    }
+    if (d->mConnection) {
+        HttpConnection *connection = d->mConnection;
+        connection->takeJob();
+        d->mTransport->d_func()->connectionClosed(connection);
+    }
+    return true;
+}
+
+void TransportJob::finish(int error, const QString &errorText)
+{
+    setError(error);
+    setErrorText(errorText);
+    emitResult();
+}
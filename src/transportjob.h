@@ -0,0 +1,219 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_TRANSPORTJOB_H
+#define KBLOG_TRANSPORTJOB_H
+
+#include <kblog_export.h>
+
+#include <transport.h>
+
+#include <KJob>
+
+#include <QByteArray>
+#include <QList>
+#include <QPair>
+
+class QUrl;
+
+/**
+  @file
+  This file is part of the library for accessing blogs and defines the
+  TransportJob class.
+*/
+
+namespace KBlog
+{
+
+class TransportJobPrivate;
+
+/**
+  @brief
+  A single HTTP request sent through a Transport.
+
+  Jobs are created with Transport::get() or Transport::post() and are
+  started explicitly with start(), so request headers can be set first.
+  The result() signal is emitted once the complete response has been
+  received; the job deletes itself afterwards.
+*/
+class KBLOG_EXPORT TransportJob : public KJob
+{
+    Q_OBJECT
+public:
+    /**
+      Errors reported by error() in addition to those of KJob.
+    */
+    enum Error {
+        /** The connection to the server could not be established or broke. */
+        ConnectionError = KJob::UserDefinedError + 1,
+        /** The server sent a response that is not valid HTTP. */
+        ProtocolError,
+        /** The server answered with an HTTP status code of 400 or above. */
+        HttpError,
+        /** The server did not accept the connection or stopped answering in time. */
+        TimeoutError
+    };
+
+    /**
+      Destroys the job.
+    */
+    ~TransportJob() override;
+
+    /**
+      Returns the HTTP method, e.g. GET or POST.
+    */
+    QByteArray method() const;
+
+    /**
+      Returns the URL of the request. After a redirect this is the URL of
+      the last request.
+    */
+    QUrl url() const;
+
+    /**
+      Sets the URL of the request. This must be called before the job
+      has been started.
+
+      @param url the new URL.
+    */
+    void setUrl(const QUrl &url);
+
+    /**
+      Returns the priority of the request.
+      @see setPriority()
+    */
+    Transport::Priority priority() const;
+
+    /**
+      Sets the priority of the request. It decides which request is sent
+      first while the host has queued requests. This must be called before
+      the job has been started.
+
+      @param priority the priority, defaults to Transport::Interactive.
+    */
+    void setPriority(Transport::Priority priority);
+
+    /**
+      Returns the body that is sent with the request. It is empty if the
+      body is read from a device.
+    */
+    QByteArray postData() const;
+
+    /**
+      Sets a header that is sent with the request, replacing a previous
+      value of the same header.
+
+      @param name the header name, e.g. "Content-Type".
+      @param value the header value.
+    */
+    void setRequestHeader(const QByteArray &name, const QByteArray &value);
+
+    /**
+      Returns the value of a request header or an empty array.
+      @param name the header name.
+    */
+    QByteArray requestHeader(const QByteArray &name) const;
+
+    /**
+      Returns all request headers in the order they were set.
+    */
+    QList<QPair<QByteArray, QByteArray> > requestHeaders() const;
+
+    /**
+      Returns the HTTP status code of the response or 0 if there is none.
+    */
+    int statusCode() const;
+
+    /**
+      Returns the value of a response header or an empty array. Header names
+      are compared case insensitively.
+
+      @param name the header name.
+    */
+    QByteArray responseHeader(const QByteArray &name) const;
+
+    /**
+      Returns the body of the response. It is empty if bufferData() is
+      false.
+    */
+    QByteArray data() const;
+
+    /**
+      Sets whether the body of the response is kept for data(). Turn it
+      off if the body is only read from dataReceived(), so it is not held
+      in memory.
+
+      @param buffer whether to keep the body, defaults to true.
+    */
+    void setBufferData(bool buffer);
+
+    /**
+      Returns whether the body of the response is kept for data().
+      @see setBufferData()
+    */
+    bool bufferData() const;
+
+    /**
+      Finishes the job as soon as the slot connected to dataReceived()
+      returns, e.g. once the answer has been parsed from the first part of
+      the response. The rest of the body is not passed on; it is read and
+      dropped to keep the connection for the next request, or the
+      connection is closed if too much of it is left. This only has an
+      effect in a slot connected to dataReceived().
+    */
+    void finishEarly();
+
+    /**
+      Returns true if the request has been sent over a connection that
+      already served an earlier request.
+    */
+    bool isConnectionReused() const;
+
+    /**
+      Continues connecting despite the errors of the certificate of the
+      server. This only has an effect in a slot connected directly to
+      Transport::sslErrors().
+    */
+    void ignoreSslErrors();
+
+    /**
+      Queues the request on the transport.
+    */
+    void start() override;
+
+Q_SIGNALS:
+    /**
+      Emitted whenever a part of the response body has arrived, so the
+      response can be parsed before it is complete. Unless bufferData()
+      is false, data() holds everything received so far. It is not emitted
+      for the body of a redirect the transport acts on. A redirect it does
+      not follow, e.g. of a POST request, finishes the job with HttpError.
+      The job must not be killed from a slot connected to this signal, call
+      finishEarly() instead.
+
+      @param job the job.
+      @param data the part of the body that has just arrived.
+    */
+    void dataReceived(KBlog::TransportJob *job, const QByteArray &data);
+
+protected:
+    bool doKill() override;
+
+private:
+    friend class Transport;
+    friend class TransportPrivate;
+    friend class HttpConnection;
+    TransportJob(Transport *transport, const QByteArray &method,
+                 const QUrl &url, const QByteArray &data);
+    void finish(int error, const QString &errorText);
+    TransportJobPrivate *const d;
+    Q_DISABLE_COPY(TransportJob)
+};
+
+} //namespace KBlog
+#endif
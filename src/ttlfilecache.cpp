@@ -0,0 +1,134 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "ttlfilecache_p.h"
+
+#include "kblog_debug.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+
+using namespace KBlog;
+
+// how long the other objects wait for an update to finish
+static const qint64 updateTimeout = 60 * 1000;
+
+TtlFileCacheBase::TtlFileCacheBase(const QString &directory, const char *name,
+                                   quint32 magic, quint32 version, int maxAge)
+    : mDirectory(directory), mName(name), mMagic(magic), mVersion(version),
+      mMaxAge(maxAge), mDiskReads(0)
+{
+}
+
+TtlFileCacheBase::~TtlFileCacheBase()
+{
+}
+
+QString TtlFileCacheBase::directory() const
+{
+    return mDirectory;
+}
+
+int TtlFileCacheBase::maxAge() const
+{
+    QReadLocker locker(&mLock);
+    return mMaxAge;
+}
+
+void TtlFileCacheBase::setMaxAge(int seconds)
+{
+    QWriteLocker locker(&mLock);
+    mMaxAge = seconds;
+}
+
+int TtlFileCacheBase::diskReads() const
+{
+    QReadLocker locker(&mLock);
+    return mDiskReads;
+}
+
+QString TtlFileCacheBase::fileName(const QString &key) const
+{
+    return mDirectory + QLatin1Char('/') + key;
+}
+
+bool TtlFileCacheBase::isFreshSince(const QDateTime &storedAt) const
+{
+    QReadLocker locker(&mLock);
+    return storedAt.isValid() &&
+           storedAt.secsTo(QDateTime::currentDateTimeUtc()) < mMaxAge;
+}
+
+bool TtlFileCacheBase::startUpdate(const QString &key)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QWriteLocker locker(&mLock);
+    QHash<QString, qint64>::Iterator it = mUpdates.find(key);
+    if (it != mUpdates.end() && now - *it < updateTimeout) {
+        return false;
+    }
+    mUpdates.insert(key, now);
+    return true;
+}
+
+void TtlFileCacheBase::cancelUpdate(const QString &key)
+{
+    QWriteLocker locker(&mLock);
+    mUpdates.remove(key);
+}
+
+bool TtlFileCacheBase::readFile(const QString &key,
+                                const std::function<bool(QDataStream &)> &readEntry,
+                                const std::function<bool(QFile &)> &readLegacy)
+{
+    QFile file(fileName(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCDebug(KBLOG_LOG) << "No cached" << mName << "for" << key;
+        return false;
+    }
+    ++mDiskReads;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    quint32 magic = 0, version = 0;
+    stream >> magic >> version;
+    if (magic != mMagic && file.seek(0) && readLegacy(file)) {
+        return true;
+    }
+    if (magic != mMagic || version != mVersion) {
+        qCDebug(KBLOG_LOG) << "Ignoring cached" << mName << "of unknown version" << file.fileName();
+        return false;
+    }
+    if (!readEntry(stream) || stream.status() != QDataStream::Ok) {
+        qCWarning(KBLOG_LOG) << "Ignoring corrupt cached" << mName << file.fileName();
+        return false;
+    }
+    return true;
+}
+
+void TtlFileCacheBase::writeFile(const QString &key,
+                                 const std::function<void(QDataStream &)> &writeEntry) const
+{
+    if (!QDir().mkpath(mDirectory)) {
+        qCWarning(KBLOG_LOG) << "Cannot create the cache directory" << mDirectory;
+        return;
+    }
+    // readers in other processes see either the old or the new file
+    QSaveFile file(fileName(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCDebug(KBLOG_LOG) << "Cannot write cached" << mName << file.fileName();
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << mMagic << mVersion;
+    writeEntry(stream);
+    file.commit();
+}
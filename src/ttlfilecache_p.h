@@ -0,0 +1,179 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_TTLFILECACHE_P_H
+#define KBLOG_TTLFILECACHE_P_H
+
+#include "kblog_private_export.h"
+
+#include <QDateTime>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+
+#include <functional>
+
+class QDataStream;
+class QFile;
+
+namespace KBlog
+{
+
+/**
+  The part of TtlFileCache that does not depend on the type of the
+  entries: the files, the maximum age and the updates in progress.
+*/
+class KBLOG_TESTS_EXPORT TtlFileCacheBase
+{
+public:
+    QString directory() const;
+
+    int maxAge() const;
+    void setMaxAge(int seconds);
+
+    /**
+      Returns the number of files read so far.
+    */
+    int diskReads() const;
+
+protected:
+    TtlFileCacheBase(const QString &directory, const char *name, quint32 magic,
+                     quint32 version, int maxAge);
+    virtual ~TtlFileCacheBase();
+
+    virtual QString fileName(const QString &key) const;
+
+    bool isFreshSince(const QDateTime &storedAt) const;
+
+    /**
+      Returns true if the caller should update @p key, i.e. no other
+      object has started to do so in the last minute. The update ends
+      with TtlFileCache::storeEntry() or cancelUpdate().
+    */
+    bool startUpdate(const QString &key);
+    void cancelUpdate(const QString &key);
+
+    /**
+      Reads the file of @p key with @p readEntry, or with @p readLegacy if
+      it does not start with the magic number. Expects mLock to be locked
+      for writing.
+    */
+    bool readFile(const QString &key, const std::function<bool(QDataStream &)> &readEntry,
+                  const std::function<bool(QFile &)> &readLegacy);
+    void writeFile(const QString &key, const std::function<void(QDataStream &)> &writeEntry) const;
+
+    mutable QReadWriteLock mLock;
+
+private:
+    const QString mDirectory;
+    const char *const mName;
+    const quint32 mMagic;
+    const quint32 mVersion;
+    int mMaxAge;
+    int mDiskReads;
+    QHash<QString, qint64> mUpdates;
+};
+
+/**
+  Entries that expire after maxAge() seconds, kept in memory for all
+  objects of the process and in one file per key in directory(). Every
+  key is read from disk at most once. A file starts with a magic number
+  and a version, followed by the entry as streamed by writeEntry().
+*/
+template <class Entry>
+class TtlFileCache : public TtlFileCacheBase
+{
+public:
+    /**
+      Returns the entry of @p key, read from disk if it is not known yet.
+    */
+    Entry entry(const QString &key)
+    {
+        {
+            QReadLocker locker(&mLock);
+            typename QHash<QString, Entry>::ConstIterator it = mEntries.constFind(key);
+            if (it != mEntries.constEnd()) {
+                return *it;
+            }
+        }
+
+        QWriteLocker locker(&mLock);
+        // another thread might have read it in the meantime
+        typename QHash<QString, Entry>::ConstIterator it = mEntries.constFind(key);
+        if (it != mEntries.constEnd()) {
+            return *it;
+        }
+        Entry entry;
+        if (!readFile(key,
+                      [this, &key, &entry](QDataStream &stream) {
+                          return readEntry(stream, key, &entry);
+                      },
+                      [this, &entry](QFile &file) {
+                          return readLegacy(file, &entry);
+                      })) {
+            entry = Entry();
+        }
+        mEntries.insert(key, entry);
+        return entry;
+    }
+
+    /**
+      Returns whether @p entry has been stored less than maxAge() ago.
+    */
+    bool isFresh(const Entry &entry) const
+    {
+        return isFreshSince(timestamp(entry));
+    }
+
+protected:
+    TtlFileCache(const QString &directory, const char *name, quint32 magic,
+                 quint32 version, int maxAge)
+        : TtlFileCacheBase(directory, name, magic, version, maxAge)
+    {
+    }
+
+    /**
+      Returns when @p entry was stored, or an invalid date if unknown.
+    */
+    virtual QDateTime timestamp(const Entry &entry) const = 0;
+
+    virtual bool readEntry(QDataStream &stream, const QString &key, Entry *entry) const = 0;
+    virtual void writeEntry(QDataStream &stream, const QString &key, const Entry &entry) const = 0;
+
+    /**
+      Reads a file written by an earlier version without the magic
+      number. There is none by default.
+    */
+    virtual bool readLegacy(QFile &file, Entry *entry) const
+    {
+        Q_UNUSED(file);
+        Q_UNUSED(entry);
+        return false;
+    }
+
+    /**
+      Replaces the entry of @p key, in memory and on disk, and ends its
+      update.
+    */
+    void storeEntry(const QString &key, const Entry &entry)
+    {
+        cancelUpdate(key);
+        QWriteLocker locker(&mLock);
+        mEntries.insert(key, entry);
+        writeFile(key, [this, &key, &entry](QDataStream &stream) {
+            writeEntry(stream, key, entry);
+        });
+    }
+
+private:
+    QHash<QString, Entry> mEntries;
+};
+
+}
+
+#endif
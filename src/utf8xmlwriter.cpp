@@ -0,0 +1,160 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "utf8xmlwriter_p.h"
+
+#include <cstring>
+
+using namespace KBlog;
+
+Utf8XmlWriter::Utf8XmlWriter(int capacity)
+    : mSize(0)
+{
+    // the buffer is used up to mSize and truncated in takeData()
+    mData.resize(capacity);
+}
+
+void Utf8XmlWriter::reserve(int bytes)
+{
+    if (mSize + bytes > mData.size()) {
+        mData.resize(qMax(mData.size() * 2, mSize + bytes));
+    }
+}
+
+void Utf8XmlWriter::writeMarkup(const char *markup)
+{
+    const int length = int(std::strlen(markup));
+    reserve(length);
+    std::memcpy(mData.data() + mSize, markup, length);
+    mSize += length;
+}
+
+void Utf8XmlWriter::writeMarkup(const QByteArray &markup)
+{
+    reserve(markup.size());
+    std::memcpy(mData.data() + mSize, markup.constData(), markup.size());
+    mSize += markup.size();
+}
+
+void Utf8XmlWriter::writeNumber(int number)
+{
+    writeMarkup(QByteArray::number(number));
+}
+
+void Utf8XmlWriter::writeCData(const QString &text)
+{
+    writeMarkup("<![CDATA[");
+    const QChar *data = text.constData();
+    int from = 0;
+    int end;
+    while ((end = text.indexOf(QLatin1String("]]>"), from)) >= 0) {
+        // keep "]]" in this section and start the next one with ">"
+        writeUtf8(data + from, data + end + 2);
+        writeMarkup("]]><![CDATA[");
+        from = end + 2;
+    }
+    writeUtf8(data + from, data + text.size());
+    writeMarkup("]]>");
+}
+
+void Utf8XmlWriter::writeText(const QString &text)
+{
+    writeEscaped(text, false);
+}
+
+void Utf8XmlWriter::writeAttribute(const QString &text)
+{
+    writeEscaped(text, true);
+}
+
+void Utf8XmlWriter::writeEscaped(const QString &text, bool quotes)
+{
+    const QChar *begin = text.constData();
+    const QChar *end = begin + text.size();
+    const QChar *chunk = begin;
+    for (const QChar *it = begin; it != end; ++it) {
+        const char *entity = nullptr;
+        switch (it->unicode()) {
+        case '&': entity = "&amp;"; break;
+        case '<': entity = "&lt;"; break;
+        case '>': entity = "&gt;"; break;
+        case '"':
+            if (!quotes) {
+                continue;
+            }
+            entity = "&quot;";
+            break;
+        case '\'':
+            if (!quotes) {
+                continue;
+            }
+            entity = "&apos;";
+            break;
+        default: continue;
+        }
+        writeUtf8(chunk, it);
+        writeMarkup(entity);
+        chunk = it + 1;
+    }
+    writeUtf8(chunk, end);
+}
+
+void Utf8XmlWriter::writeUtf8(const QChar *begin, const QChar *end)
+{
+    // enough for ASCII, anything else grows the buffer as it comes
+    reserve(int(end - begin));
+    for (const QChar *it = begin; it != end; ++it) {
+        uint code = it->unicode();
+        if (code < 0x80) {
+            if (mSize == mData.size()) {
+                reserve(int(end - it));
+            }
+            mData.data()[mSize++] = char(code);
+            continue;
+        }
+        if (mSize + 4 > mData.size()) {
+            reserve(4 + int(end - it));
+        }
+        char *out = mData.data() + mSize;
+        if (code < 0x800) {
+            out[0] = char(0xc0 | (code >> 6));
+            out[1] = char(0x80 | (code & 0x3f));
+            mSize += 2;
+            continue;
+        }
+        if (QChar::isHighSurrogate(code) && it + 1 != end && (it + 1)->isLowSurrogate()) {
+            ++it;
+            code = QChar::surrogateToUcs4(ushort(code), it->unicode());
+            out[0] = char(0xf0 | (code >> 18));
+            out[1] = char(0x80 | ((code >> 12) & 0x3f));
+            out[2] = char(0x80 | ((code >> 6) & 0x3f));
+            out[3] = char(0x80 | (code & 0x3f));
+            mSize += 4;
+            continue;
+        }
+        if (QChar::isSurrogate(code)) {
+            // a lone surrogate, QString::toUtf8() writes '?' as well
+            out[0] = '?';
+            ++mSize;
+            continue;
+        }
+        out[0] = char(0xe0 | (code >> 12));
+        out[1] = char(0x80 | ((code >> 6) & 0x3f));
+        out[2] = char(0x80 | (code & 0x3f));
+        mSize += 3;
+    }
+}
+
+QByteArray Utf8XmlWriter::takeData()
+{
+    mData.truncate(mSize);
+    mSize = 0;
+    QByteArray data;
+    data.swap(mData);
+    return data;
+}
@@ -0,0 +1,78 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_UTF8XMLWRITER_P_H
+#define KBLOG_UTF8XMLWRITER_P_H
+
+#include "kblog_private_export.h"
+
+#include <QByteArray>
+#include <QString>
+
+namespace KBlog
+{
+
+/**
+  Writes XML markup as UTF-8 straight into one buffer. Unlike building
+  a QString and converting it with toUtf8(), the text is encoded only
+  once and never copied.
+*/
+class KBLOG_TESTS_EXPORT Utf8XmlWriter
+{
+public:
+    /**
+      Creates a writer whose buffer has room for @p capacity bytes. The
+      buffer grows if that turns out to be too small.
+    */
+    explicit Utf8XmlWriter(int capacity = 0);
+
+    /**
+      Appends @p markup as is. It has to be ASCII.
+    */
+    void writeMarkup(const char *markup);
+    void writeMarkup(const QByteArray &markup);
+
+    /**
+      Appends @p number in decimal.
+    */
+    void writeNumber(int number);
+
+    /**
+      Appends @p text within a CDATA section. A "]]>" within @p text
+      is split across two sections, so the text is sent unchanged.
+    */
+    void writeCData(const QString &text);
+
+    /**
+      Appends @p text with the markup characters escaped.
+    */
+    void writeText(const QString &text);
+
+    /**
+      Appends @p text with the markup characters and both quotes
+      escaped, for use as an attribute value.
+    */
+    void writeAttribute(const QString &text);
+
+    /**
+      Returns the markup written so far and clears the writer.
+    */
+    QByteArray takeData();
+
+private:
+    void reserve(int bytes);
+    void writeEscaped(const QString &text, bool quotes);
+    void writeUtf8(const QChar *begin, const QChar *end);
+
+    QByteArray mData;
+    int mSize;
+};
+
+}
+
+#endif
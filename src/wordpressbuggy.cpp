@@ -10,12 +10,16 @@
 #include "wordpressbuggy_p.h"
 
 #include "blogpost.h"
+#include "transport.h"
+#include "transportjob.h"
+#include "utf8xmlwriter_p.h"
+#include "xmlrpcresponsescanner_p.h"
 
 #include "kblog_debug.h"
 #include <KLocalizedString>
 
-#include <kio/job.h>
-
+#include <QDateTime>
+#include <QScopedPointer>
 #include <QStringList>
 
 using namespace KBlog;
@@ -48,12 +52,8 @@ void WordpressBuggy::createPost(KBlog::BlogPost *post)
     // we need mCategoriesList to be loaded first, since we cannot use the post->categories()
     // names later, but we need to map them to categoryId of the blog
     d->loadCategories();
-    if (d->mCategoriesList.isEmpty()) {
+    if (d->waitForCategories(MovableTypePrivate::WaitingCreate, post)) {
         qCDebug(KBLOG_LOG) << "No categories in the cache yet. Have to fetch them first.";
-        d->mCreatePostCache << post;
-        connect(this, SIGNAL(listedCategories(QList<QMap<QString,QString> >)),
-                this, SLOT(slotTriggerCreatePost()));
-        listCategories();
     } else {
         qCDebug(KBLOG_LOG) << "createPost()";
         if (!post) {
@@ -65,7 +65,8 @@ void WordpressBuggy::createPost(KBlog::BlogPost *post)
 
         bool publish = post->isPrivate();
         // If we do setPostCategories() later than we disable publishing first.
-        if (!post->categories().isEmpty()) {
+        if (!post->categories().isEmpty() &&
+                d->mNewPostCategories != MovableTypePrivate::NewPostCategoriesSupported) {
             post->setPrivate(true);
             if (d->mSilentCreationList.contains(post)) {
                 qCDebug(KBLOG_LOG) << "Post already in mSilentCreationList, this *should* never happen!";
@@ -74,77 +75,27 @@ void WordpressBuggy::createPost(KBlog::BlogPost *post)
             }
         }
 
-        QString xmlMarkup = QStringLiteral("<?xml version=\"1.0\"?>");
-        xmlMarkup += QStringLiteral("<methodCall>");
-        xmlMarkup += QStringLiteral("<methodName>metaWeblog.newPost</methodName>");
-        xmlMarkup += QStringLiteral("<params><param>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + blogId() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</param>");
-        xmlMarkup += QStringLiteral("<param>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + username() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</param><param>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + password() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</param>");
-        xmlMarkup += QStringLiteral("<param><struct>");
-        xmlMarkup += QStringLiteral("<member><name>description</name>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->content() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</member><member>");
-        xmlMarkup += QStringLiteral("<name>title</name>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->title() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</member><member>");
-
-        xmlMarkup += QStringLiteral("<name>dateCreated</name>");
-        xmlMarkup += QStringLiteral("<value><dateTime.iso8601>") +
-                     post->creationDateTime().toUTC().toString(QStringLiteral("yyyyMMddThh:mm:ss")) +
-                     QStringLiteral("</dateTime.iso8601></value>");
-        xmlMarkup += QStringLiteral("</member><member>");
-        xmlMarkup += QStringLiteral("<name>mt_allow_comments</name>");
-        xmlMarkup += QStringLiteral("<value><int>%1</int></value>").arg((int)post->isCommentAllowed());
-        xmlMarkup += QStringLiteral("</member><member>");
-        xmlMarkup += QStringLiteral("<name>mt_allow_pings</name>");
-        xmlMarkup += QStringLiteral("<value><int>%1</int></value>").arg((int)post->isTrackBackAllowed());
-        xmlMarkup += QStringLiteral("</member><member>");
-        if (!post->additionalContent().isEmpty()) {
-            xmlMarkup += QStringLiteral("<name>mt_text_more</name>");
-            xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->additionalContent() + QStringLiteral("]]></string></value>");
-            xmlMarkup += QStringLiteral("</member><member>");
-        }
-        xmlMarkup += QStringLiteral("<name>wp_slug</name>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->slug() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</member><member>");
-        xmlMarkup += QStringLiteral("<name>mt_excerpt</name>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->summary() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</member><member>");
-        xmlMarkup += QStringLiteral("<name>mt_keywords</name>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->tags().join(QLatin1Char(',')) + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</member></struct></param>");
-        xmlMarkup += QStringLiteral("<param><value><boolean>") +
-                     QStringLiteral("%1").arg((int)(!post->isPrivate())) +
-                     QStringLiteral("</boolean></value></param>");
-        xmlMarkup += QStringLiteral("</params></methodCall>");
-
-        QByteArray postData;
-        QDataStream stream(&postData, QIODevice::WriteOnly);
-        stream.writeRawData(xmlMarkup.toUtf8().constData(), xmlMarkup.toUtf8().length());
-
-        KIO::StoredTransferJob *job = KIO::storedHttpPost(postData, url(), KIO::HideProgressInfo);
+        const QByteArray postData = d->markupPost(*post, true);
+
+        TransportJob *job = transport()->post(url(), postData);
         if (!job) {
             qCWarning(KBLOG_LOG) << "Failed to create job for: " << url().url();
             return;
         }
+        job->setPriority(requestPriority());
 
         d->mCreatePostMap[ job ] = post;
+        d->scanResponse(job);
 
 
-        job->addMetaData(
-            QStringLiteral("customHTTPHeader"), QStringLiteral("X-hacker: Shame on you Wordpress, ") + QString() +
-            QStringLiteral("you took another 4 hours of my life to work around the stupid dateTime bug."));
-        job->addMetaData(QStringLiteral("content-type"), QStringLiteral("Content-Type: text/xml; charset=utf-8"));
-        job->addMetaData(QStringLiteral("ConnectTimeout"), QStringLiteral("50"));
-        job->addMetaData(QStringLiteral("UserAgent"), userAgent());
+        job->setRequestHeader("X-hacker", "Shame on you Wordpress, "
+                              "you took another 4 hours of my life to work around the stupid dateTime bug.");
+        job->setRequestHeader("Content-Type", "text/xml; charset=utf-8");
+        job->setRequestHeader("User-Agent", userAgent().toUtf8());
 
         connect(job, SIGNAL(result(KJob*)),
                 this, SLOT(slotCreatePost(KJob*)));
+        job->start();
         // HACK: uuh this a bit ugly now... reenable the original publish argument,
         // since createPost should have parsed now
         post->setPrivate(publish);
@@ -161,12 +112,8 @@ void WordpressBuggy::modifyPost(KBlog::BlogPost *post)
     // we need mCategoriesList to be loaded first, since we cannot use the post->categories()
     // names later, but we need to map them to categoryId of the blog
     d->loadCategories();
-    if (d->mCategoriesList.isEmpty()) {
+    if (d->waitForCategories(MovableTypePrivate::WaitingModify, post)) {
         qCDebug(KBLOG_LOG) << "No categories in the cache yet. Have to fetch them first.";
-        d->mModifyPostCache << post;
-        connect(this, SIGNAL(listedCategories(QList<QMap<QString,QString> >)),
-                this, SLOT(slotTriggerModifyPost()));
-        listCategories();
     } else {
         if (!post) {
             qCritical() << "WordpressBuggy::modifyPost: post is a null pointer";
@@ -176,83 +123,46 @@ void WordpressBuggy::modifyPost(KBlog::BlogPost *post)
 
         qCDebug(KBLOG_LOG) << "Uploading Post with postId" << post->postId();
 
-        QString xmlMarkup = QStringLiteral("<?xml version=\"1.0\"?>");
-        xmlMarkup += QStringLiteral("<methodCall>");
-        xmlMarkup += QStringLiteral("<methodName>metaWeblog.editPost</methodName>");
-        xmlMarkup += QStringLiteral("<params><param>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->postId() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</param>");
-        xmlMarkup += QStringLiteral("<param>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + username() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</param><param>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + password() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</param>");
-        xmlMarkup += QStringLiteral("<param><struct>");
-        xmlMarkup += QStringLiteral("<member><name>description</name>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->content() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</member><member>");
-        xmlMarkup += QStringLiteral("<name>title</name>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->title() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</member><member>");
-
-        xmlMarkup += QStringLiteral("<name>lastModified</name>");
-        xmlMarkup += QStringLiteral("<value><dateTime.iso8601>") +
-                     post->modificationDateTime().toUTC().toString(QStringLiteral("yyyyMMddThh:mm:ss")) +
-                     QStringLiteral("</dateTime.iso8601></value>");
-        xmlMarkup += QStringLiteral("</member><member>");
-        xmlMarkup += QStringLiteral("<name>dateCreated</name>");
-        xmlMarkup += QStringLiteral("<value><dateTime.iso8601>") +
-                     post->creationDateTime().toUTC().toString(QStringLiteral("yyyyMMddThh:mm:ss")) +
-                     QStringLiteral("</dateTime.iso8601></value>");
-        xmlMarkup += QStringLiteral("</member><member>");
-        xmlMarkup += QStringLiteral("<name>mt_allow_comments</name>");
-        xmlMarkup += QStringLiteral("<value><int>%1</int></value>").arg((int)post->isCommentAllowed());
-        xmlMarkup += QStringLiteral("</member><member>");
-        xmlMarkup += QStringLiteral("<name>mt_allow_pings</name>");
-        xmlMarkup += QStringLiteral("<value><int>%1</int></value>").arg((int)post->isTrackBackAllowed());
-        xmlMarkup += QStringLiteral("</member><member>");
-        if (!post->additionalContent().isEmpty()) {
-            xmlMarkup += QStringLiteral("<name>mt_text_more</name>");
-            xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->additionalContent() + QStringLiteral("]]></string></value>");
-            xmlMarkup += QStringLiteral("</member><member>");
-        }
-        xmlMarkup += QStringLiteral("<name>wp_slug</name>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->slug() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</member><member>");
-        xmlMarkup += QStringLiteral("<name>mt_excerpt</name>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->summary() + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</member><member>");
-        xmlMarkup += QStringLiteral("<name>mt_keywords</name>");
-        xmlMarkup += QStringLiteral("<value><string><![CDATA[") + post->tags().join(QLatin1Char(',')) + QStringLiteral("]]></string></value>");
-        xmlMarkup += QStringLiteral("</member></struct></param>");
-        xmlMarkup += QStringLiteral("<param><value><boolean>") +
-                     QStringLiteral("%1").arg((int)(!post->isPrivate())) +
-                     QStringLiteral("</boolean></value></param>");
-        xmlMarkup += QStringLiteral("</params></methodCall>");
-
-        QByteArray postData;
-        QDataStream stream(&postData, QIODevice::WriteOnly);
-        stream.writeRawData(xmlMarkup.toUtf8().constData(), xmlMarkup.toUtf8().length());
-
-        KIO::StoredTransferJob *job = KIO::storedHttpPost(postData, url(), KIO::HideProgressInfo);
+        const QByteArray postData = d->markupPost(*post, false);
+
+        TransportJob *job = transport()->post(url(), postData);
         if (!job) {
             qCWarning(KBLOG_LOG) << "Failed to create job for: " << url().url();
             return;
         }
+        job->setPriority(requestPriority());
 
         d->mModifyPostMap[ job ] = post;
+        d->scanResponse(job);
 
 
-        job->addMetaData(
-            QStringLiteral("customHTTPHeader"), QStringLiteral("X-hacker: Shame on you Wordpress, ") + QString() +
-            QStringLiteral("you took another 4 hours of my life to work around the stupid dateTime bug."));
-        job->addMetaData(QStringLiteral("content-type"), QStringLiteral("Content-Type: text/xml; charset=utf-8"));
-        job->addMetaData(QStringLiteral("ConnectTimeout"), QStringLiteral("50"));
-        job->addMetaData(QStringLiteral("UserAgent"), userAgent());
+        job->setRequestHeader("X-hacker", "Shame on you Wordpress, "
+                              "you took another 4 hours of my life to work around the stupid dateTime bug.");
+        job->setRequestHeader("Content-Type", "text/xml; charset=utf-8");
+        job->setRequestHeader("User-Agent", userAgent().toUtf8());
 
         connect(job, SIGNAL(result(KJob*)),
                 this, SLOT(slotModifyPost(KJob*)));
+        job->start();
+    }
+}
+
+void WordpressBuggy::listRecentPostsPaged(int number, int pageSize)
+{
+    Q_D(WordpressBuggy);
+    // rejected before, or missing from the methods the server listed
+    if (d->mGetPostsUnsupported ||
+            !d->mXmlRpcClient->capabilities().supports(QStringLiteral("wp.getPosts"))) {
+        MovableType::listRecentPostsPaged(number, pageSize);
+        return;
     }
+    qCDebug(KBLOG_LOG) << "Fetching list of posts with wp.getPosts in pages of" << pageSize;
+    d->startPaging(number, pageSize);
+    if (number <= 0) {
+        d->pageReceived(QList<BlogPost>(), true);
+        return;
+    }
+    d->callGetPosts();
 }
 
 QString WordpressBuggy::interfaceName() const
@@ -261,12 +171,14 @@ QString WordpressBuggy::interfaceName() const
 }
 
 WordpressBuggyPrivate::WordpressBuggyPrivate()
+    : mGetPostsGeneration(0), mGetPostsUnsupported(false)
 {
 }
 
 WordpressBuggyPrivate::~WordpressBuggyPrivate()
 {
     qCDebug(KBLOG_LOG);
+    qDeleteAll(mResponseScanners);
 }
 
 QList<QVariant> WordpressBuggyPrivate::defaultArgs(const QString &id)
@@ -281,17 +193,238 @@ QList<QVariant> WordpressBuggyPrivate::defaultArgs(const QString &id)
     return args;
 }
 
+QByteArray WordpressBuggyPrivate::markupPost(const BlogPost &post, bool create)
+{
+    Q_Q(WordpressBuggy);
+    const QString id = create ? q->blogId() : post.postId();
+    const QString tags = post.tags().join(QLatin1Char(','));
+    // room for the markup around the strings, which are mostly ASCII
+    Utf8XmlWriter writer(1024 + id.size() + q->username().size() + q->password().size() +
+                         post.content().size() + post.title().size() +
+                         post.additionalContent().size() + post.slug().size() +
+                         post.summary().size() + tags.size());
+    writer.writeMarkup("<?xml version=\"1.0\"?><methodCall><methodName>");
+    writer.writeMarkup(create ? "metaWeblog.newPost" : "metaWeblog.editPost");
+    writer.writeMarkup("</methodName><params><param><value><string>");
+    writer.writeCData(id);
+    writer.writeMarkup("</string></value></param><param><value><string>");
+    writer.writeCData(q->username());
+    writer.writeMarkup("</string></value></param><param><value><string>");
+    writer.writeCData(q->password());
+    writer.writeMarkup("</string></value></param><param><struct>"
+                       "<member><name>description</name><value><string>");
+    writer.writeCData(post.content());
+    writer.writeMarkup("</string></value></member><member><name>title</name><value><string>");
+    writer.writeCData(post.title());
+    writer.writeMarkup("</string></value></member><member>");
+    if (!create) {
+        writer.writeMarkup("<name>lastModified</name><value><dateTime.iso8601>");
+        writer.writeMarkup(post.modificationDateTime().toUTC().toString(QStringLiteral("yyyyMMddThh:mm:ss")).toLatin1());
+        writer.writeMarkup("</dateTime.iso8601></value></member><member>");
+    }
+    writer.writeMarkup("<name>dateCreated</name><value><dateTime.iso8601>");
+    writer.writeMarkup(post.creationDateTime().toUTC().toString(QStringLiteral("yyyyMMddThh:mm:ss")).toLatin1());
+    writer.writeMarkup("</dateTime.iso8601></value></member><member>"
+                       "<name>mt_allow_comments</name><value><int>");
+    writer.writeNumber(int(post.isCommentAllowed()));
+    writer.writeMarkup("</int></value></member><member><name>mt_allow_pings</name><value><int>");
+    writer.writeNumber(int(post.isTrackBackAllowed()));
+    writer.writeMarkup("</int></value></member><member>");
+    if (!post.additionalContent().isEmpty()) {
+        writer.writeMarkup("<name>mt_text_more</name><value><string>");
+        writer.writeCData(post.additionalContent());
+        writer.writeMarkup("</string></value></member><member>");
+    }
+    writer.writeMarkup("<name>wp_slug</name><value><string>");
+    writer.writeCData(post.slug());
+    writer.writeMarkup("</string></value></member><member><name>mt_excerpt</name><value><string>");
+    writer.writeCData(post.summary());
+    writer.writeMarkup("</string></value></member><member><name>mt_keywords</name><value><string>");
+    writer.writeCData(tags);
+    writer.writeMarkup("</string></value></member>");
+    if (create && mNewPostCategories == NewPostCategoriesSupported) {
+        const QStringList categories = post.categories();
+        writer.writeMarkup("<member><name>categories</name><value><array><data>");
+        for (const QString &category : categories) {
+            writer.writeMarkup("<value><string>");
+            writer.writeCData(category);
+            writer.writeMarkup("</string></value>");
+        }
+        writer.writeMarkup("</data></array></value></member>");
+    }
+    writer.writeMarkup("</struct></param><param><value><boolean>");
+    writer.writeNumber(int(!post.isPrivate()));
+    writer.writeMarkup("</boolean></value></param></params></methodCall>");
+    return writer.takeData();
+}
+
+void WordpressBuggyPrivate::callGetPosts()
+{
+    Q_Q(WordpressBuggy);
+    QMap<QString, QVariant> filter;
+    filter[QStringLiteral("post_type")] = QStringLiteral("post");
+    filter[QStringLiteral("number")] = nextPageSize();
+    filter[QStringLiteral("offset")] = mPageOffset;
+    filter[QStringLiteral("orderby")] = QStringLiteral("post_date");
+    filter[QStringLiteral("order")] = QStringLiteral("DESC");
+    QList<QVariant> args(defaultArgs(q->blogId()));
+    args << QVariant(filter);
+    mGetPostsGeneration = mPageGeneration;
+    mXmlRpcClient->call(
+        QStringLiteral("wp.getPosts"), args,
+        q, SLOT(slotGetPosts(QList<QVariant>,QVariant)),
+        q, SLOT(slotGetPostsError(int,QString,QVariant)));
+}
+
+bool WordpressBuggyPrivate::readPostFromWpMap(BlogPost *post, const QMap<QString, QVariant> &postInfo)
+{
+    if (!post || !postInfo.contains(QStringLiteral("post_id"))) {
+        return false;
+    }
+    post->setPostId(postInfo[QStringLiteral("post_id")].toString());
+    post->setTitle(postInfo[QStringLiteral("post_title")].toString());
+    post->setContent(postInfo[QStringLiteral("post_content")].toString());
+    post->setSummary(postInfo[QStringLiteral("post_excerpt")].toString());
+    post->setSlug(postInfo[QStringLiteral("post_name")].toString());
+    post->setLink(QUrl(postInfo[QStringLiteral("link")].toString()));
+    post->setPermaLink(QUrl(postInfo[QStringLiteral("link")].toString()));
+
+    QDateTime dt = postInfo[QStringLiteral("post_date_gmt")].toDateTime();
+    if (dt.isValid() && !dt.isNull()) {
+        // the _gmt fields are sent without a time zone
+        dt.setTimeSpec(Qt::UTC);
+        post->setCreationDateTime(dt.toLocalTime());
+    }
+    dt = postInfo[QStringLiteral("post_modified_gmt")].toDateTime();
+    if (dt.isValid() && !dt.isNull()) {
+        dt.setTimeSpec(Qt::UTC);
+        post->setModificationDateTime(dt.toLocalTime());
+    }
+
+    const QString postStatus = postInfo[QStringLiteral("post_status")].toString();
+    post->setPrivate(postStatus != QLatin1String("publish") && !postStatus.isEmpty());
+    post->setCommentAllowed(postInfo[QStringLiteral("comment_status")].toString() == QLatin1String("open"));
+    post->setTrackBackAllowed(postInfo[QStringLiteral("ping_status")].toString() == QLatin1String("open"));
+
+    QStringList categories;
+    QStringList tags;
+    const QList<QVariant> terms = postInfo[QStringLiteral("terms")].toList();
+    for (const QVariant &termVariant : terms) {
+        const QMap<QString, QVariant> term = termVariant.toMap();
+        const QString taxonomy = term[QStringLiteral("taxonomy")].toString();
+        if (taxonomy == QLatin1String("category")) {
+            categories << term[QStringLiteral("name")].toString();
+        } else if (taxonomy == QLatin1String("post_tag")) {
+            tags << term[QStringLiteral("name")].toString();
+        }
+    }
+    post->setCategories(categories);
+    post->setTags(tags);
+    post->setStatus(BlogPost::Fetched);
+    return true;
+}
+
+void WordpressBuggyPrivate::slotGetPosts(const QList<QVariant> &result, const QVariant &id)
+{
+    Q_Q(WordpressBuggy);
+    Q_UNUSED(id);
+
+    if (mGetPostsGeneration != mPageGeneration) {
+        qCDebug(KBLOG_LOG) << "Dropping a page of a stopped listing";
+        return;
+    }
+    if (result[0].type() != QVariant::List) {
+        qCritical() << "Could not fetch list of posts out of the"
+                    << "result from the server, not a list.";
+        mPageNumber = 0;
+        Q_EMIT q->error(WordpressBuggy::ParsingError,
+                      i18n("Could not fetch list of posts out of the result "
+                           "from the server, not a list."));
+        return;
+    }
+    const int requested = nextPageSize();
+    const QList<QVariant> postReceived = result[0].toList();
+    QList<BlogPost> page;
+    page.reserve(qMin(postReceived.count(), requested));
+    int skipped = 0;
+    for (const QVariant &postVariant : postReceived) {
+        if (page.count() + skipped == requested) {
+            break;
+        }
+        BlogPost post;
+        if (!readPostFromWpMap(&post, postVariant.toMap())) {
+            qCritical() << "readPostFromWpMap failed!";
+            Q_EMIT q->error(WordpressBuggy::ParsingError, i18n("Could not read post."));
+            ++skipped;
+            continue;
+        }
+        page.append(post);
+    }
+    if (pageReceived(page, postReceived.count() < requested, skipped)) {
+        callGetPosts();
+    }
+}
+
+void WordpressBuggyPrivate::slotGetPostsError(int number, const QString &errorString,
+                                              const QVariant &id)
+{
+    Q_Q(WordpressBuggy);
+    Q_UNUSED(id);
+    if (mGetPostsGeneration != mPageGeneration) {
+        return;
+    }
+    // -32601 is "requested method does not exist"
+    if (mPageOffset == 0 && number == -32601) {
+        qCDebug(KBLOG_LOG) << "wp.getPosts is not supported, falling back to"
+                           << "metaWeblog.getRecentPosts";
+        mGetPostsUnsupported = true;
+        q->MovableType::listRecentPostsPaged(mPageNumber, mPageSize);
+        return;
+    }
+    qCDebug(KBLOG_LOG) << "An error occurred: " << errorString;
+    mPageNumber = 0;
+    Q_EMIT q->error(WordpressBuggy::XmlRpc, errorString);
+}
+
+void WordpressBuggyPrivate::scanResponse(TransportJob *job)
+{
+    Q_Q(WordpressBuggy);
+    mResponseScanners[ job ] = new XmlRpcResponseScanner;
+    // every part goes to the scanner, there is no need to keep them
+    job->setBufferData(false);
+    QObject::connect(job, SIGNAL(dataReceived(KBlog::TransportJob*,QByteArray)),
+                     q, SLOT(slotResponseData(KBlog::TransportJob*,QByteArray)));
+}
+
+void WordpressBuggyPrivate::slotResponseData(KBlog::TransportJob *job, const QByteArray &data)
+{
+    XmlRpcResponseScanner *scanner = mResponseScanners.value(job);
+    if (scanner && scanner->addData(data) != XmlRpcResponseScanner::NeedMoreData) {
+        // the answer is known, the rest of the response does not matter
+        job->finishEarly();
+    }
+}
+
+XmlRpcResponseScanner *WordpressBuggyPrivate::takeResponse(KJob *job)
+{
+    XmlRpcResponseScanner *scanner = mResponseScanners.take(job);
+    if (!scanner) {
+        scanner = new XmlRpcResponseScanner;
+    }
+    // the whole body has been passed by dataReceived()
+    scanner->finish();
+    return scanner;
+}
+
 void WordpressBuggyPrivate::slotCreatePost(KJob *job)
 {
     qCDebug(KBLOG_LOG);
 
-    KIO::StoredTransferJob *stj = qobject_cast<KIO::StoredTransferJob *>(job);
-    const QString data = QString::fromUtf8(stj->data().constData(), stj->data().size());
-
     Q_Q(WordpressBuggy);
 
     KBlog::BlogPost *post = mCreatePostMap[ job ];
     mCreatePostMap.remove(job);
+    const QScopedPointer<XmlRpcResponseScanner> response(takeResponse(job));
 
     if (job->error() != 0) {
         qCritical() << "slotCreatePost error:" << job->errorString();
@@ -299,27 +432,22 @@ void WordpressBuggyPrivate::slotCreatePost(KJob *job)
         return;
     }
 
-    QRegExp rxError(QStringLiteral("faultString"));
-    if (rxError.indexIn(data) != -1) {
-        rxError = QRegExp(QStringLiteral("<string>(.+)</string>"));
-        if (rxError.indexIn(data) != -1) {
-            qCDebug(KBLOG_LOG) << "RegExp of faultString failed.";
-        }
-        qCDebug(KBLOG_LOG) << rxError.cap(1);
-        Q_EMIT q->errorPost(WordpressBuggy::XmlRpc, rxError.cap(1), post);
+    if (response->state() == XmlRpcResponseScanner::Fault) {
+        qCDebug(KBLOG_LOG) << response->faultString();
+        Q_EMIT q->errorPost(WordpressBuggy::XmlRpc, response->faultString(), post);
         return;
     }
 
-    QRegExp rxId(QStringLiteral("<string>(.+)</string>"));
-    if (rxId.indexIn(data) == -1) {
-        qCritical() << "Could not regexp the id out of the result:" << data;
+    const QString postId = response->value().trimmed();
+    if (response->state() != XmlRpcResponseScanner::Value || postId.isEmpty()) {
+        qCritical() << "Could not read the id out of the result:" << response->errorString();
         Q_EMIT q->errorPost(WordpressBuggy::XmlRpc,
-                          i18n("Could not regexp the id out of the result."), post);
+                          i18n("Could not read the id out of the result."), post);
         return;
     }
-    qCDebug(KBLOG_LOG) << "QRegExp rx( \"<string>(.+)</string>\" ) matches" << rxId.cap(1);
+    qCDebug(KBLOG_LOG) << "The new post has the id" << postId;
 
-    post->setPostId(rxId.cap(1));
+    post->setPostId(postId);
     if (mSilentCreationList.contains(post)) {
         // set the categories and publish afterwards
         setPostCategories(post, !post->isPrivate());
@@ -335,11 +463,9 @@ void WordpressBuggyPrivate::slotModifyPost(KJob *job)
 {
     qCDebug(KBLOG_LOG);
 
-    KIO::StoredTransferJob *stj = qobject_cast<KIO::StoredTransferJob *>(job);
-    const QString data = QString::fromUtf8(stj->data().constData(), stj->data().size());
-
     KBlog::BlogPost *post = mModifyPostMap[ job ];
     mModifyPostMap.remove(job);
+    const QScopedPointer<XmlRpcResponseScanner> response(takeResponse(job));
     Q_Q(WordpressBuggy);
     if (job->error() != 0) {
         qCritical() << "slotModifyPost error:" << job->errorString();
@@ -347,27 +473,22 @@ void WordpressBuggyPrivate::slotModifyPost(KJob *job)
         return;
     }
 
-    QRegExp rxError(QStringLiteral("faultString"));
-    if (rxError.indexIn(data) != -1) {
-        rxError = QRegExp(QStringLiteral("<string>(.+)</string>"));
-        if (rxError.indexIn(data) != -1) {
-            qCDebug(KBLOG_LOG) << "RegExp of faultString failed.";
-        }
-        qCDebug(KBLOG_LOG) << rxError.cap(1);
-        Q_EMIT q->errorPost(WordpressBuggy::XmlRpc, rxError.cap(1), post);
+    if (response->state() == XmlRpcResponseScanner::Fault) {
+        qCDebug(KBLOG_LOG) << response->faultString();
+        Q_EMIT q->errorPost(WordpressBuggy::XmlRpc, response->faultString(), post);
         return;
     }
 
-    QRegExp rxId(QStringLiteral("<boolean>(.+)</boolean>"));
-    if (rxId.indexIn(data) == -1) {
-        qCritical() << "Could not regexp the id out of the result:" << data;
+    if (response->state() != XmlRpcResponseScanner::Value) {
+        qCritical() << "Could not read the result:" << response->errorString();
         Q_EMIT q->errorPost(WordpressBuggy::XmlRpc,
-                          i18n("Could not regexp the id out of the result."), post);
+                          i18n("Could not read the result."), post);
         return;
     }
-    qCDebug(KBLOG_LOG) << "QRegExp rx( \"<boolean>(.+)</boolean>\" ) matches" << rxId.cap(1);
+    qCDebug(KBLOG_LOG) << "The server answered" << response->value();
 
-    if (rxId.cap(1).toInt() == 1) {
+    const QString value = response->value().trimmed();
+    if (value == QLatin1String("1") || value == QLatin1String("true")) {
         qCDebug(KBLOG_LOG) << "Post successfully updated.";
         if (mSilentCreationList.contains(post)) {
             post->setStatus(KBlog::BlogPost::Created);
@@ -31,7 +31,7 @@ class WordpressBuggyPrivate;
   and most likely many more) which simply use the yyyyMMddThh:mm:ss
   dateTime.iso8601 format stated on http://www.xmlrpc.com. This is only an example for
   an ISO-8601 compatible format, but many blogs seem to assume exactly this format.
-  This class is needed because KXmlRpc::Client only has support for the extended
+  This class is needed because the XML-RPC client only has support for the extended
   format yyyy-MM-ddThh:mm:ss which is also standard conform and makes more sense than
   the mixture above. This class reimplements createPost and modifyPost from scratch
   to send the dateTime in a compatible format (yyyyMMddThh:mm:ss).
@@ -85,6 +85,17 @@ public:
     */
     void modifyPost(KBlog::BlogPost *post) override;
 
+    /**
+      List recent posts page by page with wp.getPosts, which takes an
+      offset, so every page is a separate request. Servers without
+      wp.getPosts (before WordPress 3.4) fall back to the implementation
+      of Blogger1.
+
+      @see Blog::listRecentPostsPaged()
+      @see listedRecentPostsPage()
+    */
+    void listRecentPostsPaged(int number, int pageSize) override;
+
     /**
       Returns the  of the inherited object.
     */
@@ -100,6 +111,9 @@ private:
     Q_DECLARE_PRIVATE(WordpressBuggy)
     Q_PRIVATE_SLOT(d_func(), void slotCreatePost(KJob *))
     Q_PRIVATE_SLOT(d_func(), void slotModifyPost(KJob *))
+    Q_PRIVATE_SLOT(d_func(), void slotResponseData(KBlog::TransportJob *, const QByteArray &))
+    Q_PRIVATE_SLOT(d_func(), void slotGetPosts(const QList<QVariant> &, const QVariant &))
+    Q_PRIVATE_SLOT(d_func(), void slotGetPostsError(int, const QString &, const QVariant &))
 };
 
 } //namespace KBlog
@@ -13,27 +13,31 @@
 #include "wordpressbuggy.h"
 #include "movabletype_p.h"
 
-#include <kxmlrpcclient/client.h>
-
 class KJob;
 template <class T, class S>class QMap;
 
-namespace KIO
-{
-class Job;
-}
-
 namespace KBlog
 {
 
+class TransportJob;
+class XmlRpcResponseScanner;
+
 class WordpressBuggyPrivate : public MovableTypePrivate
 {
 public:
     QMap<KJob *, KBlog::BlogPost *> mCreatePostMap;
     QMap<KJob *, KBlog::BlogPost *> mModifyPostMap;
+    QMap<KJob *, XmlRpcResponseScanner *> mResponseScanners;
+    quint32 mGetPostsGeneration;
+    bool mGetPostsUnsupported;
     WordpressBuggyPrivate();
     virtual ~WordpressBuggyPrivate();
     QList<QVariant> defaultArgs(const QString &id = QString()) override;
+    QByteArray markupPost(const BlogPost &post, bool create);
+    void scanResponse(TransportJob *job);
+    XmlRpcResponseScanner *takeResponse(KJob *job);
+    void callGetPosts();
+    bool readPostFromWpMap(BlogPost *post, const QMap<QString, QVariant> &postInfo);
 
     //adding these two lines prevents the symbols from MovableTypePrivate
     //to be hidden by the symbols below that.
@@ -41,6 +45,9 @@ public:
     using MovableTypePrivate::slotModifyPost;
     virtual void slotCreatePost(KJob *);
     virtual void slotModifyPost(KJob *);
+    void slotResponseData(KBlog::TransportJob *job, const QByteArray &data);
+    virtual void slotGetPosts(const QList<QVariant> &result, const QVariant &id);
+    virtual void slotGetPostsError(int number, const QString &errorString, const QVariant &id);
     Q_DECLARE_PUBLIC(WordpressBuggy)
 };
 
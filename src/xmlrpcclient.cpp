@@ -0,0 +1,920 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "xmlrpcclient_p.h"
+#include "transport.h"
+#include "transportjob.h"
+#include "xmlrpcpostdecoder_p.h"
+
+#include "kblog_debug.h"
+#include <KLocalizedString>
+
+#include <QDateTime>
+#include <QFile>
+#include <QStringList>
+#include <QXmlStreamReader>
+
+#include <limits>
+
+using namespace KBlog;
+
+// stands in for the data of an XmlRpcStream in the markup, it cannot
+// appear in any other marshalled value
+static const char streamMarker[] = "\0kblog-stream\0";
+
+static QByteArray streamMarkerBytes()
+{
+    return QByteArray(streamMarker, sizeof(streamMarker) - 1);
+}
+
+static bool findStream(const QVariant &arg, XmlRpcStream *stream)
+{
+    if (arg.userType() == qMetaTypeId<XmlRpcStream>()) {
+        *stream = arg.value<XmlRpcStream>();
+        return true;
+    }
+    if (arg.type() == QVariant::List) {
+        const QList<QVariant> list = arg.toList();
+        for (const QVariant &item : list) {
+            if (findStream(item, stream)) {
+                return true;
+            }
+        }
+    } else if (arg.type() == QVariant::Map) {
+        const QMap<QString, QVariant> map = arg.toMap();
+        for (const QVariant &item : map) {
+            if (findStream(item, stream)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static QByteArray marshal(const QVariant &arg)
+{
+    if (arg.userType() == qMetaTypeId<XmlRpcStream>()) {
+        return "<value><base64>" + streamMarkerBytes() + "</base64></value>\r\n";
+    }
+    switch (arg.type()) {
+    case QVariant::String:
+        return "<value><string>" + arg.toString().toHtmlEscaped().toUtf8() + "</string></value>\r\n";
+    case QVariant::StringList: {
+        QByteArray markup = "<value><array><data>\r\n";
+        const QStringList list = arg.toStringList();
+        for (const QString &item : list) {
+            markup += marshal(QVariant(item));
+        }
+        markup += "</data></array></value>\r\n";
+        return markup;
+    }
+    case QVariant::Int:
+    case QVariant::UInt:
+        return "<value><int>" + QByteArray::number(arg.toInt()) + "</int></value>\r\n";
+    case QVariant::LongLong:
+    case QVariant::ULongLong:
+        return "<value><i8>" + QByteArray::number(arg.toLongLong()) + "</i8></value>\r\n";
+    case QVariant::Double:
+        return "<value><double>" + QByteArray::number(arg.toDouble(), 'g', 17) + "</double></value>\r\n";
+    case QVariant::Bool:
+        return QByteArray("<value><boolean>") + (arg.toBool() ? "1" : "0") + "</boolean></value>\r\n";
+    case QVariant::ByteArray:
+        return "<value><base64>" + arg.toByteArray().toBase64() + "</base64></value>\r\n";
+    case QVariant::DateTime:
+        return "<value><dateTime.iso8601>" + arg.toDateTime().toString(Qt::ISODate).toLatin1() +
+               "</dateTime.iso8601></value>\r\n";
+    case QVariant::Date:
+        return "<value><dateTime.iso8601>" + QDateTime(arg.toDate(), QTime(0, 0)).toString(Qt::ISODate).toLatin1() +
+               "</dateTime.iso8601></value>\r\n";
+    case QVariant::List: {
+        QByteArray markup = "<value><array><data>\r\n";
+        const QList<QVariant> list = arg.toList();
+        for (const QVariant &item : list) {
+            markup += marshal(item);
+        }
+        markup += "</data></array></value>\r\n";
+        return markup;
+    }
+    case QVariant::Map: {
+        QByteArray markup = "<value><struct>\r\n";
+        const QMap<QString, QVariant> map = arg.toMap();
+        for (QMap<QString, QVariant>::ConstIterator it = map.constBegin(); it != map.constEnd(); ++it) {
+            markup += "<member>\r\n<name>" + it.key().toHtmlEscaped().toUtf8() + "</name>\r\n";
+            markup += marshal(it.value());
+            markup += "</member>\r\n";
+        }
+        markup += "</struct></value>\r\n";
+        return markup;
+    }
+    default:
+        qCWarning(KBLOG_LOG) << "Failed to marshal unknown variant type:" << arg.type();
+        return "<value/>\r\n";
+    }
+}
+
+static QVariant readValue(QXmlStreamReader &reader);
+
+static QVariant readStruct(QXmlStreamReader &reader)
+{
+    QMap<QString, QVariant> map;
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("member")) {
+            reader.skipCurrentElement();
+            continue;
+        }
+        QString name;
+        QVariant value;
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("name")) {
+                name = reader.readElementText();
+            } else if (reader.name() == QLatin1String("value")) {
+                value = readValue(reader);
+            } else {
+                reader.skipCurrentElement();
+            }
+        }
+        map.insert(name, value);
+    }
+    return map;
+}
+
+static QVariant readArray(QXmlStreamReader &reader)
+{
+    QList<QVariant> list;
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("data")) {
+            reader.skipCurrentElement();
+            continue;
+        }
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("value")) {
+                list << readValue(reader);
+            } else {
+                reader.skipCurrentElement();
+            }
+        }
+    }
+    return list;
+}
+
+static QDateTime readDateTime(const QString &text)
+{
+    // both the basic (yyyyMMddThh:mm:ss) and the extended format are in use
+    QDateTime dateTime = QDateTime::fromString(text, Qt::ISODate);
+    if (!dateTime.isValid()) {
+        dateTime = QDateTime::fromString(text, QStringLiteral("yyyyMMdd'T'hh:mm:ss"));
+    }
+    return dateTime;
+}
+
+// expects the reader to be positioned on <value> and leaves it on </value>
+static QVariant readValue(QXmlStreamReader &reader)
+{
+    QVariant result;
+    QString text;
+    bool typed = false;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isEndElement()) {
+            break;
+        }
+        if (reader.isCharacters()) {
+            if (!typed) {
+                text += reader.text();
+            }
+            continue;
+        }
+        if (!reader.isStartElement()) {
+            continue;
+        }
+        typed = true;
+        const QStringRef type = reader.name();
+        if (type == QLatin1String("string")) {
+            result = reader.readElementText();
+        } else if (type == QLatin1String("int") || type == QLatin1String("i4") ||
+                   type == QLatin1String("i8")) {
+            const qlonglong number = reader.readElementText().trimmed().toLongLong();
+            if (number >= std::numeric_limits<int>::min() &&
+                    number <= std::numeric_limits<int>::max()) {
+                result = static_cast<int>(number);
+            } else {
+                result = number;
+            }
+        } else if (type == QLatin1String("boolean")) {
+            const QString value = reader.readElementText().trimmed();
+            result = (value == QLatin1String("1") || value == QLatin1String("true"));
+        } else if (type == QLatin1String("double")) {
+            result = reader.readElementText().trimmed().toDouble();
+        } else if (type == QLatin1String("dateTime.iso8601")) {
+            result = readDateTime(reader.readElementText().trimmed());
+        } else if (type == QLatin1String("base64")) {
+            result = QByteArray::fromBase64(reader.readElementText().toLatin1());
+        } else if (type == QLatin1String("struct")) {
+            result = readStruct(reader);
+        } else if (type == QLatin1String("array")) {
+            result = readArray(reader);
+        } else if (type == QLatin1String("nil")) {
+            reader.skipCurrentElement();
+            result = QVariant();
+        } else {
+            reader.raiseError(i18n("Unknown type: %1", type.toString()));
+        }
+    }
+    if (!typed) {
+        // a value without a type is a string
+        result = text;
+    }
+    return result;
+}
+
+XmlRpcStreamDevice::XmlRpcStreamDevice(const QByteArray &prefix, QIODevice *source,
+                                       const QByteArray &suffix, QObject *parent)
+    : QIODevice(parent), mPrefix(prefix), mSuffix(suffix), mSource(source),
+      mSourceStart(source->pos()), mSourceSize(source->size() - source->pos()),
+      mSourceRead(0), mPrefixPos(0), mEncodedPos(0), mSuffixPos(0)
+{
+}
+
+XmlRpcStreamDevice::~XmlRpcStreamDevice()
+{
+}
+
+bool XmlRpcStreamDevice::isSequential() const
+{
+    return true;
+}
+
+qint64 XmlRpcStreamDevice::size() const
+{
+    return mPrefix.size() + (mSourceSize + 2) / 3 * 4 + mSuffix.size();
+}
+
+bool XmlRpcStreamDevice::reset()
+{
+    if (!mSource->seek(mSourceStart)) {
+        return false;
+    }
+    mSourceRead = 0;
+    mCarry.clear();
+    mEncoded.clear();
+    mPrefixPos = 0;
+    mEncodedPos = 0;
+    mSuffixPos = 0;
+    return true;
+}
+
+qint64 XmlRpcStreamDevice::readData(char *data, qint64 maxSize)
+{
+    // encode 48 KiB of the source at a time, a multiple of three bytes so
+    // the chunks can simply be concatenated
+    static const qint64 chunkSize = 3 * 16384;
+
+    qint64 total = 0;
+    while (total < maxSize) {
+        if (mPrefixPos < mPrefix.size()) {
+            const qint64 count = qMin(maxSize - total, mPrefix.size() - mPrefixPos);
+            memcpy(data + total, mPrefix.constData() + mPrefixPos, count);
+            mPrefixPos += count;
+            total += count;
+        } else if (mEncodedPos < mEncoded.size()) {
+            const qint64 count = qMin(maxSize - total, mEncoded.size() - mEncodedPos);
+            memcpy(data + total, mEncoded.constData() + mEncodedPos, count);
+            mEncodedPos += count;
+            total += count;
+        } else if (mSourceRead < mSourceSize) {
+            const QByteArray read = mSource->read(qMin(chunkSize, mSourceSize - mSourceRead));
+            if (read.isEmpty()) {
+                setErrorString(mSource->errorString());
+                return total > 0 ? total : -1;
+            }
+            mSourceRead += read.size();
+            QByteArray raw = mCarry + read;
+            mCarry.clear();
+            if (mSourceRead < mSourceSize) {
+                const int keep = raw.size() % 3;
+                mCarry = raw.right(keep);
+                raw.chop(keep);
+            }
+            mEncoded = raw.toBase64();
+            mEncodedPos = 0;
+        } else if (mSuffixPos < mSuffix.size()) {
+            const qint64 count = qMin(maxSize - total, mSuffix.size() - mSuffixPos);
+            memcpy(data + total, mSuffix.constData() + mSuffixPos, count);
+            mSuffixPos += count;
+            total += count;
+        } else {
+            break;
+        }
+    }
+    return total > 0 ? total : -1;
+}
+
+qint64 XmlRpcStreamDevice::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+    return -1;
+}
+
+XmlRpcQuery::XmlRpcQuery(const QString &method, const QList<QVariant> &args,
+                         const QVariant &id, QObject *parent)
+    : QObject(parent), mMethod(method), mArgs(args), mId(id), mDecodePosts(false), mFinished(false)
+{
+}
+
+XmlRpcQuery::~XmlRpcQuery()
+{
+}
+
+QString XmlRpcQuery::method() const
+{
+    return mMethod;
+}
+
+QList<QVariant> XmlRpcQuery::args() const
+{
+    return mArgs;
+}
+
+bool XmlRpcQuery::hasStream() const
+{
+    XmlRpcStream stream;
+    return findStream(QVariant(mArgs), &stream);
+}
+
+bool XmlRpcQuery::decodesPosts() const
+{
+    return mDecodePosts;
+}
+
+void XmlRpcQuery::setDecodePosts(bool decode)
+{
+    mDecodePosts = decode;
+}
+
+bool XmlRpcQuery::isFinished() const
+{
+    return mFinished;
+}
+
+void XmlRpcQuery::addFollower(XmlRpcQuery *follower)
+{
+    mFollowers.append(follower);
+}
+
+void XmlRpcQuery::start(Transport *transport, const QUrl &url,
+                        const QString &userAgent, Transport::Priority priority)
+{
+    QByteArray request = XmlRpcClient::markupCall(mMethod, mArgs);
+    TransportJob *job = nullptr;
+    XmlRpcStream stream;
+    const int marker = request.indexOf(streamMarkerBytes());
+    if (marker >= 0 && findStream(QVariant(mArgs), &stream)) {
+        QIODevice *source = stream.mDevice;
+        if (!source) {
+            QFile *file = new QFile(stream.mFileName, this);
+            if (!file->open(QIODevice::ReadOnly)) {
+                const QString errorString = i18n("Could not open %1: %2", stream.mFileName,
+                                                 file->errorString());
+                QTimer::singleShot(0, this, [this, errorString]() {
+                    deliverFault(-1, errorString);
+                });
+                return;
+            }
+            source = file;
+        }
+        if (source->isSequential()) {
+            // the size is not known up front, so the data has to be read first
+            request.replace(marker, streamMarkerBytes().size(), source->readAll().toBase64());
+            job = transport->post(url, request);
+        } else {
+            const QByteArray suffix = request.mid(marker + streamMarkerBytes().size());
+            request.truncate(marker);
+            XmlRpcStreamDevice *device = new XmlRpcStreamDevice(request, source, suffix, this);
+            device->open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+            job = transport->post(url, device, device->size());
+        }
+    } else {
+        job = transport->post(url, request);
+    }
+    job->setRequestHeader("Content-Type", "text/xml; charset=utf-8");
+    job->setRequestHeader("User-Agent", userAgent.toUtf8());
+    job->setPriority(priority);
+    connect(job, &KJob::result, this, &XmlRpcQuery::slotResult);
+    job->start();
+}
+
+void XmlRpcQuery::deliver(const QList<QVariant> &result)
+{
+    mFinished = true;
+    Q_EMIT message(result, mId);
+    const QList<QPointer<XmlRpcQuery> > followers = mFollowers;
+    for (const QPointer<XmlRpcQuery> &follower : followers) {
+        if (follower) {
+            follower->deliver(result);
+        }
+    }
+    deleteLater();
+}
+
+void XmlRpcQuery::deliverFault(int number, const QString &errorString)
+{
+    mFinished = true;
+    Q_EMIT fault(number, errorString, mId);
+    const QList<QPointer<XmlRpcQuery> > followers = mFollowers;
+    for (const QPointer<XmlRpcQuery> &follower : followers) {
+        if (follower) {
+            follower->deliverFault(number, errorString);
+        }
+    }
+    deleteLater();
+}
+
+void XmlRpcQuery::slotResult(KJob *job)
+{
+    TransportJob *transportJob = qobject_cast<TransportJob *>(job);
+    if (job->error() != 0) {
+        deliverFault(-1, job->errorString());
+        return;
+    }
+
+    QList<QVariant> result;
+    int faultCode = 0;
+    QString faultString;
+    if (mDecodePosts) {
+        QList<PostFields> posts;
+        bool isList = false;
+        if (!XmlRpcPostDecoder::decode(transportJob->data(), &posts, &isList, &faultCode, &faultString)) {
+            deliverFault(faultCode, faultString);
+        } else if (isList) {
+            deliver(result << QVariant::fromValue(posts));
+        } else if (!posts.isEmpty()) {
+            deliver(result << QVariant::fromValue(posts.first()));
+        } else {
+            // neither a post nor a list, e.g. a boolean
+            deliver(result << QVariant());
+        }
+        return;
+    }
+    if (XmlRpcClient::parseResponse(transportJob->data(), &result, &faultCode, &faultString)) {
+        deliver(result);
+    } else {
+        deliverFault(faultCode, faultString);
+    }
+}
+
+XmlRpcClient::XmlRpcClient(const QUrl &url, QObject *parent)
+    : QObject(parent), mUrl(url), mPriority(Transport::Interactive), mBatching(false), mBatchWindow(0),
+      mMulticall(MulticallUnknown), mWaitingForMethods(false)
+{
+    mBatchTimer.setSingleShot(true);
+    connect(&mBatchTimer, &QTimer::timeout, this, &XmlRpcClient::flush);
+}
+
+XmlRpcClient::~XmlRpcClient()
+{
+    // let the other clients of the server probe it themselves, unless
+    // the cache is gone already because the process exits
+    ServerCapabilities *capabilities = ServerCapabilities::self();
+    if (!mProbeKey.isEmpty() && capabilities) {
+        capabilities->cancelProbe(mProbeKey);
+    }
+}
+
+QUrl XmlRpcClient::url() const
+{
+    return mUrl;
+}
+
+void XmlRpcClient::setUrl(const QUrl &url)
+{
+    if (url == mUrl) {
+        return;
+    }
+    mUrl = url;
+    // another server, its support for system.multicall is not known
+    mMulticall = MulticallUnknown;
+    mWaitingForMethods = false;
+    // a call in flight to the old server must not answer one to the new
+    mShared.clear();
+    // the calls waiting for a batch or a probe were meant for the old
+    // server, nothing would send them anymore
+    mBatchTimer.stop();
+    const QList<QPointer<XmlRpcQuery> > queries = mPending;
+    mPending.clear();
+    for (const QPointer<XmlRpcQuery> &query : queries) {
+        if (query) {
+            query->deliverFault(-1, i18n("The address of the server changed before the call was sent."));
+        }
+    }
+}
+
+QString XmlRpcClient::userAgent() const
+{
+    return mUserAgent;
+}
+
+void XmlRpcClient::setUserAgent(const QString &userAgent)
+{
+    mUserAgent = userAgent;
+}
+
+Transport *XmlRpcClient::transport() const
+{
+    return mTransport ? mTransport.data() : Transport::self();
+}
+
+void XmlRpcClient::setTransport(Transport *transport)
+{
+    mTransport = transport;
+}
+
+Transport::Priority XmlRpcClient::priority() const
+{
+    return mPriority;
+}
+
+void XmlRpcClient::setPriority(Transport::Priority priority)
+{
+    mPriority = priority;
+}
+
+bool XmlRpcClient::isBatchingEnabled() const
+{
+    return mBatching;
+}
+
+void XmlRpcClient::setBatchingEnabled(bool enabled)
+{
+    mBatching = enabled;
+    if (!enabled && !mPending.isEmpty()) {
+        flush();
+    }
+}
+
+int XmlRpcClient::batchWindow() const
+{
+    return mBatchWindow;
+}
+
+void XmlRpcClient::setBatchWindow(int msecs)
+{
+    mBatchWindow = qMax(0, msecs);
+}
+
+bool XmlRpcClient::call(const QString &method, const QList<QVariant> &args,
+                        QObject *msgObj, const char *messageSlot,
+                        QObject *faultObj, const char *faultSlot,
+                        const QVariant &id, bool shared)
+{
+    XmlRpcQuery *query = createQuery(method, args, msgObj, messageSlot, faultObj, faultSlot, id);
+    if (shared && share(query)) {
+        return true;
+    }
+    enqueue(query);
+    return false;
+}
+
+bool XmlRpcClient::callPosts(const QString &method, const QList<QVariant> &args,
+                             QObject *msgObj, const char *messageSlot,
+                             QObject *faultObj, const char *faultSlot,
+                             const QVariant &id, bool shared)
+{
+    XmlRpcQuery *query = createQuery(method, args, msgObj, messageSlot, faultObj, faultSlot, id);
+    // a batched call is answered from the multicall response with maps
+    query->setDecodePosts(true);
+    if (shared && share(query)) {
+        return true;
+    }
+    enqueue(query);
+    return false;
+}
+
+bool XmlRpcClient::share(XmlRpcQuery *query)
+{
+    if (query->hasStream()) {
+        return false;
+    }
+    // the decoded posts differ from the maps of a plain call
+    const QByteArray key = (query->decodesPosts() ? "posts:" : "call:") +
+                           markupCall(query->method(), query->args());
+    XmlRpcQuery *leader = mShared.value(key);
+    if (leader && !leader->isFinished()) {
+        qCDebug(KBLOG_LOG) << "Sharing the result of" << query->method() << "already in flight";
+        leader->addFollower(query);
+        return true;
+    }
+    mShared.insert(key, query);
+    connect(query, &QObject::destroyed, this, [this, key, query]() {
+        if (mShared.value(key) == query) {
+            mShared.remove(key);
+        }
+    });
+    return false;
+}
+
+ServerCapabilities::Entry XmlRpcClient::capabilities() const
+{
+    return ServerCapabilities::self()->entry(ServerCapabilities::key(mUrl));
+}
+
+bool XmlRpcClient::probeMethods()
+{
+    ServerCapabilities *capabilities = ServerCapabilities::self();
+    const QString key = ServerCapabilities::key(mUrl);
+    if (capabilities->isFresh(capabilities->entry(key))) {
+        return false;
+    }
+    if (mWaitingForMethods) {
+        return true;
+    }
+    mWaitingForMethods = true;
+    connect(capabilities, &ServerCapabilities::probeFinished,
+            this, &XmlRpcClient::slotProbeFinished, Qt::UniqueConnection);
+    // otherwise another client asks the server already
+    if (capabilities->startProbe(key)) {
+        qCDebug(KBLOG_LOG) << "Probing" << mUrl << "for its methods";
+        mProbeKey = key;
+        sendProbe(QStringLiteral("system.listMethods"));
+    }
+    return true;
+}
+
+void XmlRpcClient::sendProbe(const QString &method)
+{
+    mProbeMethod = method;
+    TransportJob *job = post(markupCall(method, QList<QVariant>()));
+    connect(job, &KJob::result, this, &XmlRpcClient::slotProbeResult);
+    job->start();
+}
+
+XmlRpcQuery *XmlRpcClient::createQuery(const QString &method, const QList<QVariant> &args,
+                                       QObject *msgObj, const char *messageSlot,
+                                       QObject *faultObj, const char *faultSlot,
+                                       const QVariant &id)
+{
+    XmlRpcQuery *query = new XmlRpcQuery(method, args, id, this);
+    connect(query, SIGNAL(message(QList<QVariant>,QVariant)), msgObj, messageSlot);
+    connect(query, SIGNAL(fault(int,QString,QVariant)), faultObj, faultSlot);
+    return query;
+}
+
+void XmlRpcClient::enqueue(XmlRpcQuery *query)
+{
+    const QString method = query->method();
+    if (!mBatching || mMulticall == MulticallUnsupported ||
+            method.startsWith(QLatin1String("system.")) || query->hasStream()) {
+        query->start(transport(), mUrl, mUserAgent, mPriority);
+        return;
+    }
+
+    mPending.append(query);
+    if (!mBatchTimer.isActive()) {
+        mBatchTimer.start(mBatchWindow);
+    }
+}
+
+TransportJob *XmlRpcClient::post(const QByteArray &request)
+{
+    TransportJob *job = transport()->post(mUrl, request);
+    job->setRequestHeader("Content-Type", "text/xml; charset=utf-8");
+    job->setRequestHeader("User-Agent", mUserAgent.toUtf8());
+    job->setPriority(mPriority);
+    return job;
+}
+
+void XmlRpcClient::sendSingly(const QList<QPointer<XmlRpcQuery> > &queries)
+{
+    for (const QPointer<XmlRpcQuery> &query : queries) {
+        if (query) {
+            query->start(transport(), mUrl, mUserAgent, mPriority);
+        }
+    }
+}
+
+void XmlRpcClient::flush()
+{
+    mBatchTimer.stop();
+    if (mPending.isEmpty() || mMulticall == MulticallProbing) {
+        return;
+    }
+
+    if (mMulticall == MulticallUnknown && mPending.count() > 1) {
+        // ask the server once whether it supports system.multicall, the
+        // pending calls are sent when the answer arrives
+        if (probeMethods()) {
+            mMulticall = MulticallProbing;
+            return;
+        }
+        mMulticall = capabilities().lists(QStringLiteral("system.multicall")) ?
+                     MulticallSupported : MulticallUnsupported;
+    }
+
+    const QList<QPointer<XmlRpcQuery> > queries = mPending;
+    mPending.clear();
+    if (queries.count() == 1 || mMulticall != MulticallSupported) {
+        sendSingly(queries);
+        return;
+    }
+
+    QList<QVariant> calls;
+    calls.reserve(queries.count());
+    for (const QPointer<XmlRpcQuery> &query : queries) {
+        QMap<QString, QVariant> call;
+        if (query) {
+            call[QStringLiteral("methodName")] = query->method();
+            call[QStringLiteral("params")] = query->args();
+        } else {
+            // keep the positions of the results in sync with the queries
+            call[QStringLiteral("methodName")] = QStringLiteral("system.listMethods");
+            call[QStringLiteral("params")] = QList<QVariant>();
+        }
+        calls << call;
+    }
+    qCDebug(KBLOG_LOG) << "Sending" << calls.count() << "calls in one system.multicall";
+    TransportJob *job = post(markupCall(QStringLiteral("system.multicall"),
+                                        QList<QVariant>() << QVariant(calls)));
+    mBatches.insert(job, queries);
+    connect(job, &KJob::result, this, &XmlRpcClient::slotBatchResult);
+    job->start();
+}
+
+void XmlRpcClient::slotProbeResult(KJob *job)
+{
+    TransportJob *transportJob = qobject_cast<TransportJob *>(job);
+    QList<QVariant> result;
+    int faultCode = 0;
+    QString faultString;
+    const bool introspection = mProbeMethod == QLatin1String("system.listMethods");
+    if (job->error() == 0 &&
+            parseResponse(transportJob->data(), &result, &faultCode, &faultString) &&
+            !result.isEmpty() && result.first().type() == QVariant::List) {
+        const QString key = mProbeKey;
+        mProbeKey.clear();
+        ServerCapabilities::self()->store(key, result.first().toStringList(), introspection);
+        return;
+    }
+    if (introspection) {
+        qCDebug(KBLOG_LOG) << "system.listMethods failed:" << faultString;
+        sendProbe(QStringLiteral("mt.supportedMethods"));
+        return;
+    }
+    // the server cannot tell, do not ask again before the entry is too old
+    qCDebug(KBLOG_LOG) << "mt.supportedMethods failed:" << faultString;
+    const QString key = mProbeKey;
+    mProbeKey.clear();
+    ServerCapabilities::self()->store(key, QStringList(), false);
+}
+
+void XmlRpcClient::slotProbeFinished(const QString &key)
+{
+    if (!mWaitingForMethods || key != ServerCapabilities::key(mUrl)) {
+        return;
+    }
+    mWaitingForMethods = false;
+    // the client which probed has gone away, try again
+    if (probeMethods()) {
+        return;
+    }
+    if (mMulticall == MulticallProbing) {
+        mMulticall = capabilities().lists(QStringLiteral("system.multicall")) ?
+                     MulticallSupported : MulticallUnsupported;
+        qCDebug(KBLOG_LOG) << mUrl << "supports system.multicall:" << (mMulticall == MulticallSupported);
+        flush();
+    }
+    Q_EMIT methodsProbed();
+}
+
+void XmlRpcClient::slotBatchResult(KJob *job)
+{
+    const QList<QPointer<XmlRpcQuery> > queries = mBatches.take(job);
+    TransportJob *transportJob = qobject_cast<TransportJob *>(job);
+    if (job->error() != 0) {
+        for (const QPointer<XmlRpcQuery> &query : queries) {
+            if (query) {
+                query->deliverFault(-1, job->errorString());
+            }
+        }
+        return;
+    }
+
+    QList<QVariant> result;
+    int faultCode = 0;
+    QString faultString;
+    bool isFault = false;
+    if (!parseResponse(transportJob->data(), &result, &faultCode, &faultString, &isFault)) {
+        if (isFault) {
+            // the server rejected system.multicall itself, so none of the
+            // calls has run; send them singly and do not try again
+            qCDebug(KBLOG_LOG) << "system.multicall failed:" << faultString;
+            mMulticall = MulticallUnsupported;
+            sendSingly(queries);
+            return;
+        }
+        // e.g. a warning in front of the markup or a truncated body; the
+        // server might have run the calls, sending them again could create
+        // a post twice
+        qCDebug(KBLOG_LOG) << "Invalid system.multicall response:" << faultString;
+        for (const QPointer<XmlRpcQuery> &query : queries) {
+            if (query) {
+                query->deliverFault(faultCode, faultString);
+            }
+        }
+        return;
+    }
+
+    const QList<QVariant> responses = result.value(0).toList();
+    for (int i = 0; i < queries.count(); ++i) {
+        XmlRpcQuery *query = queries.at(i);
+        if (!query) {
+            continue;
+        }
+        if (i >= responses.count()) {
+            query->deliverFault(-1, i18n("No result for the call in the system.multicall response."));
+            continue;
+        }
+        const QVariant &response = responses.at(i);
+        if (response.type() == QVariant::Map) {
+            const QMap<QString, QVariant> map = response.toMap();
+            query->deliverFault(map.value(QStringLiteral("faultCode")).toInt(),
+                                map.value(QStringLiteral("faultString")).toString());
+        } else {
+            query->deliver(response.toList());
+        }
+    }
+}
+
+QByteArray XmlRpcClient::markupCall(const QString &method, const QList<QVariant> &args)
+{
+    QByteArray markup = "<?xml version=\"1.0\" ?>\r\n<methodCall>\r\n";
+    markup += "<methodName>" + method.toHtmlEscaped().toUtf8() + "</methodName>\r\n";
+    if (!args.isEmpty()) {
+        markup += "<params>\r\n";
+        for (const QVariant &arg : args) {
+            markup += "<param>\r\n" + marshal(arg) + "</param>\r\n";
+        }
+        markup += "</params>\r\n";
+    }
+    markup += "</methodCall>\r\n";
+    return markup;
+}
+
+QDateTime XmlRpcClient::parseDateTime(const QString &text)
+{
+    return readDateTime(text.trimmed());
+}
+
+bool XmlRpcClient::parseResponse(const QByteArray &data, QList<QVariant> *result,
+                                 int *faultCode, QString *faultString, bool *isFault)
+{
+    QXmlStreamReader reader(data);
+    bool fault = false;
+    if (reader.readNextStartElement() && reader.name() == QLatin1String("methodResponse")) {
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("params")) {
+                while (reader.readNextStartElement()) {
+                    // <param>
+                    while (reader.readNextStartElement()) {
+                        if (reader.name() == QLatin1String("value")) {
+                            *result << readValue(reader);
+                        } else {
+                            reader.skipCurrentElement();
+                        }
+                    }
+                }
+            } else if (reader.name() == QLatin1String("fault")) {
+                while (reader.readNextStartElement()) {
+                    if (reader.name() == QLatin1String("value")) {
+                        const QMap<QString, QVariant> map = readValue(reader).toMap();
+                        *faultCode = map.value(QStringLiteral("faultCode")).toInt();
+                        *faultString = map.value(QStringLiteral("faultString")).toString();
+                        fault = true;
+                    } else {
+                        reader.skipCurrentElement();
+                    }
+                }
+            } else {
+                reader.skipCurrentElement();
+            }
+        }
+    } else if (!reader.hasError()) {
+        reader.raiseError(i18n("No methodResponse element found."));
+    }
+
+    if (reader.hasError()) {
+        *faultCode = -1;
+        *faultString = i18n("Received invalid XML markup: %1 at %2:%3",
+                            reader.errorString(), reader.lineNumber(),
+                            reader.columnNumber());
+        fault = false;
+    }
+    if (isFault) {
+        *isFault = fault;
+    }
+    return !fault && !reader.hasError();
+}
@@ -0,0 +1,260 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_XMLRPCCLIENT_P_H
+#define KBLOG_XMLRPCCLIENT_P_H
+
+#include <QHash>
+#include <QIODevice>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QUrl>
+#include <QVariant>
+
+#include "kblog_private_export.h"
+#include "servercapabilities_p.h"
+#include "transport.h"
+
+class KJob;
+
+namespace KBlog
+{
+
+class TransportJob;
+
+/**
+  A base64 value whose data is read from a device or a file while the
+  call is sent, instead of being held in memory. Only one stream can be
+  passed per call, and such calls are never batched.
+*/
+struct XmlRpcStream {
+    XmlRpcStream() : mDevice(nullptr) {}
+    QIODevice *mDevice;
+    QString mFileName;
+};
+
+/**
+  Produces the body of a call with a stream: the markup before the value,
+  the base64 encoded stream and the markup after it. The stream is read
+  and encoded in small chunks as the transport asks for data.
+*/
+class KBLOG_TESTS_EXPORT XmlRpcStreamDevice : public QIODevice
+{
+    Q_OBJECT
+public:
+    XmlRpcStreamDevice(const QByteArray &prefix, QIODevice *source,
+                       const QByteArray &suffix, QObject *parent = nullptr);
+    ~XmlRpcStreamDevice();
+
+    bool isSequential() const override;
+    qint64 size() const override;
+    bool reset() override;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    QByteArray mPrefix;
+    QByteArray mSuffix;
+    QIODevice *mSource;
+    qint64 mSourceStart;
+    qint64 mSourceSize;
+    qint64 mSourceRead;
+    QByteArray mCarry;
+    QByteArray mEncoded;
+    qint64 mPrefixPos;
+    qint64 mEncodedPos;
+    qint64 mSuffixPos;
+};
+
+/**
+  One XML-RPC method call. It emits either message() or fault() and
+  deletes itself afterwards.
+*/
+class XmlRpcQuery : public QObject
+{
+    Q_OBJECT
+public:
+    XmlRpcQuery(const QString &method, const QList<QVariant> &args,
+                const QVariant &id, QObject *parent = nullptr);
+    ~XmlRpcQuery();
+
+    QString method() const;
+    QList<QVariant> args() const;
+
+    bool hasStream() const;
+    bool decodesPosts() const;
+    void setDecodePosts(bool decode);
+    bool isFinished() const;
+    // @p follower is answered with the result of this query
+    void addFollower(XmlRpcQuery *follower);
+    void start(Transport *transport, const QUrl &url, const QString &userAgent,
+               Transport::Priority priority);
+    void deliver(const QList<QVariant> &result);
+    void deliverFault(int number, const QString &errorString);
+
+Q_SIGNALS:
+    void message(const QList<QVariant> &result, const QVariant &id);
+    void fault(int number, const QString &errorString, const QVariant &id);
+
+private Q_SLOTS:
+    void slotResult(KJob *job);
+
+private:
+    QString mMethod;
+    QList<QVariant> mArgs;
+    QVariant mId;
+    bool mDecodePosts;
+    bool mFinished;
+    QList<QPointer<XmlRpcQuery> > mFollowers;
+};
+
+/**
+  A small XML-RPC client that sends its calls through a Transport, so
+  all calls to one server share the pooled keep-alive connections.
+  The interface mirrors the one of KXmlRpc::Client.
+*/
+class KBLOG_TESTS_EXPORT XmlRpcClient : public QObject
+{
+    Q_OBJECT
+public:
+    explicit XmlRpcClient(const QUrl &url, QObject *parent = nullptr);
+    ~XmlRpcClient();
+
+    QUrl url() const;
+
+    /**
+      Sets the URL of the server. If it changes, the calls still waiting
+      to be batched fail instead of being sent to the new server, and
+      calls in flight to the old server are no longer shared.
+    */
+    void setUrl(const QUrl &url);
+
+    QString userAgent() const;
+    void setUserAgent(const QString &userAgent);
+
+    Transport *transport() const;
+    void setTransport(Transport *transport);
+
+    Transport::Priority priority() const;
+    void setPriority(Transport::Priority priority);
+
+    bool isBatchingEnabled() const;
+    void setBatchingEnabled(bool enabled);
+
+    int batchWindow() const;
+    void setBatchWindow(int msecs);
+
+    /**
+      Calls @p method with @p args. The result is delivered to the slot
+      @p messageSlot of @p msgObj with the signature
+      (QList<QVariant>,QVariant), errors to @p faultSlot of @p faultObj
+      with the signature (int,QString,QVariant). @p id is passed on
+      unchanged to identify the call.
+
+      Set @p shared for calls that only read. If an identical call is
+      still in flight, no request is sent, the result of that call is
+      delivered to both, and true is returned.
+    */
+    bool call(const QString &method, const QList<QVariant> &args,
+              QObject *msgObj, const char *messageSlot,
+              QObject *faultObj, const char *faultSlot,
+              const QVariant &id = QVariant(), bool shared = false);
+
+    /**
+      Like call(), for getPost and getRecentPosts. Unless the call is
+      batched, the response is decoded with XmlRpcPostDecoder and the
+      result holds a PostFields or a QList<PostFields> instead of maps.
+
+      @see PostFields::fromResult()
+    */
+    bool callPosts(const QString &method, const QList<QVariant> &args,
+                   QObject *msgObj, const char *messageSlot,
+                   QObject *faultObj, const char *faultSlot,
+                   const QVariant &id = QVariant(), bool shared = false);
+
+    /**
+      Returns the methods the server listed when it was last probed, as
+      shared by all clients of the URL.
+    */
+    ServerCapabilities::Entry capabilities() const;
+
+    /**
+      Asks the server for its methods, with system.listMethods or else
+      mt.supportedMethods, unless they are cached and not too old.
+      Returns false if capabilities() can be used right away, otherwise
+      methodsProbed() is emitted once the answer has arrived.
+    */
+    bool probeMethods();
+
+    static QByteArray markupCall(const QString &method, const QList<QVariant> &args);
+    /**
+      Parses a method response. Returns false for a fault and for invalid
+      markup; @p isFault tells the two apart if given.
+    */
+    static bool parseResponse(const QByteArray &data, QList<QVariant> *result,
+                              int *faultCode, QString *faultString, bool *isFault = nullptr);
+    static QDateTime parseDateTime(const QString &text);
+
+Q_SIGNALS:
+    /**
+      This signal is emitted when the probe started by probeMethods()
+      has ended.
+    */
+    void methodsProbed();
+
+private Q_SLOTS:
+    void flush();
+    void slotProbeResult(KJob *job);
+    void slotProbeFinished(const QString &key);
+    void slotBatchResult(KJob *job);
+
+private:
+    enum MulticallSupport {
+        MulticallUnknown,
+        MulticallProbing,
+        MulticallSupported,
+        MulticallUnsupported
+    };
+
+    XmlRpcQuery *createQuery(const QString &method, const QList<QVariant> &args,
+                             QObject *msgObj, const char *messageSlot,
+                             QObject *faultObj, const char *faultSlot,
+                             const QVariant &id);
+    void enqueue(XmlRpcQuery *query);
+    bool share(XmlRpcQuery *query);
+    TransportJob *post(const QByteArray &request);
+    void sendSingly(const QList<QPointer<XmlRpcQuery> > &queries);
+    void sendProbe(const QString &method);
+
+    QUrl mUrl;
+    QString mUserAgent;
+    QPointer<Transport> mTransport;
+    Transport::Priority mPriority;
+    bool mBatching;
+    int mBatchWindow;
+    MulticallSupport mMulticall;
+    // waiting for probeFinished(), and the probe sent by this client
+    bool mWaitingForMethods;
+    QString mProbeKey;
+    QString mProbeMethod;
+    QTimer mBatchTimer;
+    QList<QPointer<XmlRpcQuery> > mPending;
+    QHash<KJob *, QList<QPointer<XmlRpcQuery> > > mBatches;
+    // the shared calls in flight, by their markup
+    QHash<QByteArray, XmlRpcQuery *> mShared;
+};
+
+} //namespace KBlog
+
+Q_DECLARE_METATYPE(KBlog::XmlRpcStream)
+
+#endif
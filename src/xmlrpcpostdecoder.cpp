@@ -0,0 +1,376 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "xmlrpcpostdecoder_p.h"
+#include "xmlrpcclient_p.h"
+
+#include <KLocalizedString>
+
+#include <QXmlStreamReader>
+
+using namespace KBlog;
+
+namespace
+{
+
+enum Field {
+    Categories,
+    Content,
+    DateCreated,
+    Description,
+    LastModified,
+    Link,
+    AllowComments,
+    AllowPings,
+    Excerpt,
+    Keywords,
+    TextMore,
+    PermaLink,
+    PostIdCamelCase,
+    PostStatus,
+    PostId,
+    Title,
+    Slug,
+    UnknownField
+};
+
+struct Member {
+    const char *mName;
+    Field mField;
+};
+
+// sorted by name for the binary search
+const Member members[] = {
+    { "categories", Categories },
+    { "content", Content },
+    { "dateCreated", DateCreated },
+    { "description", Description },
+    { "lastModified", LastModified },
+    { "link", Link },
+    { "mt_allow_comments", AllowComments },
+    { "mt_allow_pings", AllowPings },
+    { "mt_excerpt", Excerpt },
+    { "mt_keywords", Keywords },
+    { "mt_text_more", TextMore },
+    { "permaLink", PermaLink },
+    { "postId", PostIdCamelCase },
+    { "post_status", PostStatus },
+    { "postid", PostId },
+    { "title", Title },
+    { "wp_slug", Slug }
+};
+
+Field lookup(const QStringRef &name)
+{
+    int low = 0;
+    int high = int(sizeof(members) / sizeof(Member)) - 1;
+    while (low <= high) {
+        const int middle = (low + high) / 2;
+        const int cmp = name.compare(QLatin1String(members[middle].mName));
+        if (cmp == 0) {
+            return members[middle].mField;
+        }
+        if (cmp < 0) {
+            high = middle - 1;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return UnknownField;
+}
+
+// the readers expect the reader on <value> and leave it on </value>
+
+QString readText(QXmlStreamReader &reader)
+{
+    QString text;
+    bool typed = false;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isEndElement()) {
+            break;
+        }
+        if (reader.isCharacters()) {
+            // a value without a type is a string
+            if (!typed) {
+                text += reader.text();
+            }
+        } else if (reader.isStartElement()) {
+            typed = true;
+            if (reader.name() == QLatin1String("base64")) {
+                text = QString::fromUtf8(QByteArray::fromBase64(reader.readElementText().toLatin1()));
+            } else if (reader.name() == QLatin1String("string")) {
+                text = reader.readElementText();
+            } else {
+                text = reader.readElementText(QXmlStreamReader::SkipChildElements).trimmed();
+            }
+        }
+    }
+    return text;
+}
+
+bool readBool(QXmlStreamReader &reader)
+{
+    const QString text = readText(reader);
+    return text == QLatin1String("true") || text.toInt() != 0;
+}
+
+QStringList readStrings(QXmlStreamReader &reader)
+{
+    QStringList strings;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isEndElement()) {
+            break;
+        }
+        if (reader.isCharacters()) {
+            if (!reader.isWhitespace()) {
+                strings = QStringList(reader.text().toString());
+            }
+        } else if (reader.isStartElement()) {
+            if (reader.name() == QLatin1String("array")) {
+                while (reader.readNextStartElement()) {
+                    // <data>
+                    while (reader.readNextStartElement()) {
+                        if (reader.name() == QLatin1String("value")) {
+                            strings << readText(reader);
+                        } else {
+                            reader.skipCurrentElement();
+                        }
+                    }
+                }
+            } else {
+                strings = QStringList(reader.readElementText(QXmlStreamReader::SkipChildElements));
+            }
+        }
+    }
+    return strings;
+}
+
+void readPost(QXmlStreamReader &reader, PostFields *post)
+{
+    // on <struct>
+    while (reader.readNextStartElement()) {
+        if (reader.name() != QLatin1String("member")) {
+            reader.skipCurrentElement();
+            continue;
+        }
+        Field field = UnknownField;
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("name")) {
+                reader.readNext();
+                field = reader.isCharacters() ? lookup(reader.text().trimmed()) : UnknownField;
+                if (!reader.isEndElement()) {
+                    reader.skipCurrentElement();
+                }
+                continue;
+            }
+            if (reader.name() != QLatin1String("value")) {
+                reader.skipCurrentElement();
+                continue;
+            }
+            switch (field) {
+            case Categories:
+                post->mCategories = readStrings(reader);
+                break;
+            case Content:
+                post->mContent = readText(reader);
+                break;
+            case DateCreated:
+                post->mDateCreated = XmlRpcClient::parseDateTime(readText(reader));
+                break;
+            case Description:
+                post->mDescription = readText(reader);
+                break;
+            case LastModified:
+                post->mLastModified = XmlRpcClient::parseDateTime(readText(reader));
+                break;
+            case Link:
+                post->mLink = readText(reader);
+                break;
+            case AllowComments:
+                post->mAllowComments = readBool(reader);
+                break;
+            case AllowPings:
+                post->mAllowPings = readBool(reader);
+                break;
+            case Excerpt:
+                post->mExcerpt = readText(reader);
+                break;
+            case Keywords:
+                post->mKeywords = readStrings(reader);
+                break;
+            case TextMore:
+                post->mTextMore = readText(reader);
+                break;
+            case PermaLink:
+                post->mPermaLink = readText(reader);
+                break;
+            case PostIdCamelCase: {
+                // postid wins if both are sent
+                const QString id = readText(reader);
+                if (post->mPostId.isEmpty()) {
+                    post->mPostId = id;
+                }
+                break;
+            }
+            case PostStatus:
+                post->mPostStatus = readText(reader);
+                break;
+            case PostId: {
+                const QString id = readText(reader);
+                if (!id.isEmpty()) {
+                    post->mPostId = id;
+                }
+                break;
+            }
+            case Title:
+                post->mTitle = readText(reader);
+                break;
+            case Slug:
+                post->mSlug = readText(reader);
+                break;
+            case UnknownField:
+                reader.skipCurrentElement();
+                break;
+            }
+        }
+    }
+}
+
+// on <value>, reads a struct or an array of structs
+void readPosts(QXmlStreamReader &reader, QList<PostFields> *posts, bool *isList)
+{
+    while (reader.readNextStartElement()) {
+        if (reader.name() == QLatin1String("struct")) {
+            PostFields post;
+            readPost(reader, &post);
+            posts->append(post);
+            *isList = false;
+        } else if (reader.name() == QLatin1String("array")) {
+            *isList = true;
+            while (reader.readNextStartElement()) {
+                // <data>
+                while (reader.readNextStartElement()) {
+                    if (reader.name() != QLatin1String("value")) {
+                        reader.skipCurrentElement();
+                        continue;
+                    }
+                    while (reader.readNextStartElement()) {
+                        if (reader.name() == QLatin1String("struct")) {
+                            PostFields post;
+                            readPost(reader, &post);
+                            posts->append(post);
+                        } else {
+                            reader.skipCurrentElement();
+                        }
+                    }
+                }
+            }
+        } else {
+            reader.skipCurrentElement();
+        }
+    }
+}
+
+}
+
+PostFields PostFields::fromMap(const QMap<QString, QVariant> &postInfo)
+{
+    PostFields post;
+    post.mPostId = postInfo.value(QStringLiteral("postid")).toString();
+    if (post.mPostId.isEmpty()) {
+        post.mPostId = postInfo.value(QStringLiteral("postId")).toString();
+    }
+    post.mTitle = postInfo.value(QStringLiteral("title")).toString();
+    post.mDescription = postInfo.value(QStringLiteral("description")).toString();
+    const QVariant content = postInfo.value(QStringLiteral("content"));
+    if (content.type() == QVariant::ByteArray) {
+        post.mContent = QString::fromUtf8(content.toByteArray());
+    } else {
+        post.mContent = content.toString();
+    }
+    post.mTextMore = postInfo.value(QStringLiteral("mt_text_more")).toString();
+    post.mExcerpt = postInfo.value(QStringLiteral("mt_excerpt")).toString();
+    post.mSlug = postInfo.value(QStringLiteral("wp_slug")).toString();
+    post.mLink = postInfo.value(QStringLiteral("link")).toString();
+    post.mPermaLink = postInfo.value(QStringLiteral("permaLink")).toString();
+    post.mPostStatus = postInfo.value(QStringLiteral("post_status")).toString();
+    post.mCategories = postInfo.value(QStringLiteral("categories")).toStringList();
+    post.mKeywords = postInfo.value(QStringLiteral("mt_keywords")).toStringList();
+    post.mDateCreated = postInfo.value(QStringLiteral("dateCreated")).toDateTime();
+    post.mLastModified = postInfo.value(QStringLiteral("lastModified")).toDateTime();
+    post.mAllowComments = postInfo.value(QStringLiteral("mt_allow_comments")).toInt() != 0;
+    post.mAllowPings = postInfo.value(QStringLiteral("mt_allow_pings")).toInt() != 0;
+    return post;
+}
+
+QList<PostFields> PostFields::fromResult(const QVariant &value, bool *ok)
+{
+    *ok = true;
+    if (value.userType() == qMetaTypeId<QList<PostFields> >()) {
+        return value.value<QList<PostFields> >();
+    }
+    if (value.userType() == qMetaTypeId<PostFields>()) {
+        return QList<PostFields>() << value.value<PostFields>();
+    }
+    QList<PostFields> posts;
+    if (value.type() == QVariant::List) {
+        const QList<QVariant> list = value.toList();
+        posts.reserve(list.count());
+        for (const QVariant &item : list) {
+            posts << fromMap(item.toMap());
+        }
+    } else if (value.type() == QVariant::Map) {
+        posts << fromMap(value.toMap());
+    } else {
+        *ok = false;
+    }
+    return posts;
+}
+
+bool XmlRpcPostDecoder::decode(const QByteArray &data, QList<PostFields> *posts, bool *isList,
+                               int *faultCode, QString *faultString)
+{
+    QXmlStreamReader reader(data);
+    *isList = false;
+    if (reader.readNextStartElement() && reader.name() == QLatin1String("methodResponse")) {
+        while (reader.readNextStartElement()) {
+            if (reader.name() == QLatin1String("params")) {
+                while (reader.readNextStartElement()) {
+                    // <param>
+                    while (reader.readNextStartElement()) {
+                        if (reader.name() == QLatin1String("value")) {
+                            readPosts(reader, posts, isList);
+                        } else {
+                            reader.skipCurrentElement();
+                        }
+                    }
+                }
+            } else if (reader.name() == QLatin1String("fault")) {
+                // rare, leave it to the generic parser
+                QList<QVariant> result;
+                XmlRpcClient::parseResponse(data, &result, faultCode, faultString);
+                return false;
+            } else {
+                reader.skipCurrentElement();
+            }
+        }
+    } else if (!reader.hasError()) {
+        reader.raiseError(i18n("No methodResponse element found."));
+    }
+
+    if (reader.hasError()) {
+        *faultCode = -1;
+        *faultString = i18n("Received invalid XML markup: %1 at %2:%3",
+                            reader.errorString(), reader.lineNumber(),
+                            reader.columnNumber());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,85 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_XMLRPCPOSTDECODER_P_H
+#define KBLOG_XMLRPCPOSTDECODER_P_H
+
+#include "kblog_private_export.h"
+
+#include <QDateTime>
+#include <QList>
+#include <QMap>
+#include <QMetaType>
+#include <QStringList>
+#include <QVariant>
+
+namespace KBlog
+{
+
+/**
+  The members of a post struct as sent by the Blogger 1.0, MetaWeblog and
+  Movable Type APIs. Unknown members are dropped.
+*/
+struct KBLOG_TESTS_EXPORT PostFields {
+    PostFields() : mAllowComments(false), mAllowPings(false) {}
+
+    /**
+      Reads the fields from a struct that has already been parsed into a
+      map, e.g. one delivered within a system.multicall response.
+    */
+    static PostFields fromMap(const QMap<QString, QVariant> &postInfo);
+
+    /**
+      Returns the posts held by @p value, which is either a list or a
+      single post, as decoded fields or as maps. Sets @p ok to false if
+      @p value holds no post at all.
+    */
+    static QList<PostFields> fromResult(const QVariant &value, bool *ok);
+
+    QString mPostId;
+    QString mTitle;
+    QString mDescription;
+    QString mContent;
+    QString mTextMore;
+    QString mExcerpt;
+    QString mSlug;
+    QString mLink;
+    QString mPermaLink;
+    QString mPostStatus;
+    QStringList mCategories;
+    QStringList mKeywords;
+    QDateTime mDateCreated;
+    QDateTime mLastModified;
+    bool mAllowComments;
+    bool mAllowPings;
+};
+
+/**
+  Decodes getPost and getRecentPosts responses straight into PostFields,
+  without building a QVariant tree first. The member names are looked up
+  in a sorted table, so no string is allocated per member.
+*/
+class KBLOG_TESTS_EXPORT XmlRpcPostDecoder
+{
+public:
+    /**
+      Decodes @p data. The posts of an array, or the single post of a
+      struct, are appended to @p posts and @p isList tells which one it
+      was. Returns false on a fault or invalid markup, with @p faultCode
+      and @p faultString set.
+    */
+    static bool decode(const QByteArray &data, QList<PostFields> *posts, bool *isList,
+                       int *faultCode, QString *faultString);
+};
+
+} //namespace KBlog
+
+Q_DECLARE_METATYPE(KBlog::PostFields)
+Q_DECLARE_METATYPE(QList<KBlog::PostFields>)
+
+#endif
@@ -0,0 +1,158 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "xmlrpcresponsescanner_p.h"
+
+#include <KLocalizedString>
+
+using namespace KBlog;
+
+// <methodResponse><params><param><value>
+static const int paramValueDepth = 4;
+// <methodResponse><fault><value><struct><member><value>
+static const int faultStructDepth = 4;
+static const int faultValueDepth = 6;
+
+XmlRpcResponseScanner::XmlRpcResponseScanner()
+    : mState(NeedMoreData), mBytesAdded(0), mDepth(0), mValueDepth(0),
+      mTyped(false), mFault(false), mFaultCode(0)
+{
+}
+
+XmlRpcResponseScanner::State XmlRpcResponseScanner::addData(const QByteArray &data)
+{
+    mBytesAdded += data.size();
+    if (mState == NeedMoreData) {
+        mReader.addData(data);
+        scan();
+    }
+    return mState;
+}
+
+XmlRpcResponseScanner::State XmlRpcResponseScanner::finish()
+{
+    if (mState == NeedMoreData) {
+        setInvalid(i18n("The response ended before its result."));
+    }
+    return mState;
+}
+
+XmlRpcResponseScanner::State XmlRpcResponseScanner::state() const
+{
+    return mState;
+}
+
+qint64 XmlRpcResponseScanner::bytesAdded() const
+{
+    return mBytesAdded;
+}
+
+QString XmlRpcResponseScanner::value() const
+{
+    return mValue;
+}
+
+int XmlRpcResponseScanner::faultCode() const
+{
+    return mFaultCode;
+}
+
+QString XmlRpcResponseScanner::faultString() const
+{
+    return mFaultString;
+}
+
+QString XmlRpcResponseScanner::errorString() const
+{
+    return mErrorString;
+}
+
+void XmlRpcResponseScanner::setInvalid(const QString &errorString)
+{
+    mState = Invalid;
+    mErrorString = errorString;
+    mReader.clear();
+}
+
+void XmlRpcResponseScanner::scan()
+{
+    while (mState == NeedMoreData) {
+        switch (mReader.readNext()) {
+        case QXmlStreamReader::Invalid:
+            if (mReader.error() != QXmlStreamReader::PrematureEndOfDocumentError) {
+                setInvalid(i18n("Received invalid XML markup: %1 at %2:%3",
+                                mReader.errorString(), mReader.lineNumber(),
+                                mReader.columnNumber()));
+            }
+            // otherwise wait for the next part of the response
+            return;
+        case QXmlStreamReader::StartElement: {
+            ++mDepth;
+            const QStringRef name = mReader.name();
+            if (mDepth == 1 && name != QLatin1String("methodResponse")) {
+                setInvalid(i18n("No methodResponse element found."));
+                return;
+            }
+            if (mDepth == 2) {
+                mFault = (name == QLatin1String("fault"));
+            } else if (mValueDepth && mDepth == mValueDepth + 1) {
+                mTyped = true;
+                mText.clear();
+            } else if (name == QLatin1String("value") &&
+                       mDepth == (mFault ? faultValueDepth : paramValueDepth)) {
+                mValueDepth = mDepth;
+                mTyped = false;
+                mText.clear();
+            } else if (mFault && mDepth == faultValueDepth && name == QLatin1String("name")) {
+                mMemberName.clear();
+            }
+            break;
+        }
+        case QXmlStreamReader::Characters:
+            if (mValueDepth) {
+                if ((mDepth == mValueDepth && !mTyped) || mDepth == mValueDepth + 1) {
+                    mText += mReader.text();
+                }
+            } else if (mFault && mDepth == faultValueDepth) {
+                // within <name>
+                mMemberName += mReader.text();
+            }
+            break;
+        case QXmlStreamReader::EndElement:
+            if (mValueDepth && mDepth == mValueDepth + 1 &&
+                    mReader.name() != QLatin1String("string")) {
+                mText = mText.trimmed();
+            } else if (mValueDepth && mDepth == mValueDepth) {
+                mValueDepth = 0;
+                if (!mFault) {
+                    mValue = mText;
+                    mState = Value;
+                    mReader.clear();
+                    return;
+                }
+                const QString member = mMemberName.trimmed();
+                if (member == QLatin1String("faultCode")) {
+                    mFaultCode = mText.trimmed().toInt();
+                } else if (member == QLatin1String("faultString")) {
+                    mFaultString = mText;
+                }
+            } else if (mFault && mDepth <= faultStructDepth) {
+                mState = Fault;
+                mReader.clear();
+                return;
+            } else if (mDepth == 1) {
+                setInvalid(i18n("The response holds no result."));
+                return;
+            }
+            --mDepth;
+            break;
+        default:
+            break;
+        }
+    }
+}
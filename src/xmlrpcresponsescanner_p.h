@@ -0,0 +1,93 @@
+/*
+  This file is part of the kblog library.
+
+  SPDX-FileCopyrightText: 2026 KBlog Developers
+
+  SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KBLOG_XMLRPCRESPONSESCANNER_P_H
+#define KBLOG_XMLRPCRESPONSESCANNER_P_H
+
+#include "kblog_private_export.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QXmlStreamReader>
+
+namespace KBlog
+{
+
+/**
+  Reads the result of an XML-RPC response that returns a single scalar,
+  e.g. the id of a new post, while the response is still arriving. It
+  stops as soon as the value or the fault has been read and ignores the
+  rest of the data.
+*/
+class KBLOG_TESTS_EXPORT XmlRpcResponseScanner
+{
+public:
+    enum State {
+        /** The answer has not been read yet. */
+        NeedMoreData,
+        /** The response holds a value, see value(). */
+        Value,
+        /** The response is a fault, see faultCode() and faultString(). */
+        Fault,
+        /** The response is no valid XML-RPC response, see errorString(). */
+        Invalid
+    };
+
+    XmlRpcResponseScanner();
+
+    /**
+      Scans the next part of the response and returns the new state.
+    */
+    State addData(const QByteArray &data);
+
+    /**
+      Tells the scanner that the response is complete. Returns Invalid
+      if it ends before the answer.
+    */
+    State finish();
+
+    State state() const;
+
+    /**
+      Returns the number of bytes passed to addData(), including the ones
+      that have been ignored.
+    */
+    qint64 bytesAdded() const;
+
+    /**
+      Returns the text of the value, e.g. "1" for a boolean true.
+    */
+    QString value() const;
+
+    int faultCode() const;
+    QString faultString() const;
+    QString errorString() const;
+
+private:
+    void scan();
+    void setInvalid(const QString &errorString);
+
+    QXmlStreamReader mReader;
+    State mState;
+    qint64 mBytesAdded;
+    int mDepth;
+    // the depth of the <value> that is read, 0 outside of one
+    int mValueDepth;
+    bool mTyped;
+    bool mFault;
+    QString mText;
+    QString mMemberName;
+    QString mValue;
+    int mFaultCode;
+    QString mFaultString;
+    QString mErrorString;
+};
+
+}
+
+#endif